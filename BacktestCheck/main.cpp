@@ -0,0 +1,213 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: BacktestCheck
+ * Created: 2026/10/16 21:58:40
+ */
+
+// runs sessions through lib/TFSimulation/BacktestRunner at increasing thread counts, and times them:
+//   BacktestCheck [days] [quotes a day] [sessions] [threads]
+// days of generated quotes and trades are written to TradeFrame.hdf5 in the current directory,
+//   session ix runs day ix % days with an ema crossover strategy placing market orders
+// the sessions are run with 1 thread, then doubling up to [threads], each session's datums and P/L must match the
+//   single thread run, as the sessions are isolated from each other
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include <boost/log/core.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+#include <TFTimeSeries/TimeSeries.h>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5WriteTimeSeries.h>
+
+#include <TFTrading/Watch.h>
+#include <TFTrading/Position.h>
+#include <TFTrading/Instrument.h>
+
+#include <TFSimulation/BacktestRunner.h>
+
+namespace {
+
+  using BacktestRunner = ou::tf::BacktestRunner;
+
+  const std::string c_sSymbol( "SYM" );
+  const std::string c_sRoot( "/app/BacktestCheck" );
+
+  std::string Group( size_t day ) {
+    return c_sRoot + "/d" + std::to_string( day );
+  }
+
+  // a random walk midpoint, a quote each 1ms to 6ms, a trade each fourth quote
+  void Generate( size_t nDays, size_t nQuotes ) {
+    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
+    const hid_t idFile( dm.GetH5File()->getId() );
+    if ( ( 0 < H5Lexists( idFile, "/app", H5P_DEFAULT ) ) && ( 0 < H5Lexists( idFile, c_sRoot.c_str(), H5P_DEFAULT ) ) ) {
+      H5Ldelete( idFile, c_sRoot.c_str(), H5P_DEFAULT ); // from an earlier run
+    }
+    for ( size_t day = 0; day < nDays; ++day ) {
+      const std::string sGroup( Group( day ) );
+      ou::tf::Quotes quotes;
+      ou::tf::Trades trades;
+      boost::posix_time::ptime dt(
+        boost::gregorian::date( 2026, 1, 5 ) + boost::gregorian::days( day ),
+        boost::posix_time::time_duration( 14, 30, 0 ) );
+      double mid( 100.0 );
+      unsigned int seed( day + 1 );
+      for ( size_t ix = 0; ix < nQuotes; ++ix ) {
+        dt += boost::posix_time::microseconds( 1000 + rand_r( &seed ) % 5000 );
+        mid += ( double( rand_r( &seed ) % 201 ) - 100.0 ) * 0.0005;
+        quotes.Append( ou::tf::Quote( dt, mid - 0.01, 100, mid + 0.01, 100 ) );
+        if ( 0 == ix % 4 ) trades.Append( ou::tf::Trade( dt, mid, 100 ) );
+      }
+      dm.AddGroup( sGroup + "/quotes/" );
+      dm.AddGroup( sGroup + "/trades/" );
+      ou::tf::HDF5WriteTimeSeries<ou::tf::Quotes> wtsQuotes( dm, true, true );
+      wtsQuotes.Write( sGroup + "/quotes/" + c_sSymbol, &quotes );
+      ou::tf::HDF5WriteTimeSeries<ou::tf::Trades> wtsTrades( dm, true, true );
+      wtsTrades.Write( sGroup + "/trades/" + c_sSymbol, &trades );
+    }
+    dm.Flush();
+  }
+
+  // ema crossover on the midpoint, some work per quote, and an order at each cross
+  class Strategy {
+  public:
+
+    Strategy( BacktestRunner::Context& context )
+    : m_emaFast {}, m_emaSlow {}, m_nQuotes {}, m_side {}
+    {
+      ou::tf::Instrument::pInstrument_t pInstrument
+        = std::make_shared<ou::tf::Instrument>( c_sSymbol, ou::tf::InstrumentType::Stock, "SMART" );
+      m_pWatch = std::make_shared<ou::tf::Watch>( pInstrument, context.pProvider );
+      m_pPosition = std::make_shared<ou::tf::Position>( m_pWatch, context.pProvider );
+      context.pPortfolio->AddPosition( "sym", m_pPosition );
+      m_pWatch->OnQuote.Add( MakeDelegate( this, &Strategy::HandleQuote ) );
+      m_pWatch->StartWatch();
+    }
+
+    ~Strategy() {
+      m_pWatch->StopWatch();
+      m_pWatch->OnQuote.Remove( MakeDelegate( this, &Strategy::HandleQuote ) );
+    }
+
+    void Close() { m_pPosition->ClosePosition(); }
+
+  private:
+
+    ou::tf::Watch::pWatch_t m_pWatch;
+    ou::tf::Position::pPosition_t m_pPosition;
+
+    double m_emaFast;
+    double m_emaSlow;
+    size_t m_nQuotes;
+    int m_side; // -1 short, 0 flat, 1 long
+
+    void HandleQuote( const ou::tf::Quote& quote ) {
+      const double mid( quote.Midpoint() );
+      if ( 0 == m_nQuotes++ ) {
+        m_emaFast = m_emaSlow = mid;
+        return;
+      }
+      m_emaFast += ( mid - m_emaFast ) * 0.05;
+      m_emaSlow += ( mid - m_emaSlow ) * 0.005;
+      const int want( ( m_emaFast > m_emaSlow ) ? 1 : -1 );
+      if ( ( 1000 < m_nQuotes ) && ( want != m_side ) && ( 0 == m_pPosition->GetRow().nPositionPending ) ) {
+        m_pPosition->PlaceOrder(
+          ou::tf::OrderType::Market,
+          ( 1 == want ) ? ou::tf::OrderSide::Buy : ou::tf::OrderSide::Sell,
+          ( 0 == m_side ) ? 100 : 200 );
+        m_side = want;
+      }
+    }
+  };
+
+  BacktestRunner::vResult_t Run( size_t nDays, size_t nSessions, size_t nThreads, double& dblSeconds ) {
+    BacktestRunner runner( nThreads );
+    for ( size_t ix = 0; ix < nSessions; ++ix ) {
+      runner.Add(
+        "s" + std::to_string( ix ) + "-d" + std::to_string( ix % nDays ), Group( ix % nDays ),
+        []( BacktestRunner::Context& context ){ context.pStrategy = std::make_shared<Strategy>( context ); },
+        []( BacktestRunner::Context& context ){ std::static_pointer_cast<Strategy>( context.pStrategy )->Close(); } );
+    }
+    const auto begin( std::chrono::steady_clock::now() );
+    BacktestRunner::vResult_t vResult( runner.Run() );
+    dblSeconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - begin ).count();
+    return vResult;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nDays( ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 8 );
+  const size_t nQuotes( ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 100000 );
+  const size_t nSessions( ( 3 < argc ) ? std::stoul( argv[ 3 ] ) : 16 );
+  const size_t nThreadsMax( ( 4 < argc ) ? std::stoul( argv[ 4 ] ) : 8 );
+
+  if ( ( 0 == nDays ) || ( 0 == nSessions ) ) {
+    std::cout << "BacktestCheck [days] [quotes a day] [sessions] [threads]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the simulated order flow is logged at info, a line per event, which would be the most of the time
+  boost::log::core::get()->set_filter( boost::log::trivial::severity >= boost::log::trivial::warning );
+
+  size_t nFail {};
+  try {
+    Generate( nDays, nQuotes );
+
+    BacktestRunner::vResult_t vResultSingle;
+    for ( size_t nThreads = 1; nThreads <= nThreadsMax; nThreads *= 2 ) {
+      double dblSeconds;
+      const BacktestRunner::vResult_t vResult( Run( nDays, nSessions, nThreads, dblSeconds ) );
+      if ( 1 == nThreads ) {
+        BacktestRunner::Summary( vResult, std::cout );
+        vResultSingle = vResult;
+      }
+      unsigned long nDatums {};
+      size_t nDiffer {};
+      for ( size_t ix = 0; ix < vResult.size(); ++ix ) {
+        const BacktestRunner::Result& result( vResult[ ix ] );
+        const BacktestRunner::Result& single( vResultSingle[ ix ] );
+        nDatums += result.nDatums;
+        if ( !result.bOk || ( result.nDatums != single.nDatums ) || ( result.dblTotal != single.dblTotal ) ) nDiffer++;
+      }
+      std::cout
+        << "threads " << std::setw( 2 ) << nThreads << ": " << nSessions << " sessions, " << nDatums << " datums, "
+        << std::fixed << std::setprecision( 2 ) << dblSeconds << "s, " << nDatums / dblSeconds / 1e6 << "M datums/s"
+        << ", " << nDiffer << " differ from 1 thread"
+        << std::endl;
+      std::cout.unsetf( std::ios::fixed );
+      nFail += nDiffer;
+    }
+  }
+  catch ( const std::exception& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return ( 0 == nFail ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
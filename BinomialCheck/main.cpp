@@ -0,0 +1,465 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: BinomialCheck
+ * Created: 2026/10/16 18:32:10
+ */
+
+// compares lib/TFOptions/Binomial with the vector based CRR and newton search it replaced, over a grid of inputs:
+//   BinomialCheck price  [steps]...
+//   BinomialCheck iv     [steps]...
+//   BinomialCheck replay [steps]...
+// price compares option, delta, gamma, theta from CRR, single and batched, against the reference tree
+// iv prices each grid point with the reference tree, then recovers the volatility with both searches
+// replay times the library search over a 2000 option chain quoted for a number of ticks, with and without warm starts
+// the exit status is EXIT_FAILURE when a difference is beyond its tolerance
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <TFOptions/Binomial.h>
+
+namespace {
+
+  namespace binomial = ou::tf::option::binomial;
+
+  using vInput_t = std::vector<binomial::structInput>;
+
+  namespace reference { // the tree and search as they were before the arena / power table rewrite
+
+    void CRR( const binomial::structInput& input, binomial::structOutput& output ) {
+
+      std::vector<double> v; v.resize( input.n + 1 );
+      double u, d, p;
+      double dt;
+      double df;
+      double z;
+
+      switch ( input.optionSide ) {
+      case ou::tf::OptionSide::Call:
+        z = 1;
+        break;
+      case ou::tf::OptionSide::Put:
+        z = -1;
+        break;
+      default:
+        z = 0;
+      }
+
+      dt = input.T / input.n;
+      u = exp( input.v * sqrt( dt ) );
+      d = 1.0 / u;
+      p = ( exp( input.b * dt ) - d ) / ( u - d );
+      df = exp( -input.r * dt );
+
+      for ( int ix = 0; ix <= input.n; ++ix ) {
+        v[ ix ] = std::max<double>( 0.0, z * ( input.S * pow( u, ix ) * pow( d, input.n - ix ) - input.X ) );
+      }
+      for ( int j = input.n - 1; j >= 0; --j ) {
+        for ( int i = 0; i <= j; ++i ) {
+          double europrice = df * ( p * v[ i + 1 ] + ( 1.0 - p ) * v[ i ] );
+          double exerciseprice;
+          switch ( input.optionStyle ) {
+          case ou::tf::OptionStyle::American:
+            exerciseprice = z * ( input.S * pow( u, i ) * pow( d, j - i ) - input.X );
+            v[ i ] = std::max<double>( exerciseprice, europrice );
+            break;
+          case ou::tf::OptionStyle::European:
+            v[ i ] = europrice;
+            break;
+          default:
+            break;
+          }
+          if ( 2 == j ) {
+            output.gamma = ( ( v[ 2 ] - v[ 1 ] ) / ( input.S * u * u - input.S )
+              - ( v[ 1 ] - v[ 0 ] ) / ( input.S - input.S * d * d ) )
+              / ( 0.5 * ( input.S * u * u - input.S * d * d ) );
+            output.theta = v[ 1 ];
+          }
+          if ( 1 == j ) {
+            output.delta = ( v[ 1 ] - v[ 0 ] ) / ( input.S * ( u - d ) );
+          }
+        }
+      }
+      output.theta = ( output.theta - v[ 0 ] ) / ( 2.0 * dt ) / 365.0;
+      output.option = v[ 0 ];
+    }
+
+    double CalcImpliedVolatility( const binomial::structInput& input_, double option, binomial::structOutput& output, double epsilon ) {
+
+      size_t cnt = 10;
+      binomial::structInput input( input_ );
+
+      reference::CRR( input, output );
+      double option1 = output.option;
+
+      static double pct = 0.01;
+
+      double diff = 2 * epsilon;
+      while ( epsilon < diff ) {
+
+        double vol = input.v;
+        double deltaVol = pct * vol;
+        double volInput1 = input.v = vol + deltaVol;
+
+        reference::CRR( input, output );
+        double option2 = output.option;
+
+        output.vega = ( option2 - option1 ) / ( deltaVol );
+        double volInput2 = output.iv = input.v = vol - ( ( option1 - option ) / output.vega );
+
+        reference::CRR( input, output );
+        option1 = output.option;
+        diff = std::fabs( (double) ( output.option - option ) );
+
+        output.vega = ( ( output.option - option2 ) / ( volInput2 - volInput1 ) ) * 0.01;
+
+        --cnt;
+        if ( 0 == cnt ) {
+          throw std::runtime_error( "IVp in CRR" );
+        }
+      }
+
+      return output.iv;
+    }
+
+  } // namespace reference
+
+  vInput_t Grid( const std::vector<long>& vSteps ) {
+    vInput_t vInput;
+    for ( const long n: vSteps ) {
+      for ( const ou::tf::OptionStyle::EOptionStyle style: { ou::tf::OptionStyle::American, ou::tf::OptionStyle::European } ) {
+        for ( const ou::tf::OptionSide::EOptionSide side: { ou::tf::OptionSide::Call, ou::tf::OptionSide::Put } ) {
+          for ( const double moneyness: { 0.70, 0.90, 0.97, 1.00, 1.03, 1.10, 1.30 } ) {
+            for ( const double days: { 1.0, 7.0, 30.0, 91.0, 365.0, 730.0 } ) {
+              for ( const double v: { 0.05, 0.20, 0.50, 1.00, 2.00 } ) {
+                for ( const double r: { 0.001, 0.05 } ) {
+                  binomial::structInput input;
+                  input.optionStyle = style;
+                  input.optionSide = side;
+                  input.S = 100.0;
+                  input.X = 100.0 * moneyness;
+                  input.T = days / 365.0;
+                  input.r = input.b = r;
+                  input.v = v;
+                  input.n = n;
+                  vInput.push_back( input );
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    return vInput;
+  }
+
+  std::string Describe( const binomial::structInput& input ) {
+    return
+        std::string( ou::tf::OptionStyle::American == input.optionStyle ? "american " : "european " )
+      + ( ou::tf::OptionSide::Call == input.optionSide ? "call" : "put" )
+      + " X=" + std::to_string( input.X ) + " T=" + std::to_string( input.T )
+      + " v=" + std::to_string( input.v ) + " r=" + std::to_string( input.r )
+      + " n=" + std::to_string( input.n );
+  }
+
+  class Worst { // largest difference seen for one field, and the count beyond its tolerance
+  public:
+    Worst( const std::string& sName, double dblTolerance )
+    : m_sName( sName ), m_dblTolerance( dblTolerance ), m_dblDiff {}, m_nOver {}, m_pInput( nullptr ) {}
+    void Add( double a, double b, const binomial::structInput& input ) {
+      const double diff( std::fabs( a - b ) / std::max( 1.0, std::fabs( b ) ) );
+      if ( !( diff <= m_dblTolerance ) ) m_nOver++; // nan counts as over
+      if ( !( diff <= m_dblDiff ) ) {
+        m_dblDiff = diff;
+        m_pInput = &input;
+      }
+    }
+    size_t Over() const { return m_nOver; }
+    void Emit() const {
+      std::cout
+        << std::setw( 8 ) << m_sName << ": max " << std::setw( 12 ) << m_dblDiff
+        << ", " << m_nOver << " over " << m_dblTolerance;
+      if ( nullptr != m_pInput ) std::cout << ", at " << Describe( *m_pInput );
+      std::cout << std::endl;
+    }
+  private:
+    std::string m_sName;
+    double m_dblTolerance;
+    double m_dblDiff;
+    size_t m_nOver;
+    const binomial::structInput* m_pInput;
+  };
+
+  // relative to the value when it is above 1.0, absolute below
+  //   the power table is built outward from S where pow() was exact per node, so a few ulps move on deep trees,
+  //   gamma and theta are differences of nearby values and show that most
+  const double c_dblPrice = 1e-9;
+  const double c_dblGreek = 1e-6;
+
+  size_t Price( const vInput_t& vInput ) {
+
+    std::vector<binomial::structOutput> vReference( vInput.size() );
+    std::vector<binomial::structOutput> vSingle( vInput.size() );
+    std::vector<binomial::structOutput> vBatch( vInput.size() );
+
+    for ( size_t ix = 0; ix < vInput.size(); ++ix ) {
+      reference::CRR( vInput[ ix ], vReference[ ix ] );
+      binomial::CRR( vInput[ ix ], vSingle[ ix ] );
+    }
+    binomial::CRR( vInput.data(), vBatch.data(), vInput.size() );
+
+    size_t nOver {};
+    for ( const char* szSource: { "single", "batch" } ) {
+      const std::vector<binomial::structOutput>& vOutput( ( 's' == *szSource ) ? vSingle : vBatch );
+      Worst option( "option", c_dblPrice );
+      Worst delta( "delta", c_dblGreek );
+      Worst gamma( "gamma", c_dblGreek );
+      Worst theta( "theta", c_dblGreek );
+      for ( size_t ix = 0; ix < vInput.size(); ++ix ) {
+        option.Add( vOutput[ ix ].option, vReference[ ix ].option, vInput[ ix ] );
+        delta.Add( vOutput[ ix ].delta, vReference[ ix ].delta, vInput[ ix ] );
+        gamma.Add( vOutput[ ix ].gamma, vReference[ ix ].gamma, vInput[ ix ] );
+        theta.Add( vOutput[ ix ].theta, vReference[ ix ].theta, vInput[ ix ] );
+      }
+      std::cout << szSource << " CRR against the reference, " << vInput.size() << " options" << std::endl;
+      for ( const Worst* p: { &option, &delta, &gamma, &theta } ) {
+        p->Emit();
+        nOver += p->Over();
+      }
+    }
+    return nOver;
+  }
+
+  size_t ImpliedVolatility( const vInput_t& vInput ) {
+
+    static const double epsilon = 0.0001;
+
+    size_t nPriced {};       // grid points with time value to solve for
+    size_t nReference {};    // solved by the reference search
+    size_t nSolved {};       // solved by the library search
+    size_t nMissed {};       // solved by the reference search, not by the library search
+    size_t nIterations {};   // trees evaluated by the library search
+    Worst recovered( "price", epsilon ); // the search stops within epsilon of the price
+
+    for ( const binomial::structInput& input: vInput ) {
+
+      binomial::structOutput output;
+      reference::CRR( input, output );
+      const double option( output.option );
+
+      binomial::structInput start( input );
+      start.v = 0.3;
+
+      // a price within epsilon of intrinsic value does not pin a volatility, neither search is asked for it
+      const double intrinsic( std::max( 0.0, ( ou::tf::OptionSide::Call == input.optionSide ? 1.0 : -1.0 ) * ( input.S - input.X ) ) );
+      if ( ( option - intrinsic ) < 100.0 * epsilon ) continue;
+      nPriced++;
+
+      bool bReference( false );
+      try {
+        binomial::structOutput outputReference;
+        reference::CalcImpliedVolatility( start, option, outputReference, epsilon );
+        bReference = std::isfinite( outputReference.iv );
+      }
+      catch ( const std::runtime_error& ) {}
+      if ( bReference ) nReference++;
+
+      try {
+        binomial::structOutput outputLibrary;
+        size_t n {};
+        const double iv( binomial::CalcImpliedVolatility( start, option, outputLibrary, epsilon, n ) );
+        nIterations += n;
+        nSolved++;
+        // judge the solution by the price it gives with the reference tree
+        binomial::structInput check( input );
+        check.v = iv;
+        binomial::structOutput outputCheck;
+        reference::CRR( check, outputCheck );
+        recovered.Add( outputCheck.option, option, input );
+      }
+      catch ( const std::runtime_error& ) {
+        if ( bReference ) nMissed++;
+      }
+    }
+
+    std::cout
+      << "implied volatility, " << nPriced << " options with time value" << std::endl
+      << "  reference solved " << nReference << ", library solved " << nSolved
+      << ", library missed " << nMissed << " the reference solved" << std::endl
+      << "  library trees per solve " << ( 0 == nSolved ? 0.0 : double( nIterations ) / nSolved ) << std::endl
+      << "  price at the library solution against the target:" << std::endl << "  ";
+    recovered.Emit();
+
+    return nMissed + recovered.Over();
+  }
+
+  // 10 weekly expiries, 100 strikes, calls and puts, on an underlying which random walks from 100 over 20 ticks
+  //   the quotes are reference tree prices at a volatility smile which drifts up over the ticks
+  //   each tick is solved for every option, as the option engine would on an underlying move
+  size_t Replay( long nSteps ) {
+
+    static const double epsilon = 0.0001;
+    static const size_t nTicks = 20;
+
+    struct Quoted {
+      binomial::structInput input; // S and v are set per tick
+      double volatility;           // smile, before the drift
+      double iv;                   // last library solution, the warm start
+    };
+
+    std::vector<Quoted> vQuoted;
+    for ( int expiry = 1; expiry <= 10; ++expiry ) {
+      for ( int strike = 0; strike < 100; ++strike ) {
+        for ( const ou::tf::OptionSide::EOptionSide side: { ou::tf::OptionSide::Call, ou::tf::OptionSide::Put } ) {
+          Quoted quoted;
+          quoted.input.optionSide = side;
+          quoted.input.X = 60.0 + 0.8 * strike;
+          quoted.input.T = 7.0 * expiry / 365.0;
+          quoted.input.r = quoted.input.b = 0.05;
+          quoted.input.n = nSteps;
+          const double m( std::log( quoted.input.X / 100.0 ) );
+          quoted.volatility = 0.22 + 0.3 * m * m - 0.1 * m;
+          quoted.iv = 0.0;
+          vQuoted.push_back( quoted );
+        }
+      }
+    }
+
+    std::mt19937 rng( 1 );
+    std::normal_distribution<double> normal( 0.0, 1.0 );
+    std::vector<double> vUnderlying( nTicks );
+    std::vector<std::vector<double> > vvOption( nTicks, std::vector<double>( vQuoted.size() ) );
+    double S( 100.0 );
+    for ( size_t tick = 0; tick < nTicks; ++tick ) {
+      S *= std::exp( 0.001 * normal( rng ) );
+      vUnderlying[ tick ] = S;
+      for ( size_t ix = 0; ix < vQuoted.size(); ++ix ) {
+        binomial::structInput input( vQuoted[ ix ].input );
+        input.S = S;
+        input.v = vQuoted[ ix ].volatility * ( 1.0 + 0.002 * tick );
+        binomial::structOutput output;
+        reference::CRR( input, output );
+        vvOption[ tick ][ ix ] = output.option;
+      }
+    }
+
+    std::cout << "replay, " << vQuoted.size() << " options, " << nTicks << " ticks, " << nSteps << " steps" << std::endl;
+
+    size_t nOver {};
+    for ( const char* szSearch: { "cold", "warm" } ) {
+      const bool bWarm( 'w' == *szSearch );
+      size_t nSolved {};
+      size_t nFailed {};
+      size_t nSkipped {};
+      size_t nIterations {};
+      for ( Quoted& quoted: vQuoted ) quoted.iv = 0.0;
+      const auto begin( std::chrono::steady_clock::now() );
+      for ( size_t tick = 0; tick < nTicks; ++tick ) {
+        for ( size_t ix = 0; ix < vQuoted.size(); ++ix ) {
+          Quoted& quoted( vQuoted[ ix ] );
+          const double option( vvOption[ tick ][ ix ] );
+          binomial::structInput input( quoted.input );
+          input.S = vUnderlying[ tick ];
+          const double intrinsic( std::max( 0.0, ( ou::tf::OptionSide::Call == input.optionSide ? 1.0 : -1.0 ) * ( input.S - input.X ) ) );
+          if ( ( option - intrinsic ) < 100.0 * epsilon ) { // as in iv, no volatility is pinned
+            nSkipped++;
+            continue;
+          }
+          // as Option::CalcGreeks starts the search: the last solution, else Manaster Koehler
+          input.v = ( bWarm && ( 0.0 < quoted.iv ) )
+            ? quoted.iv
+            : std::sqrt( std::abs( std::log( input.S / input.X ) + input.r * input.T ) * 2.0 / input.T );
+          binomial::structOutput output;
+          try {
+            size_t n {};
+            quoted.iv = binomial::CalcImpliedVolatility( input, option, output, epsilon, n );
+            nIterations += n;
+            nSolved++;
+          }
+          catch ( const std::runtime_error& ) {
+            nFailed++;
+          }
+        }
+      }
+      const double dblSeconds( std::chrono::duration<double>( std::chrono::steady_clock::now() - begin ).count() );
+      std::cout
+        << "  " << szSearch << ": " << dblSeconds << "s, solved " << nSolved
+        << ", failed " << nFailed << ", skipped " << nSkipped
+        << ", trees per solve " << ( 0 == nSolved ? 0.0 : double( nIterations ) / nSolved )
+        << std::endl;
+      nOver += nFailed;
+    }
+
+    return nOver;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const std::string sUsage(
+    "BinomialCheck price [steps]...\n"
+    "BinomialCheck iv [steps]...\n"
+    "BinomialCheck replay [steps]..."
+  );
+
+  if ( 2 > argc ) {
+    std::cout << sUsage << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string sCommand( argv[ 1 ] );
+
+  std::vector<long> vSteps;
+  for ( int ix = 2; ix < argc; ++ix ) vSteps.push_back( std::stol( argv[ ix ] ) );
+  if ( vSteps.empty() ) vSteps = ( "replay" == sCommand ) ? std::vector<long>{ 91 } : std::vector<long>{ 3, 10, 91, 250 };
+
+  size_t nOver {};
+  try {
+    const vInput_t vInput( Grid( vSteps ) );
+    if ( "price" == sCommand ) {
+      nOver = Price( vInput );
+    }
+    else
+    if ( "iv" == sCommand ) {
+      nOver = ImpliedVolatility( vInput );
+    }
+    else
+    if ( "replay" == sCommand ) {
+      for ( const long nSteps: vSteps ) nOver += Replay( nSteps );
+    }
+    else {
+      std::cout << sUsage << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch ( const std::exception& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return ( 0 == nOver ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,262 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: ChainCheck
+ * Created: 2026/10/16 20:02:44
+ */
+
+// compares the strike queries of lib/TFOptions/Chain with std::map based versions, as Chain had them, and times both:
+//   ChainCheck [queries] [ticks]
+// on two 500 strike chains, filled in random order:  SPX style, 5 wide from 3500 to 4995 and 25 wide beyond,
+// and regular, 5 wide from 3000 to 5495
+//   compare:  each query function at random prices, and AdjacentStrikes at each multiple of 5,
+//             must return the same strike, or throw the same exception type
+//   time:     an underlying random walks from 4200, five queries a tick, as strategy code does on a quote
+
+#include <map>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+#include <TFOptions/Chain.h>
+
+namespace {
+
+  using chain_t = ou::tf::option::Chain<ou::tf::option::chain::OptionName>;
+
+  namespace reference { // the map and iterator searches Chain used before the strike vector
+
+    class Chain {
+    public:
+
+      using mapChain_t = std::map<double, int>;
+
+      void Add( double strike ) { m_mapChain.emplace( strike, 0 ); }
+
+      double Put_Itm( double value ) const { return Value( Upper( value ) ); }
+      double Put_ItmAtm( double value ) const { return Value( Lower( value ) ); }
+      double Put_Atm( double value ) const { return Atm( value ); }
+      double Put_OtmAtm( double value ) const { return AtOrBelow( value ); }
+      double Put_Otm( double value ) const { return Below( value ); }
+
+      double Call_Itm( double value ) const { return Below( value ); }
+      double Call_ItmAtm( double value ) const { return AtOrBelow( value ); }
+      double Call_Atm( double value ) const { return Atm( value ); }
+      double Call_OtmAtm( double value ) const { return Value( Lower( value ) ); }
+      double Call_Otm( double value ) const { return Value( Upper( value ) ); }
+
+      double Atm( double value ) const {
+        mapChain_t::const_iterator iter1 = Lower( value );
+        Value( iter1 );
+        if ( ( value == iter1->first ) || ( m_mapChain.begin() == iter1 ) ) return value;
+        mapChain_t::const_iterator iter2 = iter1;
+        iter2--;
+        return ( ( iter1->first - value ) < ( value - iter2->first ) ) ? iter1->first : iter2->first;
+      }
+
+      int AdjacentStrikes( double strikeSource, double& strikeLower, double& strikeUpper ) const {
+        strikeLower = strikeUpper = 0.0;
+        int nReturn {};
+        mapChain_t::const_iterator iterSource = m_mapChain.find( strikeSource );
+        if ( m_mapChain.end() != iterSource ) {
+          if ( m_mapChain.begin() != iterSource ) {
+            strikeLower = std::prev( iterSource )->first;
+            nReturn++;
+          }
+          mapChain_t::const_iterator iterUpper = std::next( iterSource );
+          if ( m_mapChain.end() != iterUpper ) {
+            strikeUpper = iterUpper->first;
+            nReturn++;
+          }
+        }
+        return nReturn;
+      }
+
+    private:
+
+      mapChain_t m_mapChain;
+
+      // std::lower_bound and std::upper_bound step through the map nodes
+      mapChain_t::const_iterator Lower( double value ) const {
+        return std::lower_bound(
+          m_mapChain.begin(), m_mapChain.end(), value,
+          []( const mapChain_t::value_type& vt, double value )->bool{ return vt.first < value; } );
+      }
+      mapChain_t::const_iterator Upper( double value ) const {
+        return std::upper_bound(
+          m_mapChain.begin(), m_mapChain.end(), value,
+          []( double value, const mapChain_t::value_type& vt )->bool{ return value < vt.first; } );
+      }
+      double Value( mapChain_t::const_iterator iter ) const {
+        if ( m_mapChain.end() == iter ) throw chain_t::exception_strike_not_found( "not found" );
+        return iter->first;
+      }
+      double AtOrBelow( double value ) const {
+        mapChain_t::const_iterator iter = Lower( value );
+        Value( iter );
+        if ( value == iter->first ) return value;
+        if ( m_mapChain.begin() == iter ) throw chain_t::exception_at_start_of_chain( "at begin of chain" );
+        return std::prev( iter )->first;
+      }
+      double Below( double value ) const {
+        mapChain_t::const_iterator iter = Lower( value );
+        Value( iter );
+        if ( m_mapChain.begin() == iter ) throw chain_t::exception_at_start_of_chain( "at begin of chain" );
+        return std::prev( iter )->first;
+      }
+    };
+
+  } // namespace reference
+
+  static const size_t nQuery = 11;
+  const char* c_szQuery[ nQuery ] = {
+    "Put_Itm", "Put_ItmAtm", "Put_Atm", "Put_OtmAtm", "Put_Otm",
+    "Call_Itm", "Call_ItmAtm", "Call_Atm", "Call_OtmAtm", "Call_Otm", "Atm" };
+
+  template<typename Chain>
+  double Query( const Chain& chain, size_t ixQuery, double value ) {
+    switch ( ixQuery ) {
+      case 0: return chain.Put_Itm( value );
+      case 1: return chain.Put_ItmAtm( value );
+      case 2: return chain.Put_Atm( value );
+      case 3: return chain.Put_OtmAtm( value );
+      case 4: return chain.Put_Otm( value );
+      case 5: return chain.Call_Itm( value );
+      case 6: return chain.Call_ItmAtm( value );
+      case 7: return chain.Call_Atm( value );
+      case 8: return chain.Call_OtmAtm( value );
+      case 9: return chain.Call_Otm( value );
+      default: return chain.Atm( value );
+    }
+  }
+
+  // 0: a strike, 1: exception_strike_not_found, 2: exception_at_start_of_chain
+  template<typename Chain>
+  int Outcome( const Chain& chain, size_t ixQuery, double value, double& strike ) {
+    strike = 0.0;
+    try {
+      strike = Query( chain, ixQuery, value );
+      return 0;
+    }
+    catch ( const chain_t::exception_at_start_of_chain& ) {
+      return 2;
+    }
+    catch ( const chain_t::exception_strike_not_found& ) {
+      return 1;
+    }
+  }
+
+  std::vector<double> Strikes( bool bRegular ) {
+    std::vector<double> vStrike;
+    if ( bRegular ) {
+      for ( int ix = 0; ix < 500; ++ix ) vStrike.push_back( 3000.0 + 5.0 * ix );
+    }
+    else {
+      for ( int ix = 0; ix < 300; ++ix ) vStrike.push_back( 3500.0 + 5.0 * ix );
+      for ( int ix = 1; ix <= 100; ++ix ) {
+        vStrike.push_back( 3500.0 - 25.0 * ix );
+        vStrike.push_back( 4995.0 + 25.0 * ix );
+      }
+    }
+    std::mt19937 rng( 3 );
+    std::shuffle( vStrike.begin(), vStrike.end(), rng );
+    return vStrike;
+  }
+
+  size_t Compare( const chain_t& chain, const reference::Chain& ref, size_t nQueries ) {
+    size_t nDiffer {};
+    std::mt19937 rng( 7 );
+    std::uniform_real_distribution<double> price( 800.0, 7000.0 );
+    for ( size_t ix = 0; ix < nQueries; ++ix ) {
+      const double value( ( 0 == ix % 3 ) ? std::round( price( rng ) / 5.0 ) * 5.0 : price( rng ) ); // a third on strikes
+      const size_t ixQuery( ix % nQuery );
+      double strike1, strike2;
+      const int outcome1( Outcome( chain, ixQuery, value, strike1 ) );
+      const int outcome2( Outcome( ref, ixQuery, value, strike2 ) );
+      if ( ( outcome1 != outcome2 ) || ( strike1 != strike2 ) ) {
+        if ( 5 > nDiffer ) {
+          std::cout << "  " << c_szQuery[ ixQuery ] << "( " << value << " ): " << strike1 << " against " << strike2 << std::endl;
+        }
+        nDiffer++;
+      }
+    }
+    for ( double value = 2000.0; value < 8000.0; value += 5.0 ) {
+      double lower1, upper1, lower2, upper2;
+      const int n1( chain.AdjacentStrikes( value, lower1, upper1 ) );
+      const int n2( ref.AdjacentStrikes( value, lower2, upper2 ) );
+      if ( ( n1 != n2 ) || ( lower1 != lower2 ) || ( upper1 != upper2 ) ) {
+        if ( 5 > nDiffer ) std::cout << "  AdjacentStrikes( " << value << " ) differs" << std::endl;
+        nDiffer++;
+      }
+    }
+    return nDiffer;
+  }
+
+  // nanoseconds per query, sum keeps the queries from being optimized away, and shows both gave the same strikes
+  template<typename Chain>
+  double Time( const Chain& chain, size_t nTicks, double& sum ) {
+    std::mt19937 rng( 11 );
+    std::normal_distribution<double> step( 0.0, 0.5 );
+    double S( 4200.0 );
+    sum = 0.0;
+    const auto begin( std::chrono::steady_clock::now() );
+    for ( size_t tick = 0; tick < nTicks; ++tick ) {
+      S += step( rng );
+      sum += chain.Put_Itm( S ) + chain.Put_Otm( S ) + chain.Call_Itm( S ) + chain.Call_Otm( S ) + chain.Atm( S );
+    }
+    return std::chrono::duration<double,std::nano>( std::chrono::steady_clock::now() - begin ).count() / ( 5.0 * nTicks );
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nQueries( ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 200000 );
+  const size_t nTicks( ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 100000 );
+
+  size_t nDiffer {};
+  for ( const bool bRegular: { false, true } ) {
+
+    chain_t chain;
+    reference::Chain ref;
+    for ( const double strike: Strikes( bRegular ) ) {
+      chain.SetIQFeedNameCall( strike, "C" + std::to_string( strike ) );
+      chain.SetIQFeedNamePut( strike, "P" + std::to_string( strike ) );
+      ref.Add( strike );
+    }
+
+    std::cout << ( bRegular ? "regular" : "spx style" ) << ", " << chain.Size() << " strikes" << std::endl;
+    const size_t n( Compare( chain, ref, nQueries ) );
+    std::cout << "  compare: " << nQueries << " queries, " << n << " differ" << std::endl;
+    nDiffer += n;
+
+    double sumChain, sumReference;
+    const double nsChain( Time( chain, nTicks, sumChain ) );
+    const double nsReference( Time( ref, nTicks, sumReference ) );
+    std::cout
+      << "  time: " << nTicks << " ticks, chain " << nsChain << "ns, map " << nsReference << "ns per query"
+      << std::endl;
+    if ( sumChain != sumReference ) nDiffer++;
+  }
+
+  return ( 0 == nDiffer ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
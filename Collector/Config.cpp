@@ -21,6 +21,7 @@
 
 #include <fstream>
 #include <exception>
+#include <algorithm>
 
 #include <boost/log/trivial.hpp>
 
@@ -32,6 +33,11 @@ namespace po = boost::program_options;
 namespace {
   static const std::string sChoice_SymbolName("symbol_name" );
   static const std::string sChoice_StopTime("stop_time" );
+  static const std::string sChoice_JournalFileName( "journal_file" );
+  static const std::string sChoice_FlushCount( "flush_count" );
+  static const std::string sChoice_FlushInterval( "flush_interval" );
+  static const std::string sChoice_ChunkSize( "chunk_size" );
+  static const std::string sChoice_ChunkCache( "chunk_cache" );
 
   template<typename T>
   bool parse( const std::string& sFileName, po::variables_map& vm, const std::string& name, bool bRequired, T& dest ) {
@@ -60,8 +66,13 @@ bool Load( const std::string& sFileName, Choices& choices ) {
 
     po::options_description config( "collector config" );
     config.add_options()
-      ( sChoice_SymbolName.c_str(), po::value<std::string>( &choices.m_sSymbolName ), "symbol name" )
+      ( sChoice_SymbolName.c_str(), po::value<config::Choices::vSymbolName_t>( &choices.m_vSymbolName ), "symbol name, one line per symbol" )
       ( sChoice_StopTime.c_str(),   po::value<std::string>( &choices.m_sStopTime ), "stop time HH:mm:ss UTC" )
+      ( sChoice_JournalFileName.c_str(), po::value<std::string>( &choices.m_sJournalFileName ), "journal file" )
+      ( sChoice_FlushCount.c_str(), po::value<size_t>( &choices.m_nFlushCount ), "datums per stream per write" )
+      ( sChoice_FlushInterval.c_str(), po::value<size_t>( &choices.m_nFlushInterval ), "seconds between writes" )
+      ( sChoice_ChunkSize.c_str(), po::value<size_t>( &choices.m_nChunkSize ), "elements per hdf5 chunk" )
+      ( sChoice_ChunkCache.c_str(), po::value<size_t>( &choices.m_nChunkCache ), "KB of chunk cache per dataset" )
       ;
     po::variables_map vm;
 
@@ -74,12 +85,32 @@ bool Load( const std::string& sFileName, Choices& choices ) {
     else {
       po::store( po::parse_config_file( ifs, config), vm );
 
-      bOk &= parse<std::string>( sFileName, vm, sChoice_SymbolName, true, choices.m_sSymbolName );
-      std::replace_if( choices.m_sSymbolName.begin(), choices.m_sSymbolName.end(), [](char ch)->bool{return '~' == ch;}, '#' );
+      if ( 0 < vm.count( sChoice_SymbolName ) ) {
+        choices.m_vSymbolName = vm[sChoice_SymbolName].as<config::Choices::vSymbolName_t>();
+        for ( std::string& sSymbolName: choices.m_vSymbolName ) {
+          std::replace_if( sSymbolName.begin(), sSymbolName.end(), [](char ch)->bool{return '~' == ch;}, '#' );
+          BOOST_LOG_TRIVIAL(info) << sChoice_SymbolName << " = " << sSymbolName;
+        }
+      }
+      else {
+        BOOST_LOG_TRIVIAL(error) << sFileName << " missing '" << sChoice_SymbolName << "='";
+        bOk = false;
+      }
 
       bOk &= parse<std::string>( sFileName, vm, sChoice_StopTime, true, choices.m_sStopTime );
       choices.m_tdStopTime = boost::posix_time::duration_from_string( choices.m_sStopTime );
 
+      bOk &= parse<std::string>( sFileName, vm, sChoice_JournalFileName, false, choices.m_sJournalFileName );
+      bOk &= parse<size_t>( sFileName, vm, sChoice_FlushCount, false, choices.m_nFlushCount );
+      bOk &= parse<size_t>( sFileName, vm, sChoice_FlushInterval, false, choices.m_nFlushInterval );
+      bOk &= parse<size_t>( sFileName, vm, sChoice_ChunkSize, false, choices.m_nChunkSize );
+      bOk &= parse<size_t>( sFileName, vm, sChoice_ChunkCache, false, choices.m_nChunkCache );
+
+      if ( ( 0 == choices.m_nFlushCount ) || ( 0 == choices.m_nFlushInterval ) || ( 0 == choices.m_nChunkSize ) ) {
+        BOOST_LOG_TRIVIAL(error) << sFileName << " flush_count, flush_interval, chunk_size need to be non-zero";
+        bOk = false;
+      }
+
     }
 
   }
@@ -22,16 +22,32 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 namespace config {
 
 struct Choices {
-  std::string m_sSymbolName;
+
+  using vSymbolName_t = std::vector<std::string>;
+  vSymbolName_t m_vSymbolName; // one symbol_name= line per symbol
 
   std::string m_sStopTime;
   boost::posix_time::time_duration m_tdStopTime;
+
+  std::string m_sJournalFileName;
+
+  size_t m_nFlushCount; // datums buffered per stream before being written
+  size_t m_nFlushInterval; // seconds, longest a datum is buffered
+  size_t m_nChunkSize; // elements per hdf5 chunk
+  size_t m_nChunkCache; // KB of chunk cache per open dataset
+
+  Choices()
+  : m_sJournalFileName( "collector.jnl" )
+  , m_nFlushCount( 16 * 1024 ), m_nFlushInterval( 60 )
+  , m_nChunkSize( 1024 ), m_nChunkCache( 1024 )
+  {}
 };
 
 bool Load( const std::string& sFileName, Choices& );
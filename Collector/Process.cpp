@@ -19,15 +19,11 @@
  * Created: October 20, 2022 21:07:40
  */
 
-// start watch on l1, l2
-// write on regular intervals
+// start watches on l1, l2 for each symbol
+// the recorder writes on its own thread
 
 #include <TFTrading/ComposeInstrument.hpp>
 
-#include <TFHDF5TimeSeries/HDF5DataManager.h>
-#include <TFHDF5TimeSeries/HDF5WriteTimeSeries.h>
-#include <TFHDF5TimeSeries/HDF5Attribute.h>
-
 #include "Process.hpp"
 
 namespace {
@@ -39,12 +35,17 @@ Process::Process(
 , const std::string& sTimeStamp
 )
 : m_choices( choices )
-, m_bHdf5AttributesSet( false )
-, m_cntDepthsByOrder {}
-, m_ixDepthsByOrder_Filling( 0 )
-, m_ixDepthsByOrder_Writing( 1 )
 , m_sPathName( sSaveValuesRoot + "/" + sTimeStamp )
+, m_recorder(
+    choices.m_sJournalFileName,
+    Recorder::Policy {
+      choices.m_nFlushCount
+    , boost::posix_time::seconds( choices.m_nFlushInterval )
+    , choices.m_nChunkSize
+    , choices.m_nChunkCache * 1024
+    } )
 {
+  m_recorder.Start(); // replays a journal left by an abrupt exit
   StartIQFeed();
 }
 
@@ -54,12 +55,12 @@ Process::~Process() {
     m_pDispatch->Disconnect();
   }
 
-  if ( m_pWatch ) {
-    m_pWatch->StopWatch();
-    m_pWatch.reset();
+  for ( pSymbol_t& pSymbol: m_vSymbol ) {
+    if ( pSymbol->pWatch ) {
+      StopWatch( *pSymbol );
+    }
   }
-
-  m_pInstrument.reset();
+  m_vSymbol.clear();
 
   m_pComposeInstrumentIQFeed.reset();
 
@@ -85,112 +86,111 @@ void Process::ConstructUnderlying() {
   m_pComposeInstrumentIQFeed = std::make_unique<ou::tf::ComposeInstrument>(
     m_piqfeed,
     [this](){ // callback once started
-      const std::string& sName( m_choices.m_sSymbolName );
-      m_pComposeInstrumentIQFeed->Compose(
-        sName,
-        [this]( pInstrument_t pInstrument, bool bConstructed ){
-          m_pInstrument = std::move( pInstrument );
-          StartWatch();
-        }
-      );
+      for ( const std::string& sName: m_choices.m_vSymbolName ) {
+        m_pComposeInstrumentIQFeed->Compose(
+          sName,
+          [this]( pInstrument_t pInstrument, bool bConstructed ){
+            m_vSymbol.emplace_back( std::make_unique<Symbol>( m_recorder, std::move( pInstrument ) ) );
+            StartWatch( *m_vSymbol.back() );
+            if ( m_choices.m_vSymbolName.size() == m_vSymbol.size() ) {
+              StartDepth();
+            }
+          }
+        );
+      }
     }
     );
   assert( m_pComposeInstrumentIQFeed );
 
 }
 
-void Process::StartWatch() {
+void Process::StartWatch( Symbol& symbol ) {
 
   // TODO: watch built elsewhere, needs to be restartable for a new day?
   //       or, delete and rebuild for a new day?
   //             this, so that can handle when new front month started
 
-  assert( m_pInstrument );
+  assert( symbol.pInstrument );
+  const ou::tf::Instrument& instrument( *symbol.pInstrument );
 
-  const std::string& sSymbolName( m_pInstrument->GetInstrumentName() );
-  const std::string& sIQFeedSymbolName( m_pInstrument->GetInstrumentName( ou::tf::Instrument::eidProvider_t::EProviderIQF ) );
+  const std::string& sSymbolName( instrument.GetInstrumentName() );
+  symbol.sIQFeedSymbolName = instrument.GetInstrumentName( ou::tf::Instrument::eidProvider_t::EProviderIQF );
 
   std::cout << "future: "
     << sSymbolName
-    << ", " << sIQFeedSymbolName
+    << ", " << symbol.sIQFeedSymbolName
     << std::endl;
 
-  m_pWatch = std::make_shared<ou::tf::Watch>( m_pInstrument, m_piqfeed );
+  const ou::tf::keytypes::eidProvider_t idProvider( m_piqfeed->ID() );
+
+  symbol.ixQuotes = m_recorder.Register( {
+    Recorder::EType::Quote, m_sPathName + ou::tf::Quotes::Directory() + sSymbolName,
+    instrument.GetMultiplier(), instrument.GetSignificantDigits(), idProvider } );
+  symbol.ixTrades = m_recorder.Register( {
+    Recorder::EType::Trade, m_sPathName + ou::tf::Trades::Directory() + sSymbolName,
+    instrument.GetMultiplier(), instrument.GetSignificantDigits(), idProvider } );
+  symbol.ixDepthsByOrder = m_recorder.Register( {
+    Recorder::EType::DepthByOrder, m_sPathName + ou::tf::DepthsByOrder::Directory() + sSymbolName,
+    instrument.GetMultiplier(), instrument.GetSignificantDigits(), idProvider } );
+
+  symbol.pWatch = std::make_shared<ou::tf::Watch>( symbol.pInstrument, m_piqfeed );
+  symbol.pWatch->RecordSeries( false ); // the recorder persists the series
+  symbol.pWatch->OnQuote.Add( MakeDelegate( &symbol, &Symbol::HandleQuote ) );
+  symbol.pWatch->OnTrade.Add( MakeDelegate( &symbol, &Symbol::HandleTrade ) );
+  symbol.pWatch->StartWatch();
+}
 
-  m_sPathName_Depth
-    = m_sPathName + ou::tf::DepthsByOrder::Directory()
-    + m_pInstrument->GetInstrumentName();
+void Process::StartDepth() {
 
   assert( !m_pDispatch );  // trigger on re-entry, need to fix
   m_pDispatch = std::make_unique<ou::tf::iqfeed::l2::Symbols>(
-    [ this, &sIQFeedSymbolName ](){
-      m_pDispatch->Single( true );
-      m_pDispatch->WatchAdd(
-        sIQFeedSymbolName,
-        [this]( const ou::tf::DepthByOrder& depth ){
-          m_cntDepthsByOrder++;
-          m_rDepthsByOrder[m_ixDepthsByOrder_Filling].Append( depth );
-        }
-      );
+    [ this ](){
+      m_pDispatch->Single( 1 == m_vSymbol.size() ); // otherwise messages are routed by symbol name
+      for ( pSymbol_t& pSymbol: m_vSymbol ) {
+        Symbol& symbol( *pSymbol );
+        m_pDispatch->WatchAdd(
+          symbol.sIQFeedSymbolName,
+          [this,&symbol]( const ou::tf::DepthByOrder& depth ){
+            m_recorder.Append( symbol.ixDepthsByOrder, depth );
+          }
+        );
+      }
     }
   );
 
-  m_pWatch->StartWatch();
   m_pDispatch->Connect();
 }
 
-void Process::StopWatch() {
+void Process::StopWatch( Symbol& symbol ) {
 
-  m_pWatch->StopWatch();
-  m_pWatch->SaveSeries( m_sPathName );
+  symbol.pWatch->StopWatch();
+  symbol.pWatch->OnQuote.Remove( MakeDelegate( &symbol, &Symbol::HandleQuote ) );
+  symbol.pWatch->OnTrade.Remove( MakeDelegate( &symbol, &Symbol::HandleTrade ) );
+  symbol.pWatch.reset();
 
-  std::cout << "  ... Done " << std::endl;
+  std::cout << "  ... Done " << symbol.sIQFeedSymbolName << std::endl;
 
 }
 
-void Process::Write() {
-
-  assert( 0 == m_rDepthsByOrder[m_ixDepthsByOrder_Writing].Size() );
-
-  rDepthsByOrder_t::size_type ix {};
-  ix = m_ixDepthsByOrder_Writing.exchange( 2 ); // take the writing index
-  ix = m_ixDepthsByOrder_Filling.exchange( ix ); // and make it the new filling index
-  ix = m_ixDepthsByOrder_Writing.exchange( ix ); // and write what was being filled
-  assert( 2 == ix );
-
-  //std::cout << "  Saving collected values ... " << std::endl;
-  if ( m_pDispatch ) {
-    // TODO: need to get the watch in pWatch_t operational
-    if ( 0 != m_rDepthsByOrder[m_ixDepthsByOrder_Writing].Size() ) {
-      ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
-      ou::tf::HDF5WriteTimeSeries<ou::tf::DepthsByOrder> wtsDepths( dm, true, true, 5, 256 );
-      wtsDepths.Write( m_sPathName_Depth, &m_rDepthsByOrder[m_ixDepthsByOrder_Writing] );
-
-      if ( !m_bHdf5AttributesSet ) {
-        m_bHdf5AttributesSet= true;
-        ou::tf::HDF5Attributes attrDepths( dm, m_sPathName_Depth );
-        attrDepths.SetSignature( ou::tf::DepthByOrder::Signature() );
-        //attrDepths.SetMultiplier( m_pInstrument->GetMultiplier() );
-        //attrDepths.SetSignificantDigits( m_pInstrument->GetSignificantDigits() );
-        attrDepths.SetProviderType( m_pWatch->GetProvider()->ID() );
-      }
-
-      m_rDepthsByOrder[m_ixDepthsByOrder_Writing].Clear();
-    }
-  }
-
+void Process::Report() {
+  m_recorder.Report( std::cout );
 }
 
 void Process::Finish() {
 
   if ( m_pDispatch ) {
-    m_pDispatch->WatchDel( m_pInstrument->GetInstrumentName() );
-    Write();
+    for ( pSymbol_t& pSymbol: m_vSymbol ) {
+      m_pDispatch->WatchDel( pSymbol->sIQFeedSymbolName );
+    }
   }
 
-  if ( m_pWatch ) {
-    StopWatch();
-    m_pWatch.reset();
+  for ( pSymbol_t& pSymbol: m_vSymbol ) {
+    if ( pSymbol->pWatch ) {
+      StopWatch( *pSymbol );
+    }
   }
 
+  m_recorder.Flush();
+  Report();
+
 }
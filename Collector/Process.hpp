@@ -23,8 +23,8 @@
 
 #pragma once
 
-#include <array>
-#include <atomic>
+#include <memory>
+#include <vector>
 
 #include <TFIQFeed/Provider.h>
 
@@ -34,6 +34,7 @@
 #include <TFTrading/Instrument.h>
 
 #include "Config.hpp"
+#include "Recorder.hpp"
 
 namespace ou {
 namespace tf {
@@ -50,15 +51,14 @@ public:
   );
   ~Process();
 
-  void Write(); // incremental write of l2
-  void Finish(); // stop and write l1 + remainder of l2
-  size_t Count() const { return m_cntDepthsByOrder; }
+  void Report(); // recorder throughput and lag, since the previous report
+  void Finish(); // stop the watches and write everything recorded
+  uint64_t Count() const { return m_recorder.Appended(); }
 
 protected:
 private:
 
   const std::string m_sPathName;
-  std::string m_sPathName_Depth;
 
   const config::Choices& m_choices;
 
@@ -67,28 +67,36 @@ private:
 
   std::unique_ptr<ou::tf::ComposeInstrument> m_pComposeInstrumentIQFeed;
 
-  bool m_bHdf5AttributesSet;
-  size_t m_cntDepthsByOrder;
+  Recorder m_recorder;
 
   using pInstrument_t = ou::tf::Instrument::pInstrument_t;
-  pInstrument_t m_pInstrument;
-
   using pWatch_t = ou::tf::Watch::pWatch_t;
-  pWatch_t m_pWatch;
 
-  using rDepthsByOrder_t = std::array<ou::tf::DepthsByOrder,2>;
-  rDepthsByOrder_t m_rDepthsByOrder; // one writes while one collects
-  using ixDepthsByOrder_t = std::atomic<rDepthsByOrder_t::size_type>;
-  ixDepthsByOrder_t m_ixDepthsByOrder_Filling;
-  ixDepthsByOrder_t m_ixDepthsByOrder_Writing;
+  struct Symbol { // l1 through the watch, l2 through the shared dispatch
+    Recorder& recorder;
+    pInstrument_t pInstrument;
+    pWatch_t pWatch;
+    std::string sIQFeedSymbolName;
+    Recorder::ixStream_t ixQuotes;
+    Recorder::ixStream_t ixTrades;
+    Recorder::ixStream_t ixDepthsByOrder;
+    Symbol( Recorder& recorder_, pInstrument_t pInstrument_ )
+    : recorder( recorder_ ), pInstrument( std::move( pInstrument_ ) )
+    , ixQuotes {}, ixTrades {}, ixDepthsByOrder {}
+    {}
+    void HandleQuote( const ou::tf::Quote& quote ) { recorder.Append( ixQuotes, quote ); }
+    void HandleTrade( const ou::tf::Trade& trade ) { recorder.Append( ixTrades, trade ); }
+  };
+  using pSymbol_t = std::unique_ptr<Symbol>;
+  using vSymbol_t = std::vector<pSymbol_t>;
+  vSymbol_t m_vSymbol;
 
-  //ou::tf::DepthsByOrder m_depths_byorder; // time series for persistence
-  ou::tf::iqfeed::l2::OrderBased m_OrderBased; // direct access
   std::unique_ptr<ou::tf::iqfeed::l2::Symbols> m_pDispatch;
 
   void StartIQFeed();
   void HandleIQFeedConnected( int );
   void ConstructUnderlying();
-  void StartWatch();
-  void StopWatch();
+  void StartWatch( Symbol& );
+  void StartDepth();
+  void StopWatch( Symbol& );
 };
\ No newline at end of file
@@ -0,0 +1,849 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Recorder.cpp
+ * Author:  raymond@burkholder.net
+ * Project: Collector
+ * Created: 2026/10/16 23:12:48
+ */
+
+#include <chrono>
+#include <limits>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesContainer.h>
+#include <TFHDF5TimeSeries/HDF5Attribute.h>
+
+#include "Recorder.hpp"
+
+// journal record: uint32_t size of the remainder, uint8_t ERecord, then
+//   Epoch:  uint64_t epoch, the first record of a journal file
+//   Define: ixStream_t, uint8_t EType, uint32_t multiplier, uint8_t significant digits, uint32_t provider, path name
+//   Datum:  ixStream_t, the datum as bytes
+
+// the journal is rotated at nJournalRotateSize: the file is renamed to <name>.prev, a new file is started
+//   with a new epoch and the stream definitions, and a marker is queued,
+//   when the writer reaches the marker, it writes everything buffered, flushes the file, then removes <name>.prev
+
+namespace {
+
+  enum class ERecord: uint8_t { Epoch = 1, Define, Datum };
+
+  static const size_t nDatumHeader = sizeof( uint32_t ) + sizeof( ERecord ) + sizeof( Recorder::ixStream_t );
+
+  // a define's path name is the only part of a record not fixed in size, a longer length read by the replay
+  //   is a torn or damaged tail
+  static const uint32_t nMaxRecordSize = 64 * 1024;
+
+  // dataset attribute, written once the file has been flushed:
+  //   the journal epoch of the latest write, the dataset size as that epoch started, and the flushed dataset size
+  static const char szJournal[] = "Journal";
+  enum EJournal { Epoch, Base, Committed, Count };
+
+  static const std::chrono::milliseconds msPoll( 100 ); // writer wake up, for the flush interval
+  static const size_t nChunkCacheSlots = 521; // hdf5 default, prime, well above the chunks in play per dataset
+
+  // one attribute, so the three values reach the file together
+  bool ReadJournal( H5::DataSet& dataset, uint64_t* rValue ) {
+    bool bFound( false );
+    if ( dataset.attrExists( szJournal ) ) {
+      H5::Attribute attr( dataset.openAttribute( szJournal ) );
+      attr.read( H5::PredType::NATIVE_UINT64, rValue );
+      attr.close();
+      bFound = true;
+    }
+    return bFound;
+  }
+
+  void WriteJournal( H5::DataSet& dataset, const uint64_t* rValue ) {
+    if ( !dataset.attrExists( szJournal ) ) {
+      const hsize_t nCount( EJournal::Count );
+      H5::DataSpace ds( 1, &nCount );
+      H5::Attribute attr( dataset.createAttribute( szJournal, H5::PredType::NATIVE_UINT64, ds ) );
+      attr.close();
+      ds.close();
+    }
+    H5::Attribute attr( dataset.openAttribute( szJournal ) );
+    attr.write( H5::PredType::NATIVE_UINT64, rValue );
+    attr.close();
+  }
+
+  template<typename T>
+  void Put( std::string& s, const T& value ) {
+    s.append( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+  }
+
+  template<typename T>
+  const char* Get( const char* p, const char* pEnd, T& value ) {
+    if ( sizeof( T ) > (size_t)( pEnd - p ) ) throw std::runtime_error( "Recorder: journal record too short" );
+    std::memcpy( &value, p, sizeof( T ) );
+    return p + sizeof( T );
+  }
+
+} // namespace anonymous
+
+// ==== Stream
+
+struct Recorder::Stream {
+
+  const Definition def;
+  const size_t nDatumSize;
+  uint64_t nChunk; // elements per chunk of the open dataset
+
+  uint64_t nEpoch; // of the datums being written, 0 when not known
+  uint64_t nBase;  // dataset size as the epoch started
+  bool bCommit;    // written since the latest commit
+  uint64_t nSkip;  // replay: datums already in the dataset
+  ou::Timestamp tsOldest; // queue time of the oldest buffered datum
+
+  Stats stats;
+
+  Stream( const Definition& def_, size_t nDatumSize_ )
+  : def( def_ ), nDatumSize( nDatumSize_ ), nChunk( 1 ), nEpoch {}, nBase {}, bCommit( false ), nSkip {} {}
+  virtual ~Stream() {}
+
+  virtual void Add( const char* ) = 0;
+  virtual size_t Buffered() const = 0;
+  virtual void Clear() = 0;
+
+  virtual bool IsOpen() const = 0;
+  virtual void Open( ou::tf::HDF5DataManager&, const Policy& ) = 0; // creates the dataset if needed, it is kept open
+  virtual void Close() = 0;
+  virtual uint64_t Size() const = 0; // of the open dataset
+  virtual void Append( size_t n ) = 0; // the first n buffered datums, which are then removed from the buffer
+
+  // buffered datums which fill chunks, a written chunk is not rewritten, so an abrupt exit can't damage it,
+  //   a partial chunk, written for the flush interval or a rotation, is rewritten, possibly to new space, as it fills,
+  //   Write flushes the file straight after
+  size_t WholeChunks() const {
+    const uint64_t nEnd( ( Size() + Buffered() ) / nChunk * nChunk );
+    return ( Size() < nEnd ) ? nEnd - Size() : 0;
+  }
+
+  void Written( uint64_t nEpoch_, uint64_t nBefore ) {
+    if ( nEpoch_ != nEpoch ) {
+      nEpoch = nEpoch_;
+      nBase = nBefore;
+    }
+    bCommit = true;
+  }
+
+  // after the file has been flushed, so the attribute never claims more than the file holds
+  void Commit( ou::tf::HDF5DataManager& dm ) {
+    const uint64_t rValue[ EJournal::Count ] = { nEpoch, nBase, Size() };
+    H5::DataSet dataset( dm.GetH5File()->openDataSet( def.sPathName ) );
+    WriteJournal( dataset, rValue );
+    dataset.close();
+    bCommit = false;
+  }
+
+  // replay: truncates the dataset to its committed size, as an abrupt exit can leave the dataset extended
+  //   past the datums which reached the file, returns the datums of journal epoch nEpoch_ already in the dataset
+  uint64_t InFile( ou::tf::HDF5DataManager& dm, const Policy& policy, uint64_t nEpoch_ ) {
+    uint64_t n {};
+    uint64_t rValue[ EJournal::Count ];
+    H5::DataSet dataset( dm.GetH5File()->openDataSet( def.sPathName ) );
+    if ( ReadJournal( dataset, rValue ) ) {
+      if ( rValue[ EJournal::Committed ] < Size() ) {
+        Close();
+        hsize_t nSize( rValue[ EJournal::Committed ] );
+        dataset.extend( &nSize ); // H5Dset_extent, shrinks as well
+        Open( dm, policy );
+      }
+      if ( nEpoch_ < rValue[ EJournal::Epoch ] ) { // a later journal has been written, so all of this one was
+        n = std::numeric_limits<uint64_t>::max();
+      }
+      else {
+        if ( ( nEpoch_ == rValue[ EJournal::Epoch ] ) && ( rValue[ EJournal::Base ] <= Size() ) ) {
+          n = Size() - rValue[ EJournal::Base ];
+          nEpoch = nEpoch_; // the base stays
+          nBase = rValue[ EJournal::Base ];
+        }
+      }
+    }
+    dataset.close();
+    return n;
+  }
+
+};
+
+template<typename DD>
+struct Recorder::StreamDatum: public Recorder::Stream {
+
+  using container_t = ou::tf::HDF5TimeSeriesContainer<DD>;
+
+  std::vector<DD> vDatum;
+  std::unique_ptr<container_t> pContainer;
+
+  StreamDatum( const Definition& def ): Stream( def, sizeof( DD ) ) {}
+  virtual ~StreamDatum() {}
+
+  virtual void Add( const char* p ) {
+    vDatum.emplace_back();
+    std::memcpy( &vDatum.back(), p, sizeof( DD ) );
+  }
+
+  virtual size_t Buffered() const { return vDatum.size(); }
+  virtual void Clear() { vDatum.clear(); }
+
+  virtual bool IsOpen() const { return (bool)pContainer; }
+
+  virtual void Open( ou::tf::HDF5DataManager& dm, const Policy& policy ) {
+
+    dm.AddGroup( def.sPathName );
+
+    if ( 0 >= H5Lexists( dm.GetH5File()->getId(), def.sPathName.c_str(), H5P_DEFAULT ) ) {
+      H5::CompType* pdt = DD::DefineDataType();
+      pdt->pack();
+      hsize_t curSize = 0;
+      hsize_t maxSize = H5S_UNLIMITED;
+      H5::DataSpace ds( 1, &curSize, &maxSize );
+      H5::DSetCreatPropList pl;
+      const hsize_t nChunkSize( policy.nChunkSize );
+      pl.setChunk( 1, &nChunkSize );
+      pl.setShuffle();
+      pl.setDeflate( 5 );
+      H5::DataSet dataset( dm.GetH5File()->createDataSet( def.sPathName, *pdt, ds, pl ) );
+      const uint64_t rValue[ EJournal::Count ] = { 0, 0, 0 }; // nothing committed yet
+      WriteJournal( dataset, rValue );
+      dataset.close();
+      pl.close();
+      ds.close();
+      pdt->close();
+      delete pdt;
+
+      ou::tf::HDF5Attributes attr( dm, def.sPathName );
+      attr.SetSignature( DD::Signature() );
+      if ( EType::DepthByOrder != def.eType ) {
+        attr.SetMultiplier( def.nMultiplier );
+        attr.SetSignificantDigits( def.nSignificantDigits );
+      }
+      attr.SetProviderType( def.idProvider );
+    }
+
+    { // an existing dataset keeps the chunk size it was created with
+      H5::DataSet dataset( dm.GetH5File()->openDataSet( def.sPathName ) );
+      H5::DSetCreatPropList pl( dataset.getCreatePlist() );
+      hsize_t nChunkDim( 1 );
+      if ( H5D_CHUNKED == pl.getLayout() ) {
+        pl.getChunk( 1, &nChunkDim );
+      }
+      nChunk = std::max<hsize_t>( 1, nChunkDim );
+      pl.close();
+      dataset.close();
+    }
+
+    // the chunk being appended to stays in the cache between writes, so it is not read back and re-inflated,
+    //   w0 of 1 evicts the fully written chunks first
+    H5::DSetAccPropList pl;
+    pl.setChunkCache( nChunkCacheSlots, std::max<size_t>( policy.nChunkCache, 2 * nChunk * sizeof( DD ) ), 1.0 );
+    pContainer = std::make_unique<container_t>( dm, def.sPathName, pl );
+    pl.close();
+  }
+
+  virtual void Close() { pContainer.reset(); }
+
+  virtual uint64_t Size() const { return pContainer->size(); }
+
+  virtual void Append( size_t n ) {
+    assert( n <= vDatum.size() );
+    const uint64_t nExpected( pContainer->size() + n );
+    pContainer->Append( vDatum.data(), vDatum.data() + n );
+    vDatum.erase( vDatum.begin(), vDatum.begin() + n );
+    if ( nExpected != pContainer->size() ) { // the accessor reports hdf5 errors rather than throwing
+      throw std::runtime_error( "dataset did not extend" );
+    }
+  }
+
+};
+
+// ==== Recorder
+
+Recorder::Recorder( const std::string& sJournalFileName, const Policy& policy )
+: m_sJournalFileName( sJournalFileName )
+, m_sJournalFileNamePrev( sJournalFileName + ".prev" )
+, m_policy( policy )
+, m_pJournal( nullptr ), m_nJournalSize {}
+, m_nEpoch {}, m_nEpochWriter {}
+, m_bRetainJournal( false ), m_bRotating( false )
+, m_queue( nQueueCapacity )
+, m_bStop( false ), m_bFlush( false )
+, m_nAppended {}, m_nWritten {}
+{
+  assert( 0 < m_policy.nFlushCount );
+  assert( 0 < m_policy.nChunkSize );
+}
+
+Recorder::~Recorder() {
+  if ( m_threadWriter.joinable() ) {
+    {
+      std::lock_guard<std::mutex> lock( m_mutexWriter );
+      m_bStop = true;
+    }
+    m_cvWriter.notify_one();
+    m_threadWriter.join(); // the writer drains the queue, writes, and flushes before finishing
+  }
+  if ( nullptr != m_pJournal ) {
+    std::fclose( m_pJournal );
+    m_pJournal = nullptr;
+    if ( m_bRetainJournal || ( m_nAppended.load() != m_nWritten.load() ) ) {
+      std::cout << "Recorder: journal retained for replay: " << m_sJournalFileName << std::endl;
+    }
+    else {
+      std::remove( m_sJournalFileName.c_str() );
+      std::remove( m_sJournalFileNamePrev.c_str() );
+    }
+  }
+  m_vStream.clear();
+  m_pdm.reset();
+}
+
+void Recorder::Start() {
+  assert( !m_threadWriter.joinable() );
+  m_pdm = std::make_unique<ou::tf::HDF5DataManager>( ou::tf::HDF5DataManager::RDWR );
+  {
+    // metadata reaches the file with a flush only, rather than as the cache evicts,
+    //   so an abrupt exit between flushes leaves the file as of the latest flush
+    const hid_t idFile( m_pdm->GetH5File()->getId() );
+    H5AC_cache_config_t config;
+    config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    if ( 0 <= H5Fget_mdc_config( idFile, &config ) ) {
+      config.evictions_enabled = false;
+      config.incr_mode = H5C_incr__off;
+      config.flash_incr_mode = H5C_flash_incr__off;
+      config.decr_mode = H5C_decr__off;
+      if ( 0 > H5Fset_mdc_config( idFile, &config ) ) {
+        std::cout << "Recorder::Start: metadata cache not configured" << std::endl;
+      }
+    }
+  }
+  m_pdm->Flush(); // a file just created is complete on disk
+  // throws when the journal could not be written, the journal is left in place
+  Replay( m_sJournalFileNamePrev );
+  Replay( m_sJournalFileName );
+  std::remove( m_sJournalFileNamePrev.c_str() );
+  m_nWritten = 0; // counts appended datums only
+  {
+    std::lock_guard<std::mutex> lock( m_mutexJournal );
+    NewJournal();
+    m_nEpochWriter = m_nEpoch;
+  }
+  m_tsReported = ou::Timestamp::Now();
+  m_threadWriter = std::thread( [this](){ Writer(); } );
+}
+
+Recorder::pStream_t Recorder::MakeStream( const Definition& def ) {
+  pStream_t pStream;
+  switch ( def.eType ) {
+    case EType::Quote:
+      pStream = std::make_unique<StreamDatum<ou::tf::Quote> >( def );
+      break;
+    case EType::Trade:
+      pStream = std::make_unique<StreamDatum<ou::tf::Trade> >( def );
+      break;
+    case EType::DepthByOrder:
+      pStream = std::make_unique<StreamDatum<ou::tf::DepthByOrder> >( def );
+      break;
+    default:
+      throw std::runtime_error( "Recorder::MakeStream: unknown type" );
+  }
+  return pStream;
+}
+
+size_t Recorder::DatumSize( EType eType ) {
+  switch ( eType ) {
+    case EType::Quote: return sizeof( ou::tf::Quote );
+    case EType::Trade: return sizeof( ou::tf::Trade );
+    case EType::DepthByOrder: return sizeof( ou::tf::DepthByOrder );
+    default: return 0;
+  }
+}
+
+void Recorder::Frame( std::string& record ) {
+  const uint32_t nSize( record.size() - sizeof( uint32_t ) );
+  std::memcpy( &record[ 0 ], &nSize, sizeof( uint32_t ) );
+}
+
+void Recorder::Define( std::string& record, ixStream_t ixStream, const Definition& def ) {
+  record.resize( sizeof( uint32_t ) );
+  Put( record, ERecord::Define );
+  Put( record, ixStream );
+  Put( record, def.eType );
+  Put( record, def.nMultiplier );
+  Put( record, def.nSignificantDigits );
+  Put( record, static_cast<uint32_t>( def.idProvider ) );
+  record.append( def.sPathName );
+  Frame( record );
+}
+
+void Recorder::Journal( const char* p, size_t n ) {
+  if ( ( nullptr == m_pJournal ) || ( 1 != std::fwrite( p, n, 1, m_pJournal ) ) || ( 0 != std::fflush( m_pJournal ) ) ) {
+    if ( !m_bRetainJournal ) {
+      std::cout << "Recorder: journal write failed " << m_sJournalFileName << std::endl;
+    }
+    m_bRetainJournal = true; // incomplete, can't be relied upon, nor emptied
+  }
+  m_nJournalSize += n;
+}
+
+void Recorder::NewJournal() {
+  m_pJournal = std::fopen( m_sJournalFileName.c_str(), "wb" );
+  if ( nullptr == m_pJournal ) {
+    throw std::runtime_error( "Recorder: can not open journal " + m_sJournalFileName );
+  }
+  m_nJournalSize = 0;
+  // epochs increase, a dataset stamped with a later epoch has everything of an earlier journal
+  m_nEpoch = std::max<uint64_t>( ou::Timestamp::Now().Nanoseconds(), m_nEpoch + 1 );
+  std::string record( sizeof( uint32_t ), 0 );
+  Put( record, ERecord::Epoch );
+  Put( record, m_nEpoch );
+  Frame( record );
+  Journal( record.data(), record.size() );
+  for ( vDefinition_t::size_type ix = 0; ix < m_vDefinition.size(); ix++ ) {
+    Define( record, ix, m_vDefinition[ ix ] );
+    Journal( record.data(), record.size() );
+  }
+}
+
+void Recorder::Rotate() {
+  std::fclose( m_pJournal );
+  m_pJournal = nullptr;
+  if ( 0 != std::rename( m_sJournalFileName.c_str(), m_sJournalFileNamePrev.c_str() ) ) {
+    std::cout << "Recorder: can not rotate journal " << m_sJournalFileName << std::endl;
+    m_pJournal = std::fopen( m_sJournalFileName.c_str(), "ab" );
+    m_bRotating = true; // no further attempts
+    m_bRetainJournal = true;
+    return;
+  }
+  m_bRotating = true;
+  NewJournal();
+  Record marker;
+  marker.ixStream = nMarker;
+  marker.nSize = 0;
+  marker.nsQueued = m_nEpoch; // the marker carries the new epoch
+  while ( !m_queue.push( marker ) ) {
+    std::this_thread::yield();
+  }
+}
+
+Recorder::ixStream_t Recorder::Register( const Definition& def ) {
+  assert( 0 < DatumSize( def.eType ) );
+  std::lock_guard<std::mutex> lock( m_mutexJournal );
+  if ( nMarker <= m_vDefinition.size() ) {
+    throw std::runtime_error( "Recorder::Register: too many streams" );
+  }
+  const ixStream_t ixStream( m_vDefinition.size() );
+  std::string record;
+  Define( record, ixStream, def );
+  if ( nMaxRecordSize < ( record.size() - sizeof( uint32_t ) ) ) {
+    throw std::runtime_error( "Recorder::Register: path name too long" );
+  }
+  m_vDefinition.push_back( def );
+  m_vAppended.push_back( 0 );
+  Journal( record.data(), record.size() );
+  return ixStream;
+}
+
+void Recorder::Push( Record& record, EType eType ) {
+  record.nsQueued = ou::Timestamp::Now().Nanoseconds();
+
+  char rch[ nDatumHeader + nMaxDatum ];
+  const uint32_t nSize( nDatumHeader - sizeof( uint32_t ) + record.nSize );
+  const ERecord eRecord( ERecord::Datum );
+  std::memcpy( rch, &nSize, sizeof( uint32_t ) );
+  std::memcpy( rch + sizeof( uint32_t ), &eRecord, sizeof( ERecord ) );
+  std::memcpy( rch + sizeof( uint32_t ) + sizeof( ERecord ), &record.ixStream, sizeof( ixStream_t ) );
+  std::memcpy( rch + nDatumHeader, record.rchDatum, record.nSize );
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutexJournal );
+    assert( record.ixStream < m_vDefinition.size() );
+    assert( eType == m_vDefinition[ record.ixStream ].eType );
+    Journal( rch, nDatumHeader + record.nSize );
+    ++m_vAppended[ record.ixStream ];
+    ++m_nAppended;
+    while ( !m_queue.push( record ) ) { // the writer is a full queue behind
+      std::this_thread::yield();
+    }
+    if ( ( nJournalRotateSize <= m_nJournalSize ) && !m_bRotating ) {
+      Rotate();
+    }
+  }
+
+  if ( m_queue.write_available() + nWake <= nQueueCapacity ) {
+    m_cvWriter.notify_one(); // otherwise the writer polls
+  }
+}
+
+void Recorder::AddStreams() {
+  vDefinition_t vDefinition;
+  {
+    std::lock_guard<std::mutex> lock( m_mutexJournal );
+    vDefinition.assign( m_vDefinition.begin() + m_vStream.size(), m_vDefinition.end() );
+  }
+  for ( const Definition& def: vDefinition ) {
+    m_vStream.emplace_back( MakeStream( def ) );
+  }
+}
+
+void Recorder::Drain() {
+  Record record;
+  while ( m_queue.pop( record ) ) {
+    if ( nMarker == record.ixStream ) {
+      Rotated( record.nsQueued );
+    }
+    else {
+      if ( m_vStream.size() <= record.ixStream ) {
+        AddStreams();
+      }
+      Stream& stream( *m_vStream[ record.ixStream ] );
+      assert( record.nSize == stream.nDatumSize );
+      if ( 0 == stream.Buffered() ) {
+        stream.tsOldest = ou::Timestamp( record.nsQueued );
+      }
+      stream.Add( record.rchDatum );
+      const uint64_t nsLag( ou::Timestamp::Now().Nanoseconds() - record.nsQueued );
+      stream.stats.nQueued++;
+      stream.stats.nsLag += nsLag;
+      if ( stream.stats.nsLagMax < nsLag ) stream.stats.nsLagMax = nsLag;
+    }
+  }
+}
+
+void Recorder::Rotated( uint64_t nEpoch ) {
+  // everything ahead of the marker is in the previous journal,
+  //   the commits need to reach the file as well, before the previous journal is removed
+  if ( WriteDue( true ) ) {
+    m_pdm->Flush();
+    Commit();
+    m_pdm->Flush();
+  }
+  m_nEpochWriter = nEpoch;
+  if ( !m_bRetainJournal ) {
+    std::remove( m_sJournalFileNamePrev.c_str() );
+    m_bRotating = false;
+  }
+}
+
+bool Recorder::Write( Stream& stream, uint64_t nEpoch, bool bAll ) {
+  size_t n( stream.Buffered() );
+  const ou::Timestamp tsStart( ou::Timestamp::Now() );
+  bool bOk( false );
+  try {
+    if ( !stream.IsOpen() ) {
+      stream.Open( *m_pdm, m_policy );
+    }
+    if ( !bAll ) {
+      n = stream.WholeChunks();
+    }
+    if ( 0 < n ) {
+      const uint64_t nBefore( stream.Size() );
+      const uint64_t nPartial( nBefore % stream.nChunk ); // datums of a partial chunk already in the file
+      const size_t nFill( ( 0 < nPartial ) ? std::min<size_t>( n, stream.nChunk - nPartial ) : n );
+      stream.Append( nFill );
+      if ( 0 < nPartial ) {
+        // the partial chunk was rewritten, possibly to new space, the space it left is free for reuse while the
+        //   flushed chunk index still refers to it, so the file is flushed before anything else is written
+        m_pdm->Flush();
+      }
+      if ( nFill < n ) {
+        stream.Append( n - nFill );
+      }
+      stream.Written( nEpoch, nBefore );
+    }
+    bOk = true;
+  }
+  catch ( H5::Exception& e ) {
+    std::cout << "Recorder::Write " << stream.def.sPathName << " H5::Exception " << e.getDetailMsg() << std::endl;
+    e.walkErrorStack( H5E_WALK_DOWNWARD, (H5E_walk2_t) &ou::tf::HDF5DataManager::PrintH5ErrorStackItem, this );
+  }
+  catch ( const std::exception& e ) {
+    std::cout << "Recorder::Write " << stream.def.sPathName << " " << e.what() << std::endl;
+  }
+  if ( bOk ) {
+    if ( 0 < n ) {
+      stream.stats.nWritten += n;
+      stream.stats.nWrites++;
+    }
+  }
+  else { // given up on, the datums remain in the journal
+    n = stream.Buffered();
+    stream.Clear();
+    stream.Close();
+    stream.stats.nErrors += n;
+    m_bRetainJournal = true;
+  }
+  stream.stats.nsWrite += ou::Timestamp::Now() - tsStart;
+  m_nWritten += n;
+  return bOk && ( 0 < n );
+}
+
+void Recorder::Commit() {
+  for ( pStream_t& pStream: m_vStream ) {
+    if ( pStream->bCommit && pStream->IsOpen() ) {
+      try {
+        pStream->Commit( *m_pdm );
+      }
+      catch ( H5::Exception& e ) {
+        // the dataset stays at its prior commit, a replay would truncate, so the journal is kept
+        std::cout << "Recorder::Commit " << pStream->def.sPathName << " H5::Exception " << e.getDetailMsg() << std::endl;
+        pStream->bCommit = false;
+        m_bRetainJournal = true;
+      }
+    }
+  }
+}
+
+bool Recorder::WriteDue( bool bAll ) {
+  bool bWrote( false );
+  const ou::Timestamp tsDue( ou::Timestamp::Now() - ou::Timestamp::FromDuration( m_policy.tdFlushInterval ) );
+  for ( pStream_t& pStream: m_vStream ) {
+    const size_t n( pStream->Buffered() );
+    if ( 0 < n ) {
+      if ( bAll || ( pStream->tsOldest <= tsDue ) ) {
+        bWrote |= Write( *pStream, m_nEpochWriter, true );
+      }
+      else {
+        if ( m_policy.nFlushCount <= n ) {
+          bWrote |= Write( *pStream, m_nEpochWriter, false );
+        }
+      }
+    }
+  }
+  return bWrote;
+}
+
+void Recorder::Publish() {
+  std::lock_guard<std::mutex> lock( m_mutexStats );
+  if ( m_vStats.size() < m_vStream.size() ) {
+    m_vStats.resize( m_vStream.size() );
+  }
+  for ( vStream_t::size_type ix = 0; ix < m_vStream.size(); ix++ ) {
+    Stats& stats( m_vStream[ ix ]->stats );
+    const uint64_t nsLagMax( std::max( m_vStats[ ix ].nsLagMax, stats.nsLagMax ) );
+    m_vStats[ ix ] = stats;
+    m_vStats[ ix ].nsLagMax = nsLagMax; // cleared by Report
+    stats.nsLagMax = 0;
+  }
+}
+
+void Recorder::Writer() {
+  bool bStop( false );
+  while ( !bStop ) {
+    bool bAll;
+    {
+      std::unique_lock<std::mutex> lock( m_mutexWriter );
+      m_cvWriter.wait_for(
+        lock, msPoll,
+        [this](){ return m_bStop || m_bFlush || ( nWake <= m_queue.read_available() ); } );
+      bStop = m_bStop;
+      bAll = m_bStop || m_bFlush;
+      m_bFlush = false;
+    }
+    Drain();
+    if ( WriteDue( bAll ) ) {
+      m_pdm->Flush();
+      Commit(); // reaches the file with the next flush
+    }
+    Publish();
+    {
+      std::lock_guard<std::mutex> lock( m_mutexWritten );
+    }
+    m_cvWritten.notify_all();
+  }
+}
+
+void Recorder::Flush() {
+  const uint64_t nTarget( m_nAppended.load() );
+  {
+    std::lock_guard<std::mutex> lock( m_mutexWriter );
+    m_bFlush = true;
+  }
+  m_cvWriter.notify_one();
+  std::unique_lock<std::mutex> lock( m_mutexWritten );
+  m_cvWritten.wait( lock, [this,nTarget](){ return nTarget <= m_nWritten.load(); } );
+}
+
+void Recorder::Replay( const std::string& sFileName ) {
+
+  std::FILE* pFile = std::fopen( sFileName.c_str(), "rb" );
+  if ( nullptr == pFile ) return; // clean shutdown last time
+
+  std::fseek( pFile, 0, SEEK_END );
+  const long nFile( std::ftell( pFile ) );
+  std::rewind( pFile );
+
+  long nOffset {}; // start of the next record
+  uint64_t nEpoch {};
+  uint64_t nReplayed {};
+  uint64_t nSkipped {};
+  std::string record;
+  uint32_t nSize;
+
+  assert( m_vStream.empty() );
+
+  try {
+    while ( 1 == std::fread( &nSize, sizeof( uint32_t ), 1, pFile ) ) {
+      nOffset += sizeof( uint32_t );
+      if ( ( 0 == nSize ) || ( nMaxRecordSize < nSize ) || ( ( nFile - nOffset ) < nSize ) ) {
+        break; // partial record, interrupted while being written, or a damaged length, the end of valid data
+      }
+      record.resize( nSize );
+      if ( 1 != std::fread( &record[ 0 ], nSize, 1, pFile ) ) {
+        break; // partial record
+      }
+      nOffset += nSize;
+      const char* p( record.data() );
+      const char* pEnd( p + nSize );
+      ERecord eRecord;
+      p = Get( p, pEnd, eRecord );
+      switch ( eRecord ) {
+        case ERecord::Epoch:
+          Get( p, pEnd, nEpoch );
+          break;
+        case ERecord::Define: {
+            ixStream_t ixStream;
+            Definition def;
+            uint32_t idProvider;
+            p = Get( p, pEnd, ixStream );
+            p = Get( p, pEnd, def.eType );
+            p = Get( p, pEnd, def.nMultiplier );
+            p = Get( p, pEnd, def.nSignificantDigits );
+            p = Get( p, pEnd, idProvider );
+            def.idProvider = static_cast<ou::tf::keytypes::eidProvider_t>( idProvider );
+            def.sPathName.assign( p, pEnd );
+            if ( ( 0 == nEpoch ) || ( ixStream != m_vStream.size() ) ) {
+              throw std::runtime_error( "Recorder::Replay: out of order definition" );
+            }
+            m_vStream.emplace_back( MakeStream( def ) );
+            Stream& stream( *m_vStream.back() );
+            stream.Open( *m_pdm, m_policy );
+            stream.nSkip = stream.InFile( *m_pdm, m_policy, nEpoch );
+          }
+          break;
+        case ERecord::Datum: {
+            ixStream_t ixStream;
+            p = Get( p, pEnd, ixStream );
+            if ( m_vStream.size() <= ixStream ) {
+              throw std::runtime_error( "Recorder::Replay: undefined stream" );
+            }
+            Stream& stream( *m_vStream[ ixStream ] );
+            if ( stream.nDatumSize != (size_t)( pEnd - p ) ) {
+              throw std::runtime_error( "Recorder::Replay: datum size mismatch" );
+            }
+            if ( 0 < stream.nSkip ) {
+              stream.nSkip--;
+              nSkipped++;
+            }
+            else {
+              stream.Add( p );
+              nReplayed++;
+              if ( m_policy.nFlushCount <= stream.Buffered() ) {
+                Write( stream, nEpoch, false );
+              }
+            }
+          }
+          break;
+        default:
+          throw std::runtime_error( "Recorder::Replay: unknown record" );
+      }
+    }
+  }
+  catch ( const H5::Exception& e ) {
+    std::cout << "Recorder::Replay " << sFileName << " H5::Exception " << e.getDetailMsg() << std::endl;
+    m_bRetainJournal = true;
+  }
+  catch ( const std::runtime_error& e ) {
+    std::cout << e.what() << " " << sFileName << std::endl;
+    m_bRetainJournal = true;
+  }
+  std::fclose( pFile );
+
+  if ( !m_bRetainJournal ) {
+    for ( pStream_t& pStream: m_vStream ) {
+      if ( 0 < pStream->Buffered() ) {
+        Write( *pStream, nEpoch, true );
+      }
+    }
+    m_pdm->Flush();
+    Commit();
+    m_pdm->Flush();
+  }
+  m_vStream.clear(); // live streams are registered anew
+
+  if ( m_bRetainJournal ) {
+    throw std::runtime_error( "Recorder::Replay: journal could not be written " + sFileName );
+  }
+  std::cout
+    << "Recorder::Replay " << sFileName << ": "
+    << nReplayed << " written, "
+    << nSkipped << " already in the file"
+    << std::endl;
+}
+
+void Recorder::Report( std::ostream& os ) {
+
+  vDefinition_t vDefinition;
+  std::vector<uint64_t> vAppended;
+  {
+    std::lock_guard<std::mutex> lock( m_mutexJournal );
+    vDefinition = m_vDefinition;
+    vAppended = m_vAppended;
+  }
+
+  std::lock_guard<std::mutex> lock( m_mutexStats );
+
+  const ou::Timestamp tsNow( ou::Timestamp::Now() );
+  const double dblSeconds( 1e-9 * ( tsNow - m_tsReported ) );
+  m_tsReported = tsNow;
+
+  m_vStatsReported.resize( m_vStats.size() );
+
+  uint64_t nQueued {};
+  for ( std::vector<Stats>::size_type ix = 0; ix < m_vStats.size(); ix++ ) {
+    Stats& stats( m_vStats[ ix ] );
+    const Stats& prior( m_vStatsReported[ ix ] );
+    const uint64_t nWritten( stats.nWritten - prior.nWritten );
+    const uint64_t nQueuedStream( stats.nQueued - prior.nQueued );
+    const uint64_t nsWrite( stats.nsWrite - prior.nsWrite );
+    const uint64_t nsLag( stats.nsLag - prior.nsLag );
+    nQueued += stats.nQueued;
+    os
+      << vDefinition[ ix ].sPathName
+      << std::fixed << std::setprecision( 1 )
+      << " appended=" << vAppended[ ix ]
+      << ",written=" << stats.nWritten
+      << ",pending=" << ( vAppended[ ix ] - stats.nWritten - stats.nErrors )
+      << ",rate=" << ( ( 0.0 < dblSeconds ) ? nWritten / dblSeconds : 0.0 ) << "/s"
+      << ",writes=" << ( stats.nWrites - prior.nWrites )
+      << ",write=" << ( ( 0 < nsWrite ) ? 1e3 * nWritten * DatumSize( vDefinition[ ix ].eType ) / nsWrite : 0.0 ) << "MB/s"
+      << std::setprecision( 3 )
+      << ",lag=" << ( ( 0 < nQueuedStream ) ? 1e-6 * nsLag / nQueuedStream : 0.0 )
+      << "/" << ( 1e-6 * stats.nsLagMax ) << "ms"
+      << ",errors=" << stats.nErrors
+      << std::defaultfloat
+      << std::endl;
+    m_vStatsReported[ ix ] = stats;
+    stats.nsLagMax = 0;
+  }
+  os
+    << "recorder queue=" << ( m_nAppended.load() - nQueued )
+    << ",appended=" << m_nAppended.load()
+    << ",written=" << m_nWritten.load()
+    << std::endl;
+}
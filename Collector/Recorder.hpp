@@ -0,0 +1,222 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Recorder.hpp
+ * Author:  raymond@burkholder.net
+ * Project: Collector
+ * Created: 2026/10/16 23:12:48
+ */
+
+// records quotes, trades and depths of any number of streams to the hdf5 file
+//   Append copies the datum into a journal record, writes the record to the journal file, then queues it
+//   for the writer thread, the caller never waits on hdf5
+//   the writer thread owns the hdf5 file, each stream keeps its dataset open with its own chunk cache,
+//   a stream writes its whole chunks once it has nFlushCount datums buffered, and everything buffered
+//   once its oldest datum is tdFlushInterval old
+//   the journal is rotated as it grows, a rotated journal is removed once its datums have been written
+//   and the file flushed, a journal left behind by an abrupt exit is replayed into the hdf5 file by Start
+//   once the file has been flushed, a dataset is stamped with the journal epoch, its size at its first write
+//   in that epoch, and its flushed size, the replay truncates the dataset to the flushed size, then skips
+//   the datums which had already reached the file
+// the journal is flushed to the operating system on each append, so it survives a process crash,
+//   it is not synced to the disk
+// hdf5 metadata reaches the file with a flush only, an exit during an hdf5 flush can still damage the file,
+//   the replay then fails, and the journal is kept
+// appending threads are serialized on the journal, the queue is single producer / single consumer
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <algorithm>
+#include <type_traits>
+#include <condition_variable>
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <OUCommon/Timestamp.h>
+
+#include <TFTimeSeries/DatedDatum.h>
+
+#include <TFTrading/KeyTypes.h>
+
+namespace ou {
+namespace tf {
+  class HDF5DataManager;
+} // namespace tf
+} // namespace ou
+
+class Recorder {
+public:
+
+  using ixStream_t = uint16_t;
+
+  enum class EType: uint8_t { Quote = 1, Trade, DepthByOrder };
+
+  struct Policy {
+    size_t nFlushCount; // datums buffered by a stream before it is written
+    boost::posix_time::time_duration tdFlushInterval; // longest a datum is buffered
+    size_t nChunkSize; // elements per chunk, for new datasets
+    size_t nChunkCache; // bytes of chunk cache for each open dataset
+  };
+
+  struct Definition {
+    EType eType;
+    std::string sPathName; // dataset
+    uint32_t nMultiplier;
+    uint8_t nSignificantDigits;
+    ou::tf::keytypes::eidProvider_t idProvider;
+  };
+
+  Recorder( const std::string& sJournalFileName, const Policy& );
+  Recorder( const Recorder& ) = delete;
+  Recorder( Recorder&& ) = delete;
+  ~Recorder(); // writes everything appended, then empties the journal
+
+  void Start(); // replays the journal, then starts the writer, throws when the journal can not be replayed
+
+  ixStream_t Register( const Definition& ); // after Start, from any thread, throws on a path name too long for a record
+
+  template<typename DD>
+  void Append( ixStream_t, const DD& );
+
+  void Flush(); // blocks until everything appended so far has been written
+
+  uint64_t Appended() const { return m_nAppended.load(); }
+
+  void Report( std::ostream& ); // per stream write throughput and queue lag since the previous report
+
+protected:
+private:
+
+  static constexpr EType Type( const ou::tf::Quote& ) { return EType::Quote; }
+  static constexpr EType Type( const ou::tf::Trade& ) { return EType::Trade; }
+  static constexpr EType Type( const ou::tf::DepthByOrder& ) { return EType::DepthByOrder; }
+
+  static constexpr size_t nMaxDatum
+    = std::max( { sizeof( ou::tf::Quote ), sizeof( ou::tf::Trade ), sizeof( ou::tf::DepthByOrder ) } );
+
+  struct Record {
+    ixStream_t ixStream;
+    uint16_t nSize;
+    ou::Timestamp::rep_t nsQueued;
+    alignas( 8 ) char rchDatum[ nMaxDatum ];
+  };
+
+  static const ixStream_t nMarker = std::numeric_limits<ixStream_t>::max(); // queued at a journal rotation
+
+  static const size_t nQueueCapacity = 256 * 1024;
+  static const size_t nWake = nQueueCapacity / 4; // appends wake the writer early at this backlog
+  static const size_t nJournalRotateSize = 64 * 1024 * 1024; // bytes
+
+  struct Stats {
+    uint64_t nQueued;  // taken from the queue
+    uint64_t nWritten;
+    uint64_t nWrites;
+    uint64_t nErrors;  // datums which could not be written
+    uint64_t nsWrite;  // time spent in hdf5
+    uint64_t nsLag;    // summed queue lag
+    uint64_t nsLagMax; // since the previous report
+    Stats(): nQueued {}, nWritten {}, nWrites {}, nErrors {}, nsWrite {}, nsLag {}, nsLagMax {} {}
+  };
+
+  struct Stream;
+  template<typename DD> struct StreamDatum;
+  using pStream_t = std::unique_ptr<Stream>;
+  using vStream_t = std::vector<pStream_t>;
+
+  const std::string m_sJournalFileName;
+  const std::string m_sJournalFileNamePrev; // the rotated journal, until its datums have been written
+  const Policy m_policy;
+
+  std::mutex m_mutexJournal; // serializes Append and Register, and the journal rotation
+  std::FILE* m_pJournal;
+  size_t m_nJournalSize;
+  uint64_t m_nEpoch; // identifies the journal file being appended to
+  uint64_t m_nEpochWriter; // the journal file of the datums being written
+  std::atomic<bool> m_bRetainJournal; // set when datums could not be written, the journal is kept for the next Start
+  std::atomic<bool> m_bRotating; // until the writer has removed the rotated journal
+
+  using vDefinition_t = std::vector<Definition>;
+  vDefinition_t m_vDefinition; // by ixStream, guarded by m_mutexJournal
+  std::vector<uint64_t> m_vAppended; // by ixStream, guarded by m_mutexJournal
+
+  boost::lockfree::spsc_queue<Record> m_queue;
+
+  std::mutex m_mutexWriter;
+  std::condition_variable m_cvWriter;
+  bool m_bStop;
+  bool m_bFlush;
+
+  std::mutex m_mutexWritten;
+  std::condition_variable m_cvWritten;
+
+  std::atomic<uint64_t> m_nAppended;
+  std::atomic<uint64_t> m_nWritten; // includes datums given up on
+
+  std::unique_ptr<ou::tf::HDF5DataManager> m_pdm; // the writer's, after Start
+  vStream_t m_vStream; // the writer's, by ixStream
+
+  std::mutex m_mutexStats; // published writer statistics
+  std::vector<Stats> m_vStats; // by ixStream
+  std::vector<Stats> m_vStatsReported; // as of the previous report
+  ou::Timestamp m_tsReported;
+
+  std::thread m_threadWriter;
+
+  static pStream_t MakeStream( const Definition& );
+  static size_t DatumSize( EType );
+
+  void Push( Record&, EType );
+
+  // under m_mutexJournal
+  void Journal( const char*, size_t );
+  void NewJournal();
+  void Rotate();
+
+  static void Frame( std::string& record ); // fills in the size
+  static void Define( std::string& record, ixStream_t, const Definition& );
+
+  void Writer();
+  void AddStreams();
+  void Drain();
+  void Rotated( uint64_t nEpoch );
+  bool WriteDue( bool bAll ); // true when something was written
+  bool Write( Stream&, uint64_t nEpoch, bool bAll ); // bAll: otherwise whole chunks only, true when something was written
+  void Commit(); // streams written since the previous commit, after a flush
+  void Publish();
+  void Replay( const std::string& sFileName );
+};
+
+template<typename DD>
+void Recorder::Append( ixStream_t ixStream, const DD& datum ) {
+  static_assert( std::is_trivially_copyable<DD>::value, "Recorder::Append: datum is copied as bytes" );
+  static_assert( sizeof( DD ) <= nMaxDatum, "Recorder::Append: datum too large for a record" );
+  Record record;
+  record.ixStream = ixStream;
+  record.nSize = sizeof( DD );
+  std::memcpy( record.rchDatum, &datum, sizeof( DD ) );
+  Push( record, Type( datum ) );
+}
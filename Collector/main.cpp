@@ -21,6 +21,7 @@
 
 #include <string>
 #include <sstream>
+#include <stdexcept>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 
@@ -43,9 +44,8 @@
   * switch to new save date at 17:30 EST each day
   * console based
 
-  * atomic variable[2]
-    * switching between: 0) filling, 1) writing to disk
-    * once a minute or so
+  * symbols recorded through a journal, written to disk by the recorder's thread
+  * recorder statistics once a minute or so
 */
 
 // ==========
@@ -109,7 +109,15 @@ int main( int argc, char* argv[] ) {
   //signals.add( SIGABRT );
 
   // unique ptr?  for daily start/stop?
-  Process process( choices, sTSDataStreamStarted );
+  std::unique_ptr<Process> pProcess;
+  try {
+    pProcess = std::make_unique<Process>( choices, sTSDataStreamStarted );
+  }
+  catch ( const std::runtime_error& e ) { // a journal which could not be replayed is kept for the next attempt
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  Process& process( *pProcess );
 
   signals.async_wait(
     [&process,&timerStop,&timerWrite,&m_pWork](const boost::system::error_code& error_code, int signal_number){
@@ -134,7 +142,7 @@ int main( int argc, char* argv[] ) {
 
   fWrite_t fWrite = [&process,&timerWrite,&fWrite]( const boost::system::error_code& error_code ){
     if ( 0 == error_code.value() ) {
-      process.Write();
+      process.Report();
       timerWrite.expires_from_now( boost::posix_time::seconds( 60 ) );
       timerWrite.async_wait( fWrite );
     }
@@ -168,7 +176,7 @@ int main( int argc, char* argv[] ) {
   signals.clear();
   signals.cancel();
 
-  std::cout << "DepthsByOrder=" << process.Count() << std::endl;
+  std::cout << "Recorded=" << process.Count() << std::endl;
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,209 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: ColumnStore
+ * Created: 2026/10/16 18:52:40
+ */
+
+// moves series between TradeFrame.hdf5, in the current directory, and a column store:
+//   ColumnStore import <store> <hdf5 prefix> <symbol>...
+//   ColumnStore export <store> <hdf5 prefix> <symbol>...
+//   ColumnStore bench  <store> <hdf5 prefix> <symbol>
+// the hdf5 prefix is the group above quotes/trades/bars/depths_o, "" for the root, as in "/app/collector/20261016"
+// bench reads the symbol's quotes each way, and shows the datums per second
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5WriteTimeSeries.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesContainer.h>
+
+#include <TFColumnStore/Store.hpp>
+
+namespace {
+
+  using vSymbol_t = std::vector<std::string>;
+
+  bool Exists( ou::tf::HDF5DataManager& dm, const std::string& sPath ) {
+    // one component at a time, hdf5 complains of a missing group along the path
+    std::string::size_type ix = 0;
+    while ( std::string::npos != ix ) {
+      ix = sPath.find( '/', ix + 1 );
+      const std::string sPart( sPath.substr( 0, ix ) );
+      if ( !dm.GetH5File()->nameExists( sPart ) ) return false;
+    }
+    return true;
+  }
+
+  template<typename DD>
+  bool ReadHDF5( ou::tf::HDF5DataManager& dm, const std::string& sPath, ou::tf::TimeSeries<DD>& series ) {
+    if ( !Exists( dm, sPath ) ) return false;
+    ou::tf::HDF5TimeSeriesContainer<DD> repository( dm, sPath );
+    typename ou::tf::HDF5TimeSeriesContainer<DD>::iterator begin, end;
+    begin = repository.begin();
+    end = repository.end();
+    series.Resize( end - begin );
+    repository.Read( begin, end, &series );
+    return true;
+  }
+
+  template<typename DD>
+  void Import( const ou::tf::column::Store& store, ou::tf::HDF5DataManager& dm, const std::string& sPrefix, const std::string& sSymbol ) {
+    using series_t = typename ou::tf::column::Layout<DD>::series_t;
+    const std::string sPath( sPrefix + series_t::Directory() + sSymbol );
+    if ( !store.Days<DD>( sSymbol ).empty() ) {
+      std::cout << sPath << " skipped, already in " << store.Directory<DD>( sSymbol ) << std::endl;
+      return;
+    }
+    series_t series;
+    if ( ReadHDF5<DD>( dm, sPath, series ) ) {
+      ou::tf::column::Store::Writer<DD> writer( store, sSymbol );
+      for ( typename series_t::size_type ix = 0; ix < series.Size(); ix++ ) {
+        writer.Append( series.At( ix ) );
+      }
+      writer.Sync();
+      std::cout << sPath << ": " << series.Size() << " imported" << std::endl;
+    }
+  }
+
+  template<typename DD>
+  void Export( const ou::tf::column::Store& store, ou::tf::HDF5DataManager& dm, const std::string& sPrefix, const std::string& sSymbol ) {
+    using series_t = typename ou::tf::column::Layout<DD>::series_t;
+    const std::string sPath( sPrefix + series_t::Directory() + sSymbol );
+    const std::vector<ou::tf::column::Store::date> vDay( store.Days<DD>( sSymbol ) );
+    if ( vDay.empty() ) return;
+    if ( Exists( dm, sPath ) ) {
+      std::cout << store.Directory<DD>( sSymbol ) << " skipped, already in " << sPath << std::endl;
+      return;
+    }
+    series_t series;
+    store.Load<DD>( sSymbol, boost::posix_time::ptime( vDay.front() ), boost::posix_time::ptime( vDay.back() + boost::gregorian::days( 1 ) ), series );
+    ou::tf::HDF5WriteTimeSeries<series_t> wts( dm, true, true, 5, 256 );
+    wts.Write( sPath, &series );
+    std::cout << sPath << ": " << series.Size() << " exported" << std::endl;
+  }
+
+  template<typename F>
+  void ForEachType( F&& f ) {
+    f( ou::tf::Quote() );
+    f( ou::tf::Trade() );
+    f( ou::tf::Bar() );
+    f( ou::tf::DepthByOrder() );
+  }
+
+  template<typename F>
+  void Rate( const std::string& sName, F&& f ) {
+    const auto start = std::chrono::steady_clock::now();
+    const size_t n = f();
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    std::cout
+      << sName << ": " << n << " in " << duration.count() << "s, "
+      << ( ( 0.0 < duration.count() ) ? ( n / duration.count() / 1.0e6 ) : 0.0 ) << "M/s"
+      << std::endl;
+  }
+
+  void Bench( const ou::tf::column::Store& store, const std::string& sPrefix, const std::string& sSymbol ) {
+    using namespace ou::tf;
+    using Layout_t = column::Layout<Quote>;
+
+    const std::string sPath( sPrefix + Quotes::Directory() + sSymbol );
+    double dblSum {};
+
+    Rate( "hdf5 rows", [&]()->size_t{
+      HDF5DataManager dm( HDF5DataManager::RO );
+      Quotes quotes;
+      if ( !ReadHDF5<Quote>( dm, sPath, quotes ) ) return 0;
+      for ( Quotes::size_type ix = 0; ix < quotes.Size(); ix++ ) dblSum += quotes.At( ix ).Bid();
+      return quotes.Size();
+    } );
+
+    Rate( "column scan", [&]()->size_t{
+      size_t n {};
+      for ( const column::Store::date day: store.Days<Quote>( sSymbol ) ) {
+        column::Segment<Quote> segment( store.Directory<Quote>( sSymbol, day ) );
+        const Quote::price_t* pBid( segment.Column<Layout_t::Bid>() );
+        for ( column::Segment<Quote>::size_type ix = 0; ix < segment.Size(); ix++ ) dblSum += pBid[ ix ];
+        n += segment.Size();
+      }
+      return n;
+    } );
+
+    Rate( "column rows", [&]()->size_t{
+      const std::vector<column::Store::date> vDay( store.Days<Quote>( sSymbol ) );
+      if ( vDay.empty() ) return 0;
+      Quotes quotes;
+      store.Load<Quote>( sSymbol, ptime( vDay.front() ), ptime( vDay.back() + boost::gregorian::days( 1 ) ), quotes );
+      for ( Quotes::size_type ix = 0; ix < quotes.Size(); ix++ ) dblSum += quotes.At( ix ).Bid();
+      return quotes.Size();
+    } );
+
+    std::cout << "checksum " << dblSum << std::endl;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  if ( 5 > argc ) {
+    std::cout << "ColumnStore import|export|bench <store> <hdf5 prefix> <symbol>..." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string sCommand( argv[ 1 ] );
+  const ou::tf::column::Store store( argv[ 2 ] );
+  const std::string sPrefix( argv[ 3 ] );
+  const vSymbol_t vSymbol( argv + 4, argv + argc );
+
+  try {
+    if ( "import" == sCommand ) {
+      ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
+      for ( const std::string& sSymbol: vSymbol ) {
+        ForEachType( [&]( auto datum ){ Import<decltype( datum )>( store, dm, sPrefix, sSymbol ); } );
+      }
+    }
+    else
+    if ( "export" == sCommand ) {
+      ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
+      for ( const std::string& sSymbol: vSymbol ) {
+        ForEachType( [&]( auto datum ){ Export<decltype( datum )>( store, dm, sPrefix, sSymbol ); } );
+      }
+    }
+    else
+    if ( "bench" == sCommand ) {
+      Bench( store, sPrefix, vSymbol.front() );
+    }
+    else {
+      std::cout << "unknown command " << sCommand << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch ( const std::runtime_error& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch ( const H5::Exception& e ) {
+    std::cout << "hdf5: " << e.getDetailMsg() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: DelegateCheck
+ * Created: 2026/10/16 21:44:19
+ */
+
+// dispatches lib/OUCommon/Delegate from several threads at once, and counts dispatches per second:
+//   DelegateCheck [ms per run]
+// a delegate with four handlers, dispatched by 1, 2, 4, 8, and 16 threads
+//   static:  the handlers stay, each thread's handlers must see four calls per dispatch
+//   churn:   another thread adds and removes a fifth handler every 10us, each dispatch sees four or five calls
+// before the runs, a handler removes itself during a dispatch, the other four must remain
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include <OUCommon/Delegate.h>
+
+namespace {
+
+  thread_local uint64_t t_nCalls; // calls on this dispatching thread
+
+  struct Handler {
+    ou::Delegate<int>* pDelegate;
+    Handler(): pDelegate( nullptr ) {}
+    void Handle( int ) { t_nCalls++; }
+    void HandleThenRemove( int ) {
+      t_nCalls++;
+      pDelegate->Remove( MakeDelegate( this, &Handler::HandleThenRemove ) );
+    }
+  };
+
+  const size_t c_nHandlers( 4 );
+
+  size_t SelfRemove() {
+    ou::Delegate<int> delegate;
+    Handler rHandler[ c_nHandlers ];
+    for ( Handler& handler: rHandler ) delegate.Add( MakeDelegate( &handler, &Handler::Handle ) );
+    Handler self;
+    self.pDelegate = &delegate;
+    delegate.Add( MakeDelegate( &self, &Handler::HandleThenRemove ) );
+    t_nCalls = 0;
+    delegate( 1 ); // all five, the removal applies from the next dispatch
+    delegate( 1 );
+    const bool bOk( ( c_nHandlers == delegate.Size() ) && ( 2 * c_nHandlers + 1 == t_nCalls ) );
+    std::cout << "self remove: " << delegate.Size() << " handlers remain, " << t_nCalls << " calls" << std::endl;
+    return bOk ? 0 : 1;
+  }
+
+  size_t Run( size_t nThreads, bool bChurn, size_t nMs ) {
+
+    ou::Delegate<int> delegate;
+    Handler rHandler[ c_nHandlers ];
+    for ( Handler& handler: rHandler ) delegate.Add( MakeDelegate( &handler, &Handler::Handle ) );
+
+    std::atomic<bool> bStop( false );
+    std::atomic<uint64_t> nDispatches {};
+    std::atomic<size_t> nWrong {};
+    std::atomic<uint64_t> nChurns {};
+
+    std::vector<std::thread> vThread;
+    for ( size_t ix = 0; ix < nThreads; ++ix ) {
+      vThread.emplace_back( [&](){
+        uint64_t n {};
+        t_nCalls = 0;
+        while ( !bStop.load( std::memory_order_relaxed ) ) {
+          for ( size_t dispatch = 0; dispatch < 1000; ++dispatch ) delegate( 1 );
+          n += 1000;
+        }
+        nDispatches += n;
+        const bool bOk( bChurn
+          ? ( ( c_nHandlers * n <= t_nCalls ) && ( t_nCalls <= ( c_nHandlers + 1 ) * n ) )
+          : ( c_nHandlers * n == t_nCalls ) );
+        if ( !bOk ) nWrong++;
+      } );
+    }
+
+    std::thread threadChurn;
+    if ( bChurn ) {
+      threadChurn = std::thread( [&](){
+        Handler extra;
+        uint64_t n {};
+        while ( !bStop.load( std::memory_order_relaxed ) ) {
+          delegate.Add( MakeDelegate( &extra, &Handler::Handle ) );
+          delegate.Remove( MakeDelegate( &extra, &Handler::Handle ) );
+          n++;
+          std::this_thread::sleep_for( std::chrono::microseconds( 10 ) );
+        }
+        nChurns = n;
+      } );
+    }
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( nMs ) );
+    bStop = true;
+    for ( std::thread& thread: vThread ) thread.join();
+    if ( threadChurn.joinable() ) threadChurn.join();
+
+    std::cout
+      << std::setw( 2 ) << nThreads << " threads, " << ( bChurn ? "churn " : "static" ) << ": "
+      << std::fixed << std::setprecision( 1 ) << ( 1000.0 * nDispatches.load() / nMs ) / 1e6 << "M dispatch/s";
+    if ( bChurn ) std::cout << ", " << nChurns.load() << " add and remove";
+    if ( 0 != nWrong.load() ) std::cout << ", " << nWrong.load() << " threads with wrong call counts";
+    std::cout << std::endl;
+
+    return nWrong.load();
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nMs( ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 1000 );
+
+  size_t nFail {};
+  nFail += SelfRemove();
+  for ( const bool bChurn: { false, true } ) {
+    for ( const size_t nThreads: { 1, 2, 4, 8, 16 } ) {
+      nFail += Run( nThreads, bChurn, nMs );
+    }
+  }
+
+  return ( 0 == nFail ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
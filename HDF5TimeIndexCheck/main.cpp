@@ -0,0 +1,139 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: HDF5TimeIndexCheck
+ * Created: 2026/10/16 19:12:08
+ */
+
+// checks the block cache and time index of HDF5TimeSeriesAccessor against a series with known content:
+//   HDF5TimeIndexCheck [elements]
+// a trade series is written to TradeFrame.hdf5 in the current directory, element ix at t0 + 10us * ix with a price of ix,
+// enough elements that the index stride grows beyond its starting value, then:
+//   seek:    LowerBound and UpperBound of element times, and of times between elements, on a fresh accessor
+//   reload:  a fresh accessor reads elements through its block cache at the starting stride, a seek then loads
+//            the persisted index with its larger stride, and the same elements, and their neighbours, are read again
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+
+#include <TFTimeSeries/TimeSeries.h>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5WriteTimeSeries.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesAccessor.h>
+
+namespace {
+
+  using ptime = boost::posix_time::ptime;
+  using accessor_t = ou::tf::HDF5TimeSeriesAccessor<ou::tf::Trade>;
+
+  const std::string c_sPath( "/app/HDF5TimeIndexCheck/trades" );
+  const ptime c_dtStart( boost::gregorian::date( 2026, 10, 16 ), boost::posix_time::time_duration( 9, 30, 0 ) );
+
+  ptime Time( size_t ix ) { return c_dtStart + boost::posix_time::microseconds( 10 * ix ); }
+
+  void Generate( size_t nElements ) {
+    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
+    const hid_t idFile( dm.GetH5File()->getId() );
+    if ( ( 0 < H5Lexists( idFile, "/app", H5P_DEFAULT ) )
+      && ( 0 < H5Lexists( idFile, "/app/HDF5TimeIndexCheck", H5P_DEFAULT ) )
+      && ( 0 < H5Lexists( idFile, c_sPath.c_str(), H5P_DEFAULT ) )
+    ) {
+      H5Ldelete( idFile, c_sPath.c_str(), H5P_DEFAULT ); // from an earlier run
+    }
+    ou::tf::Trades trades;
+    for ( size_t ix = 0; ix < nElements; ++ix ) {
+      trades.Append( ou::tf::Trade( Time( ix ), double( ix ), 1 ) );
+    }
+    ou::tf::HDF5WriteTimeSeries<ou::tf::Trades> write( dm, true, true, 5, 1024 );
+    write.Write( c_sPath, &trades );
+  }
+
+  // reads ix, and checks it is the element written there
+  bool Expect( accessor_t& accessor, size_t ix ) {
+    ou::tf::Trade trade;
+    accessor.Read( ix, &trade );
+    return ( trade.DateTime() == Time( ix ) ) && ( trade.Price() == double( ix ) );
+  }
+
+  size_t Seek( size_t nElements ) {
+    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR ); // the index is persisted on close
+    accessor_t accessor( dm, c_sPath );
+    size_t nFail {};
+    for ( size_t ix = 0; ix < nElements; ix += 997 ) {
+      if ( accessor.LowerBound( Time( ix ) ) != ix ) nFail++;
+      if ( accessor.UpperBound( Time( ix ) ) != ix + 1 ) nFail++;
+      if ( accessor.LowerBound( Time( ix ) + boost::posix_time::microseconds( 5 ) ) != ix + 1 ) nFail++;
+      if ( !Expect( accessor, ix ) ) nFail++;
+    }
+    if ( accessor.LowerBound( Time( nElements ) ) != nElements ) nFail++;
+    if ( accessor.LowerBound( c_dtStart - boost::posix_time::seconds( 1 ) ) != 0 ) nFail++;
+    std::cout << "seek: " << nFail << " wrong" << std::endl;
+    return nFail;
+  }
+
+  size_t Reload( size_t nElements ) {
+    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
+    accessor_t accessor( dm, c_sPath );
+    // fills the cache with blocks of the starting stride, the early ones, which a larger stride would number the same
+    std::vector<size_t> vIndex;
+    for ( size_t ix = 100; ix < 4 * 1024; ix += 1024 ) vIndex.push_back( ix );
+    for ( size_t ix = 900; ix < 4 * 1024; ix += 1024 ) vIndex.push_back( ix );
+    size_t nFail {};
+    for ( const size_t ix: vIndex ) {
+      if ( !Expect( accessor, ix ) ) nFail++;
+    }
+    // loads the stored index, with its larger stride
+    if ( accessor.LowerBound( Time( nElements / 2 ) ) != nElements / 2 ) nFail++;
+    // later elements first, their larger stride block numbers are those of earlier blocks still cached
+    for ( const size_t ix: vIndex ) {
+      if ( !Expect( accessor, ix + 2048 ) ) nFail++;
+      if ( !Expect( accessor, ix + 1024 ) ) nFail++;
+      if ( !Expect( accessor, ix ) ) nFail++;
+    }
+    for ( size_t ix = 0; ix < nElements; ix += 4999 ) {
+      if ( !Expect( accessor, ix ) ) nFail++;
+    }
+    std::cout << "reload: " << nFail << " wrong" << std::endl;
+    return nFail;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nElements( ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 5000000 );
+  if ( 8 * 1024 > nElements ) {
+    std::cout << "HDF5TimeIndexCheck [elements], at least 8192" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  size_t nFail {};
+  try {
+    Generate( nElements );
+    nFail += Seek( nElements );
+    nFail += Reload( nElements );
+  }
+  catch ( const std::exception& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return ( 0 == nFail ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -65,10 +65,15 @@ bool AppIQFeedGetHistory::OnInit() {
   m_pIQFeedSymbolListOps->Done.connect( [this]( ou::tf::IQFeedSymbolListOps::ECompletionCode code ) {
     switch ( code ) {
       case ou::tf::IQFeedSymbolListOps::ECompletionCode::ccCleared:
-        DisableMenuActionDays();
+        CallAfter( [this](){
+          m_pSymbolTable.reset();
+          DisableMenuActionDays();
+        });
         break;
       case ou::tf::IQFeedSymbolListOps::ECompletionCode::ccDone:
-        EnableMenuActionDays();
+        CallAfter( [this](){
+          OpenSymbolTable(); // rewritten first if the list came from an older binary
+        });
         break;
       case ou::tf::IQFeedSymbolListOps::ECompletionCode::ccSaved:
         break;
@@ -81,6 +86,7 @@ bool AppIQFeedGetHistory::OnInit() {
   vItemsLoadSymbols.push_back( new mi( "New Symbol List Remote", MakeDelegate( this, &AppIQFeedGetHistory::HandleNewSymbolListRemote ) ) );
   vItemsLoadSymbols.push_back( new mi( "New Symbol List Local", MakeDelegate( this, &AppIQFeedGetHistory::HandleNewSymbolListLocal ) ) );
   vItemsLoadSymbols.push_back( new mi( "Local Binary Symbol List", MakeDelegate( this, &AppIQFeedGetHistory::HandleLocalBinarySymbolList ) ) );
+  vItemsLoadSymbols.push_back( new mi( "Local Symbol Table", MakeDelegate( this, &AppIQFeedGetHistory::HandleLocalSymbolTable ) ) );
   wxMenu* pMenuSymbols = m_pFrameMain->AddDynamicMenu( "Load Symbols", vItemsLoadSymbols );
 
   FrameMain::vpItems_t vItemsLoadDays;
@@ -142,6 +148,25 @@ void AppIQFeedGetHistory::HandleLocalBinarySymbolList( void ) {
     });
 }
 
+void AppIQFeedGetHistory::HandleLocalSymbolTable( void ) { // without loading the list
+  CallAfter(
+    [this](){
+      OpenSymbolTable();
+    });
+}
+
+void AppIQFeedGetHistory::OpenSymbolTable() {
+  try {
+    std::cout << "Opening Symbol Table ..." << std::endl;
+    m_pSymbolTable = ou::tf::iqfeed::OpenMktSymbolTable();
+    std::cout << " ... done, " << m_pSymbolTable->Size() << " symbols." << std::endl;
+    EnableMenuActionDays();
+  }
+  catch ( const std::runtime_error& e ) {
+    std::cout << "Symbol Table: " << e.what() << std::endl;
+  }
+}
+
 void AppIQFeedGetHistory::HandleMenuActionDays10( void ) {
   StartWorker( "", 10 );
 }
@@ -167,8 +192,12 @@ void AppIQFeedGetHistory::HandleMenuActionDays0( void ) {
 }
 
 void AppIQFeedGetHistory::StartWorker( const std::string& s, size_t nDatums ) {
+  if ( !m_pSymbolTable ) {
+    std::cout << "No can do.  No symbol table" << std::endl;
+  }
+  else
   if ( this->m_bIQFeedConnected ) {
-    m_pWorker = new Worker( m_listIQFeedSymbols, s, nDatums );
+    m_pWorker = new Worker( m_pSymbolTable, s, nDatums );
   }
   else {
     std::cout << "No can do.  IQFeed not connected" << std::endl;
@@ -26,7 +26,7 @@
 #include <TFVuTrading/FrameMain.h>
 #include <TFVuTrading/PanelLogging.h>
 
-//#include <TFIQFeed/LoadMktSymbols.h>
+#include <TFIQFeed/LoadMktSymbols.h>
 #include <TFBitsNPieces/IQFeedSymbolListOps.h>
 
 #include "Worker.h"
@@ -44,9 +44,11 @@ private:
 //  PanelOptionsParameters* m_pPanelOptionsParameters;
   ou::tf::PanelLogging* m_pPanelLogging;
 
-  ou::tf::iqfeed::InMemoryMktSymbolList m_listIQFeedSymbols;
+  ou::tf::iqfeed::InMemoryMktSymbolList m_listIQFeedSymbols; // built and saved by IQFeedSymbolListOps
   ou::tf::IQFeedSymbolListOps* m_pIQFeedSymbolListOps;
 
+  Worker::pSymbolTable_t m_pSymbolTable; // what the worker scans
+
   wxMenu* m_pMenuLoadDays;
 
   Worker* m_pWorker;
@@ -57,6 +59,9 @@ private:
   void HandleNewSymbolListRemote( void );
   void HandleNewSymbolListLocal( void );
   void HandleLocalBinarySymbolList( void );
+  void HandleLocalSymbolTable( void );
+
+  void OpenSymbolTable();
 
   void HandleMenuActionDays10( void );
   void HandleMenuActionDays30( void );
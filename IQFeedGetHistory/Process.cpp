@@ -11,6 +11,7 @@
  * See the file LICENSE.txt for redistribution information.             *
  ************************************************************************/
 
+#include <cstdio>
 #include <algorithm>
 
 #include <boost/foreach.hpp>
@@ -30,12 +31,23 @@
 #pragma message( "** Note:  for msvc, compile in release mode, buffer checks make it slow in debug" )
 #endif
 
+const std::string Process::c_sCheckpoint( "IQFeedGetHistory.ckpt" );
+
+namespace {
+  ou::tf::iqfeed::HistoryBulkConfig Config( const std::string& sCheckpoint ) {
+    ou::tf::iqfeed::HistoryBulkConfig config;
+    config.nConnections = 15;
+    config.sCheckpointFile = sCheckpoint;
+    return config;
+  }
+}
+
 Process::Process(
-  ou::tf::iqfeed::InMemoryMktSymbolList& list,
+  const ou::tf::iqfeed::SymbolTable& table,
   const std::string& sPrefixPath,
 	size_t nDatums )
-: ou::tf::iqfeed::HistoryBulkQuery<Process>(),
-	m_list( list ),
+: ou::tf::iqfeed::HistoryBulkLoader<Process>( Config( c_sCheckpoint ) ),
+	m_table( table ),
   m_sPrefixPath( sPrefixPath ), m_nDatums( nDatums )
   //m_cntBars( 25 )
 //  m_cntBars( 0 ) // 2013/09/17
@@ -52,6 +64,7 @@ Process::Process(
 }
 
 Process::~Process() {
+  Stop();
 }
 
 void Process::Start() {
@@ -81,7 +94,7 @@ void Process::Start() {
   struct SelectSymbols {
     SelectSymbols( SymbolList_t& set ): m_selected( set ) {  };
     SymbolList_t& m_selected;
-    void operator() ( const ou::tf::iqfeed::InMemoryMktSymbolList::trd_t& trd ) {
+    void operator() ( const ou::tf::iqfeed::SymbolTable::trd_t& trd ) {
       if ( ou::tf::iqfeed::ESecurityType::Equity == trd.sc ) {
         if ( trd.bHasOptions ) {
           m_selected.insert( trd.sSymbol );
@@ -90,19 +103,28 @@ void Process::Start() {
     }
   };
 
-  m_list.SelectSymbolsByExchange( m_vExchanges.begin(), m_vExchanges.end(), SelectSymbols( setSelected ) );
+  m_table.SelectSymbolsByExchange( m_vExchanges.begin(), m_vExchanges.end(), SelectSymbols( setSelected ) );
   std::cout << "# symbols selected: " << setSelected.size() << std::endl;
 
-  SetMaxSimultaneousQueries( 15 );
-  SetSymbols( setSelected.begin(), setSelected.end() );
-  DailyBars( m_nDatums );
-  Block();
+  // symbols in the checkpoint, from an interrupted run, are skipped
+  Add( setSelected.begin(), setSelected.end(), ERequest::EndOfDays, m_nDatums );
+  inherited_t::Start();
+  Wait();
+  Stop();
+
+  const Stats stats( GetStats() );
+  std::cout
+    << "Process complete: " << stats.nDone << " done, " << stats.nNoData << " no data, "
+    << stats.nFailed << " failed, " << stats.nSkipped << " skipped, " << stats.nRetries << " retries"
+    << std::endl;
 
-  std::cout << "Process complete." << std::endl;
+  if ( 0 == stats.nFailed ) {
+    std::remove( c_sCheckpoint.c_str() ); // the next run starts fresh
+  }
 
 }
 
-void Process::OnBars( inherited_t::structResultBar* bars ) {
+void Process::OnHistoryBatch( inherited_t::Batch* batch ) {
 
   // warning:  this section is re-entrant from multiple threads
 
@@ -110,51 +132,31 @@ void Process::OnBars( inherited_t::structResultBar* bars ) {
 
   boost::mutex::scoped_lock lock( m_mutexProcessResults );
 
-  assert( bars->sSymbol.length() > 0 );
+  assert( batch->sSymbol.length() > 0 );
 
-  std::cout << bars->sSymbol << ": " << bars->bars.Size();
+  std::cout << batch->sSymbol << ": " << batch->bars.Size();
 
-  if ( 0 != bars->bars.Size() ) {
+  if ( 0 != batch->bars.Size() ) {
 
     std::string sPath;
 
-    ou::tf::HDF5DataManager::DailyBarPath( bars->sSymbol, sPath );  // build hierarchical path based upon symbol name
+    ou::tf::HDF5DataManager::DailyBarPath( batch->sSymbol, sPath );  // build hierarchical path based upon symbol name
 
     ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
     ou::tf::HDF5WriteTimeSeries<ou::tf::Bars> wts( dm, false, true, 0, 64 );
-    wts.Write( sPath, &bars->bars );
+    wts.Write( sPath, &batch->bars );
   }
 
-  ReQueueBars( bars );
-
-  std::cout << "." << std::endl;
-
-}
-
-void Process::OnTicks( inherited_t::structResultTicks* ticks ) {
-
-  boost::mutex::scoped_lock lock( m_mutexProcessResults );
-
-  assert( ticks->sSymbol.length() > 0 );
-
-  ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
-
-  if ( 0 != ticks->trades.Size() ) {
-    std::string sPath( "/optionables/trade/" + ticks->sSymbol );
-    ou::tf::HDF5WriteTimeSeries<ou::tf::Trades> wtst( dm );
-    wtst.Write( sPath, &ticks->trades );
+  if ( EStatus::Failed == batch->eStatus ) {
+    std::cout << " failed: " << batch->sError;
   }
 
-  if ( 0 != ticks->quotes.Size() ) {
-    std::string sPath( "/optionables/quote/" + ticks->sSymbol );
-    ou::tf::HDF5WriteTimeSeries<ou::tf::Quotes> wtsq( dm );
-    wtsq.Write( sPath, &ticks->quotes );
-  }
+  Release( batch ); // the symbol is checkpointed once written
+
+  std::cout << "." << std::endl;
 
-  ReQueueTicks( ticks );
 }
 
-void Process::OnCompletion() {
+void Process::OnHistoryCompletion() {
   std::cout << "Downloads complete." << std::endl;
 }
-
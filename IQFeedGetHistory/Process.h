@@ -27,19 +27,19 @@
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/locks.hpp>
 
-#include <TFIQFeed/HistoryBulkQuery.h>
-#include <TFIQFeed/InMemoryMktSymbolList.h>
+#include <TFIQFeed/HistoryBulkLoader.h>
+#include <TFIQFeed/SymbolTable.h>
 
 class Process:
-  public ou::tf::iqfeed::HistoryBulkQuery<Process>
+  public ou::tf::iqfeed::HistoryBulkLoader<Process>
 {
-  friend ou::tf::iqfeed::HistoryBulkQuery<Process>;
+  friend ou::tf::iqfeed::HistoryBulkLoader<Process>;
 public:
 
-  typedef ou::tf::iqfeed::HistoryBulkQuery<Process> inherited_t;
+  typedef ou::tf::iqfeed::HistoryBulkLoader<Process> inherited_t;
 
   Process(
-    ou::tf::iqfeed::InMemoryMktSymbolList&,
+    const ou::tf::iqfeed::SymbolTable&,
     const std::string& sPrefixPath,
     size_t nDatums
   );
@@ -48,26 +48,13 @@ public:
 
 protected:
 
-  // CRTP from HistoryBulkQuery<CProcess>
-  void OnBars( inherited_t::structResultBar* bars );
-  void OnTicks( inherited_t::structResultTicks* ticks );
-  void OnCompletion();
-
-  void OnBarsForDarvas( inherited_t::structResultBar* bars );
-
-  // CRTP prototypes
-  //void OnHistoryConnected( structQueryState* pqs );  // optional
-  //void OnHistoryDisconnected( structQueryState* pqs ); // optional
-  //void OnHistoryError( structQueryState* pqs, size_t e ); // optional
-  //void OnHistorySendDone( structQueryState* pqs ); // otional
-  //void OnHistoryTickDataPoint( structQueryState* pqs, ou::tf::iqfeed::HistoryStructs::structTickDataPoint* pDP ); // for per tick processing
-  //void OnHistoryIntervalData( structQueryState* pqs, ou::tf::iqfeed::HistoryStructs::structInterval* pDP ); // for per bar processing
-  //void OnHistorySummaryData( structQueryState* pqs, ou::tf::iqfeed::HistoryStructs::structSummary* pDP ); // for per bar processing
-  //void OnHistoryRequestDone( structQueryState* pqs ); // for processing finished ticks, bars
+  // CRTP from HistoryBulkLoader<Process>
+  void OnHistoryBatch( inherited_t::Batch* batch );
+  void OnHistoryCompletion();
 
 private:
 
-  ou::tf::iqfeed::InMemoryMktSymbolList& m_list;
+  const ou::tf::iqfeed::SymbolTable& m_table;
 
   boost::mutex m_mutexProcessResults;
 
@@ -77,6 +64,8 @@ private:
   std::set<std::string> m_vExchanges;  // list of exchanges to be scanned to create:
   std::set<std::string> m_vSymbols;  // list of symbols to be scanned
 
+  static const std::string c_sCheckpoint;  // symbols done, for a re-run after an interruption
+
   static const size_t m_BarWindow = 20;  // number of bars to examine
 
   //const size_t m_cntBars;
@@ -21,9 +21,9 @@
 // For IQFeedGetHistory
 
 Worker::Worker( 
-  ou::tf::iqfeed::InMemoryMktSymbolList& list,
+  pSymbolTable_t pSymbolTable,
   const std::string& sPrefixPath, size_t nDatums ): 
-  m_list( list ),
+  m_pSymbolTable( pSymbolTable ),
   m_nDatums( nDatums ),
   m_sPrefixPath( sPrefixPath ),
   m_thread( boost::ref( *this ) ) 
@@ -35,6 +35,6 @@ Worker::~Worker(void) {
 
 void Worker::operator()( void ) {
 
-  Process process( m_list, m_sPrefixPath, m_nDatums );
+  Process process( *m_pSymbolTable, m_sPrefixPath, m_nDatums );
   process.Start();
 }
\ No newline at end of file
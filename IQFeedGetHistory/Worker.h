@@ -16,24 +16,26 @@
 
 // For IQFeedGetHistory
 
+#include <memory>
 #include <string>
 
 #include <boost/thread/thread.hpp>
 //#include <boost/noncopyable.hpp>
 
-#include <TFIQFeed/InMemoryMktSymbolList.h>
+#include <TFIQFeed/SymbolTable.h>
 
 class Worker {
 public:
+  using pSymbolTable_t = std::shared_ptr<const ou::tf::iqfeed::SymbolTable>; // held for the life of the thread
   Worker( 
-    ou::tf::iqfeed::InMemoryMktSymbolList&,
+    pSymbolTable_t,
     const std::string& sPrefixPath, size_t nDatums );
   ~Worker(void);
   void operator()( void );
   void Join( void ) { m_thread.join(); };
 protected:
 private:
-  ou::tf::iqfeed::InMemoryMktSymbolList& m_list;
+  pSymbolTable_t m_pSymbolTable;
   std::string m_sPrefixPath;
   const size_t m_nDatums;
   boost::thread m_thread;
@@ -0,0 +1,220 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: IQFeedHistoryReplay
+ * Created: 2026/10/16 20:31:48
+ */
+
+// serves recorded history replies on the history port, and benchmarks HistoryBulkLoader against them:
+//   IQFeedHistoryReplay serve    <dir> [port]
+//   IQFeedHistoryReplay generate <dir> <symbols> <datums>
+//   IQFeedHistoryReplay bench    <dir> <HDX|HTX> <connections> <parsers> [requests/s] [error interval] [drop interval]
+// generate writes synthetic HDX (daily bars) and HTX (ticks) replies, for when nothing has been recorded
+// bench serves <dir> on port 9101 in this process, and downloads every symbol of the command's directory
+
+#include <cmath>
+#include <mutex>
+#include <cstdio>
+#include <chrono>
+#include <cstdint>
+#include <cinttypes>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include <TFIQFeed/HistoryReplay.h>
+#include <TFIQFeed/HistoryBulkLoader.h>
+
+namespace {
+
+  using vSymbol_t = std::vector<std::string>;
+
+  void Generate( const std::string& sDirectory, size_t nSymbols, size_t nDatums ) {
+
+    boost::filesystem::create_directories( sDirectory + "/HDX" );
+    boost::filesystem::create_directories( sDirectory + "/HTX" );
+
+    char szLine[ 256 ];
+    for ( size_t ixSymbol = 0; ixSymbol < nSymbols; ixSymbol++ ) {
+
+      const std::string sSymbol( "SYM" + std::to_string( ixSymbol ) );
+      double dblPrice( 20.0 + ixSymbol % 100 );
+
+      // oldest first, as the feed sends with direction 1
+      std::ofstream ofsDay( ou::tf::iqfeed::ReplayFileName( sDirectory, "HDX", sSymbol ) );
+      boost::gregorian::date day( boost::gregorian::date( 2026, 10, 16 ) - boost::gregorian::days( long( nDatums ) - 1 ) );
+      for ( size_t ix = 0; ix < nDatums; ix++ ) {
+        const double dblOpen( dblPrice );
+        dblPrice *= 1.0 + 0.01 * std::sin( double( ix + ixSymbol ) );
+        std::snprintf( szLine, sizeof( szLine ), "LH,%04d-%02d-%02d,%.4f,%.4f,%.4f,%.4f,%zu,0,",
+          (int)day.year(), (int)day.month(), (int)day.day(),
+          std::max( dblOpen, dblPrice ) + 0.05, std::min( dblOpen, dblPrice ) - 0.05, dblOpen, dblPrice, 100000 + ix );
+        ofsDay << szLine << '\n';
+        day += boost::gregorian::days( 1 );
+      }
+
+      std::ofstream ofsTick( ou::tf::iqfeed::ReplayFileName( sDirectory, "HTX", sSymbol ) );
+      uint64_t nMicro( ( 9 * 3600 + 30 * 60 ) * UINT64_C( 1000000 ) ); // from the open, about 37M ticks fit in the day
+      uint64_t nVolume {};
+      for ( size_t ix = 0; ix < nDatums; ix++ ) {
+        dblPrice += 0.01 * std::sin( double( ix ) );
+        nMicro += 1000 + ix % 777;
+        const uint64_t nSize( 100 + ix % 10 * 100 );
+        nVolume += nSize;
+        std::snprintf( szLine, sizeof( szLine ),
+          "LH,2026-10-16 %02" PRIu64 ":%02" PRIu64 ":%02" PRIu64 ".%06" PRIu64 ",%.4f,%" PRIu64 ",%" PRIu64 ",%.4f,%.4f,%" PRIu64 ",C,11,3D,0,0,",
+          nMicro / UINT64_C( 3600000000 ), ( nMicro / UINT64_C( 60000000 ) ) % 60, ( nMicro / UINT64_C( 1000000 ) ) % 60, nMicro % UINT64_C( 1000000 ),
+          dblPrice, nSize, nVolume, dblPrice - 0.01, dblPrice + 0.01, UINT64_C( 3000000000 ) + ix );
+        ofsTick << szLine << '\n';
+      }
+    }
+    std::cout << nSymbols << " symbols, " << nDatums << " datums each, written to " << sDirectory << std::endl;
+  }
+
+  class Loader: public ou::tf::iqfeed::HistoryBulkLoader<Loader> {
+    friend ou::tf::iqfeed::HistoryBulkLoader<Loader>;
+  public:
+    using inherited_t = ou::tf::iqfeed::HistoryBulkLoader<Loader>;
+    Loader( const ou::tf::iqfeed::HistoryBulkConfig& config )
+    : inherited_t( config ), m_nBatches {}, m_dblSum {} {}
+    ~Loader() { Stop(); }
+    size_t Batches() const { return m_nBatches; }
+    double Sum() const { return m_dblSum; }
+  protected:
+    void OnHistoryBatch( Batch* pBatch ) {
+      double dblSum {};
+      for ( ou::tf::Bars::size_type ix = 0; ix < pBatch->bars.Size(); ix++ ) dblSum += pBatch->bars.At( ix ).Close();
+      for ( ou::tf::Trades::size_type ix = 0; ix < pBatch->trades.Size(); ix++ ) dblSum += pBatch->trades.At( ix ).Price();
+      {
+        std::scoped_lock<std::mutex> lock( m_mutex );
+        m_nBatches++;
+        m_dblSum += dblSum;
+      }
+      Release( pBatch );
+    }
+  private:
+    std::mutex m_mutex;
+    size_t m_nBatches;
+    double m_dblSum;
+  };
+
+  void Bench(
+    const std::string& sDirectory, const std::string& sCommand,
+    size_t nConnections, size_t nParsers, double dblRate, size_t nErrorInterval, size_t nDropInterval
+  ) {
+
+    using Loader_t = ou::tf::iqfeed::HistoryBulkLoader<Loader>;
+
+    vSymbol_t vSymbol;
+    for ( boost::filesystem::directory_iterator iter( sDirectory + "/" + sCommand ), end; iter != end; ++iter ) {
+      vSymbol.push_back( iter->path().filename().string() ); // '_' is not mapped back to '/'
+    }
+    std::sort( vSymbol.begin(), vSymbol.end() );
+
+    const unsigned short nPort( 9101 );
+    ou::tf::iqfeed::HistoryReplay replay( sDirectory, nPort );
+    replay.SetErrorInterval( nErrorInterval );
+    replay.SetDropInterval( nDropInterval );
+
+    ou::tf::iqfeed::HistoryBulkConfig config;
+    config.nConnections = nConnections;
+    config.nParsers = nParsers;
+    config.dblRequestsPerSecond = dblRate;
+    config.nPort = nPort;
+    config.msRetry = std::chrono::milliseconds( 50 );
+
+    Loader loader( config );
+    loader.Add(
+      vSymbol.begin(), vSymbol.end(),
+      ( "HDX" == sCommand ) ? Loader_t::ERequest::EndOfDays : Loader_t::ERequest::Ticks,
+      1000000 );
+
+    const auto start = std::chrono::steady_clock::now();
+    loader.Start();
+    loader.Wait();
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    loader.Stop();
+
+    const Loader_t::Stats stats( loader.GetStats() );
+    const ou::tf::iqfeed::HistoryReplay::Stats statsReplay( replay.GetStats() );
+    std::cout
+      << stats.nDone << " done, " << stats.nNoData << " no data, " << stats.nFailed << " failed, "
+      << stats.nRetries << " retries, " << loader.Batches() << " batches" << std::endl
+      << "replay: " << statsReplay.nConnections << " connections, " << statsReplay.nRequests << " requests, "
+      << statsReplay.nErrors << " errors, " << statsReplay.nDrops << " drops, " << statsReplay.nBytes << " bytes" << std::endl
+      << duration.count() << "s, "
+      << ( stats.nDone + stats.nNoData + stats.nFailed ) / duration.count() << " requests/s, "
+      << stats.nDatums / duration.count() / 1.0e6 << "M datums/s, "
+      << stats.nLines / duration.count() / 1.0e6 << "M lines/s" << std::endl
+      << "checksum " << loader.Sum() << std::endl;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const std::string sUsage(
+    "IQFeedHistoryReplay serve <dir> [port]\n"
+    "IQFeedHistoryReplay generate <dir> <symbols> <datums>\n"
+    "IQFeedHistoryReplay bench <dir> <HDX|HTX> <connections> <parsers> [requests/s] [error interval] [drop interval]"
+  );
+
+  if ( 3 > argc ) {
+    std::cout << sUsage << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string sCommand( argv[ 1 ] );
+  const std::string sDirectory( argv[ 2 ] );
+
+  try {
+    if ( "serve" == sCommand ) {
+      const unsigned short nPort( ( 3 < argc ) ? std::stoi( argv[ 3 ] ) : 9100 );
+      ou::tf::iqfeed::HistoryReplay replay( sDirectory, nPort );
+      std::cout << "serving " << sDirectory << " on port " << nPort << ", enter to stop" << std::endl;
+      std::cin.get();
+    }
+    else
+    if ( ( "generate" == sCommand ) && ( 5 == argc ) ) {
+      Generate( sDirectory, std::stoul( argv[ 3 ] ), std::stoul( argv[ 4 ] ) );
+    }
+    else
+    if ( ( "bench" == sCommand ) && ( 6 <= argc ) ) {
+      Bench(
+        sDirectory, argv[ 3 ], std::stoul( argv[ 4 ] ), std::stoul( argv[ 5 ] ),
+        ( 6 < argc ) ? std::stod( argv[ 6 ] ) : 50.0,
+        ( 7 < argc ) ? std::stoul( argv[ 7 ] ) : 0,
+        ( 8 < argc ) ? std::stoul( argv[ 8 ] ) : 0 );
+    }
+    else {
+      std::cout << sUsage << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch ( const std::exception& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
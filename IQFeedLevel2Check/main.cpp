@@ -0,0 +1,613 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: IQFeedLevel2Check
+ * Created: 2026/10/16 22:14:27
+ */
+
+// differential checks of the level 2 decoders and order book against the implementations they replace:
+//   IQFeedLevel2Check book   random <messages> [seed]
+//   IQFeedLevel2Check book   hdf5   <hdf5 prefix> <symbol>
+//   IQFeedLevel2Check decode random <lines> [seed]
+//   IQFeedLevel2Check decode file   <file of feed lines>
+// the depth by order stream, synthetic or recorded in TradeFrame.hdf5 by Collector, is replayed through
+//   OrderBased (order table, flat level book) and through a reference of std::map orders and MapLevelAggregate,
+//   every book change and volume at price callback is compared, the first difference is shown
+// order arrival and delete lines, generated and mangled, or as captured from the feed, are decoded by
+//   DecodeFast and by the spirit grammar, a line DecodeFast accepts must decode the same with the grammar
+
+#include <map>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesContainer.h>
+
+#include <TFIQFeed/Level2/Symbols.hpp>
+
+namespace {
+
+  namespace l2 = ou::tf::iqfeed::l2;
+
+  using ptime = boost::posix_time::ptime;
+
+  // ==== book
+
+  struct Event { // one callback from a book
+    size_t ixMessage;
+    char chSide;
+    char chKind; // 'C' book change, 'V' volume at price
+    int nOp; // EOp, or add for volume at price
+    unsigned int ixLevel;
+    double dblPrice;
+    int64_t nVolume;
+    bool operator==( const Event& rhs ) const {
+      return ( ixMessage == rhs.ixMessage ) && ( chSide == rhs.chSide ) && ( chKind == rhs.chKind ) && ( nOp == rhs.nOp )
+          && ( ixLevel == rhs.ixLevel ) && ( dblPrice == rhs.dblPrice ) && ( nVolume == rhs.nVolume );
+    }
+  };
+
+  std::ostream& operator<<( std::ostream& os, const Event& event ) {
+    os
+      << "message " << event.ixMessage << " side " << event.chSide << " "
+      << ( ( 'C' == event.chKind ) ? "change op " : "volume at price add " ) << event.nOp
+      << " level " << event.ixLevel << " price " << event.dblPrice << " volume " << event.nVolume;
+    return os;
+  }
+
+  using vEvent_t = std::vector<Event>;
+  using vDepth_t = std::vector<ou::tf::DepthByOrder>;
+
+  class Recorder {
+  public:
+    Recorder( vEvent_t& vEvent ): m_vEvent( vEvent ), m_ixMessage {} {}
+    void Message( size_t ix ) { m_ixMessage = ix; }
+    l2::fBookChanges_t Change( char chSide ) {
+      return [this,chSide]( l2::EOp op, unsigned int ix, const ou::tf::Depth& depth ){
+        m_vEvent.push_back( Event{ m_ixMessage, chSide, 'C', (int)op, ix, depth.Price(), int64_t( depth.Volume() ) } );
+      };
+    }
+    l2::fVolumeAtPrice_t VolumeAtPrice( char chSide ) {
+      return [this,chSide]( double price, int volume, bool bAdd ){
+        m_vEvent.push_back( Event{ m_ixMessage, chSide, 'V', bAdd, 0, price, volume } );
+      };
+    }
+  private:
+    vEvent_t& m_vEvent;
+    size_t m_ixMessage;
+  };
+
+  // OrderBased as it was, std::map of orders in front of MapLevelAggregate
+  class Reference {
+  public:
+
+    Reference( Recorder& recorder ) {
+      m_ask.Set( recorder.Change( 'A' ) );
+      m_ask.Set( recorder.VolumeAtPrice( 'A' ) );
+      m_bid.Set( recorder.Change( 'B' ) );
+      m_bid.Set( recorder.VolumeAtPrice( 'B' ) );
+    }
+
+    void MarketDepth( const ou::tf::DepthByOrder& depth ) {
+      switch ( depth.MsgType() ) {
+        case '3': // add
+        case '6': // summary
+          if ( m_mapOrder.emplace( depth.OrderID(), Order( depth ) ).second ) {
+            Add( depth );
+          }
+          break;
+        case '4': { // update
+            mapOrder_t::iterator iter = m_mapOrder.find( depth.OrderID() );
+            if ( ( m_mapOrder.end() != iter ) && ( iter->second.chSide == depth.Side() ) ) {
+              Delete( ou::tf::Depth( depth.DateTime(), depth.Side(), iter->second.dblPrice, iter->second.nQuantity ) );
+              iter->second = Order( depth );
+              Add( depth );
+            }
+          }
+          break;
+        case '5': { // delete
+            mapOrder_t::iterator iter = m_mapOrder.find( depth.OrderID() );
+            if ( m_mapOrder.end() != iter ) {
+              Delete( ou::tf::Depth( depth.DateTime(), depth.Side(), iter->second.dblPrice, iter->second.nQuantity ) );
+              m_mapOrder.erase( iter );
+            }
+          }
+          break;
+        case 'C': { // clear a side, in order id sequence
+            mapOrder_t::iterator iter = m_mapOrder.begin();
+            while ( m_mapOrder.end() != iter ) {
+              if ( depth.Side() == iter->second.chSide ) {
+                Delete( ou::tf::Depth( depth.DateTime(), depth.Side(), iter->second.dblPrice, iter->second.nQuantity ) );
+                iter = m_mapOrder.erase( iter );
+              }
+              else ++iter;
+            }
+          }
+          break;
+      }
+    }
+
+  private:
+
+    struct Order {
+      double dblPrice;
+      ou::tf::Depth::volume_t nQuantity;
+      char chSide;
+      Order( const ou::tf::DepthByOrder& depth )
+      : dblPrice( depth.Price() ), nQuantity( depth.Volume() ), chSide( depth.Side() ) {}
+    };
+
+    using mapOrder_t = std::map<uint64_t,Order>;
+    mapOrder_t m_mapOrder;
+
+    l2::MapLevelAggregate<std::less<double> > m_ask;
+    l2::MapLevelAggregate<std::greater<double> > m_bid;
+
+    void Add( const ou::tf::Depth& depth ) {
+      if ( 'A' == depth.Side() ) m_ask.Add( depth );
+      else m_bid.Add( depth );
+    }
+
+    void Delete( const ou::tf::Depth& depth ) {
+      if ( 'A' == depth.Side() ) m_ask.Delete( depth );
+      else m_bid.Delete( depth );
+    }
+  };
+
+  // orders cluster around a wandering touch, updates move price or size, and a side is cleared now and then
+  vDepth_t Generate( size_t nMessages, unsigned int seed ) {
+
+    struct Order {
+      char chSide;
+      double dblPrice;
+      ou::tf::Depth::volume_t nQuantity;
+    };
+    std::map<uint64_t,Order> mapOrder;
+    std::vector<uint64_t> vOrderId; // for random picks, compacted as orders go
+
+    std::mt19937_64 rng( seed );
+    std::geometric_distribution<int> distanceTicks( 0.3 );
+    const double dblTick( 0.25 );
+    int nMid( 16000 ); // in ticks
+
+    const ptime dtBase( boost::gregorian::date( 2026, 10, 16 ), boost::posix_time::hours( 14 ) );
+    uint64_t idOrder( 600000000000 );
+
+    vDepth_t vDepth;
+    vDepth.reserve( nMessages );
+
+    auto price = [&]( char chSide )->double {
+      const int nTicks( 1 + distanceTicks( rng ) );
+      return dblTick * ( ( 'A' == chSide ) ? ( nMid + nTicks ) : ( nMid - nTicks ) );
+    };
+
+    while ( vDepth.size() < nMessages ) {
+
+      const ptime dt( dtBase + boost::posix_time::microseconds( vDepth.size() ) );
+      if ( 0 == rng() % 64 ) nMid += ( 0 == rng() % 2 ) ? 1 : -1;
+
+      // drop ids of orders gone by delete or clear
+      if ( vOrderId.size() > 2 * mapOrder.size() + 64 ) {
+        std::vector<uint64_t> v;
+        for ( const auto& pair: mapOrder ) v.push_back( pair.first );
+        vOrderId.swap( v );
+      }
+
+      const unsigned int nChoice( rng() % 1000 );
+      if ( mapOrder.size() < 40 || ( nChoice < 450 ) ) { // add
+        const char chSide( ( 0 == rng() % 2 ) ? 'A' : 'B' );
+        const Order order{ chSide, price( chSide ), ou::tf::Depth::volume_t( 1 + rng() % 20 ) };
+        mapOrder.emplace( ++idOrder, order );
+        vOrderId.push_back( idOrder );
+        vDepth.emplace_back( dt, dt, idOrder, idOrder, ( 0 == rng() % 20 ) ? '6' : '3', order.chSide, order.dblPrice, order.nQuantity );
+      }
+      else
+      if ( nChoice < 998 ) { // update or delete an order
+        const uint64_t id( vOrderId[ rng() % vOrderId.size() ] );
+        auto iter = mapOrder.find( id );
+        if ( mapOrder.end() == iter ) continue;
+        Order& order( iter->second );
+        if ( nChoice < 700 ) {
+          if ( 0 == rng() % 2 ) order.dblPrice = price( order.chSide );
+          else order.nQuantity = 1 + rng() % 20;
+          vDepth.emplace_back( dt, dt, id, id, '4', order.chSide, order.dblPrice, order.nQuantity );
+        }
+        else {
+          vDepth.emplace_back( dt, dt, id, 0, '5', order.chSide );
+          mapOrder.erase( iter );
+        }
+      }
+      else { // clear a side
+        const char chSide( ( 0 == rng() % 2 ) ? 'A' : 'B' );
+        vDepth.emplace_back( dt, dt, 0, 0, 'C', chSide );
+        for ( auto iter = mapOrder.begin(); mapOrder.end() != iter; ) {
+          if ( chSide == iter->second.chSide ) iter = mapOrder.erase( iter );
+          else ++iter;
+        }
+      }
+    }
+
+    return vDepth;
+  }
+
+  bool Exists( ou::tf::HDF5DataManager& dm, const std::string& sPath ) {
+    // one component at a time, hdf5 complains of a missing group along the path
+    std::string::size_type ix = 0;
+    while ( std::string::npos != ix ) {
+      ix = sPath.find( '/', ix + 1 );
+      const std::string sPart( sPath.substr( 0, ix ) );
+      if ( !dm.GetH5File()->nameExists( sPart ) ) return false;
+    }
+    return true;
+  }
+
+  vDepth_t Load( const std::string& sPrefix, const std::string& sSymbol ) {
+    const std::string sPath( sPrefix + ou::tf::DepthsByOrder::Directory() + sSymbol );
+    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
+    if ( !Exists( dm, sPath ) ) {
+      throw std::runtime_error( "no depth by order series at " + sPath );
+    }
+    ou::tf::HDF5TimeSeriesContainer<ou::tf::DepthByOrder> repository( dm, sPath );
+    ou::tf::HDF5TimeSeriesContainer<ou::tf::DepthByOrder>::iterator begin, end;
+    begin = repository.begin();
+    end = repository.end();
+    ou::tf::DepthsByOrder depths;
+    depths.Resize( end - begin );
+    repository.Read( begin, end, &depths );
+    vDepth_t vDepth;
+    vDepth.reserve( depths.Size() );
+    for ( ou::tf::DepthsByOrder::size_type ix = 0; ix < depths.Size(); ix++ ) vDepth.push_back( depths.At( ix ) );
+    return vDepth;
+  }
+
+  template<typename F>
+  double Seconds( F&& f ) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    return duration.count();
+  }
+
+  bool CompareBooks( const vDepth_t& vDepth ) {
+
+    vEvent_t vReference;
+    vReference.reserve( 3 * vDepth.size() );
+    Recorder recorderReference( vReference );
+    Reference reference( recorderReference );
+
+    const double dblReference = Seconds( [&](){
+      for ( size_t ix = 0; ix < vDepth.size(); ix++ ) {
+        recorderReference.Message( ix );
+        reference.MarketDepth( vDepth[ ix ] );
+      }
+    } );
+
+    vEvent_t vOrderBased;
+    vOrderBased.reserve( 3 * vDepth.size() );
+    Recorder recorderOrderBased( vOrderBased );
+    l2::OrderBased book;
+    book.Set( recorderOrderBased.Change( 'B' ), recorderOrderBased.Change( 'A' ) );
+    book.Set( recorderOrderBased.VolumeAtPrice( 'B' ), recorderOrderBased.VolumeAtPrice( 'A' ) );
+
+    const double dblOrderBased = Seconds( [&](){
+      for ( size_t ix = 0; ix < vDepth.size(); ix++ ) {
+        recorderOrderBased.Message( ix );
+        book.MarketDepth( vDepth[ ix ] );
+      }
+    } );
+
+    std::cout
+      << vDepth.size() << " messages, " << vReference.size() << " reference events, " << vOrderBased.size() << " order based events" << std::endl
+      << "reference " << dblReference << "s, order based " << dblOrderBased << "s" << std::endl;
+
+    const size_t n( std::min( vReference.size(), vOrderBased.size() ) );
+    for ( size_t ix = 0; ix < n; ix++ ) {
+      if ( !( vReference[ ix ] == vOrderBased[ ix ] ) ) {
+        std::cout
+          << "differ at event " << ix << std::endl
+          << "  reference:   " << vReference[ ix ] << std::endl
+          << "  order based: " << vOrderBased[ ix ] << std::endl;
+        return false;
+      }
+    }
+    if ( vReference.size() != vOrderBased.size() ) {
+      std::cout << "differ in event count" << std::endl;
+      return false;
+    }
+
+    std::cout << "identical" << std::endl;
+    return true;
+  }
+
+  // ==== decode
+
+  namespace OrderArrival = l2::msg::OrderArrival;
+  namespace OrderDelete = l2::msg::OrderDelete;
+
+  struct Tally {
+    size_t nLines {};
+    size_t nFast {}; // accepted by DecodeFast, and the same from the grammar
+    size_t nFallback {}; // refused by DecodeFast, accepted by the grammar
+    size_t nRefused {}; // refused by both
+    size_t nRounding {}; // grammar price one rounding off strtod, DecodeFast matched strtod
+    size_t nDiffer {};
+  };
+
+  // the grammar throws on a partial time or date
+  template<typename Parser, typename Decoded>
+  bool Grammar( Parser& parser, Decoded& out, const char* begin, const char* end ) {
+    try {
+      if constexpr ( std::is_same_v<Decoded, OrderArrival::decoded> ) return OrderArrival::Decode( parser, out, begin, end );
+      else return OrderDelete::Decode( parser, out, begin, end );
+    }
+    catch ( const boost::spirit::qi::expectation_failure<const char*>& ) {
+      return false;
+    }
+  }
+
+  template<typename Decoded>
+  bool Same( const Decoded& fast, const Decoded& grammar ) {
+    return ( fast.chMsgType == grammar.chMsgType ) && ( fast.SymbolName() == grammar.SymbolName() )
+      && ( fast.nOrderId == grammar.nOrderId ) && ( fast.mmid.id == grammar.mmid.id ) && ( fast.chOrderSide == grammar.chOrderSide )
+      && ( fast.time.hours == grammar.time.hours ) && ( fast.time.minutes == grammar.time.minutes )
+      && ( fast.time.seconds == grammar.time.seconds ) && ( fast.time.fractional == grammar.time.fractional )
+      && ( fast.date.year == grammar.date.year ) && ( fast.date.month == grammar.date.month ) && ( fast.date.day == grammar.date.day );
+  }
+
+  // compared through a copy, with the original overwritten, so the copy can't lean on the original's buffers
+  template<typename Decoded>
+  Decoded Copy( Decoded& decoded ) {
+    const Decoded copy( decoded );
+    decoded = Decoded();
+    decoded.sSymbolName.assign( 64, '#' );
+    return copy;
+  }
+
+  class Decoder {
+  public:
+
+    Decoder(): m_nShown {} {}
+
+    void Line( const std::string& sLine ) {
+      const char* begin( sLine.data() );
+      const char* end( begin + sLine.size() );
+      m_tally.nLines++;
+      if ( ( 0 < sLine.size() ) && ( '5' == sLine[ 0 ] ) ) {
+        OrderDelete::decoded fast, grammar;
+        const bool bFast( OrderDelete::DecodeFast( fast, begin, end ) );
+        const bool bGrammar( Grammar( m_parserDelete, grammar, begin, end ) );
+        const OrderDelete::decoded copy( Copy( grammar ) );
+        Count( sLine, bFast, bGrammar, bFast && bGrammar && Same( fast, copy ), false );
+      }
+      else {
+        OrderArrival::decoded fast, grammar;
+        const bool bFast( OrderArrival::DecodeFast( fast, begin, end ) );
+        const bool bGrammar( Grammar( m_parserArrival, grammar, begin, end ) );
+        const OrderArrival::decoded copy( Copy( grammar ) );
+        bool bSame( false );
+        bool bRounding( false );
+        if ( bFast && bGrammar ) {
+          bSame = Same( fast, copy )
+            && ( fast.nQuantity == copy.nQuantity ) && ( fast.nPriority == copy.nPriority )
+            && ( fast.nPrecision == copy.nPrecision );
+          if ( bSame && ( fast.dblPrice != copy.dblPrice ) ) {
+            // qi::double_ is not always correctly rounded, strtod is
+            bRounding = ( fast.dblPrice == Strtod( sLine ) );
+            bSame = bRounding;
+          }
+        }
+        Count( sLine, bFast, bGrammar, bSame, bRounding );
+      }
+    }
+
+    const Tally& Result() const { return m_tally; }
+
+  private:
+
+    Tally m_tally;
+    size_t m_nShown;
+
+    OrderArrival::parser_decoded<const char*> m_parserArrival;
+    OrderDelete::parser_decoded<const char*> m_parserDelete;
+
+    void Count( const std::string& sLine, bool bFast, bool bGrammar, bool bSame, bool bRounding ) {
+      if ( bFast ) {
+        if ( bSame ) {
+          m_tally.nFast++;
+          if ( bRounding ) m_tally.nRounding++;
+        }
+        else {
+          m_tally.nDiffer++;
+          if ( 10 > m_nShown++ ) {
+            std::cout << "differ" << ( bGrammar ? ": " : ", grammar refused: " ) << sLine << std::endl;
+          }
+        }
+      }
+      else {
+        if ( bGrammar ) m_tally.nFallback++;
+        else m_tally.nRefused++;
+      }
+    }
+
+    // the price is the sixth field of an arrival
+    static double Strtod( const std::string& sLine ) {
+      std::string::size_type ix {};
+      for ( int n = 0; n < 5; n++ ) ix = sLine.find( ',', ix ) + 1;
+      return std::strtod( sLine.c_str() + ix, nullptr );
+    }
+  };
+
+  // lines in the shape the feed sends, some mangled by a few character edits
+  void GenerateLines( size_t nLines, unsigned int seed, Decoder& decoder ) {
+
+    std::mt19937_64 rng( seed );
+    static const char* rSymbol[] = { "@ESZ26", "@NQZ26", "QQQ", "SPY", "TSLA", "QCLF27", "" };
+    static const char* rMMID[] = { "", "NSDQ", "AMEX", "MEMX", "CHXE", "ARCX", "Q" };
+    static const char rMangle[] = ",.:-+0123456789ABx ";
+
+    char szField[ 64 ];
+    std::string sLine;
+    sLine.reserve( 128 );
+
+    auto digits = [&]( int n ){
+      std::string s;
+      for ( int ix = 0; ix < n; ix++ ) s += char( '0' + rng() % 10 );
+      return s;
+    };
+
+    for ( size_t ixLine = 0; ixLine < nLines; ixLine++ ) {
+
+      const bool bDelete( 0 == rng() % 4 );
+      const bool bOrderId( 0 == rng() % 2 ); // futures carry an order id, equities a market maker
+
+      sLine.clear();
+      if ( bDelete ) sLine += '5';
+      else sLine += "6340"[ rng() % 4 ];
+      sLine += ',';
+      sLine += rSymbol[ rng() % 7 ];
+      sLine += ',';
+      if ( bOrderId ) sLine += std::to_string( 600000000000 + rng() % 100000000 );
+      sLine += ',';
+      if ( !bOrderId ) sLine += rMMID[ rng() % 7 ];
+      sLine += ',';
+      sLine += ( 0 == rng() % 2 ) ? 'A' : 'B';
+      sLine += ',';
+      if ( !bDelete ) {
+        const int nPrecision( rng() % 7 );
+        sLine += std::to_string( rng() % 100000 );
+        if ( 0 < nPrecision ) sLine += '.' + digits( nPrecision );
+        sLine += ',';
+        sLine += std::to_string( 1 + rng() % 1000 );
+        sLine += ',';
+        if ( bOrderId ) sLine += std::to_string( rng() % 100000000000 );
+        sLine += ',';
+        sLine += std::to_string( nPrecision );
+        sLine += ',';
+      }
+      if ( 0 != rng() % 8 ) {
+        std::snprintf( szField, sizeof( szField ), "%02u:%02u:%02u.%06u",
+          unsigned( rng() % 24 ), unsigned( rng() % 60 ), unsigned( rng() % 60 ), unsigned( rng() % 1000000 ) );
+        sLine += szField;
+      }
+      sLine += ',';
+      std::snprintf( szField, sizeof( szField ), "%04u-%02u-%02u",
+        unsigned( 2020 + rng() % 8 ), unsigned( 1 + rng() % 12 ), unsigned( 1 + rng() % 28 ) );
+      sLine += szField;
+      sLine += ',';
+
+      if ( 0 == rng() % 2 ) { // mangle
+        const int nEdits( 1 + rng() % 3 );
+        for ( int n = 0; ( n < nEdits ) && !sLine.empty(); n++ ) {
+          const std::string::size_type ix( rng() % sLine.size() );
+          const char ch( rMangle[ rng() % ( sizeof( rMangle ) - 1 ) ] );
+          switch ( rng() % 5 ) {
+            case 0: sLine.erase( ix, 1 ); break;
+            case 1: sLine.insert( ix, 1, ch ); break;
+            case 2: sLine[ ix ] = ch; break;
+            case 3: sLine.resize( ix ); break;
+            case 4: sLine.insert( ix, digits( 1 + rng() % 20 ) ); break; // overlong numbers
+          }
+        }
+      }
+
+      decoder.Line( sLine );
+    }
+  }
+
+  bool CompareDecoders( const Decoder& decoder ) {
+    const Tally& tally( decoder.Result() );
+    std::cout
+      << tally.nLines << " lines: "
+      << tally.nFast << " decoded the same (" << tally.nRounding << " with the grammar's price off by a rounding), "
+      << tally.nFallback << " left to the grammar, "
+      << tally.nRefused << " refused by both, "
+      << tally.nDiffer << " differ" << std::endl;
+    return 0 == tally.nDiffer;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const std::string sUsage(
+    "IQFeedLevel2Check book random <messages> [seed]\n"
+    "IQFeedLevel2Check book hdf5 <hdf5 prefix> <symbol>\n"
+    "IQFeedLevel2Check decode random <lines> [seed]\n"
+    "IQFeedLevel2Check decode file <file of feed lines>"
+  );
+
+  if ( 4 > argc ) {
+    std::cout << sUsage << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string sCommand( argv[ 1 ] );
+  const std::string sSource( argv[ 2 ] );
+
+  bool bSame( false );
+
+  try {
+    if ( ( "book" == sCommand ) && ( "random" == sSource ) ) {
+      bSame = CompareBooks( Generate( std::stoul( argv[ 3 ] ), ( 4 < argc ) ? std::stoul( argv[ 4 ] ) : 1 ) );
+    }
+    else
+    if ( ( "book" == sCommand ) && ( "hdf5" == sSource ) && ( 5 == argc ) ) {
+      bSame = CompareBooks( Load( argv[ 3 ], argv[ 4 ] ) );
+    }
+    else
+    if ( ( "decode" == sCommand ) && ( "random" == sSource ) ) {
+      Decoder decoder;
+      GenerateLines( std::stoul( argv[ 3 ] ), ( 4 < argc ) ? std::stoul( argv[ 4 ] ) : 1, decoder );
+      bSame = CompareDecoders( decoder );
+    }
+    else
+    if ( ( "decode" == sCommand ) && ( "file" == sSource ) ) {
+      std::ifstream ifs( argv[ 3 ] );
+      if ( !ifs ) throw std::runtime_error( std::string( "can not open " ) + argv[ 3 ] );
+      Decoder decoder;
+      std::string sLine;
+      while ( std::getline( ifs, sLine ) ) {
+        if ( !sLine.empty() && ( '\r' == sLine.back() ) ) sLine.pop_back();
+        decoder.Line( sLine );
+      }
+      bSame = CompareDecoders( decoder );
+    }
+    else {
+      std::cout << sUsage << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch ( const std::runtime_error& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch ( const H5::Exception& e ) {
+    std::cout << "hdf5: " << e.getDetailMsg() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return bSame ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -29,6 +29,8 @@ using namespace boost::gregorian;
 #include <OUCommon/ReadSicCodeList.h>
 #include <OUCommon/ReadNaicsToSicCodeList.h>
 
+#include <TFIQFeed/SymbolTable.h>
+
 #include "IQFeedMarketSymbols.h"
 
 IMPLEMENT_APP(AppIQFeedMarketSymbols)
@@ -156,6 +158,8 @@ void AppIQFeedMarketSymbols::HandleObtainNewIQFeedSymbolListRemote() {
   ou::tf::iqfeed::LoadMktSymbols( m_listIQFeedSymbols, ou::tf::iqfeed::MktSymbolLoadType::Download, true );
   std::cout << "Saving Binary File ... " << std::endl;
   m_listIQFeedSymbols.SaveToFile( ou::tf::iqfeed::detail::sFileNameMarketSymbolsBinary );
+  std::cout << "Saving Symbol Table ... " << std::endl;
+  ou::tf::iqfeed::SymbolTable::Write( m_listIQFeedSymbols, ou::tf::iqfeed::detail::sFileNameMarketSymbolsTable );
   std::cout << " ... done." << std::endl;
 }
 
@@ -173,6 +177,8 @@ void AppIQFeedMarketSymbols::HandleObtainNewIQFeedSymbolListLocal() {
   ou::tf::iqfeed::LoadMktSymbols( m_listIQFeedSymbols, ou::tf::iqfeed::MktSymbolLoadType::LoadTextFromDisk, false );
   std::cout << "Saving Binary File ... " << std::endl;
   m_listIQFeedSymbols.SaveToFile( ou::tf::iqfeed::detail::sFileNameMarketSymbolsBinary );
+  std::cout << "Saving Symbol Table ... " << std::endl;
+  ou::tf::iqfeed::SymbolTable::Write( m_listIQFeedSymbols, ou::tf::iqfeed::detail::sFileNameMarketSymbolsTable );
   std::cout << " ... done." << std::endl;
 }
 
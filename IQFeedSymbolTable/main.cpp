@@ -0,0 +1,190 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: IQFeedSymbolTable
+ * Created: 2026/10/16 21:48:05
+ */
+
+// converts the serialized market symbol list to a mapped symbol table, and compares the two:
+//   IQFeedSymbolTable convert <symbols.ser> <symbols.tbl>
+//   IQFeedSymbolTable bench   <symbols.ser> <symbols.tbl> [underlying]...
+// bench shows the load time and resident memory of each, times some queries, and checks every row matches,
+//   and the options selected by symbol, for underlyings listed and not
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include <TFIQFeed/SymbolTable.h>
+#include <TFIQFeed/InMemoryMktSymbolList.h>
+
+namespace {
+
+  using list_t = ou::tf::iqfeed::InMemoryMktSymbolList;
+  using table_t = ou::tf::iqfeed::SymbolTable;
+  using trd_t = list_t::trd_t;
+
+  double Resident() { // MB
+    std::ifstream ifs( "/proc/self/statm" );
+    size_t nSize {};
+    size_t nResident {};
+    ifs >> nSize >> nResident;
+    return double( nResident * ::sysconf( _SC_PAGESIZE ) ) / ( 1024.0 * 1024.0 );
+  }
+
+  template<typename F>
+  void Measure( const std::string& sName, F&& f ) {
+    const double dblResident( Resident() );
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    std::cout
+      << sName << ": " << duration.count() * 1000.0 << "ms, "
+      << Resident() - dblResident << "MB resident" << std::endl;
+  }
+
+  bool Equal( const trd_t& a, const trd_t& b ) {
+    return
+         ( a.sSymbol == b.sSymbol ) && ( a.sDescription == b.sDescription )
+      && ( a.sExchange == b.sExchange ) && ( a.sListedMarket == b.sListedMarket )
+      && ( a.sc == b.sc ) && ( a.nMultiplier == b.nMultiplier )
+      && ( a.nSIC == b.nSIC ) && ( a.nNAICS == b.nNAICS )
+      && ( a.sUnderlying == b.sUnderlying ) && ( a.eOptionSide == b.eOptionSide )
+      && ( a.dblStrike == b.dblStrike )
+      && ( a.nYear == b.nYear ) && ( a.nMonth == b.nMonth ) && ( a.nDay == b.nDay )
+      && ( a.bFrontMonth == b.bFrontMonth ) && ( a.bHasOptions == b.bHasOptions );
+  }
+
+  bool Bench( const std::string& sList, const std::string& sTable, std::vector<std::string> vUnderlying ) { // true when all match
+
+    std::unique_ptr<table_t> pTable;
+    Measure( "table open", [&](){ pTable = std::make_unique<table_t>( sTable ); } );
+
+    if ( vUnderlying.empty() ) { // equities with options, spread through the list
+      const table_t::range_t range( pTable->EqualRange<table_t::ixSymbolClass>( ou::tf::iqfeed::ESecurityType::Equity ) );
+      size_t ix {};
+      for ( table_t::iterator iter = range.first; range.second != iter; ++iter, ++ix ) {
+        const table_t::Row row( *iter );
+        if ( row.HasOptions() && ( 0 == ix % 97 ) ) vUnderlying.emplace_back( row.Symbol() );
+      }
+    }
+
+    size_t nTable {};
+    Measure( "table options by underlying, " + std::to_string( vUnderlying.size() ) + " underlying", [&](){
+      for ( const std::string& sUnderlying: vUnderlying ) {
+        pTable->SelectOptionsByUnderlying( sUnderlying, [&nTable]( const trd_t& ){ nTable++; } );
+      }
+    } );
+
+    list_t list;
+    Measure( "list load", [&](){ list.LoadFromFile( sList ); } );
+
+    size_t nList {};
+    Measure( "list options by underlying", [&](){
+      for ( const std::string& sUnderlying: vUnderlying ) {
+        list.SelectOptionsByUnderlying( sUnderlying, [&nList]( const trd_t& ){ nList++; } );
+      }
+    } );
+
+    std::cout << "options: " << nTable << " from the table, " << nList << " from the list" << std::endl;
+
+    // by symbol, each underlying, then underlyings of options which are not themselves in the table,
+    //   the list selects nothing for those
+    std::vector<std::string> vSymbol( vUnderlying );
+    {
+      const table_t::range_t range( pTable->EqualRange<table_t::ixSymbolClass>( ou::tf::iqfeed::ESecurityType::IEOption ) );
+      std::string sPrevious;
+      for ( table_t::iterator iter = range.first; range.second != iter; ++iter ) {
+        const table_t::Row row( *iter );
+        if ( row.Underlying() != sPrevious ) {
+          sPrevious = row.Underlying();
+          if ( !pTable->Exists( sPrevious ) ) vSymbol.emplace_back( sPrevious );
+        }
+      }
+    }
+    size_t nBySymbol {};
+    size_t nBySymbolDiffer {};
+    for ( const std::string& sSymbol: vSymbol ) {
+      size_t nFromTable {};
+      size_t nFromList {};
+      pTable->SelectOptionsBySymbol( sSymbol, [&nFromTable]( const trd_t& ){ nFromTable++; } );
+      list.SelectOptionsBySymbol( sSymbol, [&nFromList]( const trd_t& ){ nFromList++; } );
+      nBySymbol += nFromTable;
+      if ( nFromTable != nFromList ) nBySymbolDiffer++;
+    }
+    std::cout
+      << "options by symbol: " << vSymbol.size() - vUnderlying.size() << " underlying not listed, "
+      << nBySymbol << " from the table, " << nBySymbolDiffer << " symbols differ from the list" << std::endl;
+
+    size_t nRows {};
+    size_t nDiffer {};
+    Measure( "table GetTrd of every symbol, compared", [&](){
+      list.ScanSymbols( [&]( const trd_t& trd ){
+        nRows++;
+        if ( !Equal( trd, pTable->GetTrd( trd.sSymbol ) ) ) nDiffer++;
+      } );
+    } );
+    std::cout
+      << "rows: " << pTable->Size() << " in the table, " << list.Size() << " in the list, "
+      << nRows << " compared, " << nDiffer << " differ" << std::endl;
+
+    return ( 0 == nBySymbolDiffer ) && ( 0 == nDiffer );
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  if ( 4 > argc ) {
+    std::cout << "IQFeedSymbolTable convert|bench <symbols.ser> <symbols.tbl> [underlying]..." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string sCommand( argv[ 1 ] );
+  const std::string sList( argv[ 2 ] );
+  const std::string sTable( argv[ 3 ] );
+
+  try {
+    if ( "convert" == sCommand ) {
+      list_t list;
+      Measure( "list load", [&](){ list.LoadFromFile( sList ); } );
+      Measure( "table write", [&](){ table_t::Write( list, sTable ); } );
+      std::cout << list.Size() << " symbols" << std::endl;
+    }
+    else
+    if ( "bench" == sCommand ) {
+      if ( !Bench( sList, sTable, std::vector<std::string>( argv + 4, argv + argc ) ) ) return EXIT_FAILURE;
+    }
+    else {
+      std::cout << "unknown command " << sCommand << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch ( const std::exception& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
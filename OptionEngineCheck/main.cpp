@@ -0,0 +1,232 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: OptionEngineCheck
+ * Created: 2026/10/16 19:41:27
+ */
+
+// drives lib/TFOptions/Engine with quote bursts on a chain, and reports its statistics:
+//   OptionEngineCheck [threads] [strikes] [bursts] [pause us]
+// a local provider hands quotes to the watches, as a feed would, for an index and a call and a put at each strike
+//   before:  option quotes without an underlying quote, no greeks can be calculated, so no recalc is counted
+//   bursts:  the underlying moves beyond the tolerance, each option is requoted, then a pause, repeated
+// the exit status is EXIT_FAILURE when a recalc is counted before the underlying quote, or none after
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+#include <OUCommon/TimeSource.h>
+
+#include <TFTrading/Symbol.h>
+#include <TFTrading/ProviderInterface.h>
+
+#include <TFOptions/Engine.h>
+#include <TFOptions/Binomial.h>
+
+namespace {
+
+  class CheckSymbol: public ou::tf::Symbol<CheckSymbol> {
+  public:
+    CheckSymbol( const std::string& sName, pInstrument_t pInstrument )
+    : ou::tf::Symbol<CheckSymbol>( pInstrument, sName ) {}
+    void Inject( const ou::tf::Quote& quote ) { m_OnQuote( quote ); }
+    void Inject( const ou::tf::Trade& trade ) { m_OnTrade( trade ); }
+  };
+
+  // connects without a feed, the check supplies the quotes and trades through the symbols
+  class CheckProvider: public ou::tf::ProviderInterface<CheckProvider,CheckSymbol> {
+  public:
+    using inherited_t = ou::tf::ProviderInterface<CheckProvider,CheckSymbol>;
+    CheckProvider() {
+      m_sName = "check";
+      m_nID = ou::tf::keytypes::EProviderIQF; // NoRiskInterestRateSeries::SetWatchOn requires it
+      m_bProvidesQuotes = true;
+      m_bProvidesTrades = true;
+    }
+    void SetID( eidProvider_t id ) { m_nID = id; }
+    void Connect() override {
+      if ( !m_bConnected ) {
+        m_bConnected = true;
+        inherited_t::ConnectionComplete();
+        OnConnected( 0 );
+      }
+    }
+    void Disconnect() override {
+      if ( m_bConnected ) {
+        OnDisconnecting( 0 );
+        inherited_t::Disconnecting();
+        m_bConnected = false;
+        OnDisconnected( 0 );
+      }
+    }
+  protected:
+    pSymbol_t NewCSymbol( pInstrument_t pInstrument ) override {
+      pSymbol_t pSymbol( new CheckSymbol( pInstrument->GetInstrumentName( ID() ), pInstrument ) );
+      inherited_t::AddCSymbol( pSymbol );
+      return pSymbol;
+    }
+  };
+
+  namespace binomial = ou::tf::option::binomial;
+
+  using Engine = ou::tf::option::Engine;
+  using pInstrument_t = ou::tf::Instrument::pInstrument_t;
+  using pOption_t = ou::tf::option::Option::pOption_t;
+  using pWatch_t = ou::tf::Watch::pWatch_t;
+
+  const double c_dblRate( 4.5 ); // percent, as the rate series quotes it
+  const double c_dblVolatility( 0.20 );
+  const double c_dblHalfSpread( 0.05 );
+  const int c_nDaysToExpiry( 45 );
+  const double c_rUnderlying[ 2 ] = { 4000.0, 4004.0 }; // alternates, 0.1% apart, beyond the default tolerance
+
+  struct Leg {
+    pOption_t pOption;
+    CheckProvider::pSymbol_t pSymbol;
+    double rPrice[ 2 ]; // option at each underlying level
+  };
+
+  using vLeg_t = std::vector<Leg>;
+
+  ou::tf::Quote MakeQuote( double price ) {
+    return ou::tf::Quote( ou::TimeSource::GlobalInstance().External(), price - c_dblHalfSpread, 10, price + c_dblHalfSpread, 10 );
+  }
+
+  // waits for the engine to drain:  nothing dirty, and the recalc count steady over several polls
+  Engine::Stats Settle( Engine& engine ) {
+    Engine::Stats stats( engine.GetStats() );
+    size_t nQuiet {};
+    while ( 5 > nQuiet ) {
+      std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+      const Engine::Stats next( engine.GetStats() );
+      if ( ( 0 == next.nDirty ) && ( next.nRecalc == stats.nRecalc ) ) nQuiet++;
+      else nQuiet = 0;
+      stats = next;
+    }
+    return stats;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nThreads( ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 1 );
+  const size_t nStrikes( ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 250 );
+  const size_t nBursts( ( 3 < argc ) ? std::stoul( argv[ 3 ] ) : 200 );
+  const size_t nPause( ( 4 < argc ) ? std::stoul( argv[ 4 ] ) : 1000 );
+
+  std::shared_ptr<CheckProvider> pCheckProvider( std::make_shared<CheckProvider>() );
+  ou::tf::ProviderInterfaceBase::pProvider_t pProvider( pCheckProvider );
+
+  // a watch started on a provider other than iqfeed prints a line for its instrument, held back during the set up
+  std::streambuf* pCout( std::cout.rdbuf( nullptr ) );
+
+  ou::tf::FedRateFromIQFeed fedrate;
+  fedrate.SetWatchOn( pProvider );
+  pCheckProvider->SetID( ou::tf::keytypes::EProviderUserBase ); // a watch casts an iqfeed provider to the real one
+  pCheckProvider->Connect();
+  for ( const char* szRate: { "TB30.X", "TB90.X", "TB180.X", "1YCMY.X" } ) {
+    pCheckProvider->GetSymbol( std::string( szRate ) )->Inject( ou::tf::Trade( ou::TimeSource::GlobalInstance().External(), c_dblRate, 1 ) );
+  }
+
+  pInstrument_t pInstrumentUnderlying( std::make_shared<ou::tf::Instrument>( "SPX", ou::tf::InstrumentType::Index, "CBOE" ) );
+  pWatch_t pUnderlying( std::make_shared<ou::tf::Watch>( pInstrumentUnderlying, pProvider ) );
+
+  const boost::posix_time::ptime dtExpiry( ou::TimeSource::GlobalInstance().External() + boost::gregorian::days( c_nDaysToExpiry ) );
+
+  vLeg_t vLeg;
+  for ( size_t ix = 0; ix < nStrikes; ++ix ) {
+    const double strike( c_rUnderlying[ 0 ] - double( nStrikes ) + 2.0 * double( ix ) ); // 2 point strikes around the money
+    for ( const ou::tf::OptionSide::EOptionSide side: { ou::tf::OptionSide::Call, ou::tf::OptionSide::Put } ) {
+      const std::string sName( "SPX" + std::string( ou::tf::OptionSide::Call == side ? "C" : "P" ) + std::to_string( (int) strike ) );
+      pInstrument_t pInstrument( std::make_shared<ou::tf::Instrument>( sName, ou::tf::InstrumentType::Option, "CBOE", dtExpiry, side, strike ) );
+      Leg leg;
+      leg.pOption = std::make_shared<ou::tf::option::Option>( pInstrument, pProvider );
+      leg.pSymbol = pCheckProvider->Add( pInstrument );
+      for ( size_t state = 0; state < 2; ++state ) {
+        binomial::structInput input;
+        input.optionSide = side;
+        input.S = c_rUnderlying[ state ];
+        input.X = strike;
+        input.T = double( c_nDaysToExpiry ) / 365.0;
+        input.r = input.b = c_dblRate / 100.0;
+        input.v = c_dblVolatility;
+        binomial::structOutput output;
+        binomial::CRR( input, output );
+        leg.rPrice[ state ] = std::max( output.option, 2.0 * c_dblHalfSpread );
+      }
+      vLeg.emplace_back( std::move( leg ) );
+    }
+  }
+
+  size_t nFail {};
+  {
+    Engine engine( fedrate, nThreads );
+
+    engine.RegisterUnderlying( pUnderlying );
+    for ( const Leg& leg: vLeg ) {
+      engine.RegisterOption( leg.pOption );
+      engine.Add( leg.pOption, pUnderlying );
+    }
+    CheckProvider::pSymbol_t pSymbolUnderlying( pCheckProvider->GetSymbol( pInstrumentUnderlying ) );
+    while ( vLeg.size() != engine.GetStats().nEntries ) std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    std::cout.rdbuf( pCout );
+
+    std::cout << "threads " << nThreads << ", options " << vLeg.size() << ", bursts " << nBursts << ", pause " << nPause << "us" << std::endl;
+
+    for ( const Leg& leg: vLeg ) leg.pSymbol->Inject( MakeQuote( leg.rPrice[ 0 ] ) );
+    const Engine::Stats statsBefore( Settle( engine ) );
+    std::cout << "before the underlying: " << statsBefore.nRecalc << " recalcs" << std::endl;
+    if ( 0 != statsBefore.nRecalc ) nFail++;
+
+    const auto begin( std::chrono::steady_clock::now() );
+    for ( size_t burst = 0; burst < nBursts; ++burst ) {
+      const size_t state( ( burst + 1 ) % 2 );
+      pSymbolUnderlying->Inject( MakeQuote( c_rUnderlying[ state ] ) );
+      for ( const Leg& leg: vLeg ) leg.pSymbol->Inject( MakeQuote( leg.rPrice[ state ] ) );
+      std::this_thread::sleep_for( std::chrono::microseconds( nPause ) );
+    }
+    const Engine::Stats stats( Settle( engine ) );
+    const double dblSeconds( std::chrono::duration<double>( std::chrono::steady_clock::now() - begin ).count() );
+
+    std::cout
+      << std::fixed << std::setprecision( 2 )
+      << "bursts: " << stats.nRecalc << " recalcs for " << nBursts * ( vLeg.size() + 1 ) << " quotes"
+      << ", " << dblSeconds << "s with the settle time, " << (double) stats.nRecalc / dblSeconds << "/s"
+      << std::endl
+      << "operation queue max " << stats.nOperationQueueDepthMax
+      << ", dirty max " << stats.nDirtyMax
+      << ", latency avg " << stats.dblLatencyAvgMs << "ms"
+      << ", max " << stats.dblLatencyMaxMs << "ms"
+      << std::endl;
+    if ( 0 == stats.nRecalc ) nFail++;
+
+    for ( const Leg& leg: vLeg ) engine.Remove( leg.pOption, pUnderlying );
+    while ( 0 != engine.GetStats().nEntries ) std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+  }
+
+  pCheckProvider->Disconnect();
+
+  return ( 0 == nFail ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
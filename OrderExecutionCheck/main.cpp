@@ -0,0 +1,285 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: OrderExecutionCheck
+ * Created: 2026/10/16 22:17:03
+ */
+
+// drives the simulated exchange, lib/TFSimulation/SimulateOrderExecution, with a market maker, and times it:
+//   OrderExecutionCheck [steps] [delay ms]
+// each step moves the market:  a quote, a trade each fourth step, and in the depth mode, four depth by order events,
+//   then the market maker keeps a ladder of limit orders on each side, K levels deep, cancelling and replacing
+//   the orders whose level has moved, or which have filled
+// each mode, default fills, queue position fills, and queue position with depth by order, runs with K of 5, 25, and 100
+// every submitted order must end filled, cancelled, or live, and no cancel may be left unanswered a second after it
+//   was made, the exit status is EXIT_FAILURE otherwise
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+
+#include <boost/log/core.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+#include <OUCommon/TimeSource.h>
+
+#include <TFTrading/Order.h>
+#include <TFTrading/Instrument.h>
+
+#include <TFSimulation/SimulateOrderExecution.h>
+
+namespace {
+
+  using ptime = boost::posix_time::ptime;
+  using idOrder_t = ou::tf::Order::idOrder_t;
+
+  enum class EMode { Default, Queue, QueueDepth };
+
+  class MarketMaker {
+  public:
+
+    struct Counts {
+      unsigned long nEvents;
+      unsigned long nSubmits;
+      unsigned long nCancels;
+      unsigned long nFills;
+      unsigned long nFilled;    // orders filled completely
+      unsigned long nCancelled;
+      unsigned long nNotFound;  // cancels for orders which filled first
+      Counts(): nEvents {}, nSubmits {}, nCancels {}, nFills {}, nFilled {}, nCancelled {}, nNotFound {} {}
+    };
+
+    MarketMaker( EMode mode, size_t nLevels, long nDelayMs )
+    : m_nLevels( nLevels ), m_idNext( 1 )
+    , m_pInstrument( std::make_shared<ou::tf::Instrument>( "SYM", ou::tf::InstrumentType::Stock, "SMART" ) )
+    , m_vBid( nLevels ), m_vAsk( nLevels )
+    {
+      m_oe.SetOnOrderFill( MakeDelegate( this, &MarketMaker::HandleFill ) );
+      m_oe.SetOnOrderCancelled( MakeDelegate( this, &MarketMaker::HandleCancelled ) );
+      m_oe.SetOnNoOrderFound( MakeDelegate( this, &MarketMaker::HandleNotFound ) );
+      m_oe.SetOrderDelay( boost::posix_time::milliseconds( nDelayMs ) );
+      m_oe.SetQueuePosition( EMode::Default != mode );
+    }
+
+    ou::tf::sim::OrderExecution& Exchange() { return m_oe; }
+    const Counts& GetCounts() const { return m_counts; }
+    void Event() { m_counts.nEvents++; }
+
+    // replaces the orders whose level has moved, or which are gone
+    void Ladder( long tickBid, long tickAsk, ptime dt ) {
+      for ( size_t level = 0; level < m_nLevels; ++level ) {
+        Keep( m_vBid[ level ], ou::tf::OrderSide::Buy, tickBid - level, dt );
+        Keep( m_vAsk[ level ], ou::tf::OrderSide::Sell, tickAsk + level, dt );
+      }
+    }
+
+    size_t Live() const { return m_mapOrder.size(); }
+
+    // cancels made before dt, and not yet answered
+    size_t Unanswered( ptime dt ) const {
+      size_t n {};
+      for ( const mapCancel_t::value_type& vt: m_mapCancel ) {
+        if ( vt.second < dt ) n++;
+      }
+      return n;
+    }
+
+  private:
+
+    struct Rung {
+      idOrder_t id;
+      long tick;
+      Rung(): id {}, tick {} {}
+    };
+    using vRung_t = std::vector<Rung>;
+
+    using mapOrder_t = std::unordered_map<idOrder_t, ou::tf::Order::pOrder_t>;
+    using mapCancel_t = std::unordered_map<idOrder_t, ptime>;
+
+    ou::tf::sim::OrderExecution m_oe;
+
+    const size_t m_nLevels;
+    idOrder_t m_idNext;
+    ou::tf::Instrument::pInstrument_t m_pInstrument;
+
+    vRung_t m_vBid;
+    vRung_t m_vAsk;
+
+    mapOrder_t m_mapOrder;   // orders submitted, and not filled or cancelled
+    mapCancel_t m_mapCancel; // cancels made, and when
+
+    Counts m_counts;
+
+    void Keep( Rung& rung, ou::tf::OrderSide::EOrderSide side, long tick, ptime dt ) {
+      const bool bLive( m_mapOrder.end() != m_mapOrder.find( rung.id ) );
+      if ( bLive && ( tick == rung.tick ) ) return;
+      if ( bLive && ( m_mapCancel.end() == m_mapCancel.find( rung.id ) ) ) {
+        m_mapCancel.emplace( rung.id, dt );
+        m_oe.CancelOrder( rung.id );
+        m_counts.nCancels++;
+      }
+      rung.id = Submit( side, tick, dt );
+      rung.tick = tick;
+    }
+
+    idOrder_t Submit( ou::tf::OrderSide::EOrderSide side, long tick, ptime dt ) {
+      const idOrder_t id( m_idNext++ );
+      const ou::tf::Order::TableRowDef row(
+        id, 0, m_pInstrument->GetInstrumentName(), "",
+        ou::tf::OrderStatus::Created, ou::tf::OrderType::Limit, side,
+        0.01 * tick, 0.0, 0.0, 100, 100, 0, 0.0, 0.0,
+        dt, boost::posix_time::not_a_date_time, boost::posix_time::not_a_date_time );
+      ou::tf::Order::pOrder_t pOrder( std::make_shared<ou::tf::Order>( row, m_pInstrument ) );
+      pOrder->SetSendingToProvider();
+      m_mapOrder.emplace( id, pOrder );
+      m_oe.SubmitOrder( pOrder );
+      m_counts.nSubmits++;
+      return id;
+    }
+
+    void HandleFill( idOrder_t id, const ou::tf::Execution& exec ) {
+      m_counts.nFills++;
+      mapOrder_t::iterator iter( m_mapOrder.find( id ) );
+      if ( m_mapOrder.end() != iter ) {
+        iter->second->ReportExecution( exec );
+        if ( 0 == iter->second->GetQuanRemaining() ) {
+          m_counts.nFilled++;
+          m_mapOrder.erase( iter );
+        }
+      }
+    }
+
+    void HandleCancelled( idOrder_t id ) {
+      m_counts.nCancelled++;
+      m_mapOrder.erase( id );
+      m_mapCancel.erase( id );
+    }
+
+    void HandleNotFound( idOrder_t id ) {
+      m_counts.nNotFound++;
+      m_mapCancel.erase( id );
+    }
+  };
+
+  const char* Name( EMode mode ) {
+    switch ( mode ) {
+      case EMode::Default: return "default";
+      case EMode::Queue: return "queue";
+      default: return "queue+depth";
+    }
+  }
+
+  size_t Run( EMode mode, size_t nLevels, size_t nSteps, long nDelayMs ) {
+
+    ou::TimeSource& ts( ou::TimeSource::GlobalInstance() );
+    MarketMaker mm( mode, nLevels, nDelayMs );
+    ou::tf::sim::OrderExecution& oe( mm.Exchange() );
+
+    unsigned int seed( 7 );
+    long mid( 10000 ); // ticks
+    ptime dt( boost::gregorian::date( 2026, 1, 5 ), boost::posix_time::time_duration( 14, 30, 0 ) );
+
+    using market_t = std::pair<ou::tf::DepthByOrder::idorder_t, std::pair<char, long> >; // id, side, tick
+    std::vector<market_t> vMarket; // the market's resting orders, in the depth mode
+    ou::tf::DepthByOrder::idorder_t idMarket( 1 );
+
+    const auto begin( std::chrono::steady_clock::now() );
+    for ( size_t step = 0; step < nSteps; ++step ) {
+
+      dt += boost::posix_time::microseconds( 500 + rand_r( &seed ) % 1500 );
+      ts.ForceSimulationTime( dt );
+      const int move( rand_r( &seed ) % 8 );
+      if ( 0 == move ) mid--;
+      else if ( 1 == move ) mid++;
+      const long tickBid( mid );
+      const long tickAsk( mid + 1 );
+
+      if ( EMode::QueueDepth == mode ) { // adds and deletes near the touch
+        for ( size_t n = 0; n < 4; ++n ) {
+          if ( ( 200 > vMarket.size() ) || ( rand_r( &seed ) & 1 ) ) {
+            const bool bAsk( rand_r( &seed ) & 1 );
+            const long tick( bAsk ? ( tickAsk + rand_r( &seed ) % 10 ) : ( tickBid - rand_r( &seed ) % 10 ) );
+            const ou::tf::DepthByOrder depth( dt, dt, idMarket, idMarket, '3', bAsk ? 'A' : 'B', 0.01 * tick, 100 + rand_r( &seed ) % 400 );
+            oe.NewDepthByOrder( depth );
+            vMarket.push_back( market_t( idMarket++, std::make_pair( bAsk ? 'A' : 'B', tick ) ) );
+          }
+          else {
+            const size_t ix( rand_r( &seed ) % vMarket.size() );
+            const ou::tf::DepthByOrder depth( dt, dt, vMarket[ ix ].first, 0, '5', vMarket[ ix ].second.first );
+            oe.NewDepthByOrder( depth );
+            vMarket[ ix ] = vMarket.back();
+            vMarket.pop_back();
+          }
+          mm.Event();
+        }
+      }
+
+      oe.NewQuote( ou::tf::Quote( dt, 0.01 * tickBid, 100 + rand_r( &seed ) % 500, 0.01 * tickAsk, 100 + rand_r( &seed ) % 500 ) );
+      mm.Event();
+      if ( 0 == step % 4 ) {
+        oe.NewTrade( ou::tf::Trade( dt, 0.01 * ( ( rand_r( &seed ) & 1 ) ? tickBid : tickAsk ), 100 + rand_r( &seed ) % 400 ) );
+        mm.Event();
+      }
+
+      mm.Ladder( tickBid, tickAsk, dt );
+    }
+    const double dblSeconds( std::chrono::duration<double>( std::chrono::steady_clock::now() - begin ).count() );
+
+    const MarketMaker::Counts& counts( mm.GetCounts() );
+    const unsigned long nOrders( counts.nSubmits + counts.nCancels );
+    const size_t nUnanswered( mm.Unanswered( dt - boost::posix_time::seconds( 1 ) ) );
+    const bool bAccounted( counts.nSubmits == counts.nFilled + counts.nCancelled + mm.Live() );
+
+    std::cout
+      << std::left << std::setw( 11 ) << Name( mode ) << std::right << " K " << std::setw( 3 ) << nLevels << ": "
+      << std::fixed << std::setprecision( 2 ) << ( counts.nEvents + nOrders ) / dblSeconds / 1e6 << "M events+orders/s"
+      << ", " << dblSeconds << "s"
+      << std::setprecision( 0 )
+      << ", submits " << counts.nSubmits << ", cancels " << counts.nCancels
+      << ", fills " << counts.nFills << ", live " << mm.Live();
+    if ( 0 != nUnanswered ) std::cout << ", " << nUnanswered << " cancels unanswered";
+    if ( !bAccounted ) std::cout << ", orders unaccounted for";
+    std::cout << std::endl;
+    std::cout.unsetf( std::ios::fixed );
+
+    return ( bAccounted && ( 0 == nUnanswered ) ) ? 0 : 1;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nSteps( ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 100000 );
+  const long nDelayMs( ( 2 < argc ) ? std::stol( argv[ 2 ] ) : 5 );
+
+  // the simulated order flow is logged at info, a line per event, which would be the most of the time
+  boost::log::core::get()->set_filter( boost::log::trivial::severity >= boost::log::trivial::warning );
+
+  size_t nFail {};
+  for ( const EMode mode: { EMode::Default, EMode::Queue, EMode::QueueDepth } ) {
+    for ( const size_t nLevels: { 5, 25, 100 } ) {
+      nFail += Run( mode, nLevels, nSteps, nDelayMs );
+    }
+  }
+
+  return ( 0 == nFail ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
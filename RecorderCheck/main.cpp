@@ -0,0 +1,249 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: RecorderCheck
+ * Created: 2026/10/16 22:14:37
+ */
+
+// times the Collector's Recorder, and checks its journal replay:
+//   RecorderCheck [datums per stream] [symbols]
+// streams are recorded to TradeFrame.hdf5 in the current directory, under /app/RecorderCheck,
+//   with a quote, a trade and a depth stream per symbol, appended from two threads, as the Collector does
+//   clean:   append, then destroy the Recorder, every datum must be in its dataset, and the journal removed
+//   killed:  a child process appends, and is killed as soon as it has appended, while its writer is behind,
+//            then a tail is appended to the journal, with a length too large for a record, or a length running
+//            past the end of the file, Start must replay every datum, stop at the tail, and remove the journal
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesContainer.h>
+
+#include "../Collector/Recorder.hpp"
+
+namespace {
+
+  const std::string c_sRoot( "/app/RecorderCheck" );
+  const std::string c_sJournal( "RecorderCheck.journal" );
+
+  // whole chunks at 16k datums, the rest after 2s, so a kill leaves most of the datums in the journal only
+  const Recorder::Policy c_policy { 16 * 1024, boost::posix_time::seconds( 2 ), 1024, 1024 * 1024 };
+
+  const boost::posix_time::ptime c_dtStart( boost::gregorian::date( 2026, 1, 5 ), boost::posix_time::hours( 14 ) );
+
+  std::string Path( size_t ixSymbol, Recorder::EType eType ) {
+    static const char* rszType[] = { "", "/quotes/", "/trades/", "/depths_o/" };
+    return c_sRoot + rszType[ static_cast<size_t>( eType ) ] + "SYM" + std::to_string( ixSymbol );
+  }
+
+  void Remove() { // from an earlier run
+    std::remove( c_sJournal.c_str() );
+    std::remove( ( c_sJournal + ".prev" ).c_str() );
+    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
+    const hid_t idFile( dm.GetH5File()->getId() );
+    if ( ( 0 < H5Lexists( idFile, "/app", H5P_DEFAULT ) ) && ( 0 < H5Lexists( idFile, c_sRoot.c_str(), H5P_DEFAULT ) ) ) {
+      H5Ldelete( idFile, c_sRoot.c_str(), H5P_DEFAULT );
+    }
+    dm.Flush();
+  }
+
+  using vStream_t = std::vector<Recorder::ixStream_t>;
+
+  vStream_t Register( Recorder& recorder, size_t nSymbols ) {
+    vStream_t vStream;
+    for ( size_t ix = 0; ix < nSymbols; ++ix ) {
+      for ( const Recorder::EType eType: { Recorder::EType::Quote, Recorder::EType::Trade, Recorder::EType::DepthByOrder } ) {
+        vStream.push_back( recorder.Register( { eType, Path( ix, eType ), 1, 2, ou::tf::keytypes::EProviderIQF } ) );
+      }
+    }
+    return vStream;
+  }
+
+  // datum n of each stream is stamped c_dtStart + n us, level 1 from one thread, level 2 from another
+  void Append( Recorder& recorder, const vStream_t& vStream, size_t nDatums ) {
+    const size_t nSymbols( vStream.size() / 3 );
+    std::thread threadL1( [&](){
+      for ( size_t n = 0; n < nDatums; ++n ) {
+        const boost::posix_time::ptime dt( c_dtStart + boost::posix_time::microseconds( n ) );
+        for ( size_t ix = 0; ix < nSymbols; ++ix ) {
+          recorder.Append( vStream[ 3 * ix + 0 ], ou::tf::Quote( dt, n, 1, n + 1, 1 ) );
+          recorder.Append( vStream[ 3 * ix + 1 ], ou::tf::Trade( dt, n, 1 ) );
+        }
+      }
+    } );
+    std::thread threadL2( [&](){
+      for ( size_t n = 0; n < nDatums; ++n ) {
+        const boost::posix_time::ptime dt( c_dtStart + boost::posix_time::microseconds( n ) );
+        for ( size_t ix = 0; ix < nSymbols; ++ix ) {
+          recorder.Append( vStream[ 3 * ix + 2 ], ou::tf::DepthByOrder( dt, dt, n, n, '3', 'A', n, 1 ) );
+        }
+      }
+    } );
+    threadL1.join();
+    threadL2.join();
+  }
+
+  template<typename DD>
+  size_t Check( ou::tf::HDF5DataManager& dm, const std::string& sPath, size_t nDatums ) {
+    ou::tf::HDF5TimeSeriesContainer<DD> container( dm, sPath );
+    if ( nDatums != container.size() ) {
+      std::cout << "  " << sPath << ": " << container.size() << " of " << nDatums << " datums" << std::endl;
+      return 1;
+    }
+    std::vector<DD> vDatum( nDatums );
+    if ( 0 < nDatums ) {
+      hsize_t nCount( nDatums );
+      H5::DataSpace ds( 1, &nCount );
+      static_cast<ou::tf::HDF5TimeSeriesAccessor<DD>&>( container ).Read( 0, nDatums, &ds, vDatum.data() );
+    }
+    for ( size_t n = 0; n < nDatums; ++n ) {
+      if ( c_dtStart + boost::posix_time::microseconds( n ) != vDatum[ n ].DateTime() ) {
+        std::cout << "  " << sPath << ": datum " << n << " at " << vDatum[ n ].DateTime() << std::endl;
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  size_t Check( size_t nSymbols, size_t nDatums ) {
+    size_t nFail {};
+    std::FILE* pFile( std::fopen( c_sJournal.c_str(), "rb" ) );
+    if ( nullptr != pFile ) {
+      std::fclose( pFile );
+      std::cout << "  journal not removed" << std::endl;
+      nFail++;
+    }
+    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
+    for ( size_t ix = 0; ix < nSymbols; ++ix ) {
+      nFail += Check<ou::tf::Quote>( dm, Path( ix, Recorder::EType::Quote ), nDatums );
+      nFail += Check<ou::tf::Trade>( dm, Path( ix, Recorder::EType::Trade ), nDatums );
+      nFail += Check<ou::tf::DepthByOrder>( dm, Path( ix, Recorder::EType::DepthByOrder ), nDatums );
+    }
+    return nFail;
+  }
+
+  double Seconds( std::chrono::steady_clock::time_point begin ) {
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - begin ).count();
+  }
+
+  size_t Clean( size_t nSymbols, size_t nDatums ) {
+    Remove();
+    const size_t nTotal( 3 * nSymbols * nDatums );
+    const auto begin( std::chrono::steady_clock::now() );
+    double dblAppended;
+    {
+      Recorder recorder( c_sJournal, c_policy );
+      recorder.Start();
+      const vStream_t vStream( Register( recorder, nSymbols ) );
+      Append( recorder, vStream, nDatums );
+      dblAppended = Seconds( begin );
+    }
+    const double dblWritten( Seconds( begin ) );
+    const size_t nFail( Check( nSymbols, nDatums ) );
+    std::cout
+      << "clean: " << nTotal << " datums, appended " << nTotal / dblAppended / 1e6 << "M datums/s, written "
+      << nTotal / dblWritten / 1e6 << "M datums/s" << ( ( 0 == nFail ) ? "" : ", FAILED" )
+      << std::endl;
+    return nFail;
+  }
+
+  size_t Killed( size_t nSymbols, size_t nDatums, const char* szTail, uint32_t nTailSize ) {
+    Remove();
+
+    int rfd[ 2 ];
+    if ( 0 != pipe( rfd ) ) throw std::runtime_error( "RecorderCheck: no pipe" );
+    const pid_t pid( fork() );
+    if ( 0 == pid ) { // the recorder in the child, with no clean exit
+      Recorder* pRecorder = new Recorder( c_sJournal, c_policy );
+      pRecorder->Start();
+      const vStream_t vStream( Register( *pRecorder, nSymbols ) );
+      Append( *pRecorder, vStream, nDatums );
+      const char ch( 'x' );
+      if ( 1 == write( rfd[ 1 ], &ch, 1 ) ) pause();
+      _exit( EXIT_FAILURE );
+    }
+    char ch;
+    const ssize_t nRead( read( rfd[ 0 ], &ch, 1 ) );
+    kill( pid, SIGKILL );
+    waitpid( pid, nullptr, 0 );
+    close( rfd[ 0 ] );
+    close( rfd[ 1 ] );
+    if ( 1 != nRead ) throw std::runtime_error( "RecorderCheck: the child did not append" );
+
+    std::FILE* pFile( std::fopen( c_sJournal.c_str(), "ab" ) );
+    const char rTail[ 16 ] = {};
+    std::fwrite( &nTailSize, sizeof( uint32_t ), 1, pFile );
+    std::fwrite( rTail, sizeof( rTail ), 1, pFile );
+    std::fclose( pFile );
+
+    size_t nFail {};
+    const auto begin( std::chrono::steady_clock::now() );
+    try {
+      Recorder recorder( c_sJournal, c_policy );
+      recorder.Start();
+    }
+    catch ( const std::exception& e ) {
+      std::cout << "  " << e.what() << std::endl;
+      nFail++;
+    }
+    const double dblReplay( Seconds( begin ) );
+    nFail += Check( nSymbols, nDatums );
+    std::cout
+      << "killed, " << szTail << ": replayed in " << dblReplay << "s" << ( ( 0 == nFail ) ? "" : ", FAILED" )
+      << std::endl;
+    return nFail;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nDatums( ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 50000 );
+  const size_t nSymbols( ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 12 );
+
+  if ( 0 == nSymbols ) {
+    std::cout << "RecorderCheck [datums per stream] [symbols]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  H5::Exception::dontPrint();
+
+  size_t nFail {};
+  try {
+    nFail += Clean( nSymbols, nDatums );
+    nFail += Killed( nSymbols, nDatums, "length too large", 0xfffffff0 );
+    nFail += Killed( nSymbols, nDatums, "length past the end", 64 );
+  }
+  catch ( const std::exception& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  Remove();
+
+  return ( 0 == nFail ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
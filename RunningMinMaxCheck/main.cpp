@@ -0,0 +1,242 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: RunningMinMaxCheck
+ * Created: 2026/10/16 18:51:27
+ */
+
+// runs the Monotonic and Map storage policies of RunningMinMax side by side over a sliding window:
+//   RunningMinMaxCheck <steps> [seed]
+// each step adds a value, then expires the values older than the window, as TSSWStochastic does,
+// min and max, and the values handed to UpdateOnAdd and UpdateOnDel, are compared after every Add and Remove,
+// then each policy is timed over a fixed window of 10, 1000, and 100000 values
+
+#include <cmath>
+#include <deque>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <TFIndicators/RunningMinMax.h>
+
+namespace {
+
+  template<typename value_t>
+  struct Callback { // the last UpdateOnAdd / UpdateOnDel
+    bool bCalled;
+    value_t min;
+    value_t max;
+    Callback(): bCalled( false ), min {}, max {} {}
+    bool operator==( const Callback& rhs ) const { return ( bCalled == rhs.bCalled ) && ( min == rhs.min ) && ( max == rhs.max ); }
+  };
+
+  template<typename value_t, typename Storage>
+  class MinMax: public ou::tf::RunningMinMax<MinMax<value_t,Storage>,value_t,Storage> {
+    friend ou::tf::RunningMinMax<MinMax<value_t,Storage>,value_t,Storage>;
+  public:
+    Callback<value_t> add;
+    Callback<value_t> del;
+    void Clear() { add = del = Callback<value_t>(); }
+  protected:
+    void UpdateOnAdd( const value_t min, const value_t max ) { add.bCalled = true; add.min = min; add.max = max; }
+    void UpdateOnDel( const value_t min, const value_t max ) { del.bCalled = true; del.min = min; del.max = max; }
+  };
+
+  template<typename value_t>
+  class Check {
+  public:
+
+    using map_t = MinMax<value_t,ou::tf::runningminmax::Map<value_t> >;
+    using monotonic_t = MinMax<value_t,ou::tf::runningminmax::Monotonic<value_t> >;
+
+    Check( const std::string& sName ): m_sName( sName ), m_nCompares {}, m_nDiffer {} {}
+
+    void Add( const value_t value ) {
+      m_map.Clear();
+      m_monotonic.Clear();
+      m_map.Add( value );
+      m_monotonic.Add( value );
+      m_window.push_back( value );
+      Compare( "Add" );
+    }
+
+    void Expire() { // the oldest value
+      m_map.Clear();
+      m_monotonic.Clear();
+      m_map.Remove( m_window.front() );
+      m_monotonic.Remove( m_window.front() );
+      m_window.pop_front();
+      Compare( "Remove" );
+    }
+
+    void Reset() {
+      m_map.Reset();
+      m_monotonic.Reset();
+      m_window.clear();
+    }
+
+    size_t Window() const { return m_window.size(); }
+
+    void Emit() const {
+      std::cout << m_sName << ": " << m_nCompares << " compared, " << m_nDiffer << " differ" << std::endl;
+    }
+
+    size_t Differ() const { return m_nDiffer; }
+
+  private:
+
+    const std::string m_sName;
+    std::deque<value_t> m_window;
+    map_t m_map;
+    monotonic_t m_monotonic;
+    size_t m_nCompares;
+    size_t m_nDiffer;
+
+    template<typename MinMax_t>
+    static std::string State( const MinMax_t& mm ) {
+      std::string s;
+      try {
+        s = "min " + std::to_string( mm.Min() ) + " max " + std::to_string( mm.Max() );
+      }
+      catch ( const std::runtime_error& e ) {
+        s = e.what();
+      }
+      if ( mm.add.bCalled ) s += ", add " + std::to_string( mm.add.min ) + " " + std::to_string( mm.add.max );
+      if ( mm.del.bCalled ) s += ", del " + std::to_string( mm.del.min ) + " " + std::to_string( mm.del.max );
+      return s;
+    }
+
+    void Compare( const char* szOperation ) {
+      m_nCompares++;
+      const std::string sMap( State( m_map ) );
+      const std::string sMonotonic( State( m_monotonic ) );
+      if ( ( sMap != sMonotonic ) || !( m_map.add == m_monotonic.add ) || !( m_map.del == m_monotonic.del ) ) {
+        if ( 10 > m_nDiffer ) {
+          std::cout
+            << m_sName << " " << szOperation << " at " << m_nCompares << ", window " << m_window.size() << std::endl
+            << "  map:       " << sMap << std::endl
+            << "  monotonic: " << sMonotonic << std::endl;
+        }
+        m_nDiffer++;
+      }
+    }
+  };
+
+  // values follow a random walk, rounded to a tick so duplicates are common, with the odd spike
+  // the window, the number of values kept, changes from time to time, so expiry removes none, one, or several
+  template<typename value_t, typename Round>
+  size_t Run( const std::string& sName, size_t nSteps, unsigned int seed, Round&& round ) {
+
+    Check<value_t> check( sName );
+
+    std::mt19937_64 rng( seed );
+    std::uniform_real_distribution<double> step( -1.0, 1.0 );
+    std::uniform_int_distribution<size_t> percent( 0, 99 );
+    std::uniform_int_distribution<size_t> window( 1, 300 );
+
+    double dblLevel( 100.0 );
+    size_t nWindow( window( rng ) );
+
+    for ( size_t ix = 0; ix < nSteps; ++ix ) {
+
+      const size_t n( percent( rng ) );
+      if ( 0 == n ) nWindow = window( rng );
+      if ( ( 1 == n ) && ( 0 == ix % 7 ) ) check.Reset();
+
+      dblLevel += step( rng );
+      const double dblSpike( ( 2 == n ) ? 50.0 * step( rng ) : 0.0 );
+      check.Add( round( dblLevel + dblSpike ) );
+
+      while ( nWindow < check.Window() ) check.Expire();
+      if ( 3 == n ) { // drain, so both are taken to empty and refilled
+        while ( 0 < check.Window() ) check.Expire();
+      }
+    }
+
+    check.Emit();
+    return check.Differ();
+  }
+
+  // nanoseconds per step, each step adds a price, expires the one a window back, and reads min and max,
+  // sum keeps the reads from being optimized away, and shows both policies saw the same values
+  template<typename MinMax_t>
+  double Time( const std::vector<double>& vPrice, size_t nWindow, double& sum ) {
+    MinMax_t mm;
+    sum = 0.0;
+    const auto begin( std::chrono::steady_clock::now() );
+    for ( size_t ix = 0; ix < vPrice.size(); ++ix ) {
+      mm.Add( vPrice[ ix ] );
+      if ( nWindow <= ix ) mm.Remove( vPrice[ ix - nWindow ] );
+      sum += mm.Max() - mm.Min();
+    }
+    return std::chrono::duration<double,std::nano>( std::chrono::steady_clock::now() - begin ).count() / vPrice.size();
+  }
+
+  // cent rounded random walk prices
+  size_t Timing( size_t nSteps, unsigned int seed ) {
+
+    std::mt19937_64 rng( seed );
+    std::normal_distribution<double> step( 0.0, 0.01 );
+    std::vector<double> vPrice( nSteps );
+    double dblLevel( 100.0 );
+    for ( double& price: vPrice ) {
+      dblLevel += step( rng );
+      price = std::round( dblLevel * 100.0 ) / 100.0;
+    }
+
+    using map_t = MinMax<double,ou::tf::runningminmax::Map<double> >;
+    using monotonic_t = MinMax<double,ou::tf::runningminmax::Monotonic<double> >;
+
+    size_t nDiffer {};
+    for ( const size_t nWindow: { 10, 1000, 100000 } ) {
+      double sumMap, sumMonotonic;
+      const double nsMap( Time<map_t>( vPrice, nWindow, sumMap ) );
+      const double nsMonotonic( Time<monotonic_t>( vPrice, nWindow, sumMonotonic ) );
+      std::cout << "window " << nWindow << ": map " << nsMap << "ns, monotonic " << nsMonotonic << "ns per step" << std::endl;
+      if ( sumMap != sumMonotonic ) nDiffer++;
+    }
+    return nDiffer;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  if ( 2 > argc ) {
+    std::cout << "RunningMinMaxCheck <steps> [seed]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  size_t nDiffer {};
+  try {
+    const size_t nSteps( std::stoul( argv[ 1 ] ) );
+    const unsigned int seed( ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 1 );
+    nDiffer += Run<double>( "double", nSteps, seed, []( double value ){ return std::round( value * 100.0 ) / 100.0; } );
+    nDiffer += Run<int>( "int", nSteps, seed + 1, []( double value ){ return int( std::lround( value ) ); } );
+    nDiffer += Timing( nSteps, seed );
+  }
+  catch ( const std::exception& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return ( 0 == nDiffer ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
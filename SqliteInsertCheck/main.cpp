@@ -0,0 +1,221 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: SqliteInsertCheck
+ * Created: 2026/10/16 21:31:06
+ */
+
+// times row inserts through the OUSQL session on sqlite, and checks its transactions:
+//   SqliteInsertCheck [autocommit rows] [rows]
+// each run starts from a fresh SqliteInsertCheck.db in the current directory
+//   autocommit:   Insert per row, each its own transaction, with the statement cache off, then on
+//   transaction:  Insert per row, inside one Batch, with the statement cache off, then on
+//   InsertMany:   one statement re-bound per row, inside its own Batch
+//   rollback:     a Batch left by an exception, and an inner rollback under an outer commit, must leave no rows
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include <OUSqlite/Session.h>
+
+namespace {
+
+  const std::string c_sDb( "SqliteInsertCheck.db" );
+  const std::string c_sTable( "rows" );
+
+  struct Row {
+    template<class A>
+    void Fields( A& a ) {
+      ou::db::Field( a, "id", id );
+      ou::db::Field( a, "price", dblPrice );
+      ou::db::Field( a, "exchange", sExchange );
+    }
+    boost::int64_t id;
+    double dblPrice;
+    std::string sExchange;
+    Row(): id {}, dblPrice {} {}
+    Row( boost::int64_t id_ ): id( id_ ), dblPrice( 400.0 + 0.01 * id_ ), sExchange( "ARCA" ) {}
+  };
+
+  struct RowCreate: Row {
+    template<class A>
+    void Fields( A& a ) {
+      Row::Fields( a );
+      ou::db::Key( a, "id" );
+    }
+  };
+
+  struct Count {
+    template<class A>
+    void Fields( A& a ) {
+      ou::db::Field( a, "n", n );
+    }
+    boost::int64_t n;
+  };
+
+  void HandleRegisterTables( ou::db::Session& session ) {
+    session.RegisterTable<RowCreate>( c_sTable );
+  }
+
+  void HandleRegisterRows( ou::db::Session& session ) {
+    session.MapRowDefToTableName<Row>( c_sTable );
+  }
+
+  // a fresh database, with the table
+  void Open( ou::db::Session& session ) {
+    boost::filesystem::remove( c_sDb );
+    session.OnRegisterTables.Add( &HandleRegisterTables );
+    session.OnRegisterRows.Add( &HandleRegisterRows );
+    session.Open( c_sDb );
+  }
+
+  void Close( ou::db::Session& session ) { // before the destructor, which can't reach the derived session
+    session.Close();
+    session.OnRegisterRows.Remove( &HandleRegisterRows );
+    session.OnRegisterTables.Remove( &HandleRegisterTables );
+  }
+
+  boost::int64_t Rows( ou::db::Session& session ) {
+    Count count {};
+    ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t pQuery
+      = session.SQL<ou::db::NoBind>( "select count(*) as n from " + c_sTable );
+    session.Columns<ou::db::NoBind,Count>( pQuery, count );
+    return count.n;
+  }
+
+  // executes on the conversion to the query pointer
+  void Insert( ou::db::Session& session, Row& row ) {
+    ou::db::QueryFields<Row>::pQueryFields_t pQuery = session.Insert<Row>( row );
+  }
+
+  enum class EMode { AutoCommit, Transaction, InsertMany };
+
+  size_t Time( const char* szName, EMode mode, bool bCache, size_t nRows ) {
+
+    std::vector<Row> vRow;
+    vRow.reserve( nRows );
+    for ( size_t ix = 0; ix < nRows; ++ix ) vRow.emplace_back( ix );
+
+    ou::db::Session session;
+    Open( session );
+    session.SetStatementCacheCapacity( bCache ? 128 : 0 );
+
+    const auto begin( std::chrono::steady_clock::now() );
+    switch ( mode ) {
+      case EMode::AutoCommit:
+        for ( Row& row: vRow ) Insert( session, row );
+        break;
+      case EMode::Transaction:
+        {
+          ou::db::Session::Batch batch( session );
+          for ( Row& row: vRow ) Insert( session, row );
+          batch.Commit();
+        }
+        break;
+      case EMode::InsertMany:
+        session.InsertMany<Row>( vRow.begin(), vRow.end() );
+        break;
+    }
+    const double dblSeconds( std::chrono::duration<double>( std::chrono::steady_clock::now() - begin ).count() );
+
+    const boost::int64_t nStored( Rows( session ) );
+    const ou::db::Session::StatementCacheStats stats( session.GetStatementCacheStats() );
+    std::cout
+      << szName << ( bCache ? ", cache" : "" ) << ": " << nStored << " of " << nRows << " rows, "
+      << dblSeconds << "s, " << size_t( nRows / dblSeconds ) << " rows/s"
+      << ", cache hits " << stats.nHits << ", misses " << stats.nMisses
+      << std::endl;
+    Close( session );
+
+    return ( boost::int64_t( nRows ) == nStored ) ? 0 : 1;
+  }
+
+  size_t Rollback() {
+
+    ou::db::Session session;
+    Open( session );
+
+    try { // left by an exception
+      ou::db::Session::Batch batch( session );
+      for ( size_t ix = 0; ix < 10; ++ix ) {
+        Row row( ix );
+        Insert( session, row );
+      }
+      throw std::runtime_error( "leaving the batch" );
+    }
+    catch ( const std::runtime_error& ) {}
+    const boost::int64_t nException( Rows( session ) );
+
+    bool bThrown( false );
+    try { // an inner rollback, the outer commit must throw, and roll back the outer rows too
+      ou::db::Session::Batch outer( session );
+      Row row( 100 );
+      Insert( session, row );
+      {
+        ou::db::Session::Batch inner( session );
+        Row rowInner( 101 );
+        Insert( session, rowInner );
+        inner.Rollback();
+      }
+      outer.Commit();
+    }
+    catch ( const std::runtime_error& ) {
+      bThrown = true;
+    }
+    const boost::int64_t nInner( Rows( session ) );
+
+    std::cout
+      << "rollback: " << nException << " rows after the exception, " << nInner << " after the inner rollback"
+      << ( bThrown ? ", outer commit threw" : ", outer commit did not throw" )
+      << std::endl;
+    Close( session );
+
+    return ( ( 0 == nException ) && ( 0 == nInner ) && bThrown ) ? 0 : 1;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nAutoCommit( ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 2000 );
+  const size_t nRows( ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 100000 );
+
+  size_t nFail {};
+  try {
+    nFail += Time( "autocommit", EMode::AutoCommit, false, nAutoCommit );
+    nFail += Time( "autocommit", EMode::AutoCommit, true, nAutoCommit );
+    nFail += Time( "transaction", EMode::Transaction, false, nRows );
+    nFail += Time( "transaction", EMode::Transaction, true, nRows );
+    nFail += Time( "InsertMany", EMode::InsertMany, true, nRows );
+    nFail += Rollback();
+  }
+  catch ( const std::exception& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  boost::filesystem::remove( c_sDb );
+
+  return ( 0 == nFail ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,243 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    main.cpp
+ * Author:  raymond@burkholder.net
+ * Project: WriteBehindCheck
+ * Created: 2026/10/16 21:14:52
+ */
+
+// checks the journal replay of lib/TFTrading/WriteBehind, and times its Append against a synchronous insert:
+//   WriteBehindCheck [rows]
+// WriteBehindCheck.db and WriteBehindCheck.journal are made in the current directory
+//   replay:  a journal of whole records is written by hand, then a torn tail, with a length too large for a record,
+//            or a length running past the end of the file, Start must replay the whole records and stop at the tail
+//   time:    the latency of each write, a prepared insert committed on the caller's thread, against an Append,
+//            then the time until the appended rows are committed
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+#include <boost/filesystem.hpp>
+
+#include <OUSqlite/Session.h>
+
+#include <TFTrading/WriteBehind.h>
+
+namespace {
+
+  const std::string c_sDb( "WriteBehindCheck.db" );
+  const std::string c_sJournal( "WriteBehindCheck.journal" );
+  const std::string c_sTable( "rows" );          // written by WriteBehind
+  const std::string c_sTableSync( "rows_sync" ); // written on the caller's thread
+
+  const ou::tf::WriteBehind::ixStatement_t c_ixInsert( 0 );
+
+  struct Row {
+    template<class A>
+    void Fields( A& a ) {
+      ou::db::Field( a, "id", id );
+      ou::db::Field( a, "price", dblPrice );
+      ou::db::Field( a, "exchange", sExchange );
+    }
+    boost::int64_t id;
+    double dblPrice;
+    std::string sExchange;
+    Row(): id {}, dblPrice {} {}
+    Row( boost::int64_t id_ ): id( id_ ), dblPrice( 400.0 + 0.01 * id_ ), sExchange( "ARCA" ) {}
+  };
+
+  struct RowCreate: Row {
+    template<class A>
+    void Fields( A& a ) {
+      Row::Fields( a );
+      ou::db::Key( a, "id" );
+    }
+  };
+
+  struct RowCreateSync: RowCreate {}; // a table definition type maps to one table
+
+  struct Count {
+    template<class A>
+    void Fields( A& a ) {
+      ou::db::Field( a, "n", n );
+    }
+    boost::int64_t n;
+  };
+
+  void HandleRegisterTables( ou::db::Session& session ) {
+    session.RegisterTable<RowCreate>( c_sTable );
+    session.RegisterTable<RowCreateSync>( c_sTableSync );
+  }
+
+  // as OrderManager composes its write-behind inserts
+  std::string InsertOrIgnore( const std::string& sTable ) {
+    Row row;
+    ou::db::Action_Compose_Insert action( sTable );
+    row.Fields( action );
+    std::string sStatement;
+    action.ComposeStatement( sStatement ); // INSERT INTO ...
+    return "INSERT OR IGNORE" + sStatement.substr( 6 );
+  }
+
+  // a fresh database, with both tables
+  void Create( ou::db::Session& session ) {
+    boost::filesystem::remove( c_sDb );
+    boost::filesystem::remove( c_sJournal );
+    session.OnRegisterTables.Add( &HandleRegisterTables );
+    session.Open( c_sDb );
+    session.OnRegisterTables.Remove( &HandleRegisterTables );
+  }
+
+  boost::int64_t Rows( ou::db::Session& session, const std::string& sTable ) {
+    Count count {};
+    ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t pQuery
+      = session.SQL<ou::db::NoBind>( "select count(*) as n from " + sTable );
+    session.Columns<ou::db::NoBind,Count>( pQuery, count );
+    return count.n;
+  }
+
+  // a journal record, as WriteBehind::Append frames it:  the size of the remainder, the statement index, the fields
+  std::string Record( Row row ) {
+    std::string record( sizeof( uint32_t ), 0 );
+    ou::tf::writebehind::Action_Write write( record );
+    write.Write( c_ixInsert );
+    row.Fields( write );
+    const uint32_t nSize( record.size() - sizeof( uint32_t ) );
+    std::memcpy( &record[ 0 ], &nSize, sizeof( uint32_t ) );
+    return record;
+  }
+
+  size_t Replay( size_t nRows, const char* szTail, uint32_t nTailSize ) {
+
+    ou::db::Session session;
+    Create( session );
+
+    std::FILE* pFile( std::fopen( c_sJournal.c_str(), "wb" ) );
+    for ( size_t ix = 0; ix < nRows; ++ix ) {
+      const std::string record( Record( Row( ix ) ) );
+      std::fwrite( record.data(), record.size(), 1, pFile );
+    }
+    const char rTail[ 16 ] = {};
+    std::fwrite( &nTailSize, sizeof( uint32_t ), 1, pFile );
+    std::fwrite( rTail, sizeof( rTail ), 1, pFile );
+    std::fclose( pFile );
+
+    size_t nFail {};
+    try {
+      ou::tf::WriteBehind wb( c_sDb, c_sJournal );
+      wb.Register<Row>( c_ixInsert, InsertOrIgnore( c_sTable ) );
+      wb.Start( true );
+      if ( 0 != wb.GetStats().nErrors ) nFail++;
+    }
+    catch ( const std::exception& e ) {
+      std::cout << "  " << e.what() << std::endl;
+      nFail++;
+    }
+    const boost::int64_t nStored( Rows( session, c_sTable ) );
+    std::cout << "replay, " << szTail << ": " << nStored << " of " << nRows << " rows" << std::endl;
+    if ( boost::int64_t( nRows ) != nStored ) nFail++;
+    session.Close(); // before the destructor, which can't reach the derived session
+    return nFail;
+  }
+
+  void Emit( const char* szName, std::vector<double>& vLatency ) {
+    std::sort( vLatency.begin(), vLatency.end() );
+    double sum {};
+    for ( const double latency: vLatency ) sum += latency;
+    auto percentile = [&vLatency]( double p ){ return vLatency[ std::min( vLatency.size() - 1, size_t( p * vLatency.size() ) ) ]; };
+    std::cout
+      << szName << ": mean " << sum / vLatency.size() << "us, p50 " << percentile( 0.50 )
+      << "us, p99 " << percentile( 0.99 ) << "us, max " << vLatency.back() << "us";
+  }
+
+  size_t Time( size_t nRows ) {
+
+    using clock = std::chrono::steady_clock;
+    auto us = []( clock::time_point begin ){ return std::chrono::duration<double,std::micro>( clock::now() - begin ).count(); };
+
+    ou::db::Session session;
+    Create( session );
+
+    std::vector<double> vLatency;
+    vLatency.reserve( nRows );
+
+    { // a statement prepared once, then bound, executed, and reset per row, in its own transaction
+      Row row;
+      ou::db::QueryFields<Row>::pQueryFields_t pQuery = session.SQL<Row>( InsertOrIgnore( c_sTableSync ), row ).NoExecute();
+      const clock::time_point begin( clock::now() );
+      for ( size_t ix = 0; ix < nRows; ++ix ) {
+        const clock::time_point start( clock::now() );
+        row = Row( ix );
+        session.Bind<Row>( pQuery );
+        session.Execute( pQuery );
+        session.Reset( pQuery );
+        vLatency.push_back( us( start ) );
+      }
+      Emit( "synchronous", vLatency );
+      std::cout << ", " << us( begin ) / 1e6 << "s" << std::endl;
+    }
+
+    vLatency.clear();
+    {
+      ou::tf::WriteBehind wb( c_sDb, c_sJournal );
+      wb.Register<Row>( c_ixInsert, InsertOrIgnore( c_sTable ) );
+      wb.Start( false );
+      const clock::time_point begin( clock::now() );
+      for ( size_t ix = 0; ix < nRows; ++ix ) {
+        const clock::time_point start( clock::now() );
+        wb.Append( c_ixInsert, Row( ix ) );
+        vLatency.push_back( us( start ) );
+      }
+      const double dblAppended( us( begin ) / 1e6 );
+      wb.Flush();
+      Emit( "write-behind", vLatency );
+      std::cout << ", " << dblAppended << "s, committed at " << us( begin ) / 1e6 << "s" << std::endl;
+    }
+
+    size_t nFail {};
+    if ( boost::int64_t( nRows ) != Rows( session, c_sTableSync ) ) nFail++;
+    if ( boost::int64_t( nRows ) != Rows( session, c_sTable ) ) nFail++;
+    session.Close();
+    return nFail;
+  }
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nRows( ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 2000 );
+
+  size_t nFail {};
+  try {
+    nFail += Replay( nRows, "length too large", 0xfffffff0 );
+    nFail += Replay( nRows, "length past the end", 64 );
+    nFail += Time( nRows );
+  }
+  catch ( const std::exception& e ) {
+    std::cout << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  boost::filesystem::remove( c_sJournal );
+
+  return ( 0 == nFail ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
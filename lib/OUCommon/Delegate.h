@@ -13,15 +13,18 @@
 
 #pragma once
 
+#include <mutex>
 #include <atomic>
 #include <vector>
+#include <cassert>
 
-//#include <boost/atomic.hpp>
-#include <boost/scope_exit.hpp>
+#include <OUCommon/Rcu.h>
 
-#include <OUCommon/SpinLock.h>
-
-// 2018/07/22 TODO: change the vector manipulation to std::move?
+// 2026/10/16 dispatch is read-copy-update:  Add/Remove publish a new immutable vector,
+//   operator() dispatches from whichever vector was published on entry, without a lock,
+//   the vector replaced is deleted once no dispatch can still be using it (see Rcu.h)
+//   Add/Remove may be called from within a handler, the change applies from the next dispatch
+//   a handler may still be called by a dispatch already in progress on another thread after Remove returns
 
 // 2014/09/30 something to verify with existing code
 // http://preshing.com/20140709/the-purpose-of-memory_order_consume-in-cpp11/
@@ -59,95 +62,65 @@ public:
   void Add( OnDispatchHandler function );
   void Remove( OnDispatchHandler function );
 
-  bool IsEmpty() const { return ( 0 == m_vDispatchMaster.size() ); };
-  vsize_t Size() const { return m_vDispatchMaster.size(); };
+  bool IsEmpty() const { return ( nullptr == m_pDispatch.load( std::memory_order_acquire ) ); };
+  vsize_t Size() const;
 
 protected:
 private:
 
-  using const_iterator = typename vDispatch_t::const_iterator;
-
-  std::atomic<int> m_cntDispatchProcesses;
-  std::atomic<int> m_cntChanges;
-  ou::SpinLock m_spinlockVectorUpdate;   // lock against Add/Remove
-  ou::SpinLock m_spinlockVectorReplace;  // lock against operator()
+  std::mutex m_mutexUpdate; // serializes Add/Remove
 
-  vDispatch_t m_vDispatchMaster;  // master vector used for Add/Remove
-  vDispatch_t m_vDispatch;  // used by operator() for dispatch, copied from m_vDispatchMaster
+  std::atomic<const vDispatch_t*> m_pDispatch; // published for operator(), nullptr when empty
 
-  void VectorReplace();  // handles the copy of m_vDispatchMaster to m_vDispatch
+  void Publish( const vDispatch_t* ); // m_mutexUpdate is held
 
 };
 
 template<class T>
 Delegate<T>::Delegate()
-  : m_cntDispatchProcesses {}, m_cntChanges {}
+  : m_pDispatch( nullptr )
 {
 }
 
 template<class T>
 Delegate<T>::Delegate( const Delegate<T>& rhs )
-  : m_cntDispatchProcesses {}, m_cntChanges {}
+  : m_pDispatch( nullptr )
   // don't carry over any of the stuff, just re-initialize it.
-  // boost::atomic is non-copyable
-//  : m_cntDispatchProcesses( rhs.m_cntDispatchProcesses ), m_cntChanges( rhs.m_cntChanges ),
-//  m_spinlockVectorUpdate( rhs.m_spinlockVectorUpdate ), m_spinlockVectorReplace( rhs.m_spinlockVectorReplace ),
-//  m_vDispatchMaster( rhs.m_vDispatchMaster ), m_vDispatch( rhs.m_vDispatch )
 {
-//  m_vDispatchMaster.clear();
-//  m_vDispatch.clear();
 }
 
 template<class T>
 Delegate<T>::Delegate( Delegate<T>&& rhs )
-: m_cntDispatchProcesses {}, m_cntChanges {}
+: m_pDispatch( nullptr )
 {
-  assert( 0 == rhs.m_cntChanges );
-  assert( 0 == rhs.m_cntDispatchProcesses );
-  assert( 0 == rhs.m_vDispatch.size() );
-  assert( 0 == rhs.m_vDispatchMaster.size() );
+  assert( nullptr == rhs.m_pDispatch.load() );
 }
 
 template<class T>
 Delegate<T>::~Delegate() {
-  // this object should be deleted in same thread in which it was created
-//  int n = m_cntDispatchProcesses.load( boost::memory_order_acquire );
-//  if ( 10 < n ) {
-//    std::cerr << "~Delegate=" << n << std::endl;
-//  }
-//  else {
-    while (m_cntDispatchProcesses.load( std::memory_order_acquire ) != 0 ); // wait for dispatch to finish
-//  }
-
-  m_vDispatch.clear();
-  m_vDispatchMaster.clear();
+  // a dispatch still running on another thread keeps its vector until it finishes
+  ou::Rcu::Retire( m_pDispatch.exchange( nullptr, std::memory_order_seq_cst ) );
 }
 
 template<class T>
-void Delegate<T>::operator()( T t ) {
+typename Delegate<T>::vsize_t Delegate<T>::Size() const {
+  ou::Rcu::ReadGuard guard;
+  const vDispatch_t* pDispatch = m_pDispatch.load( std::memory_order_acquire );
+  return ( nullptr == pDispatch ) ? 0 : pDispatch->size();
+}
 
-  const_iterator iter;
+template<class T>
+void Delegate<T>::operator()( T t ) {
 
-  m_cntDispatchProcesses.fetch_add( 1, std::memory_order_acquire );
-  m_spinlockVectorReplace.wait();  // wait for any running replacement to finish
+  if ( nullptr == m_pDispatch.load( std::memory_order_relaxed ) ) return; // nothing attached, skip the read section
 
-  { // ensure things get cleared up in the case of exception in delegated function
-    BOOST_SCOPE_EXIT_TPL(&m_cntDispatchProcesses) {
-      m_cntDispatchProcesses.fetch_sub( 1, std::memory_order_release );
-    } BOOST_SCOPE_EXIT_END
+  ou::Rcu::ReadGuard guard; // left on exception in a delegated function as well
 
-    iter = m_vDispatch.begin();  // start dispatching
-    while ( m_vDispatch.end() != iter ) {
-      (*iter)( t );
-      ++iter;
+  const vDispatch_t* pDispatch = m_pDispatch.load( std::memory_order_acquire );
+  if ( nullptr != pDispatch ) {
+    for ( const OnDispatchHandler& handler: *pDispatch ) {
+      handler( t );
     }
-  } // end scope
-
-  // update dispatch with queued changes
-  if ( 0 != m_cntChanges.load( std::memory_order_acquire ) ) {
-    m_spinlockVectorUpdate.lock();
-    VectorReplace();
-    m_spinlockVectorUpdate.unlock();
   }
 
 }
@@ -155,69 +128,48 @@ void Delegate<T>::operator()( T t ) {
 template<class T>
 void Delegate<T>::Add( OnDispatchHandler function ) {
 
-  m_spinlockVectorUpdate.lock();
-
-  m_vDispatchMaster.push_back( function );
-
-  m_cntChanges.fetch_add( 1, std::memory_order_release );
+  std::lock_guard<std::mutex> lock( m_mutexUpdate );
 
-  VectorReplace();
+  const vDispatch_t* pDispatch = m_pDispatch.load( std::memory_order_relaxed );
+  vDispatch_t* pNew = ( nullptr == pDispatch ) ? new vDispatch_t : new vDispatch_t( *pDispatch );
+  pNew->push_back( function );
 
-  m_spinlockVectorUpdate.unlock();
+  Publish( pNew );
 
 }
 
 template<class T>
 void Delegate<T>::Remove( OnDispatchHandler function ) {
 
-  m_spinlockVectorUpdate.lock();
+  std::lock_guard<std::mutex> lock( m_mutexUpdate );
 
-  const_iterator iter = m_vDispatchMaster.begin();
-  while ( m_vDispatchMaster.end() != iter ) {
-    if ( function == *iter ) {
-      m_vDispatchMaster.erase( iter );
-      break;  // allow only one deletion
-    }
+  const vDispatch_t* pDispatch = m_pDispatch.load( std::memory_order_relaxed );
+  if ( nullptr == pDispatch ) return;
+
+  typename vDispatch_t::const_iterator iter = pDispatch->begin();
+  while ( pDispatch->end() != iter ) {
+    if ( function == *iter ) break;  // allow only one deletion
     ++iter;
   }
+  if ( pDispatch->end() == iter ) return;
 
-  m_cntChanges.fetch_add( 1, std::memory_order_release );
-
-  VectorReplace();
-
-  m_spinlockVectorUpdate.unlock();
+  if ( 1 == pDispatch->size() ) {
+    Publish( nullptr );
+  }
+  else {
+    vDispatch_t* pNew = new vDispatch_t;
+    pNew->reserve( pDispatch->size() - 1 );
+    pNew->insert( pNew->end(), pDispatch->begin(), iter );
+    pNew->insert( pNew->end(), iter + 1, pDispatch->end() );
+    Publish( pNew );
+  }
 
 }
 
 template<class T>
-void Delegate<T>::VectorReplace() {
-
-  // perform VectorReplace only outside of operator() method influence
-  if ( 0 == m_cntDispatchProcesses.load( std::memory_order_acquire ) ) {
-    m_spinlockVectorReplace.lock();
-//    m_spinlockVectorUpdate.lock();
-
-    // ensure we are not in process
-    if ( 0 == m_cntDispatchProcesses.load( std::memory_order_acquire ) ) {
-      m_vDispatch.resize( m_vDispatchMaster.size() );
-      typedef typename vDispatch_t::iterator iterator;
-      const_iterator ixSrc = m_vDispatchMaster.begin();
-      iterator ixDst = m_vDispatch.begin();
-      for (
-        ;
-        ixSrc != m_vDispatchMaster.end();
-        ++ixSrc, ++ixDst ) {
-          *ixDst = *ixSrc;
-      }
-    }
-
-    m_cntChanges.store( 0, std::memory_order_release );
-
-//    m_spinlockVectorUpdate.unlock();
-    m_spinlockVectorReplace.unlock();
-
-  }
-
+void Delegate<T>::Publish( const vDispatch_t* pNew ) {
+  const vDispatch_t* pOld = m_pDispatch.exchange( pNew, std::memory_order_seq_cst );
+  ou::Rcu::Retire( pOld );
 }
 
 } // ou
\ No newline at end of file
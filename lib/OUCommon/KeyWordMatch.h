@@ -20,6 +20,7 @@
 
 #include <string>
 #include <vector>
+#include <string_view>
 #include <stdexcept>
 
 namespace ou {
@@ -35,7 +36,7 @@ public:
   void AddPattern( const std::string &sPattern, T object );  // do patterns need to be pre-sorted?
   size_t GetNodeCount( void ) { return m_vNodes.size(); };
   size_t GetPatternCount( void ) { return m_cntPatterns; };
-  T FindMatch( const std::string &sMatch );
+  T FindMatch( std::string_view sMatch );
 protected:
 	T m_Initializer;
   struct structNode {
@@ -132,9 +133,9 @@ template<typename T> void KeyWordMatch<T>::AddPattern(
   ++m_cntPatterns;
 }
 
-template<typename T> T KeyWordMatch<T>::FindMatch( const std::string &sPattern ) {
+template<typename T> T KeyWordMatch<T>::FindMatch( std::string_view sPattern ) {
   // traverse structure looking for matches, object at longest match is returned
-  std::string::const_iterator iter = sPattern.begin();
+  std::string_view::const_iterator iter = sPattern.begin();
   if ( sPattern.end() == iter ) {
     throw std::runtime_error( "zero length pattern" );
   }
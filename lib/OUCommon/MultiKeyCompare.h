@@ -43,13 +43,16 @@ struct MultiKeyCompare {
   const Key2& GetKey2( void ) const { return key2; };
 
 private:
-  friend std::ostream& operator<<( std::ostream&, const MultiKeyCompare<Key1, Key2>& );  // 2015/02/21 rebuild and notice warning here
+  template<typename K1, typename K2>
+  friend std::ostream& operator<<( std::ostream&, const MultiKeyCompare<K1, K2>& );
   Key1 key1;
   Key2 key2;
 };
 
-template<typename Key>
-std::ostream& operator<<( std::ostream& os, const Key& key ) {
+// 2026/10/16 was template<typename Key> ... const Key&, which matched any type, including string literals,
+//   and made 'std::cout << "..."' ambiguous in namespace ou code compiled after this header
+template<typename Key1, typename Key2>
+std::ostream& operator<<( std::ostream& os, const MultiKeyCompare<Key1, Key2>& key ) {
   return os << key.key1 << "," << key.key2;
 }
 
@@ -15,6 +15,7 @@
 
 #include <string>
 #include <vector>
+#include <cstring>
 #include <cassert>
 
 #include <boost/asio.hpp>  // class outbound processing
@@ -59,6 +60,12 @@ using boost::asio::ip::tcp;
 // need code to catch when the socket is closed for whatever reason
 // provide an interator capability scan buffers with out the re-copy process, useful for the news parsing libraries
 
+// line view mode:  when ownerT supplies OnNetworkLineView, reads go into a single large
+//   receive buffer, line boundaries are located with memchr (vectorized in libc), and each
+//   line is handed over as a [begin,end) range into the receive buffer, valid only for the
+//   duration of the callback.  The unfinished tail line is copied to the front of the buffer
+//   only when the buffer wraps.  Owners needing to hold on to a line use OnNetworkLineBuffer.
+
 // ownerT:  CRTP class
 // charT:  type of character processed
 
@@ -72,10 +79,12 @@ public:
     OK = 0,
     ERROR_WRITE,
     ERROR_SOCKET,
-    ERROR_CONNECT
+    ERROR_CONNECT,
+    ERROR_READ // the peer closed the connection, or the read failed
   };
 
 #define NETWORK_INPUT_BUF_SIZE 2048
+#define NETWORK_RING_BUF_SIZE ( 256 * 1024 )
 
   using port_t = unsigned short;
   using ipaddress_t =  std::string;
@@ -91,9 +100,11 @@ public:
   // factor a couple of these out as traits for here and for IQFeedMessages.
   using bufferelement_t = charT;
   using inputbuffer_t = boost::array<bufferelement_t, NETWORK_INPUT_BUF_SIZE>; // bulk input buffer via asio
-  using inputrepository_t = BufferRepository<inputbuffer_t>;
+  using inputrepository_t = BufferRepositoryMPSC<inputbuffer_t>; // checked out by the serialized read chain
   using linebuffer_t = std::vector<bufferelement_t>;  // used for composing lines of data for processing
-  using linerepository_t = BufferRepository<linebuffer_t>;
+  using linerepository_t = BufferRepositoryMPSC<linebuffer_t>; // checked out by the read chain, given back from anywhere
+  using sendrepository_t = BufferRepository<linebuffer_t>; // Send is called from any thread, stays locked
+  using ringbuffer_t = std::vector<bufferelement_t>; // receive buffer for line view mode
 
   Network();
   Network( const structConnection& connection );
@@ -115,6 +126,7 @@ protected:
   void OnNetworkDisconnected() {};
   void OnNetworkError( size_t ) {;};
   void OnNetworkLineBuffer( linebuffer_t* ) {};  // new line available for processing
+  void OnNetworkLineView( const bufferelement_t* begin, const bufferelement_t* end ) {}; // new line, valid during call only, cr/lf removed
   void OnNetworkSendDone() {};
 
 private:
@@ -144,13 +156,18 @@ private:
 
   inputrepository_t m_reposInputBuffers;  // content received from the network
   linerepository_t m_reposLineBuffers;  // parsed lines sent to the callers
-  linerepository_t m_reposSendBuffers; // buffers used to send data to network
+  sendrepository_t m_reposSendBuffers; // buffers used to send data to network
 
   linebuffer_t* m_pline;  // current parsing results
 
+  ringbuffer_t m_ring; // line view mode:  receive buffer
+  size_t m_ixLine; // line view mode:  start of the unfinished line
+  size_t m_ixFill; // line view mode:  end of received content
+
   size_t m_cntAsyncReads;
   size_t m_cntBytesTransferred_input;
   size_t m_cntLinesProcessed;
+  size_t m_cntRingWraps;
 
   size_t m_cntSends;
   size_t m_cntBytesTransferred_send;
@@ -161,7 +178,24 @@ private:
   void OnSendDone( const boost::system::error_code& error, std::size_t bytes_transferred, linebuffer_t* );
   void OnSendDoneNoNotify( const boost::system::error_code& error, std::size_t bytes_transferred, linebuffer_t* );
   void OnReadDone( const boost::system::error_code& error, const std::size_t bytes_transferred, inputbuffer_t* );
+  void OnReadDoneRing( const boost::system::error_code& error, const std::size_t bytes_transferred );
   void AsyncRead( void );
+  void AsyncReadRing( void );
+  void OnReadFailed( const boost::system::error_code& error );
+
+  void AppendToLine( const bufferelement_t* begin, const bufferelement_t* end );
+  void DeliverLine( void );
+  void DeliverLineView( const bufferelement_t* begin, const bufferelement_t* end );
+
+  // a line ends with a line feed, optionally preceded by a carriage return,
+  //   both read modes hand over the line without either
+  static const bufferelement_t* StripTerminator( const bufferelement_t* begin, const bufferelement_t* end ) {
+    return ( ( begin != end ) && ( 0x0d == *( end - 1 ) ) ) ? end - 1 : end;
+  }
+
+  static bool LineViewMode() {
+    return &Network<ownerT, charT>::OnNetworkLineView != &ownerT::OnNetworkLineView;
+  }
 
   void AsioThread( void );
 
@@ -181,7 +215,8 @@ Network<ownerT,charT>::Network()
   m_psocket( NULL ),
   m_cntBytesTransferred_input( 0 ), m_cntAsyncReads( 0 ),
   m_cntSends( 0 ), m_cntBytesTransferred_send( 0 ),
-  m_cntLinesProcessed( 0 ),
+  m_cntLinesProcessed( 0 ), m_cntRingWraps( 0 ),
+  m_ixLine( 0 ), m_ixFill( 0 ),
   m_cntActiveSends( 0 ), m_lReadProgress( 0 ),
   m_timer( m_io )
 {
@@ -200,7 +235,8 @@ Network<ownerT,charT>::Network( const structConnection& connection )
   m_psocket( NULL ),
   m_cntBytesTransferred_input( 0 ), m_cntAsyncReads( 0 ),
   m_cntSends( 0 ), m_cntBytesTransferred_send( 0 ),
-  m_cntLinesProcessed( 0 ),
+  m_cntLinesProcessed( 0 ), m_cntRingWraps( 0 ),
+  m_ixLine( 0 ), m_ixFill( 0 ),
   m_cntActiveSends( 0 ), m_lReadProgress( 0 ),
   m_timer( m_io )
 
@@ -220,7 +256,8 @@ Network<ownerT,charT>::Network( const ipaddress_t& sAddress, port_t nPort )
   m_psocket( NULL ),
   m_cntBytesTransferred_input( 0 ), m_cntAsyncReads( 0 ),
   m_cntSends( 0 ), m_cntBytesTransferred_send( 0 ),
-  m_cntLinesProcessed( 0 ),
+  m_cntLinesProcessed( 0 ), m_cntRingWraps( 0 ),
+  m_ixLine( 0 ), m_ixFill( 0 ),
   m_cntActiveSends( 0 ), m_lReadProgress( 0 ),
   m_timer( m_io )
 {
@@ -235,6 +272,9 @@ template <typename ownerT, typename charT>
 void Network<ownerT,charT>::CommonConstruction() {
   m_pline = m_reposLineBuffers.CheckOutL();  // have a receiving line ready
   m_pline->clear();
+  if ( LineViewMode() ) {
+    m_ring.resize( NETWORK_RING_BUF_SIZE );
+  }
   m_pwork = new boost::asio::io_service::work(m_io);  // keep the asio service running
   m_asioThread = boost::thread( boost::bind( &Network::AsioThread, this ) );
   m_stateNetwork = NS_DISCONNECTED;
@@ -284,6 +324,7 @@ Network<ownerT,charT>::~Network() {
   DEBUGOUT( typeid( this ).name()
     << " " << m_cntBytesTransferred_input << " bytes in on "
     << m_cntAsyncReads << " reads with " << m_cntLinesProcessed << " lines out, "
+    << m_cntRingWraps << " ring wraps, "
     << m_cntBytesTransferred_send << " bytes out on "
     << m_cntSends << " sends."
     << std::endl
@@ -389,9 +430,11 @@ void Network<ownerT,charT>::Disconnect() {
   if ( NS_DISCONNECTED != m_stateNetwork ) {
     //m_psocket->cancel();  //  boost::asio::error::operation_aborted, boost::asio::error::operation_not_supported on xp
     switch ( m_stateNetwork ) {
-    case NS_CONNECTED:
-      m_stateNetwork = NS_DISCONNECTING;
-      m_psocket->shutdown( boost::asio::ip::tcp::socket::shutdown_both );
+    case NS_CONNECTED: {
+        m_stateNetwork = NS_DISCONNECTING;
+        boost::system::error_code ec; // the peer may have gone already
+        m_psocket->shutdown( boost::asio::ip::tcp::socket::shutdown_both, ec );
+      }
       OnNetDisconnecting();
       break;
     case NS_CONNECTING:
@@ -446,6 +489,11 @@ void Network<ownerT,charT>::AsyncRead() {
     assert( NS_CONNECTED == m_stateNetwork );
   }
 
+  if ( LineViewMode() ) {
+    AsyncReadRing();
+    return;
+  }
+
   //InterlockedIncrement( &m_lReadProgress );
   boost::interprocess::ipcdetail::atomic_inc32( &m_lReadProgress );
 
@@ -474,6 +522,7 @@ void Network<ownerT,charT>::OnReadDone( const boost::system::error_code& error,
     if ( 0 != m_pline->size() ) {
       m_pline->clear();
     }
+    OnReadFailed( error );
   }
   else {
     assert( ( NS_CONNECTED == m_stateNetwork ) || ( NS_DISCONNECTING == m_stateNetwork) );
@@ -484,43 +533,22 @@ void Network<ownerT,charT>::OnReadDone( const boost::system::error_code& error,
     AsyncRead();  // set up for another read while processing existing buffer
 
     // process the buffer:
-    // need current linebuffer, need stats on how often it waits for subsequent bulk data
-    bufferelement_t ch;
-    typename inputbuffer_t::const_iterator input = pbuffer->begin();
-    while ( 0 != bytes_transferred ) {
-      ch = *input;
-      ++input;
-      if ( 0 == ch ) {
-//        OutputDebugString( "Network::ReadHandler: have a 0x00 character.\n" );
-      }
-      if ( 0x0a == ch ) {
-        // send the buffer off
-        try {
-          if ( &Network<ownerT, charT>::OnNetworkLineBuffer != &ownerT::OnNetworkLineBuffer ) {
-            static_cast<ownerT*>( this )->OnNetworkLineBuffer( m_pline );
-          }
-        }
-        catch( const std::logic_error& e ) {
-          std::cerr << "Network<>::OnReadDone caught: " << e.what() << std::endl;
-        }
-        catch(...) {
-          std::cerr << "Network<>::OnReadDone default exception handler" << std::endl;
-        }
-        ++m_cntLinesProcessed;
-        // and allocate another buffer
-        m_pline = m_reposLineBuffers.CheckOutL();
-        m_pline->clear();
+    // memchr locates each line feed, the run in front of it is appended in bulk
+    const bufferelement_t* begin = pbuffer->data();
+    const bufferelement_t* end = begin + bytes_transferred;
+    while ( begin != end ) {
+      const bufferelement_t* eol
+        = static_cast<const bufferelement_t*>( std::memchr( begin, 0x0a, end - begin ) );
+      if ( nullptr == eol ) {
+        AppendToLine( begin, end );
+        begin = end;
       }
       else {
-        if ( 0x0d == ch ) {
-          // ignore the character
-        }
-        else {
-          m_pline->push_back( ch );
-        }
+        AppendToLine( begin, eol );
+        DeliverLine();
+        begin = eol + 1;
       }
-      --bytes_transferred;
-    } // end while
+    }
 
   }
   m_reposInputBuffers.CheckInL( pbuffer );
@@ -529,6 +557,152 @@ void Network<ownerT,charT>::OnReadDone( const boost::system::error_code& error,
   boost::interprocess::ipcdetail::atomic_dec32( &m_lReadProgress );
 }
 
+//
+// OnReadFailed
+//
+
+template <typename ownerT, typename charT>
+void Network<ownerT,charT>::OnReadFailed( const boost::system::error_code& error ) {
+  // no further read is issued, a connection dropped by the peer would otherwise go unnoticed
+  if ( NS_CONNECTED == m_stateNetwork ) {
+    if ( &Network<ownerT, charT>::OnNetworkError != &ownerT::OnNetworkError ) {
+      static_cast<ownerT*>( this )->OnNetworkError( ERROR_READ );
+    }
+  }
+}
+
+//
+// AppendToLine
+//
+
+template <typename ownerT, typename charT>
+void Network<ownerT,charT>::AppendToLine( const bufferelement_t* begin, const bufferelement_t* end ) {
+  m_pline->insert( m_pline->end(), begin, end );
+}
+
+//
+// DeliverLine
+//
+
+template <typename ownerT, typename charT>
+void Network<ownerT,charT>::DeliverLine() {
+  // the carriage return may have arrived in an earlier read than the line feed, so is stripped from the composed line
+  const bufferelement_t* begin = m_pline->data();
+  m_pline->resize( StripTerminator( begin, begin + m_pline->size() ) - begin );
+  // send the buffer off
+  try {
+    if ( &Network<ownerT, charT>::OnNetworkLineBuffer != &ownerT::OnNetworkLineBuffer ) {
+      static_cast<ownerT*>( this )->OnNetworkLineBuffer( m_pline );
+    }
+  }
+  catch( const std::logic_error& e ) {
+    std::cerr << "Network<>::OnReadDone caught: " << e.what() << std::endl;
+  }
+  catch(...) {
+    std::cerr << "Network<>::OnReadDone default exception handler" << std::endl;
+  }
+  ++m_cntLinesProcessed;
+  // and allocate another buffer
+  m_pline = m_reposLineBuffers.CheckOutL();
+  m_pline->clear();
+}
+
+//
+// AsyncReadRing
+//
+
+template <typename ownerT, typename charT>
+void Network<ownerT,charT>::AsyncReadRing() {
+
+  static_assert( 1 == sizeof( bufferelement_t ), "line view mode requires byte sized characters" );
+
+  boost::interprocess::ipcdetail::atomic_inc32( &m_lReadProgress );
+
+  if ( NETWORK_INPUT_BUF_SIZE > ( m_ring.size() - m_ixFill ) ) {
+    // wrap: the unfinished line is the only content copied
+    const size_t nPending = m_ixFill - m_ixLine;
+    if ( 0 != nPending ) {
+      std::memmove( m_ring.data(), m_ring.data() + m_ixLine, nPending );
+    }
+    m_ixLine = 0;
+    m_ixFill = nPending;
+    ++m_cntRingWraps;
+    if ( NETWORK_INPUT_BUF_SIZE > ( m_ring.size() - m_ixFill ) ) {
+      // a line longer than the ring
+      m_ring.resize( 2 * m_ring.size() );
+    }
+  }
+
+  m_psocket->async_read_some(
+    boost::asio::buffer( m_ring.data() + m_ixFill, m_ring.size() - m_ixFill ),
+    boost::bind(
+      &Network::OnReadDoneRing, this,
+      boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred ) );
+}
+
+//
+// OnReadDoneRing
+//
+
+template <typename ownerT, typename charT>
+void Network<ownerT,charT>::OnReadDoneRing( const boost::system::error_code& error, const std::size_t bytes_transferred ) {
+
+  if ( 0 == bytes_transferred ) {
+    // probably infers that connection has been closed
+    m_ixLine = 0;
+    m_ixFill = 0;
+    OnReadFailed( error );
+  }
+  else {
+    assert( ( NS_CONNECTED == m_stateNetwork ) || ( NS_DISCONNECTING == m_stateNetwork) );
+
+    ++m_cntAsyncReads;
+    m_cntBytesTransferred_input += bytes_transferred;
+
+    // only the new content needs scanning, the unfinished line has no line feed
+    const bufferelement_t* base = m_ring.data();
+    const bufferelement_t* begin = base + m_ixFill;
+    const bufferelement_t* end = begin + bytes_transferred;
+    while ( begin != end ) {
+      const bufferelement_t* eol
+        = static_cast<const bufferelement_t*>( std::memchr( begin, 0x0a, end - begin ) );
+      if ( nullptr == eol ) break;
+      DeliverLineView( base + m_ixLine, eol );
+      begin = eol + 1;
+      m_ixLine = begin - base;
+    }
+
+    m_ixFill += bytes_transferred;
+    if ( m_ixLine == m_ixFill ) { // nothing pending, restart at the front without a copy
+      m_ixLine = 0;
+      m_ixFill = 0;
+    }
+
+    // the ring is re-used, so the next read is issued after the lines are consumed
+    AsyncReadRing();
+  }
+
+  boost::interprocess::ipcdetail::atomic_dec32( &m_lReadProgress );
+}
+
+//
+// DeliverLineView
+//
+
+template <typename ownerT, typename charT>
+void Network<ownerT,charT>::DeliverLineView( const bufferelement_t* begin, const bufferelement_t* end ) {
+  try {
+    static_cast<ownerT*>( this )->OnNetworkLineView( begin, StripTerminator( begin, end ) );
+  }
+  catch( const std::logic_error& e ) {
+    std::cerr << "Network<>::OnReadDoneRing caught: " << e.what() << std::endl;
+  }
+  catch(...) {
+    std::cerr << "Network<>::OnReadDoneRing default exception handler" << std::endl;
+  }
+  ++m_cntLinesProcessed;
+}
+
 //
 // Send
 //
@@ -540,7 +714,7 @@ void Network<ownerT,charT>::Send( const std::string& send, bool bNotifyOnDone )
     //InterlockedIncrement( &m_cntActiveSends );
     boost::interprocess::ipcdetail::atomic_inc32( &m_cntActiveSends );
 
-    typename linerepository_t::pBuffer_t pbuffer = m_reposSendBuffers.CheckOutL();
+    typename sendrepository_t::pBuffer_t pbuffer = m_reposSendBuffers.CheckOutL();
     pbuffer->clear();
     for ( char ch: send ) {
       (*pbuffer).push_back( ch );
@@ -0,0 +1,207 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Rcu.h
+ * Author:  raymond@burkholder.net
+ * Project: OUCommon
+ * Created: 2026/10/16 22:14:05
+ */
+
+// read-copy-update with epoch based reclamation
+//   readers bracket their use of a shared pointer with a ReadGuard:  a load of the global epoch,
+//   a store to the thread's own record, and a fence, no lock and no read-modify-write
+//   writers publish a replacement, then Retire the old copy, which is deleted once every thread
+//   which may still be reading it has left its read section
+//   Retire does not wait, so a writer may itself be inside a read section, ie, a handler
+//   removing itself during dispatch
+// read sections nest, only the outermost one is published
+// thread records are recycled when a thread exits, they are never freed
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace ou { // One Unified
+
+class Rcu {
+public:
+
+  using epoch_t = uint64_t;
+
+  class ReadGuard; // brackets a read section, defined below
+
+  // call after the replacement has been published with a seq_cst store or exchange
+  template<typename T>
+  static void Retire( T* p ) {
+    if ( nullptr != p ) Retire( const_cast<void*>( static_cast<const void*>( p ) ), []( void* p ){ delete static_cast<T*>( p ); } );
+  }
+
+  static void Reclaim(); // deletes whatever is no longer reachable by a reader
+
+  struct Stats {
+    size_t nThreads;   // records in use
+    size_t nRetired;   // waiting on readers
+    size_t nReclaimed;
+  };
+  static Stats GetStats();
+
+private:
+
+  friend class ReadGuard;
+
+  struct alignas( 64 ) Record { // own cache line, written by the owning thread on every read section
+    std::atomic<epoch_t> active; // 0 when outside a read section, otherwise the epoch seen on entry
+    uint32_t nNesting;           // owning thread only
+    bool bInUse;                 // protected by the state's mutex
+    Record(): active {}, nNesting {}, bInUse( false ) {}
+  };
+
+  struct Retired {
+    epoch_t epoch;
+    void* p;
+    void (*fDelete)( void* );
+  };
+
+  using pRecord_t = std::unique_ptr<Record>;
+  using vRecord_t = std::vector<pRecord_t>;
+  using vRetired_t = std::vector<Retired>;
+
+  struct State {
+    std::mutex mutex; // records, and the retired list
+    vRecord_t vRecord;
+    vRetired_t vRetired;
+    size_t nReclaimed;
+    State(): nReclaimed {} {}
+  };
+
+  // not destroyed, delegates may retire during static destruction
+  static State& GetState() {
+    static State* pState = new State;
+    return *pState;
+  }
+
+  inline static std::atomic<epoch_t> s_epoch { 1 };
+  inline static thread_local Record* t_pRecord { nullptr };
+
+  struct Release { // returns the thread's record on thread exit
+    ~Release() {
+      if ( nullptr != t_pRecord ) {
+        std::lock_guard<std::mutex> lock( GetState().mutex );
+        t_pRecord->active.store( 0, std::memory_order_release );
+        t_pRecord->bInUse = false;
+        t_pRecord = nullptr;
+      }
+    }
+  };
+
+  static Record& Self() {
+    Record* pRecord = t_pRecord;
+    return ( nullptr == pRecord ) ? Register() : *pRecord;
+  }
+
+  static Record& Register();
+  static void Retire( void* p, void (*fDelete)( void* ) );
+  static void ReclaimLocked( State&, vRetired_t& vDelete ); // the state's mutex is held, moves reclaimable entries to vDelete
+};
+
+class Rcu::ReadGuard {
+public:
+  ReadGuard(): m_record( Rcu::Self() ) {
+    if ( 0 == m_record.nNesting++ ) {
+      m_record.active.store( s_epoch.load( std::memory_order_acquire ), std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_seq_cst ); // publish before the protected pointer is loaded
+    }
+  }
+  ~ReadGuard() {
+    if ( 0 == --m_record.nNesting ) {
+      m_record.active.store( 0, std::memory_order_release );
+    }
+  }
+  ReadGuard( const ReadGuard& ) = delete;
+  ReadGuard& operator=( const ReadGuard& ) = delete;
+private:
+  Rcu::Record& m_record;
+};
+
+inline Rcu::Record& Rcu::Register() {
+  static thread_local Release release; // constructed once per thread, destroyed on thread exit
+  State& state( GetState() );
+  std::lock_guard<std::mutex> lock( state.mutex );
+  vRecord_t::iterator iter = std::find_if(
+    state.vRecord.begin(), state.vRecord.end(), []( const pRecord_t& p ){ return !p->bInUse; } );
+  if ( state.vRecord.end() == iter ) {
+    iter = state.vRecord.insert( state.vRecord.end(), std::make_unique<Record>() );
+  }
+  (*iter)->bInUse = true;
+  (*iter)->nNesting = 0;
+  t_pRecord = iter->get();
+  return **iter;
+}
+
+inline void Rcu::ReclaimLocked( State& state, vRetired_t& vDelete ) {
+  // pairs with the fence in ReadGuard:  either the reader's epoch is seen here,
+  //   or the reader loads the pointer published ahead of Retire
+  std::atomic_thread_fence( std::memory_order_seq_cst );
+  epoch_t oldest( s_epoch.load( std::memory_order_acquire ) );
+  for ( const pRecord_t& pRecord: state.vRecord ) {
+    const epoch_t active( pRecord->active.load( std::memory_order_acquire ) );
+    if ( ( 0 != active ) && ( active < oldest ) ) oldest = active;
+  }
+  // a reader which entered at epoch e may hold anything retired at an epoch after e
+  vRetired_t::iterator iter = std::partition(
+    state.vRetired.begin(), state.vRetired.end(), [oldest]( const Retired& r ){ return oldest < r.epoch; } );
+  vDelete.insert( vDelete.end(), iter, state.vRetired.end() );
+  state.nReclaimed += state.vRetired.end() - iter;
+  state.vRetired.erase( iter, state.vRetired.end() );
+}
+
+inline void Rcu::Retire( void* p, void (*fDelete)( void* ) ) {
+  vRetired_t vDelete;
+  {
+    State& state( GetState() );
+    std::lock_guard<std::mutex> lock( state.mutex );
+    const epoch_t epoch( s_epoch.fetch_add( 1, std::memory_order_seq_cst ) + 1 );
+    state.vRetired.push_back( Retired { epoch, p, fDelete } );
+    ReclaimLocked( state, vDelete );
+  }
+  for ( Retired& r: vDelete ) r.fDelete( r.p ); // outside the lock, destructors may retire
+}
+
+inline void Rcu::Reclaim() {
+  vRetired_t vDelete;
+  {
+    State& state( GetState() );
+    std::lock_guard<std::mutex> lock( state.mutex );
+    ReclaimLocked( state, vDelete );
+  }
+  for ( Retired& r: vDelete ) r.fDelete( r.p );
+}
+
+inline Rcu::Stats Rcu::GetStats() {
+  State& state( GetState() );
+  std::lock_guard<std::mutex> lock( state.mutex );
+  return Stats {
+    (size_t)std::count_if( state.vRecord.begin(), state.vRecord.end(), []( const pRecord_t& p ){ return p->bInUse; } ),
+    state.vRetired.size(),
+    state.nReclaimed
+  };
+}
+
+} // namespace ou
@@ -15,6 +15,8 @@
 
 
 #include <mutex>
+#include <atomic>
+#include <thread>
 #include <vector>
 //#include <sstream>
 #include <cassert>
@@ -177,4 +179,147 @@ template<typename bufferT> inline bufferT* BufferRepository<bufferT>::CheckOut()
   return pBuffer;
 }
 
-} // ou
\ No newline at end of file
+// ======
+
+// BufferRepositoryMPSC
+
+// lock free variant for the tick path:  one consumer checks out, any thread checks in
+//   (the network/dispatch thread checks out, handlers on other threads give back)
+// check ins are pushed onto a shared intrusive list with a single CAS,
+// the consumer keeps a private cache and takes the whole shared list with one exchange when the cache empties,
+//   as no node is ever popped individually from the shared list, there is no ABA exposure
+// CheckOut/CheckOutL must be serialized (one consumer at a time), CheckIn/CheckInL may be called from anywhere
+// the L versions are kept so this can stand in for BufferRepository, there is no lock
+// bufferT must be default constructible and derivable (the node derives from it to carry the link)
+
+template<typename bufferT>
+class BufferRepositoryMPSC {
+public:
+
+  using pBuffer_t = bufferT*;
+
+  struct Stats {
+    std::size_t nCheckOut;
+    std::size_t nCheckIn;
+    std::size_t nCrossThreadReturn; // checked in by a thread other than the consumer
+    std::size_t nCreated;
+    std::size_t nOutstandingMax;    // high water mark of buffers checked out at once
+  };
+
+  BufferRepositoryMPSC();
+  ~BufferRepositoryMPSC();
+
+  inline void CheckIn( pBuffer_t );
+  inline pBuffer_t CheckOut();
+  void CheckInL( pBuffer_t pBuffer ) { CheckIn( pBuffer ); }
+  pBuffer_t CheckOutL() { return CheckOut(); }
+
+  bool Outstanding() const {
+    return m_cntCheckOut.load( std::memory_order_relaxed ) != m_cntCheckIn.load( std::memory_order_relaxed );
+  }
+
+  Stats GetStats() const;
+
+private:
+
+  struct Node: public bufferT {
+    Node* pNextPooled;
+    Node(): bufferT(), pNextPooled( nullptr ) {}
+  };
+
+  // consumer side
+  Node* m_pCache;
+  std::atomic<std::size_t> m_cntCheckOut; // single writer
+  std::atomic<std::size_t> m_cntCreated;  // single writer
+  std::atomic<std::size_t> m_nOutstandingMax; // single writer
+  std::atomic<std::thread::id> m_idConsumer;
+
+  // producer side, kept off the consumer's cache line
+  alignas( 64 ) std::atomic<Node*> m_pReturned;
+  std::atomic<std::size_t> m_cntCheckIn;
+  std::atomic<std::size_t> m_cntCrossThreadReturn;
+
+  static void Delete( Node* pNode ) {
+    while ( nullptr != pNode ) {
+      Node* pNext( pNode->pNextPooled );
+      delete pNode;
+      pNode = pNext;
+    }
+  }
+};
+
+template<typename bufferT> BufferRepositoryMPSC<bufferT>::BufferRepositoryMPSC()
+: m_pCache( nullptr )
+, m_cntCheckOut {}, m_cntCreated {}, m_nOutstandingMax {}
+, m_idConsumer( std::thread::id() )
+, m_pReturned( nullptr )
+, m_cntCheckIn {}, m_cntCrossThreadReturn {}
+{}
+
+template<typename bufferT> BufferRepositoryMPSC<bufferT>::~BufferRepositoryMPSC() {
+  // buffers still checked out are not reclaimed, same as BufferRepository
+  Delete( m_pCache );
+  m_pCache = nullptr;
+  Delete( m_pReturned.exchange( nullptr, std::memory_order_acquire ) );
+}
+
+template<typename bufferT> inline void BufferRepositoryMPSC<bufferT>::CheckIn( bufferT* pBuffer ) {
+  assert( pBuffer );
+  Node* pNode( static_cast<Node*>( pBuffer ) );
+  m_cntCheckIn.fetch_add( 1, std::memory_order_relaxed );
+  if ( std::this_thread::get_id() != m_idConsumer.load( std::memory_order_relaxed ) ) {
+    m_cntCrossThreadReturn.fetch_add( 1, std::memory_order_relaxed );
+  }
+  Node* pHead( m_pReturned.load( std::memory_order_relaxed ) );
+  do {
+    pNode->pNextPooled = pHead;
+  } while ( !m_pReturned.compare_exchange_weak( pHead, pNode, std::memory_order_release, std::memory_order_relaxed ) );
+}
+
+template<typename bufferT> inline bufferT* BufferRepositoryMPSC<bufferT>::CheckOut() {
+
+  const std::thread::id id( std::this_thread::get_id() );
+  if ( id != m_idConsumer.load( std::memory_order_relaxed ) ) {
+    m_idConsumer.store( id, std::memory_order_relaxed );
+  }
+
+  if ( nullptr == m_pCache ) {
+    m_pCache = m_pReturned.exchange( nullptr, std::memory_order_acquire );
+  }
+
+  Node* pNode;
+  if ( nullptr == m_pCache ) {
+    pNode = new Node;
+    m_cntCreated.store( m_cntCreated.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+  }
+  else {
+    pNode = m_pCache;
+    m_pCache = pNode->pNextPooled;
+    pNode->pNextPooled = nullptr;
+  }
+
+  const std::size_t nCheckOut( m_cntCheckOut.load( std::memory_order_relaxed ) + 1 );
+  m_cntCheckOut.store( nCheckOut, std::memory_order_relaxed );
+  const std::size_t nCheckIn( m_cntCheckIn.load( std::memory_order_relaxed ) );
+  if ( nCheckOut > nCheckIn ) {
+    const std::size_t nOutstanding( nCheckOut - nCheckIn );
+    if ( nOutstanding > m_nOutstandingMax.load( std::memory_order_relaxed ) ) {
+      m_nOutstandingMax.store( nOutstanding, std::memory_order_relaxed );
+    }
+  }
+
+  return pNode;
+}
+
+template<typename bufferT>
+typename BufferRepositoryMPSC<bufferT>::Stats BufferRepositoryMPSC<bufferT>::GetStats() const {
+  Stats stats;
+  stats.nCheckOut = m_cntCheckOut.load( std::memory_order_relaxed );
+  stats.nCheckIn = m_cntCheckIn.load( std::memory_order_relaxed );
+  stats.nCrossThreadReturn = m_cntCrossThreadReturn.load( std::memory_order_relaxed );
+  stats.nCreated = m_cntCreated.load( std::memory_order_relaxed );
+  stats.nOutstandingMax = m_nOutstandingMax.load( std::memory_order_relaxed );
+  return stats;
+}
+
+} // ou
@@ -92,6 +92,10 @@ public:
     m_pT.reset();
   }
 
+  static T* ReleaseLocalCommonInstance() { // unassigned without deletion, for an instance owned elsewhere
+    return m_pT.release();
+  }
+
 protected:
   Singleton() {};          // ctor hidden
   virtual ~Singleton() {}; // dtor hidden
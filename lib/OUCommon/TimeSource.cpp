@@ -21,7 +21,7 @@ boost::local_time::time_zone_ptr TimeSource::m_tzChicago;
 boost::local_time::time_zone_ptr TimeSource::m_tzNewYork;
 
 TimeSource::TimeSource()
-: m_dtLastRetrievedExternalTime( boost::posix_time::microsec_clock::universal_time() )
+: m_nsLastRetrievedExternalTime( Timestamp::Now().Nanoseconds() )
 {
   // http://www.boost.org/doc/libs/1_54_0/doc/html/date_time/examples.html#date_time.examples.local_utc_conversion
   try {
@@ -45,20 +45,21 @@ boost::local_time::time_zone_ptr TimeSource::LoadTimeZone( const std::string& sR
 }
 
 boost::posix_time::ptime TimeSource::External( boost::posix_time::ptime* dt ) {
+  *dt = ExternalStamp().Ptime();
+  return *dt;
+}
+
+Timestamp TimeSource::ExternalStamp() {
   // this ensures we always have a monotonically increasing time (for use in simulations and time time stamping )
-  // TODO:  can this be rewritten without a mutex?  maybe with an atomic increment?
-  std::scoped_lock<std::mutex> lock( m_mutex );
-  boost::posix_time::ptime& dt_ = *dt;  // create reference to existing location for ease of use
-//  dt_ = boost::posix_time::microsec_clock::local_time();
-  dt_ = boost::posix_time::microsec_clock::universal_time(); // changed 2013/08/29
-  if ( m_dtLastRetrievedExternalTime >= dt_ ) {
-    m_dtLastRetrievedExternalTime += boost::posix_time::microsec( 1 );
-    dt_ = m_dtLastRetrievedExternalTime;
-  }
-  else {
-    m_dtLastRetrievedExternalTime = dt_;
-  }
-  return dt_;
+  // universal time, truncated to microseconds as ptime was, steps by a microsecond on a repeat
+  static constexpr Timestamp::rep_t nsPerMicrosecond( 1000 );
+  const Timestamp::rep_t nsNow( ( Timestamp::Now().Nanoseconds() / nsPerMicrosecond ) * nsPerMicrosecond );
+  Timestamp::rep_t nsLast( m_nsLastRetrievedExternalTime.load( std::memory_order_relaxed ) );
+  Timestamp::rep_t ns;
+  do {
+    ns = ( nsLast >= nsNow ) ? ( nsLast + nsPerMicrosecond ) : nsNow;
+  } while ( !m_nsLastRetrievedExternalTime.compare_exchange_weak( nsLast, ns, std::memory_order_relaxed ) );
+  return Timestamp( ns );
 }
 
 boost::posix_time::ptime TimeSource::Local() {
@@ -84,4 +85,4 @@ boost::posix_time::ptime TimeSource::Internal( SimulationContext* context ) {
     return External();
 }
 
-} // ou
\ No newline at end of file
+} // ou
\ No newline at end of file
@@ -16,12 +16,14 @@
 #include <cassert>
 
 #include <mutex>
+#include <atomic>
 #include <vector>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/date_time/local_time/local_time.hpp>
 
 #include "Singleton.h"
+#include "Timestamp.h"
 #include "ReusableBuffers.h"
 
 namespace ou {
@@ -47,6 +49,11 @@ public:
     return External( &dt );
   };
 
+  Timestamp ExternalStamp();  // same monotonic sequence as External, without the ptime construction
+
+  // wall clock at kernel tick resolution, not monotonic, for coarse stamping (timeouts, statistics)
+  static Timestamp Coarse() { return Timestamp::NowCoarse(); }
+
   inline boost::posix_time::ptime Internal() {
     return Internal( &m_contextCommon );
   };
@@ -105,14 +112,12 @@ private:
   BufferRepository<SimulationContext> m_contexts;
 
   SimulationContext m_contextCommon;
-  boost::posix_time::ptime m_dtLastRetrievedExternalTime;
+  std::atomic<Timestamp::rep_t> m_nsLastRetrievedExternalTime;
 
   static bool m_bTzLoaded;
   static boost::local_time::tz_database m_tzDb;
   static boost::local_time::time_zone_ptr m_tzChicago;
   static boost::local_time::time_zone_ptr m_tzNewYork;
-
-  std::mutex m_mutex;
 };
 
 } // ou
@@ -0,0 +1,122 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Timestamp.h
+ * Author:  raymond@burkholder.net
+ * Project: OUCommon
+ * Created: 2026/10/16 11:03:27
+ */
+
+// int64 nanoseconds since 1970-01-01 00:00:00 utc
+// for hot comparisons (merging, windowing, bar building) where boost ptime special value checks add up
+// ptime remains the storage and interface type, Timestamp is derived from it where it is compared repeatedly
+// special values map to the extremes of the range:  not_a_date_time, -infinity, ..., +infinity
+
+#pragma once
+
+#include <ctime>
+#include <limits>
+#include <cstdint>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace ou { // One Unified
+
+class Timestamp {
+public:
+
+  using rep_t = int64_t;
+
+  static constexpr rep_t nsPerSecond = 1'000'000'000;
+
+  constexpr Timestamp(): m_ns( NotADateTime ) {}
+  explicit constexpr Timestamp( rep_t ns ): m_ns( ns ) {}
+  explicit Timestamp( const boost::posix_time::ptime& dt ): m_ns( FromPtime( dt ) ) {}
+
+  constexpr rep_t Nanoseconds() const { return m_ns; }
+  constexpr bool IsNull() const { return NotADateTime == m_ns; }
+
+  boost::posix_time::ptime Ptime() const { return ToPtime( m_ns ); }
+
+  constexpr bool operator< ( const Timestamp& rhs ) const { return m_ns <  rhs.m_ns; }
+  constexpr bool operator<=( const Timestamp& rhs ) const { return m_ns <= rhs.m_ns; }
+  constexpr bool operator> ( const Timestamp& rhs ) const { return m_ns >  rhs.m_ns; }
+  constexpr bool operator>=( const Timestamp& rhs ) const { return m_ns >= rhs.m_ns; }
+  constexpr bool operator==( const Timestamp& rhs ) const { return m_ns == rhs.m_ns; }
+  constexpr bool operator!=( const Timestamp& rhs ) const { return m_ns != rhs.m_ns; }
+
+  // duration between, in nanoseconds, valid for non-special values
+  constexpr rep_t operator-( const Timestamp& rhs ) const { return m_ns - rhs.m_ns; }
+  constexpr Timestamp operator+( rep_t ns ) const { return Timestamp( m_ns + ns ); }
+  constexpr Timestamp operator-( rep_t ns ) const { return Timestamp( m_ns - ns ); }
+
+  static rep_t FromDuration( const boost::posix_time::time_duration& td ) {
+    return td.ticks() * nsPerTick;
+  }
+
+  static rep_t FromPtime( const boost::posix_time::ptime& dt ) {
+    if ( dt.is_special() ) {
+      if ( dt.is_not_a_date_time() ) return NotADateTime;
+      return dt.is_neg_infinity() ? NegInfinity : PosInfinity;
+    }
+    return ( dt - Epoch() ).ticks() * nsPerTick;
+  }
+
+  static boost::posix_time::ptime ToPtime( rep_t ns ) {
+    switch ( ns ) {
+      case NotADateTime: return boost::posix_time::ptime( boost::date_time::not_a_date_time );
+      case NegInfinity:  return boost::posix_time::ptime( boost::date_time::neg_infin );
+      case PosInfinity:  return boost::posix_time::ptime( boost::date_time::pos_infin );
+      default:
+        return Epoch() + boost::posix_time::time_duration( 0, 0, 0, ns / nsPerTick );
+    }
+  }
+
+  // wall clock, full resolution
+  static Timestamp Now() {
+    struct timespec ts;
+    ::clock_gettime( CLOCK_REALTIME, &ts );
+    return Timestamp( ts.tv_sec * nsPerSecond + ts.tv_nsec );
+  }
+
+  // wall clock, resolution of the kernel tick (1-4ms), avoids the clock read
+  static Timestamp NowCoarse() {
+    struct timespec ts;
+#if defined( CLOCK_REALTIME_COARSE )
+    ::clock_gettime( CLOCK_REALTIME_COARSE, &ts );
+#else
+    ::clock_gettime( CLOCK_REALTIME, &ts );
+#endif
+    return Timestamp( ts.tv_sec * nsPerSecond + ts.tv_nsec );
+  }
+
+private:
+
+  static constexpr rep_t NotADateTime = std::numeric_limits<rep_t>::min();
+  static constexpr rep_t NegInfinity  = std::numeric_limits<rep_t>::min() + 1;
+  static constexpr rep_t PosInfinity  = std::numeric_limits<rep_t>::max();
+
+  static constexpr rep_t nsPerTick = nsPerSecond / boost::posix_time::time_duration::ticks_per_second();
+
+  rep_t m_ns;
+
+  static const boost::posix_time::ptime& Epoch() {
+    static const boost::posix_time::ptime epoch( boost::gregorian::date( 1970, 1, 1 ) );
+    return epoch;
+  }
+
+};
+
+} // namespace ou
@@ -37,6 +37,7 @@ public:
   void Close();
 
   bool IsOpen() const { return m_bOpened; }
+  const std::string& FileName() const { return m_sDbFileName; }
 
 protected:
 
@@ -69,6 +70,7 @@ template<class S, class T>
 void SessionBase<S,T>::Open( const std::string& sDbFileName, enumOpenFlags flags ) {
 
   if ( !m_bOpened ) {
+    m_sDbFileName = sDbFileName;
     if ( boost::filesystem::exists( sDbFileName ) ) {
       // open already created and loaded database
       dynamic_cast<S*>( this )->ImplOpen( sDbFileName, flags );
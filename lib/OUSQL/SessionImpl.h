@@ -39,12 +39,19 @@
 // Currently, the same physical structure needs to be re-used.  Structure is provided during statement construction,
 // not necessarily a good thing all the time.
 
+// 2026/10/16
+// transactions: Begin/Commit/RollbackTransaction, nesting, and the Batch scope
+// prepared statements are cached by the database interface on sql text, so ad hoc queries with
+//   the same text are not re-compiled.  InsertMany re-binds one structure per row, per the note above.
+
 
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 #include <typeinfo>
+#include <iostream>
+#include <exception>
 #include <stdexcept>
 
 #include <boost/noncopyable.hpp>
@@ -276,6 +283,54 @@ public:
 
   int64_t GetLastRowId() { return m_db.GetLastRowId(); };  // call after an auto-increment insertion
 
+  // statements are prepared once per sql text, and re-used by later queries with the same text
+  using StatementCacheStats = typename IDatabase::StatementCacheStats;
+  void SetStatementCacheCapacity( size_t nCapacity ) { m_db.SetStatementCacheCapacity( nCapacity ); } // 0 disables
+  StatementCacheStats GetStatementCacheStats() const { return m_db.GetStatementCacheStats(); }
+
+  // transactions nest, only the outermost begin and commit reach the database
+  void BeginTransaction();
+  void CommitTransaction(); // throws when an inner scope rolled back, the whole transaction is then rolled back
+  void RollbackTransaction();
+
+  // a group of writes as one transaction: committed at the end of the scope,
+  //   rolled back when the scope is left through an exception
+  class Batch: boost::noncopyable {
+  public:
+    explicit Batch( SessionImpl& session )
+    : m_session( session ), m_bOpen( true ), m_nUncaught( std::uncaught_exceptions() ) {
+      m_session.BeginTransaction();
+    }
+    ~Batch() {
+      if ( m_bOpen ) {
+        try {
+          if ( m_nUncaught < std::uncaught_exceptions() ) m_session.RollbackTransaction();
+          else m_session.CommitTransaction();
+        }
+        catch ( const std::runtime_error& e ) {
+          std::cout << "SessionImpl::Batch: " << e.what() << std::endl;
+        }
+      }
+    }
+    void Commit() { // rather than at the end of the scope, to receive the error
+      m_bOpen = false;
+      m_session.CommitTransaction();
+    }
+    void Rollback() {
+      m_bOpen = false;
+      m_session.RollbackTransaction();
+    }
+  private:
+    SessionImpl& m_session;
+    bool m_bOpen;
+    const int m_nUncaught;
+  };
+
+  // F: row definition mapped to a table, assignable from the iterator's value type
+  //   one statement re-bound for each row, all rows in one transaction
+  template<class F, class Iterator>
+  size_t InsertMany( Iterator begin, Iterator end );
+
   template<class F>
   void Bind( QueryFields<F>& qf ) {
     typename IDatabase::structStatementState& StatementState
@@ -450,6 +505,13 @@ private:
 
   IDatabase m_db;
 
+  size_t m_nTransactionDepth;
+  bool m_bRollbackOnly; // set by an inner rollback
+
+  void ExecuteSql( const std::string& sSql ) { // no fields, no results
+    QueryFields<NoBind>::pQueryFields_t pQuery = SQL<NoBind>( sSql ); // executes on assignment
+  }
+
   typedef std::map<std::string, pQueryBase_t> mapTableDefs_t;  // map table name to table definition
   typedef typename mapTableDefs_t::iterator mapTableDefs_iter_t;
   typedef std::pair<std::string, pQueryBase_t> mapTableDefs_pair_t;
@@ -464,7 +526,8 @@ private:
 
 // Constructor
 template<class IDatabase>
-SessionImpl<IDatabase>::SessionImpl(): m_bOpened( false ) {
+SessionImpl<IDatabase>::SessionImpl()
+: m_bOpened( false ), m_nTransactionDepth {}, m_bRollbackOnly( false ) {
 }
 
 // Destructor
@@ -497,6 +560,71 @@ void SessionImpl<IDatabase>::ImplClose() {
   }
 }
 
+// BeginTransaction
+template<class IDatabase>
+void SessionImpl<IDatabase>::BeginTransaction() {
+  if ( 0 == m_nTransactionDepth ) {
+    ExecuteSql( "BEGIN TRANSACTION" );
+    m_bRollbackOnly = false;
+  }
+  ++m_nTransactionDepth;
+}
+
+// CommitTransaction
+template<class IDatabase>
+void SessionImpl<IDatabase>::CommitTransaction() {
+  assert( 0 < m_nTransactionDepth );
+  --m_nTransactionDepth;
+  if ( 0 == m_nTransactionDepth ) {
+    if ( m_bRollbackOnly ) {
+      ExecuteSql( "ROLLBACK TRANSACTION" );
+      throw std::runtime_error( "SessionImpl::CommitTransaction: rolled back by an inner scope" );
+    }
+    try {
+      ExecuteSql( "COMMIT TRANSACTION" );
+    }
+    catch ( ... ) { // leave no transaction open
+      try {
+        ExecuteSql( "ROLLBACK TRANSACTION" );
+      }
+      catch ( ... ) {}
+      throw;
+    }
+  }
+}
+
+// RollbackTransaction
+template<class IDatabase>
+void SessionImpl<IDatabase>::RollbackTransaction() {
+  assert( 0 < m_nTransactionDepth );
+  --m_nTransactionDepth;
+  if ( 0 == m_nTransactionDepth ) {
+    ExecuteSql( "ROLLBACK TRANSACTION" );
+  }
+  else {
+    m_bRollbackOnly = true;
+  }
+}
+
+// InsertMany
+template<class IDatabase>
+template<class F, class Iterator>
+size_t SessionImpl<IDatabase>::InsertMany( Iterator begin, Iterator end ) {
+  F f; // the statement binds from this instance
+  typename QueryFields<F>::pQueryFields_t pQuery = Insert<F>( f ).NoExecute();
+  Batch batch( *this );
+  size_t nRows {};
+  for ( Iterator iter = begin; end != iter; ++iter ) {
+    f = *iter;
+    Bind<F>( pQuery );
+    Execute( pQuery );
+    Reset( pQuery );
+    ++nRows;
+  }
+  batch.Commit();
+  return nRows;
+}
+
 // CreateTables
 template<class IDatabase>
 void SessionImpl<IDatabase>::CreateTables() {
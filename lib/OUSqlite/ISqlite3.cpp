@@ -12,6 +12,7 @@
  * See the file LICENSE.txt for redistribution information.             *
  ************************************************************************/
 
+#include <iterator>
 #include <stdexcept>
 #include <cassert>
 
@@ -24,7 +25,7 @@ namespace ou {
 namespace db {
 
 ISqlite3::ISqlite3(void)
-  : m_db( nullptr )
+  : m_db( nullptr ), m_nCacheCapacity( 128 ), m_statsCache {}
 {
 }
 
@@ -43,10 +44,17 @@ void ISqlite3::SessionOpen( const std::string& sDbFileName, enumOpenFlags flags
     throw std::runtime_error( "Db open error" );
   }
 
+  // with more than one connection to the file, wait out another connection's transaction, rather than fail
+  sqlite3_busy_timeout( m_db, 5000 );
+
 }
 
 void ISqlite3::SessionClose( void ) {
   if ( nullptr != m_db ) {
+    {
+      std::lock_guard<std::mutex> lock( m_mutexCache );
+      CacheEvict( 0 );
+    }
     int rtn = sqlite3_close( m_db );
     m_db = nullptr;
     if (  SQLITE_OK != rtn ) {
@@ -62,6 +70,8 @@ void ISqlite3::SessionClose( void ) {
 
 void ISqlite3::PrepareStatement( structStatementState& statement, std::string& sStatement ) {
   sStatement += ";";
+  statement.pStmt = CacheTake( sStatement );
+  if ( nullptr != statement.pStmt ) return;
   int rtn = sqlite3_prepare_v2(
     m_db, sStatement.c_str(), -1, &statement.pStmt, NULL );
   if ( SQLITE_OK != rtn ) {
@@ -138,6 +148,10 @@ void ISqlite3::ResetStatement( structStatementState& statement ) {
 
 void ISqlite3::CloseStatement( structStatementState& statement ) {
   if ( nullptr != statement.pStmt ) { // it shouldn't be zero, but test anyway
+    if ( CacheGive( statement.pStmt ) ) {
+      statement.pStmt = nullptr;
+      return;
+    }
     int rtn = sqlite3_finalize( statement.pStmt );
     if ( SQLITE_OK != rtn ) {
       std::string sErr( "ISqlite3::CloseStatement: " );
@@ -151,5 +165,63 @@ void ISqlite3::CloseStatement( structStatementState& statement ) {
   }
 }
 
+void ISqlite3::SetStatementCacheCapacity( size_t nCapacity ) {
+  std::lock_guard<std::mutex> lock( m_mutexCache );
+  m_nCacheCapacity = nCapacity;
+  CacheEvict( nCapacity );
+}
+
+ISqlite3::StatementCacheStats ISqlite3::GetStatementCacheStats() const {
+  std::lock_guard<std::mutex> lock( m_mutexCache );
+  StatementCacheStats stats( m_statsCache );
+  stats.nCapacity = m_nCacheCapacity;
+  stats.nIdle = m_lruStatement.size();
+  return stats;
+}
+
+sqlite3_stmt* ISqlite3::CacheTake( const std::string& sStatement ) {
+  std::lock_guard<std::mutex> lock( m_mutexCache );
+  mapStatement_t::iterator iter = m_mapStatement.find( sStatement );
+  if ( m_mapStatement.end() == iter ) {
+    ++m_statsCache.nMisses;
+    return nullptr;
+  }
+  sqlite3_stmt* pStmt = *iter->second;
+  m_lruStatement.erase( iter->second );
+  m_mapStatement.erase( iter );
+  ++m_statsCache.nHits;
+  return pStmt;
+}
+
+bool ISqlite3::CacheGive( sqlite3_stmt* pStmt ) {
+  std::lock_guard<std::mutex> lock( m_mutexCache );
+  if ( 0 == m_nCacheCapacity ) return false;
+  sqlite3_reset( pStmt ); // return code is from the last step, which has already been reported
+  sqlite3_clear_bindings( pStmt );
+  m_lruStatement.push_front( pStmt );
+  m_mapStatement.emplace( sqlite3_sql( pStmt ), m_lruStatement.begin() );
+  CacheEvict( m_nCacheCapacity );
+  return true;
+}
+
+// m_mutexCache is held by the caller
+void ISqlite3::CacheEvict( size_t nCapacity ) {
+  while ( nCapacity < m_lruStatement.size() ) {
+    lruStatement_t::iterator iterLru = std::prev( m_lruStatement.end() );
+    sqlite3_stmt* pStmt = *iterLru;
+    std::pair<mapStatement_t::iterator, mapStatement_t::iterator> range
+      = m_mapStatement.equal_range( sqlite3_sql( pStmt ) );
+    for ( mapStatement_t::iterator iter = range.first; range.second != iter; ++iter ) {
+      if ( iterLru == iter->second ) {
+        m_mapStatement.erase( iter );
+        break;
+      }
+    }
+    m_lruStatement.erase( iterLru );
+    sqlite3_finalize( pStmt );
+    ++m_statsCache.nEvictions;
+  }
+}
+
 } // db
 } // ou
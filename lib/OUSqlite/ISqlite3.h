@@ -14,7 +14,10 @@
 
 #pragma once
 
+#include <list>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 //#include <OUSQL/SessionBase.h>  // for the enumerations
 #include <OUSQL/Constants.h>
@@ -47,6 +50,14 @@ public:
   ISqlite3(void);
   ~ISqlite3(void);
 
+  struct StatementCacheStats {
+    size_t nCapacity;
+    size_t nIdle;      // statements currently held for re-use
+    size_t nHits;      // prepares satisfied from the cache
+    size_t nMisses;    // prepares compiled by sqlite
+    size_t nEvictions;
+  };
+
   void SessionOpen( const std::string& sDbFileName, enumOpenFlags = EOpenFlagsZero );
   void SessionClose( void );
 
@@ -59,12 +70,30 @@ public:
     return sqlite3_last_insert_rowid( m_db );
   }
 
+  // closed statements are reset and held, by sql text, for re-use by the next prepare of the same text
+  //   least recently closed are finalized beyond nCapacity, 0 finalizes on close
+  void SetStatementCacheCapacity( size_t nCapacity );
+  StatementCacheStats GetStatementCacheStats() const;
+
 protected:
 
 private:
 
   sqlite3* m_db;
 
+  using lruStatement_t = std::list<sqlite3_stmt*>; // front is most recently closed
+  using mapStatement_t = std::unordered_multimap<std::string, lruStatement_t::iterator>;
+
+  mutable std::mutex m_mutexCache;
+  size_t m_nCacheCapacity;
+  lruStatement_t m_lruStatement;
+  mapStatement_t m_mapStatement;
+  StatementCacheStats m_statsCache;
+
+  sqlite3_stmt* CacheTake( const std::string& sStatement ); // nullptr when not cached
+  bool CacheGive( sqlite3_stmt* ); // false when not cached, the caller finalizes
+  void CacheEvict( size_t nCapacity );
+
 };
 
 } // db
@@ -99,8 +99,9 @@ void InstrumentFilter<S,TS>::HandleObject( const std::string& sPath, const std::
   if ( m_bSendThroughFilter ) {
     typename ou::tf::HDF5TimeSeriesContainer<typename TS::datum_t> tsRepository( m_dm, sPath );
     typename ou::tf::HDF5TimeSeriesContainer<typename TS::datum_t>::iterator begin, end;
-    begin = std::lower_bound( tsRepository.begin(), tsRepository.end(), m_dtDate1 );
-    end   = std::lower_bound( begin, tsRepository.end(), m_dtDate2 );
+    begin = tsRepository.LowerBound( m_dtDate1 );
+    end   = tsRepository.LowerBound( m_dtDate2 );
+    if ( end < begin ) end = begin;
     hsize_t cnt = end - begin;
     if ( m_nRequiredDays <= cnt ) {
       TS timeseries;
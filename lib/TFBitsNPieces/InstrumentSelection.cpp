@@ -73,8 +73,9 @@ public:
 void InstrumentSelection::ProcessGroupItem( const std::string& sObjectPath, const std::string& sObjectName ) {
   ou::tf::HDF5TimeSeriesContainer<ou::tf::Bar> barRepository( m_dm, sObjectPath );
   ou::tf::HDF5TimeSeriesContainer<ou::tf::Bar>::iterator begin, end;
-  begin = std::lower_bound( barRepository.begin(), barRepository.end(), m_dtDate1 );
-  end = std::lower_bound( begin, barRepository.end(), m_dtDate2 );
+  begin = barRepository.LowerBound( m_dtDate1 );
+  end = barRepository.LowerBound( m_dtDate2 );
+  if ( end < begin ) end = begin;
   hsize_t cnt = end - begin;
   if ( 8 < cnt ) {
 //    ptime dttmp = (*(end-1)).DateTime();
@@ -0,0 +1,65 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Encoding.hpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFColumnStore
+ * Created: 2026/10/16 17:41:05
+ */
+
+// the timestamp column: nanoseconds as zigzag varint deltas from the previous row
+//   ticks are mostly microseconds apart, so a delta takes two to four bytes rather than eight
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+namespace ou {
+namespace tf {
+namespace column {
+
+inline uint64_t ZigZag( int64_t n ) { // small magnitudes, of either sign, to small values
+  return ( static_cast<uint64_t>( n ) << 1 ) ^ static_cast<uint64_t>( n >> 63 );
+}
+
+inline int64_t UnZigZag( uint64_t n ) {
+  return static_cast<int64_t>( n >> 1 ) ^ -static_cast<int64_t>( n & 1 );
+}
+
+static const size_t nMaxVarInt = 10; // bytes for a uint64_t, seven bits each
+
+inline void PutVarInt( std::string& s, uint64_t n ) {
+  while ( 0x80 <= n ) {
+    s.push_back( static_cast<char>( ( n & 0x7f ) | 0x80 ) );
+    n >>= 7;
+  }
+  s.push_back( static_cast<char>( n ) );
+}
+
+// returns nullptr when the value runs past pEnd
+inline const uint8_t* GetVarInt( const uint8_t* p, const uint8_t* pEnd, uint64_t& n ) {
+  n = 0;
+  for ( unsigned int shift = 0; ( p < pEnd ) && ( shift < 64 ); shift += 7 ) {
+    const uint8_t b( *p++ );
+    n |= static_cast<uint64_t>( b & 0x7f ) << shift;
+    if ( 0 == ( b & 0x80 ) ) return p;
+  }
+  return nullptr;
+}
+
+} // namespace column
+} // namespace tf
+} // namespace ou
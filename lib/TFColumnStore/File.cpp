@@ -0,0 +1,173 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    File.cpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFColumnStore
+ * Created: 2026/10/16 17:52:19
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "File.hpp"
+
+namespace ou {
+namespace tf {
+namespace column {
+
+namespace {
+
+  static const size_t nHeaderSize = 4096; // a page, the header is mapped on its own
+
+  void Fail( const std::string& sWhat, const std::string& sFileName ) {
+    throw std::runtime_error( "column store: " + sWhat + " " + sFileName + ": " + std::strerror( errno ) );
+  }
+
+} // namespace anonymous
+
+uint64_t FileSize( const std::string& sFileName ) {
+  struct stat st;
+  if ( 0 != ::stat( sFileName.c_str(), &st ) ) return 0;
+  return st.st_size;
+}
+
+// ==== HeaderFile
+
+HeaderFile::HeaderFile( const std::string& sFileName, bool bWriter )
+: m_fd( -1 ), m_pHeader( nullptr ), m_bCreated( false )
+{
+  m_fd = ::open( sFileName.c_str(), bWriter ? ( O_RDWR | O_CREAT ) : O_RDONLY, 0644 );
+  if ( 0 > m_fd ) Fail( "can not open", sFileName );
+
+  if ( bWriter ) {
+    if ( 0 != ::flock( m_fd, LOCK_EX | LOCK_NB ) ) {
+      ::close( m_fd );
+      throw std::runtime_error( "column store: segment has a writer " + sFileName );
+    }
+    struct stat st;
+    if ( 0 != ::fstat( m_fd, &st ) ) Fail( "can not stat", sFileName );
+    if ( (off_t)nHeaderSize > st.st_size ) {
+      if ( 0 != ::ftruncate( m_fd, nHeaderSize ) ) Fail( "can not size", sFileName );
+      m_bCreated = true;
+    }
+  }
+  else {
+    if ( nHeaderSize > FileSize( sFileName ) ) {
+      ::close( m_fd );
+      throw std::runtime_error( "column store: segment header is incomplete " + sFileName );
+    }
+  }
+
+  void* p = ::mmap( nullptr, nHeaderSize, bWriter ? ( PROT_READ | PROT_WRITE ) : PROT_READ, MAP_SHARED, m_fd, 0 );
+  if ( MAP_FAILED == p ) Fail( "can not map", sFileName );
+  m_pHeader = reinterpret_cast<Header*>( p );
+}
+
+HeaderFile::~HeaderFile() {
+  if ( nullptr != m_pHeader ) {
+    ::munmap( m_pHeader, nHeaderSize );
+    m_pHeader = nullptr;
+  }
+  if ( 0 <= m_fd ) {
+    ::close( m_fd ); // releases the lock
+    m_fd = -1;
+  }
+}
+
+// ==== MappedFile
+
+MappedFile::MappedFile( const std::string& sFileName )
+: m_fd( -1 ), m_pData( nullptr ), m_nMapped {}
+{
+  m_fd = ::open( sFileName.c_str(), O_RDONLY );
+  if ( 0 > m_fd ) Fail( "can not open", sFileName );
+}
+
+MappedFile::~MappedFile() {
+  if ( nullptr != m_pData ) {
+    ::munmap( const_cast<uint8_t*>( m_pData ), m_nMapped );
+    m_pData = nullptr;
+  }
+  if ( 0 <= m_fd ) {
+    ::close( m_fd );
+    m_fd = -1;
+  }
+}
+
+bool MappedFile::Map( uint64_t nBytes ) {
+  if ( nBytes <= m_nMapped ) return true;
+  struct stat st;
+  if ( 0 != ::fstat( m_fd, &st ) ) return false;
+  const uint64_t nSize( st.st_size );
+  if ( nSize < nBytes ) return false;
+  void* p = ::mmap( nullptr, nSize, PROT_READ, MAP_SHARED, m_fd, 0 );
+  if ( MAP_FAILED == p ) return false;
+  ::madvise( p, nSize, MADV_SEQUENTIAL ); // columns are mostly scanned
+  if ( nullptr != m_pData ) {
+    ::munmap( const_cast<uint8_t*>( m_pData ), m_nMapped );
+  }
+  m_pData = reinterpret_cast<const uint8_t*>( p );
+  m_nMapped = nSize;
+  return true;
+}
+
+// ==== AppendFile
+
+AppendFile::AppendFile( const std::string& sFileName, uint64_t nSize )
+: m_sFileName( sFileName ), m_fd( -1 ), m_nSize( nSize )
+{
+  m_fd = ::open( sFileName.c_str(), O_WRONLY | O_CREAT, 0644 );
+  if ( 0 > m_fd ) Fail( "can not open", sFileName );
+  // drops what was written past the committed rows, by an interrupted writer
+  if ( 0 != ::ftruncate( m_fd, nSize ) ) Fail( "can not size", sFileName );
+  if ( (off_t)nSize != ::lseek( m_fd, nSize, SEEK_SET ) ) Fail( "can not seek", sFileName );
+}
+
+AppendFile::~AppendFile() {
+  if ( 0 <= m_fd ) {
+    ::close( m_fd );
+    m_fd = -1;
+  }
+}
+
+void AppendFile::Write( const void* p, size_t n ) {
+  const char* pch = reinterpret_cast<const char*>( p );
+  while ( 0 < n ) {
+    const ssize_t nWritten = ::write( m_fd, pch, n );
+    if ( 0 > nWritten ) {
+      if ( EINTR == errno ) continue;
+      Fail( "can not write", m_sFileName );
+    }
+    pch += nWritten;
+    n -= nWritten;
+    m_nSize += nWritten;
+  }
+}
+
+void AppendFile::Sync() {
+  if ( 0 != ::fdatasync( m_fd ) ) Fail( "can not sync", m_sFileName );
+}
+
+} // namespace column
+} // namespace tf
+} // namespace ou
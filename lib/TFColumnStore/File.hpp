@@ -0,0 +1,102 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    File.hpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFColumnStore
+ * Created: 2026/10/16 17:52:19
+ */
+
+// files of a segment:  the header, mapped shared, carries the committed row count,
+//   the columns are appended to by the one writer, and mapped read only by any number of readers
+// errors throw std::runtime_error
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+namespace ou {
+namespace tf {
+namespace column {
+
+struct Header {
+  char rchMagic[ 8 ];
+  uint32_t nVersion;
+  uint32_t nColumns; // other than the timestamp
+  uint64_t nSignature; // of the datum, as in the hdf5 attributes
+  std::atomic<uint64_t> nCount; // committed rows, stored once the columns hold them
+};
+
+static_assert( std::atomic<uint64_t>::is_always_lock_free, "Header::nCount is shared between processes" );
+
+class HeaderFile {
+public:
+  // writer: creates the file if needed, and holds an exclusive lock, throws when another writer has it
+  // reader: the file needs to exist
+  HeaderFile( const std::string& sFileName, bool bWriter );
+  HeaderFile( const HeaderFile& ) = delete;
+  HeaderFile( HeaderFile&& ) = delete;
+  ~HeaderFile();
+  Header& Get() { return *m_pHeader; }
+  const Header& Get() const { return *m_pHeader; }
+  bool Created() const { return m_bCreated; } // by this writer, the header is to be filled in
+protected:
+private:
+  int m_fd;
+  Header* m_pHeader;
+  bool m_bCreated;
+};
+
+class MappedFile { // read only
+public:
+  explicit MappedFile( const std::string& sFileName );
+  MappedFile( const MappedFile& ) = delete;
+  MappedFile( MappedFile&& ) = delete;
+  ~MappedFile();
+  const uint8_t* Data() const { return m_pData; }
+  uint64_t Size() const { return m_nMapped; }
+  // maps the file as it now is, when fewer than nBytes are mapped, false when the file is shorter,
+  //   pointers into the prior mapping are then no longer valid
+  bool Map( uint64_t nBytes );
+protected:
+private:
+  int m_fd;
+  const uint8_t* m_pData;
+  uint64_t m_nMapped;
+};
+
+class AppendFile {
+public:
+  AppendFile( const std::string& sFileName, uint64_t nSize ); // opens or creates, truncated to nSize
+  AppendFile( const AppendFile& ) = delete;
+  AppendFile( AppendFile&& ) = delete;
+  ~AppendFile();
+  void Write( const void*, size_t );
+  uint64_t Size() const { return m_nSize; }
+  void Sync(); // to the disk
+protected:
+private:
+  const std::string m_sFileName;
+  int m_fd;
+  uint64_t m_nSize;
+};
+
+uint64_t FileSize( const std::string& sFileName ); // 0 when there is no file
+
+} // namespace column
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,101 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Layout.hpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFColumnStore
+ * Created: 2026/10/16 17:44:32
+ */
+
+// the columns of each datum type, other than the timestamp
+//   row_t holds one value per column, in column order, each column is a file of fixed width values
+//   the enum names the column indexes, for Segment<DD>::Column<ix>()
+
+#pragma once
+
+#include <tuple>
+#include <array>
+#include <string>
+#include <cstdint>
+
+#include <OUCommon/Timestamp.h>
+
+#include <TFTimeSeries/TimeSeries.h>
+
+namespace ou {
+namespace tf {
+namespace column {
+
+template<typename DD> struct Layout;
+
+template<> struct Layout<Quote> {
+  using series_t = Quotes;
+  enum EColumn { Bid, Ask, BidSize, AskSize };
+  using row_t = std::tuple<Quote::price_t, Quote::price_t, Quote::bidsize_t, Quote::asksize_t>;
+  static constexpr std::array<const char*, 4> rName { "bid", "ask", "bidsize", "asksize" };
+  static row_t Split( const Quote& quote ) {
+    return row_t( quote.Bid(), quote.Ask(), quote.BidSize(), quote.AskSize() );
+  }
+  static Quote Join( const ptime dt, const row_t& row ) {
+    return Quote( dt, std::get<Bid>( row ), std::get<BidSize>( row ), std::get<Ask>( row ), std::get<AskSize>( row ) );
+  }
+};
+
+template<> struct Layout<Trade> {
+  using series_t = Trades;
+  enum EColumn { Price, Volume };
+  using row_t = std::tuple<Trade::price_t, Trade::volume_t>;
+  static constexpr std::array<const char*, 2> rName { "price", "volume" };
+  static row_t Split( const Trade& trade ) {
+    return row_t( trade.Price(), trade.Volume() );
+  }
+  static Trade Join( const ptime dt, const row_t& row ) {
+    return Trade( dt, std::get<Price>( row ), std::get<Volume>( row ) );
+  }
+};
+
+template<> struct Layout<Bar> {
+  using series_t = Bars;
+  enum EColumn { Open, High, Low, Close, Volume };
+  using row_t = std::tuple<Bar::price_t, Bar::price_t, Bar::price_t, Bar::price_t, Bar::volume_t>;
+  static constexpr std::array<const char*, 5> rName { "open", "high", "low", "close", "volume" };
+  static row_t Split( const Bar& bar ) {
+    return row_t( bar.Open(), bar.High(), bar.Low(), bar.Close(), bar.Volume() );
+  }
+  static Bar Join( const ptime dt, const row_t& row ) {
+    return Bar( dt, std::get<Open>( row ), std::get<High>( row ), std::get<Low>( row ), std::get<Close>( row ), std::get<Volume>( row ) );
+  }
+};
+
+template<> struct Layout<DepthByOrder> {
+  using series_t = DepthsByOrder;
+  enum EColumn { Market, Order, Priority, MsgType, Side, Price, Volume };
+  using row_t = std::tuple<Timestamp::rep_t, DepthByOrder::idorder_t, uint64_t, char, char, DepthByOrder::price_t, DepthByOrder::volume_t>;
+  static constexpr std::array<const char*, 7> rName { "market", "order", "priority", "msgtype", "side", "price", "volume" };
+  static row_t Split( const DepthByOrder& depth ) {
+    return row_t(
+      Timestamp::FromPtime( depth.MarketTimeStamp() ), depth.OrderID(), depth.Priority(),
+      depth.MsgType(), depth.Side(), depth.Price(), depth.Volume() );
+  }
+  static DepthByOrder Join( const ptime dt, const row_t& row ) {
+    return DepthByOrder(
+      dt, Timestamp::ToPtime( std::get<Market>( row ) ), std::get<Order>( row ), std::get<Priority>( row ),
+      std::get<MsgType>( row ), std::get<Side>( row ), std::get<Price>( row ), std::get<Volume>( row ) );
+  }
+};
+
+} // namespace column
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,393 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Segment.hpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFColumnStore
+ * Created: 2026/10/16 18:06:47
+ */
+
+// a segment is a directory holding one symbol's datums of one type for one day:
+//   header:  magic, version, column count, datum signature, committed row count
+//   time:    nanoseconds since the epoch, zigzag varint deltas from the previous row
+//   <name>:  one file per Layout<DD> column, fixed width native values
+// SegmentWriter appends rows, Commit writes them to the column files, then stores the row count,
+//   so a reader never sees a row before all of its columns are in the files
+// Segment maps the files read only, Refresh takes up the rows committed since, without locking,
+//   a Segment is used by one thread at a time, any number of Segments read while the one writer appends
+
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <cstring>
+#include <utility>
+#include <iostream>
+#include <type_traits>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "File.hpp"
+#include "Layout.hpp"
+#include "Encoding.hpp"
+
+namespace ou {
+namespace tf {
+namespace column {
+
+static const char rchMagic[ 8 ] = { 'T', 'F', 'C', 'O', 'L', 'S', 'E', 'G' };
+static const uint32_t nVersion = 1;
+
+static const char szHeaderFile[] = "header";
+static const char szTimeFile[] = "time";
+
+namespace detail {
+
+  template<typename Tuple, typename F, size_t... ix>
+  void ForEach( Tuple& tuple, F&& f, std::index_sequence<ix...> ) {
+    ( f( std::integral_constant<size_t, ix>(), std::get<ix>( tuple ) ), ... );
+  }
+
+  template<typename Tuple, typename F>
+  void ForEach( Tuple& tuple, F&& f ) { // f( index, element ) for each element
+    ForEach( tuple, std::forward<F>( f ), std::make_index_sequence<std::tuple_size<std::remove_const_t<Tuple> >::value>() );
+  }
+
+  // throws when the header is not of DD
+  template<typename DD>
+  void Validate( const Header& header, const std::string& sDirectory ) {
+    if (
+         ( 0 != std::memcmp( header.rchMagic, rchMagic, sizeof( rchMagic ) ) )
+      || ( nVersion != header.nVersion )
+      || ( std::tuple_size<typename Layout<DD>::row_t>::value != header.nColumns )
+      || ( DD::Signature() != header.nSignature )
+    ) {
+      throw std::runtime_error( "column store: segment is not of the datum type " + sDirectory );
+    }
+  }
+
+  // decodes nCount timestamps from p, continuing from ns, returns the end of the last one, nullptr when short
+  inline const uint8_t* DecodeTime(
+    const uint8_t* p, const uint8_t* pEnd, uint64_t nCount, Timestamp::rep_t& ns, std::vector<Timestamp::rep_t>* pv
+  ) {
+    for ( uint64_t ix = 0; ix < nCount; ix++ ) {
+      uint64_t n;
+      p = GetVarInt( p, pEnd, n );
+      if ( nullptr == p ) break;
+      ns += UnZigZag( n );
+      if ( nullptr != pv ) pv->push_back( ns );
+    }
+    return p;
+  }
+
+} // namespace detail
+
+// ==== Segment
+
+template<typename DD>
+class Segment {
+public:
+
+  using layout_t = Layout<DD>;
+  using row_t = typename layout_t::row_t;
+  using size_type = uint64_t;
+  static constexpr size_t nColumns = std::tuple_size<row_t>::value;
+
+  explicit Segment( const std::string& sDirectory ); // throws when there is no segment of DD
+  Segment( const Segment& ) = delete;
+  Segment( Segment&& ) = delete;
+
+  size_type Refresh(); // takes up the rows committed since, returns Size()
+
+  size_type Size() const { return m_vTime.size(); }
+
+  Timestamp::rep_t Nanoseconds( size_type ix ) const { return m_vTime[ ix ]; }
+  ptime DateTime( size_type ix ) const { return Timestamp::ToPtime( m_vTime[ ix ] ); }
+  const std::vector<Timestamp::rep_t>& Times() const { return m_vTime; } // decoded by Refresh
+
+  // zero copy, valid until the next Refresh, Size() values
+  template<size_t ix>
+  const std::tuple_element_t<ix, row_t>* Column() const {
+    return reinterpret_cast<const std::tuple_element_t<ix, row_t>*>( m_rpColumn[ ix ]->Data() );
+  }
+
+  DD operator[]( size_type ix ) const;
+
+  size_type LowerBound( const ptime& ) const; // index of first element not before dt, Size() if none
+  size_type UpperBound( const ptime& ) const; // index of first element after dt, Size() if none
+
+  void CopyTo( TimeSeries<DD>&, size_type ixBegin, size_type ixEnd ) const; // appends [ixBegin, ixEnd)
+  void CopyTo( TimeSeries<DD>& series ) const { CopyTo( series, 0, Size() ); }
+
+  class const_iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = DD;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = DD;
+    const_iterator( const Segment* pSegment, size_type ix ): m_pSegment( pSegment ), m_ix( ix ) {}
+    DD operator*() const { return (*m_pSegment)[ m_ix ]; }
+    const_iterator& operator++() { ++m_ix; return *this; }
+    const_iterator& operator+=( difference_type n ) { m_ix += n; return *this; }
+    difference_type operator-( const const_iterator& rhs ) const { return m_ix - rhs.m_ix; }
+    bool operator==( const const_iterator& rhs ) const { return m_ix == rhs.m_ix; }
+    bool operator!=( const const_iterator& rhs ) const { return m_ix != rhs.m_ix; }
+  private:
+    const Segment* m_pSegment;
+    size_type m_ix;
+  };
+
+  const_iterator begin() const { return const_iterator( this, 0 ); }
+  const_iterator end() const { return const_iterator( this, Size() ); }
+
+protected:
+private:
+
+  const std::string m_sDirectory;
+  HeaderFile m_header;
+  MappedFile m_fileTime;
+  std::array<std::unique_ptr<MappedFile>, nColumns> m_rpColumn;
+
+  std::vector<Timestamp::rep_t> m_vTime;
+  const uint8_t* m_pTimeNext; // not yet decoded, within m_fileTime
+  uint64_t m_offTimeNext;
+
+};
+
+template<typename DD>
+Segment<DD>::Segment( const std::string& sDirectory )
+: m_sDirectory( sDirectory )
+, m_header( sDirectory + "/" + szHeaderFile, false )
+, m_fileTime( sDirectory + "/" + szTimeFile )
+, m_pTimeNext( nullptr ), m_offTimeNext {}
+{
+  detail::Validate<DD>( m_header.Get(), m_sDirectory );
+  for ( size_t ix = 0; ix < nColumns; ix++ ) {
+    m_rpColumn[ ix ] = std::make_unique<MappedFile>( m_sDirectory + "/" + layout_t::rName[ ix ] );
+  }
+  Refresh();
+}
+
+template<typename DD>
+typename Segment<DD>::size_type Segment<DD>::Refresh() {
+  const uint64_t nCount( m_header.Get().nCount.load( std::memory_order_acquire ) );
+  if ( m_vTime.size() < nCount ) {
+
+    row_t row;
+    detail::ForEach(
+      row,
+      [this,nCount]( auto ix, auto& value ){
+        if ( !m_rpColumn[ ix ]->Map( nCount * sizeof( value ) ) ) {
+          throw std::runtime_error( "column store: column shorter than its rows " + m_sDirectory + "/" + layout_t::rName[ ix ] );
+        }
+      } );
+
+    m_fileTime.Map( m_fileTime.Size() + 1 ); // whatever has been written since
+    const uint8_t* pEnd( m_fileTime.Data() + m_fileTime.Size() );
+    const uint8_t* p( m_fileTime.Data() + m_offTimeNext );
+    Timestamp::rep_t ns( m_vTime.empty() ? 0 : m_vTime.back() );
+    const uint64_t nNew( nCount - m_vTime.size() );
+    m_vTime.reserve( nCount );
+    p = detail::DecodeTime( p, pEnd, nNew, ns, &m_vTime );
+    if ( ( nullptr == p ) || ( nCount != m_vTime.size() ) ) {
+      throw std::runtime_error( "column store: time column shorter than its rows " + m_sDirectory );
+    }
+    m_offTimeNext = p - m_fileTime.Data();
+  }
+  return Size();
+}
+
+template<typename DD>
+DD Segment<DD>::operator[]( size_type ix ) const {
+  assert( ix < Size() );
+  row_t row;
+  detail::ForEach(
+    row,
+    [this,ix]( auto ixColumn, auto& value ){
+      std::memcpy( &value, m_rpColumn[ ixColumn ]->Data() + ix * sizeof( value ), sizeof( value ) );
+    } );
+  return layout_t::Join( Timestamp::ToPtime( m_vTime[ ix ] ), row );
+}
+
+template<typename DD>
+typename Segment<DD>::size_type Segment<DD>::LowerBound( const ptime& dt ) const {
+  return std::lower_bound( m_vTime.begin(), m_vTime.end(), Timestamp::FromPtime( dt ) ) - m_vTime.begin();
+}
+
+template<typename DD>
+typename Segment<DD>::size_type Segment<DD>::UpperBound( const ptime& dt ) const {
+  return std::upper_bound( m_vTime.begin(), m_vTime.end(), Timestamp::FromPtime( dt ) ) - m_vTime.begin();
+}
+
+template<typename DD>
+void Segment<DD>::CopyTo( TimeSeries<DD>& series, size_type ixBegin, size_type ixEnd ) const {
+  ixEnd = std::min( ixEnd, Size() );
+  if ( ixBegin < ixEnd ) {
+    series.Reserve( series.Size() + ( ixEnd - ixBegin ) );
+    for ( size_type ix = ixBegin; ix < ixEnd; ix++ ) {
+      series.Append( (*this)[ ix ] );
+    }
+  }
+}
+
+// ==== SegmentWriter
+
+template<typename DD>
+class SegmentWriter {
+public:
+
+  using layout_t = Layout<DD>;
+  using row_t = typename layout_t::row_t;
+  using size_type = uint64_t;
+  static constexpr size_t nColumns = std::tuple_size<row_t>::value;
+
+  // creates the segment, or continues one, dropping anything written past its committed rows,
+  //   throws when another writer has the segment
+  explicit SegmentWriter( const std::string& sDirectory );
+  SegmentWriter( const SegmentWriter& ) = delete;
+  SegmentWriter( SegmentWriter&& ) = delete;
+  ~SegmentWriter(); // commits
+
+  void Append( const DD& );
+  void Commit(); // the appended rows become visible to readers
+  void Sync(); // commits, then syncs the files to the disk
+
+  size_type Size() const { return m_nCommitted + m_nPending; }
+  size_type Committed() const { return m_nCommitted; }
+  Timestamp::rep_t Last() const { return m_nsLast; } // of the latest row, 0 when none
+
+protected:
+private:
+
+  const std::string m_sDirectory;
+  HeaderFile m_header;
+  std::unique_ptr<AppendFile> m_pfileTime;
+  std::array<std::unique_ptr<AppendFile>, nColumns> m_rpColumn;
+
+  uint64_t m_nCommitted;
+  uint64_t m_nPending;
+  Timestamp::rep_t m_nsLast;
+
+  std::string m_sTime; // pending rows
+  std::array<std::string, nColumns> m_rsColumn;
+
+};
+
+template<typename DD>
+SegmentWriter<DD>::SegmentWriter( const std::string& sDirectory )
+: m_sDirectory( sDirectory )
+, m_header( ( boost::filesystem::create_directories( sDirectory ), sDirectory + "/" + szHeaderFile ), true )
+, m_nCommitted {}, m_nPending {}, m_nsLast {}
+{
+  Header& header( m_header.Get() );
+  if ( m_header.Created() ) {
+    std::memcpy( header.rchMagic, rchMagic, sizeof( rchMagic ) );
+    header.nVersion = nVersion;
+    header.nColumns = nColumns;
+    header.nSignature = DD::Signature();
+    header.nCount.store( 0, std::memory_order_release );
+  }
+  detail::Validate<DD>( header, m_sDirectory );
+
+  m_nCommitted = header.nCount.load( std::memory_order_acquire );
+
+  uint64_t offTime {};
+  if ( 0 < m_nCommitted ) { // the end of the committed timestamps, and the latest of them
+    const std::string sTimeFile( m_sDirectory + "/" + szTimeFile );
+    MappedFile file( sTimeFile );
+    const uint8_t* p( nullptr );
+    if ( file.Map( FileSize( sTimeFile ) ) ) {
+      p = detail::DecodeTime( file.Data(), file.Data() + file.Size(), m_nCommitted, m_nsLast, nullptr );
+    }
+    if ( nullptr == p ) {
+      throw std::runtime_error( "column store: time column shorter than its rows " + m_sDirectory );
+    }
+    offTime = p - file.Data();
+  }
+  m_pfileTime = std::make_unique<AppendFile>( m_sDirectory + "/" + szTimeFile, offTime );
+
+  row_t row;
+  detail::ForEach(
+    row,
+    [this]( auto ix, auto& value ){
+      const std::string sFileName( m_sDirectory + "/" + layout_t::rName[ ix ] );
+      const uint64_t nSize( m_nCommitted * sizeof( value ) );
+      if ( FileSize( sFileName ) < nSize ) {
+        throw std::runtime_error( "column store: column shorter than its rows " + sFileName );
+      }
+      m_rpColumn[ ix ] = std::make_unique<AppendFile>( sFileName, nSize );
+    } );
+}
+
+template<typename DD>
+SegmentWriter<DD>::~SegmentWriter() {
+  try {
+    Commit();
+  }
+  catch ( const std::runtime_error& e ) {
+    std::cout << e.what() << std::endl;
+  }
+}
+
+template<typename DD>
+void SegmentWriter<DD>::Append( const DD& datum ) {
+  const Timestamp::rep_t ns( Timestamp::FromPtime( datum.DateTime() ) );
+  PutVarInt( m_sTime, ZigZag( ns - m_nsLast ) );
+  m_nsLast = ns;
+  row_t row( layout_t::Split( datum ) );
+  detail::ForEach(
+    row,
+    [this]( auto ix, const auto& value ){
+      m_rsColumn[ ix ].append( reinterpret_cast<const char*>( &value ), sizeof( value ) );
+    } );
+  m_nPending++;
+}
+
+template<typename DD>
+void SegmentWriter<DD>::Commit() {
+  if ( 0 < m_nPending ) {
+    for ( size_t ix = 0; ix < nColumns; ix++ ) {
+      m_rpColumn[ ix ]->Write( m_rsColumn[ ix ].data(), m_rsColumn[ ix ].size() );
+      m_rsColumn[ ix ].clear();
+    }
+    m_pfileTime->Write( m_sTime.data(), m_sTime.size() );
+    m_sTime.clear();
+    m_nCommitted += m_nPending;
+    m_nPending = 0;
+    m_header.Get().nCount.store( m_nCommitted, std::memory_order_release ); // after the columns are in the files
+  }
+}
+
+template<typename DD>
+void SegmentWriter<DD>::Sync() {
+  Commit();
+  for ( std::unique_ptr<AppendFile>& pFile: m_rpColumn ) {
+    pFile->Sync();
+  }
+  m_pfileTime->Sync();
+}
+
+} // namespace column
+} // namespace tf
+} // namespace ou
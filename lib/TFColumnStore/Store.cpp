@@ -0,0 +1,63 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Store.cpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFColumnStore
+ * Created: 2026/10/16 18:31:12
+ */
+
+#include <cctype>
+#include <algorithm>
+
+#include <boost/filesystem.hpp>
+#include <boost/date_time/gregorian/gregorian.hpp>
+
+#include "Store.hpp"
+
+namespace ou {
+namespace tf {
+namespace column {
+
+Store::Store( const std::string& sRoot )
+: m_sRoot( sRoot )
+{
+  while ( ( 1 < m_sRoot.size() ) && ( '/' == m_sRoot.back() ) ) m_sRoot.pop_back(); // Directory() leads with '/'
+}
+
+std::string Store::DayName( date day ) {
+  return boost::gregorian::to_iso_string( day );
+}
+
+std::vector<Store::date> Store::Days( const std::string& sDirectory ) {
+  std::vector<date> vDay;
+  boost::system::error_code ec;
+  for ( boost::filesystem::directory_iterator iter( sDirectory, ec ), end; iter != end; iter.increment( ec ) ) {
+    if ( ec ) break;
+    const std::string sName( iter->path().filename().string() );
+    if ( ( 8 == sName.size() ) && std::all_of( sName.begin(), sName.end(), ::isdigit ) ) {
+      try {
+        vDay.push_back( boost::gregorian::from_undelimited_string( sName ) );
+      }
+      catch ( const std::exception& ) {} // not a segment
+    }
+  }
+  std::sort( vDay.begin(), vDay.end() );
+  return vDay;
+}
+
+} // namespace column
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,120 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Store.hpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFColumnStore
+ * Created: 2026/10/16 18:31:12
+ */
+
+// a tree of segments, in the naming of the hdf5 file:
+//   <root>/quotes/<symbol>/<yyyymmdd>/, <root>/trades/<symbol>/<yyyymmdd>/, ...
+// one segment per symbol, datum type, and utc day
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+
+#include "Segment.hpp"
+
+namespace ou {
+namespace tf {
+namespace column {
+
+class Store {
+public:
+
+  using date = boost::gregorian::date;
+
+  explicit Store( const std::string& sRoot );
+
+  const std::string& Root() const { return m_sRoot; }
+
+  template<typename DD>
+  std::string Directory( const std::string& sSymbol ) const {
+    return m_sRoot + Layout<DD>::series_t::Directory() + sSymbol;
+  }
+
+  template<typename DD>
+  std::string Directory( const std::string& sSymbol, date day ) const {
+    return Directory<DD>( sSymbol ) + "/" + DayName( day );
+  }
+
+  template<typename DD>
+  std::vector<date> Days( const std::string& sSymbol ) const { // ascending
+    return Days( Directory<DD>( sSymbol ) );
+  }
+
+  // appends the datums of [dtBegin, dtEnd) to series
+  template<typename DD>
+  void Load( const std::string& sSymbol, const ptime dtBegin, const ptime dtEnd, TimeSeries<DD>& series ) const;
+
+  // appends datums, routed to the segment of their day, datums arrive in time order
+  template<typename DD>
+  class Writer {
+  public:
+    Writer( const Store& store, const std::string& sSymbol )
+    : m_store( store ), m_sSymbol( sSymbol ) {}
+    Writer( const Writer& ) = delete;
+    Writer( Writer&& ) = delete;
+    void Append( const DD& datum ) {
+      const date day( datum.DateTime().date() );
+      if ( day != m_day ) {
+        m_pSegment.reset(); // commits the prior day
+        m_pSegment = std::make_unique<SegmentWriter<DD> >( m_store.Directory<DD>( m_sSymbol, day ) );
+        m_day = day;
+      }
+      m_pSegment->Append( datum );
+    }
+    void Commit() { if ( m_pSegment ) m_pSegment->Commit(); }
+    void Sync() { if ( m_pSegment ) m_pSegment->Sync(); }
+  protected:
+  private:
+    const Store& m_store;
+    const std::string m_sSymbol;
+    date m_day;
+    std::unique_ptr<SegmentWriter<DD> > m_pSegment;
+  };
+
+  static std::string DayName( date ); // yyyymmdd
+
+protected:
+private:
+
+  std::string m_sRoot;
+
+  static std::vector<date> Days( const std::string& sDirectory );
+
+};
+
+template<typename DD>
+void Store::Load( const std::string& sSymbol, const ptime dtBegin, const ptime dtEnd, TimeSeries<DD>& series ) const {
+  const date dayBegin( dtBegin.date() );
+  const date dayEnd( dtEnd.date() );
+  for ( const date day: Days<DD>( sSymbol ) ) {
+    if ( ( dayBegin <= day ) && ( day <= dayEnd ) ) {
+      Segment<DD> segment( Directory<DD>( sSymbol, day ) );
+      segment.CopyTo( series, segment.LowerBound( dtBegin ), segment.LowerBound( dtEnd ) );
+    }
+  }
+}
+
+} // namespace column
+} // namespace tf
+} // namespace ou
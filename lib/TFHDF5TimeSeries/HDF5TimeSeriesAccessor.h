@@ -15,6 +15,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <algorithm>
 
 #include <TFTimeSeries/DatedDatum.h>
 
@@ -28,16 +30,27 @@ namespace tf { // TradeFrame
 // purpose is to get around the other circular reference of iterator needs to
 //  know about the container, and the container issues the iterator
 
+// single element reads go through a small lru cache of blocks, each block is m_nStride elements
+// time seeks use a sparse index, the time of every m_nStride'th element, so a seek is a binary search
+//   of the index followed by one block read
+// the index is built on first use, kept current by Write, and persisted as attributes on the dataset
+//   (when the file is writable) once, on destruction, it is reused on open when the element count still matches
+// the first Write after the index is persisted removes the stored copy, so an interrupted run rebuilds it
+// the stride doubles as the dataset grows so the index stays within the attribute size limit
+
 // class DD needs to be composed from the CDatedDatum class for access to ptime element
 template<class DD> class HDF5TimeSeriesAccessor {
 public:
-  explicit HDF5TimeSeriesAccessor<DD>( HDF5DataManager& dm, const std::string &sPathName );
+  // pl: dataset access properties, such as the chunk cache for a dataset kept open for appends
+  explicit HDF5TimeSeriesAccessor<DD>( HDF5DataManager& dm, const std::string &sPathName, const H5::DSetAccPropList& pl = H5::DSetAccPropList::DEFAULT );
   virtual ~HDF5TimeSeriesAccessor<DD>( void );
   typedef hsize_t size_type;
   size_type size() const { return m_curElementCount; };
   void Read( hsize_t index, DD* );
   void Read( hsize_t ixStart, hsize_t count, H5::DataSpace *pMemoryDataSpace, DD* pDatedDatum );
   void Write( hsize_t ixStart, size_t count, const DD* );
+  size_type LowerBound( const ptime& ); // index of first element not before dt, size() if none
+  size_type UpperBound( const ptime& ); // index of first element after dt, size() if none
 protected:
   std::string m_sPathName;
   H5::DataSet* m_pDiskDataSet;
@@ -46,7 +59,42 @@ protected:
   virtual void SetNewSize( size_type size ) {};
   void UpdateElementCount( void );
 private:
+
+  static constexpr size_type nMinStride = 1024; // elements, the default chunk size used by HDF5WriteTimeSeries
+  static constexpr size_type nMaxIndexEntries = 4096; // 32KB attribute, below the 64KB compact attribute limit
+  static constexpr size_t nCachedBlocks = 4;
+
+  static constexpr const char* szTimeIndex = "TimeIndex";
+  static constexpr const char* szTimeIndexStride = "TimeIndexStride";
+  static constexpr const char* szTimeIndexCount = "TimeIndexCount";
+
   HDF5DataManager& m_dm;
+
+  struct Block {
+    size_type ixBlock;
+    uint64_t nLastUse;
+    std::vector<DD> vDatum;
+  };
+  std::vector<Block> m_vBlock;
+  uint64_t m_nUse;
+
+  bool m_bIndex;
+  bool m_bIndexDirty; // m_vIndex differs from the stored copy
+  size_type m_nStride;
+  std::vector<ptime> m_vIndex; // m_vIndex[ k ] is the time of element k * m_nStride
+
+  void ReadElement( hsize_t index, DD* ); // uncached
+  const Block& GetBlock( size_type ixBlock );
+  void InvalidateFrom( size_type index );
+  void SetStride( size_type nStride ); // blocks are cached per stride
+
+  size_type Search( const ptime&, bool bUpper );
+  void EnsureIndex();
+  void ExtendIndex();
+  bool LoadIndex();
+  void SaveIndex();
+  void RemoveIndex();
+
   HDF5TimeSeriesAccessor( const HDF5TimeSeriesAccessor& ); // copy constructor not implemented
   HDF5TimeSeriesAccessor& operator=( const HDF5TimeSeriesAccessor& ); // assignment constructor not implemented
 };
@@ -60,12 +108,13 @@ template<class DD> void HDF5TimeSeriesAccessor<DD>::UpdateElementCount( void ) {
   SetNewSize( m_curElementCount );
 }
 
-template<class DD> HDF5TimeSeriesAccessor<DD>::HDF5TimeSeriesAccessor( HDF5DataManager& dm, const std::string &sPathName):
+template<class DD> HDF5TimeSeriesAccessor<DD>::HDF5TimeSeriesAccessor( HDF5DataManager& dm, const std::string &sPathName, const H5::DSetAccPropList& pl ):
   m_dm( dm ),
-  m_sPathName( sPathName ) {
+  m_sPathName( sPathName ),
+  m_nUse {}, m_bIndex( false ), m_bIndexDirty( false ), m_nStride( nMinStride ) {
 
   try {
-    m_pDiskDataSet = new H5::DataSet( m_dm.GetH5File()->openDataSet( m_sPathName.c_str() ) );
+    m_pDiskDataSet = new H5::DataSet( m_dm.GetH5File()->openDataSet( m_sPathName.c_str(), pl ) );
     m_pDiskCompType = new H5::CompType( *m_pDiskDataSet );
 
     H5::CompType *pMemCompType = DD::DefineDataType( NULL );
@@ -90,6 +139,7 @@ template<class DD> HDF5TimeSeriesAccessor<DD>::HDF5TimeSeriesAccessor( HDF5DataM
 }
 
 template<class DD> HDF5TimeSeriesAccessor<DD>::~HDF5TimeSeriesAccessor() {
+  if ( m_bIndexDirty ) SaveIndex();
   m_pDiskCompType->close();
   delete m_pDiskCompType;
   //m_pDiskDataSet->flush( H5F_SCOPE_LOCAL );
@@ -98,6 +148,12 @@ template<class DD> HDF5TimeSeriesAccessor<DD>::~HDF5TimeSeriesAccessor() {
 }
 
 template<class DD> void HDF5TimeSeriesAccessor<DD>::Read( hsize_t ixSource, DD* pDatedDatum ) {
+  assert( ixSource < m_curElementCount );
+  const Block& block( GetBlock( ixSource / m_nStride ) );
+  *pDatedDatum = block.vDatum[ ixSource - block.ixBlock * m_nStride ];
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::ReadElement( hsize_t ixSource, DD* pDatedDatum ) {
   // store the retrieved value in pDatedDatum
   assert( ixSource < m_curElementCount );
   try {
@@ -201,6 +257,20 @@ template<class DD> void HDF5TimeSeriesAccessor<DD>::Write( hsize_t ixStart, size
       if ( m_curElementCount == oldElementCount ) {
         //cout << "Dataset did not expand" << endl;
       }
+
+      InvalidateFrom( ixStart );
+      if ( m_bIndex ) {
+        // drop entries at or after ixStart, take new entries from the written data, then any remaining tail from disk
+        m_vIndex.resize( std::min<size_type>( m_vIndex.size(), ( ixStart + m_nStride - 1 ) / m_nStride ) );
+        for ( size_type ix = m_vIndex.size() * m_nStride; ix < ixStart + count; ix += m_nStride ) {
+          m_vIndex.push_back( pDatedDatum[ ix - ixStart ].DateTime() );
+        }
+        ExtendIndex();
+        if ( !m_bIndexDirty ) {
+          RemoveIndex();
+          m_bIndexDirty = true;
+        }
+      }
       //cout << "Wrote " << count << ", total " << m_curElementCount << endl;
     }
     catch ( H5::Exception e ) {
@@ -213,5 +283,182 @@ template<class DD> void HDF5TimeSeriesAccessor<DD>::Write( hsize_t ixStart, size
   }
 }
 
+template<class DD>
+const typename HDF5TimeSeriesAccessor<DD>::Block& HDF5TimeSeriesAccessor<DD>::GetBlock( size_type ixBlock ) {
+  ++m_nUse;
+  Block* pBlock( nullptr );
+  for ( Block& block: m_vBlock ) {
+    if ( ixBlock == block.ixBlock ) {
+      block.nLastUse = m_nUse;
+      return block;
+    }
+    if ( ( nullptr == pBlock ) || ( block.nLastUse < pBlock->nLastUse ) ) pBlock = &block;
+  }
+  if ( nCachedBlocks > m_vBlock.size() ) {
+    m_vBlock.emplace_back( Block() );
+    pBlock = &m_vBlock.back();
+  }
+  const size_type ixStart( ixBlock * m_nStride );
+  const size_type count( std::min( m_nStride, m_curElementCount - ixStart ) );
+  pBlock->ixBlock = ixBlock;
+  pBlock->nLastUse = m_nUse;
+  pBlock->vDatum.resize( count );
+  H5::DataSpace dsMemory( 1, &count );
+  Read( ixStart, count, &dsMemory, pBlock->vDatum.data() );
+  dsMemory.close();
+  return *pBlock;
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::SetStride( size_type nStride ) {
+  if ( m_nStride != nStride ) {
+    m_nStride = nStride;
+    m_vBlock.clear();
+    m_nUse = 0;
+  }
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::InvalidateFrom( size_type index ) {
+  const size_type ixBlock( index / m_nStride );
+  m_vBlock.erase(
+    std::remove_if( m_vBlock.begin(), m_vBlock.end(), [ixBlock]( const Block& block ){ return ixBlock <= block.ixBlock; } ),
+    m_vBlock.end() );
+}
+
+template<class DD>
+typename HDF5TimeSeriesAccessor<DD>::size_type HDF5TimeSeriesAccessor<DD>::LowerBound( const ptime& dt ) {
+  return Search( dt, false );
+}
+
+template<class DD>
+typename HDF5TimeSeriesAccessor<DD>::size_type HDF5TimeSeriesAccessor<DD>::UpperBound( const ptime& dt ) {
+  return Search( dt, true );
+}
+
+template<class DD>
+typename HDF5TimeSeriesAccessor<DD>::size_type HDF5TimeSeriesAccessor<DD>::Search( const ptime& dt, bool bUpper ) {
+  EnsureIndex();
+  // first index entry which qualifies, the answer is then in the block preceding it
+  const size_type k = ( bUpper
+    ? std::upper_bound( m_vIndex.begin(), m_vIndex.end(), dt )
+    : std::lower_bound( m_vIndex.begin(), m_vIndex.end(), dt ) ) - m_vIndex.begin();
+  if ( 0 == k ) return 0;
+  const Block& block( GetBlock( k - 1 ) );
+  using iterator_t = typename std::vector<DD>::const_iterator;
+  const iterator_t iter = bUpper
+    ? std::upper_bound( block.vDatum.begin(), block.vDatum.end(), dt, []( const ptime& dt_, const DD& dd ){ return dt_ < dd.DateTime(); } )
+    : std::lower_bound( block.vDatum.begin(), block.vDatum.end(), dt, []( const DD& dd, const ptime& dt_ ){ return dd.DateTime() < dt_; } );
+  return ( k - 1 ) * m_nStride + ( iter - block.vDatum.begin() );
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::EnsureIndex() {
+  if ( !m_bIndex ) {
+    m_bIndex = true;
+    if ( !LoadIndex() ) {
+      m_vIndex.clear();
+      size_type nStride( nMinStride );
+      while ( nMaxIndexEntries < ( m_curElementCount + nStride - 1 ) / nStride ) nStride *= 2;
+      SetStride( nStride );
+      ExtendIndex();
+      m_bIndexDirty = true;
+    }
+  }
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::ExtendIndex() {
+  DD dd;
+  for ( size_type ix = m_vIndex.size() * m_nStride; ix < m_curElementCount; ix += m_nStride ) {
+    ReadElement( ix, &dd );
+    m_vIndex.push_back( dd.DateTime() );
+  }
+  if ( nMaxIndexEntries < m_vIndex.size() ) {
+    while ( nMaxIndexEntries < m_vIndex.size() ) {
+      // keep the even entries, they are the entries for the doubled stride
+      size_type ix {};
+      for ( size_type k = 0; k < m_vIndex.size(); k += 2 ) m_vIndex[ ix++ ] = m_vIndex[ k ];
+      m_vIndex.resize( ix );
+      SetStride( 2 * m_nStride );
+    }
+  }
+}
+
+template<class DD> bool HDF5TimeSeriesAccessor<DD>::LoadIndex() {
+  static_assert( sizeof( ptime ) == sizeof( int64_t ), "ptime is stored as int64" );
+  bool bLoaded( false );
+  try {
+    if ( m_pDiskDataSet->attrExists( szTimeIndexCount ) ) {
+      uint64_t nCount, nStride;
+      H5::Attribute attrCount( m_pDiskDataSet->openAttribute( szTimeIndexCount ) );
+      attrCount.read( H5::PredType::NATIVE_UINT64, &nCount );
+      attrCount.close();
+      H5::Attribute attrStride( m_pDiskDataSet->openAttribute( szTimeIndexStride ) );
+      attrStride.read( H5::PredType::NATIVE_UINT64, &nStride );
+      attrStride.close();
+      if ( ( m_curElementCount == nCount ) && ( nMinStride <= nStride ) ) {
+        H5::Attribute attrIndex( m_pDiskDataSet->openAttribute( szTimeIndex ) );
+        H5::DataSpace ds( attrIndex.getSpace() );
+        const hssize_t nEntries( ds.getSimpleExtentNpoints() );
+        ds.close();
+        if ( (hssize_t)( ( nCount + nStride - 1 ) / nStride ) == nEntries ) {
+          SetStride( nStride );
+          m_vIndex.resize( nEntries );
+          attrIndex.read( H5::PredType::NATIVE_INT64, m_vIndex.data() );
+          bLoaded = true;
+        }
+        attrIndex.close();
+      }
+    }
+  }
+  catch ( H5::Exception& e ) {
+    // rebuild instead
+  }
+  if ( !bLoaded ) m_vIndex.clear();
+  return bLoaded;
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::SaveIndex() {
+  unsigned int intent {};
+  H5Fget_intent( m_dm.GetH5File()->getId(), &intent );
+  if ( 0 == ( intent & H5F_ACC_RDWR ) ) return;
+  try {
+    RemoveIndex();
+    if ( !m_vIndex.empty() ) {
+      const hsize_t nEntries( m_vIndex.size() );
+      H5::DataSpace dsIndex( 1, &nEntries );
+      H5::Attribute attrIndex( m_pDiskDataSet->createAttribute( szTimeIndex, H5::PredType::NATIVE_INT64, dsIndex ) );
+      attrIndex.write( H5::PredType::NATIVE_INT64, m_vIndex.data() );
+      attrIndex.close();
+      dsIndex.close();
+      const uint64_t nStride( m_nStride );
+      const uint64_t nCount( m_curElementCount );
+      H5::DataSpace dsScalar( H5S_SCALAR );
+      H5::Attribute attrStride( m_pDiskDataSet->createAttribute( szTimeIndexStride, H5::PredType::NATIVE_UINT64, dsScalar ) );
+      attrStride.write( H5::PredType::NATIVE_UINT64, &nStride );
+      attrStride.close();
+      H5::Attribute attrCount( m_pDiskDataSet->createAttribute( szTimeIndexCount, H5::PredType::NATIVE_UINT64, dsScalar ) );
+      attrCount.write( H5::PredType::NATIVE_UINT64, &nCount );
+      attrCount.close();
+      dsScalar.close();
+    }
+  }
+  catch ( H5::Exception& e ) {
+    std::cout << "HDF5TimeSeriesAccessor<DD>::SaveIndex " << e.getDetailMsg() << std::endl;
+  }
+  m_bIndexDirty = false;
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::RemoveIndex() {
+  unsigned int intent {};
+  H5Fget_intent( m_dm.GetH5File()->getId(), &intent );
+  if ( 0 == ( intent & H5F_ACC_RDWR ) ) return;
+  try {
+    for ( const char* sz: { szTimeIndex, szTimeIndexStride, szTimeIndexCount } ) {
+      if ( m_pDiskDataSet->attrExists( sz ) ) m_pDiskDataSet->removeAttr( sz );
+    }
+  }
+  catch ( H5::Exception& e ) {
+    std::cout << "HDF5TimeSeriesAccessor<DD>::RemoveIndex " << e.getDetailMsg() << std::endl;
+  }
+}
+
 } // namespace tf
 } // namespace ou
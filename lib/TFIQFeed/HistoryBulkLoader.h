@@ -0,0 +1,967 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HistoryBulkLoader.h
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFIQFeed
+ * Created: 2026/10/16 19:24:05
+ */
+
+#pragma once
+
+// downloads history for a list of symbols over a pool of connections to the history port
+//   requests are sent at up to the feed's request rate, with a few queued on each connection
+//     so the next reply follows the last without a round trip
+//   a connection's network thread only finds the request and the end of each line's reply, the
+//     line buffer is handed to the parser thread of the request, which gives it back when parsed
+//   datums arrive at the owner in Batch structures, the owner gives each back with Release(),
+//     with nMaxBatches out, parsing waits, and with nMaxQueuedLines unparsed, requests wait
+//   a request failing part way is retried, datums already handed over are skipped in the retry
+//   the checkpoint file lists the requests whose last Batch has been released, they are skipped
+//     when the file is loaded on a re-run
+// the owner calls Stop() before it is destroyed, callbacks arrive on the parser threads
+
+#include <map>
+#include <set>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <condition_variable>
+
+#include <boost/filesystem.hpp>
+
+#include <OUCommon/Network.h>
+#include <OUCommon/ReusableBuffers.h>
+
+#include <TFTimeSeries/TimeSeries.h>
+
+#include "HistoryQuery.h" // HistoryStructs parsers
+#include "HistoryReplay.h" // ReplayFileName
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+struct HistoryBulkConfig {
+
+  size_t nConnections;
+  size_t nPipeline; // requests queued on a connection
+  size_t nParsers;
+  double dblRequestsPerSecond; // credits, as the feed hands them out
+  size_t nBatchDatums; // datums per Batch, 0 for a request in one Batch
+  size_t nMaxBatches; // with the owner at once
+  size_t nMaxQueuedLines; // received but not parsed
+  size_t nMaxAttempts; // per request
+  std::chrono::milliseconds msRetry; // doubled with each attempt
+  std::chrono::seconds secStall; // a connection with a request out and no reply for this long is dropped
+  std::string sAddress;
+  unsigned short nPort;
+  std::string sCheckpointFile; // empty for none
+  std::string sRecordDirectory; // replies written for HistoryReplay, empty for none
+
+  HistoryBulkConfig()
+  : nConnections( 15 ), nPipeline( 2 ), nParsers( 2 )
+  , dblRequestsPerSecond( 50.0 ) // 2020/12/23 a credit each 20ms, see HistoryBulkQuery.h
+  , nBatchDatums( 0 ), nMaxBatches( 64 ), nMaxQueuedLines( 1 << 20 )
+  , nMaxAttempts( 5 ), msRetry( 1000 ), secStall( 60 )
+  , sAddress( "127.0.0.1" ), nPort( 9100 )
+  {}
+};
+
+template<typename T>  // T=CRTP based class
+class HistoryBulkLoader {
+public:
+
+  enum class ERequest {
+    EndOfDays, // HDX, bars
+    Intervals, // HIX, bars
+    Ticks,     // HTX, quotes & trades
+    TickDays   // HTD, quotes & trades
+  };
+
+  enum class EStatus { Ok, NoData, Failed };
+
+  struct Request; // forward reference
+
+  struct Batch {
+    std::string sSymbol;
+    ERequest eRequest;
+    size_t nSequence; // within the request
+    bool bLast; // the request's final Batch, possibly without datums
+    EStatus eStatus; // with bLast
+    std::string sError; // with EStatus::NoData, EStatus::Failed
+    Bars bars; // EndOfDays, Intervals
+    Quotes quotes; // Ticks, TickDays:  quote added in sequence before trade
+    Trades trades;
+    Request* pRequest; // internal use
+    size_t Size() const { return bars.Size() + trades.Size(); }
+    void Clear() {
+      sSymbol.clear();
+      sError.clear();
+      bars.Clear();
+      quotes.Clear();
+      trades.Clear();
+      pRequest = nullptr;
+    }
+  };
+
+  struct Stats {
+    size_t nRequests; // added, less those in the checkpoint
+    size_t nSkipped; // in the checkpoint
+    size_t nDone;
+    size_t nNoData;
+    size_t nFailed;
+    size_t nRetries;
+    size_t nLines;
+    size_t nDatums;
+  };
+
+  HistoryBulkLoader( const HistoryBulkConfig& );
+  virtual ~HistoryBulkLoader();
+
+  // symbols for one kind of request, before or after Start()
+  template<typename Iter>
+  void Add( Iter begin, Iter end, ERequest, unsigned int nDatums, unsigned int nIntervalSeconds = 0 );
+
+  void Start();
+  void Wait(); // until the last Batch of each request has been released
+  void Stop(); // requests outstanding are abandoned
+
+  void Release( Batch* ); // from any thread
+
+  Stats GetStats() const;
+
+protected:
+
+  // CRTP callbacks for inheriting class
+  void OnHistoryBatch( Batch* pBatch ) { Release( pBatch ); }
+  void OnHistoryCompletion() {}
+
+private:
+
+  using clock_t = std::chrono::steady_clock;
+
+  class Connection;
+
+  enum class EItem { Line, End, Lost };
+
+  struct Item {
+    EItem eItem;
+    Request* pRequest;
+    uint64_t id; // of the attempt
+    Connection* pConnection;
+    typename ou::Network<Connection>::linebuffer_t* pLine;
+    size_t ixPayload; // past the request id
+  };
+
+  struct Parser {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Item> deque;
+    std::thread thread;
+    HistoryStructs::DataPointParser<typename ou::Network<Connection>::linebuffer_t::const_iterator> grammarDataPoint;
+    HistoryStructs::IntervalParser<typename ou::Network<Connection>::linebuffer_t::const_iterator> grammarInterval;
+    HistoryStructs::EndOfDayParser<typename ou::Network<Connection>::linebuffer_t::const_iterator> grammarEndOfDay;
+  };
+
+public:
+
+  struct Request {
+    std::string sSymbol;
+    ERequest eRequest;
+    std::string sCommand; // HDX, HIX, HTX, HTD
+    std::string sKey; // the request less its id, the checkpoint entry
+    size_t ixParser;
+    size_t nAttempt;
+    std::atomic<uint64_t> id; // of the current attempt, replies to an earlier one are dropped
+    // parser thread:
+    size_t nParsed; // this attempt
+    size_t nDelivered; // in batches handed to the owner, over all attempts, a retry skips as many
+    size_t nSequence;
+    size_t nBad; // lines not parsed
+    bool bError;
+    std::string sError;
+    std::string sRecord;
+    Batch* pBatch;
+    Request(): nAttempt {}, id {}, nParsed {}, nDelivered {}, nSequence {}, nBad {}, bError( false ), pBatch( nullptr ) {}
+  };
+
+private:
+
+  class Connection: public ou::Network<Connection> {
+    friend ou::Network<Connection>;
+  public:
+
+    using inherited_t = ou::Network<Connection>;
+    using linebuffer_t = typename inherited_t::linebuffer_t;
+
+    enum class EState { Idle, Connecting, Ready, Broken, Disconnecting };
+
+    Connection( HistoryBulkLoader& loader, const std::string& sAddress, unsigned short nPort )
+    : inherited_t( sAddress, nPort ), m_tpRetry( clock_t::now() ), m_loader( loader )
+    , m_state( EState::Idle ), m_nInFlight {}, m_nsActivity {}
+    {}
+
+    EState State() const { return m_state.load( std::memory_order_acquire ); }
+    void State( EState state ) { m_state.store( state, std::memory_order_release ); }
+    size_t InFlight() const { return m_nInFlight.load( std::memory_order_acquire ); }
+
+    void Issue( Request* pRequest, const std::string& sCommand ) {
+      {
+        std::scoped_lock<std::mutex> lock( m_mutex );
+        if ( 0 == m_deque.size() ) Touch();
+        m_deque.push_back( pRequest );
+        m_nInFlight.store( m_deque.size(), std::memory_order_release );
+      }
+      this->Send( sCommand );
+    }
+
+    void Fail() { // requests in flight are handed back for another attempt
+      State( EState::Broken );
+      std::deque<Request*> deque;
+      {
+        std::scoped_lock<std::mutex> lock( m_mutex );
+        deque.swap( m_deque );
+        m_nInFlight.store( 0, std::memory_order_release );
+      }
+      for ( Request* pRequest: deque ) {
+        m_loader.Route( Item { EItem::Lost, pRequest, pRequest->id.load( std::memory_order_acquire ), this, nullptr, 0 } );
+      }
+      m_loader.Notify();
+    }
+
+    bool Stalled( clock_t::time_point now, std::chrono::seconds secStall ) const {
+      return ( 0 < InFlight() )
+        && ( secStall < ( now.time_since_epoch() - clock_t::duration( m_nsActivity.load( std::memory_order_relaxed ) ) ) );
+    }
+
+    clock_t::time_point m_tpRetry; // when Idle, for the next connect
+
+  protected:
+
+    // called by Network via CRTP
+    void OnNetworkConnected() {
+      this->Send( "S,SET PROTOCOL,6.2\n" );
+      State( EState::Ready );
+      m_loader.Notify();
+    }
+
+    void OnNetworkDisconnected() {
+      m_tpRetry = clock_t::now() + m_loader.m_config.msRetry;
+      State( EState::Idle );
+      m_loader.Notify();
+    }
+
+    void OnNetworkError( size_t e ) {
+      switch ( State() ) {
+        case EState::Connecting: // the Network's timer disconnects
+          State( EState::Broken );
+          break;
+        case EState::Ready:
+          std::cout << "HistoryBulkLoader connection error " << e << std::endl;
+          Fail();
+          break;
+        default:
+          break;
+      }
+    }
+
+    void OnNetworkLineBuffer( linebuffer_t* pLine ) {
+
+      // <id>,<reply>:  lines without a numeric id, as in 'S,CURRENT PROTOCOL,6.2', are not for a request
+      const typename linebuffer_t::value_type* begin( pLine->data() );
+      const typename linebuffer_t::value_type* end( begin + pLine->size() );
+      const typename linebuffer_t::value_type* p( begin );
+      uint64_t id {};
+      while ( ( p != end ) && ( '0' <= *p ) && ( '9' >= *p ) ) {
+        id = id * 10 + ( *p - '0' );
+        ++p;
+      }
+      if ( ( begin == p ) || ( end == p ) || ( ',' != *p ) ) {
+        this->GiveBackBuffer( pLine );
+        return;
+      }
+      ++p;
+
+      Request* pRequest( nullptr );
+      {
+        std::scoped_lock<std::mutex> lock( m_mutex );
+        if ( !m_deque.empty() && ( id == m_deque.front()->id.load( std::memory_order_relaxed ) ) ) {
+          pRequest = m_deque.front();
+        }
+      }
+      if ( nullptr == pRequest ) { // reply to an abandoned attempt
+        this->GiveBackBuffer( pLine );
+        return;
+      }
+      Touch();
+
+      const size_t nPayload( end - p );
+      const bool bEnd( ( 8 <= nPayload ) && ( 0 == std::memcmp( p, "!ENDMSG!", 8 ) ) );
+      const bool bError( ( 2 <= nPayload ) && ( 'E' == p[ 0 ] ) && ( ',' == p[ 1 ] ) ); // not always followed by !ENDMSG!
+
+      if ( bEnd ) {
+        this->GiveBackBuffer( pLine );
+      }
+      else {
+        m_loader.Route( Item { EItem::Line, pRequest, id, this, pLine, size_t( p - begin ) } );
+      }
+
+      if ( bEnd || bError ) {
+        {
+          std::scoped_lock<std::mutex> lock( m_mutex );
+          m_deque.pop_front();
+          m_nInFlight.store( m_deque.size(), std::memory_order_release );
+        }
+        m_loader.Route( Item { EItem::End, pRequest, id, this, nullptr, 0 } );
+        m_loader.Notify();
+      }
+    }
+
+  private:
+
+    HistoryBulkLoader& m_loader;
+
+    std::atomic<EState> m_state;
+
+    std::mutex m_mutex;
+    std::deque<Request*> m_deque; // in flight, in the order sent
+    std::atomic<size_t> m_nInFlight;
+
+    std::atomic<clock_t::rep> m_nsActivity; // of the latest reply
+
+    void Touch() { m_nsActivity.store( clock_t::now().time_since_epoch().count(), std::memory_order_relaxed ); }
+
+  };
+
+  const HistoryBulkConfig m_config;
+
+  bool m_bStarted;
+  std::atomic<bool> m_bStop;
+
+  mutable std::mutex m_mutex; // requests, the queues, the dispatch decisions
+  std::condition_variable m_cvDispatch;
+  std::deque<std::unique_ptr<Request> > m_dequeRequest; // owns them
+  std::deque<Request*> m_dequeNew;
+  std::multimap<clock_t::time_point, Request*> m_mapRetry;
+  uint64_t m_idNext;
+  size_t m_ixParserNext;
+  double m_dblCredits;
+  clock_t::time_point m_tpCredits;
+
+  std::vector<std::unique_ptr<Connection> > m_vConnection;
+  std::vector<std::unique_ptr<Parser> > m_vParser;
+  std::thread m_threadDispatch;
+
+  std::atomic<size_t> m_nQueuedLines;
+
+  std::mutex m_mutexBatch;
+  std::condition_variable m_cvBatch;
+  std::atomic<size_t> m_nBatchesOut;
+  ou::BufferRepository<Batch> m_reposBatch;
+
+  std::mutex m_mutexWait;
+  std::condition_variable m_cvWait;
+  size_t m_nOutstanding; // requests whose last Batch is not yet released
+
+  std::mutex m_mutexCheckpoint;
+  std::set<std::string> m_setCheckpoint; // loaded
+  std::ofstream m_ofsCheckpoint;
+
+  std::atomic<size_t> m_nRequests;
+  std::atomic<size_t> m_nSkipped;
+  std::atomic<size_t> m_nDone;
+  std::atomic<size_t> m_nNoData;
+  std::atomic<size_t> m_nFailed;
+  std::atomic<size_t> m_nRetries;
+  std::atomic<size_t> m_nLines;
+  std::atomic<size_t> m_nDatums;
+
+  void Notify() { m_cvDispatch.notify_one(); }
+
+  void Route( const Item& );
+  void Dispatch();
+  void Maintain( clock_t::time_point );
+  Request* Next( clock_t::time_point );
+  Connection* Choose();
+  bool Credit( clock_t::time_point );
+  void Issue( Request*, Connection* );
+
+  void Parse( Parser& );
+  void ParseLine( Parser&, Request&, const Item& );
+  void Finish( Request&, bool bLost );
+  Batch& Current( Request& );
+  void Deliver( Request&, bool bLast, EStatus = EStatus::Ok );
+
+  void Checkpoint( const std::string& sKey );
+
+};
+
+template<typename T>
+HistoryBulkLoader<T>::HistoryBulkLoader( const HistoryBulkConfig& config )
+: m_config( config )
+, m_bStarted( false ), m_bStop( false )
+, m_idNext {}, m_ixParserNext {}
+, m_dblCredits( config.dblRequestsPerSecond ), m_tpCredits( clock_t::now() ) // the feed starts with a full bucket
+, m_nQueuedLines {}, m_nBatchesOut {}, m_nOutstanding {}
+, m_nRequests {}, m_nSkipped {}, m_nDone {}, m_nNoData {}, m_nFailed {}, m_nRetries {}, m_nLines {}, m_nDatums {}
+{
+  assert( 0 < m_config.nConnections );
+  assert( 0 < m_config.nPipeline );
+  assert( 0 < m_config.nParsers );
+  assert( 0 < m_config.nMaxBatches );
+  assert( 0.0 < m_config.dblRequestsPerSecond );
+
+  if ( !m_config.sCheckpointFile.empty() ) {
+    std::ifstream ifs( m_config.sCheckpointFile );
+    std::string sLine;
+    while ( std::getline( ifs, sLine ) ) {
+      if ( !sLine.empty() ) m_setCheckpoint.insert( sLine );
+    }
+    m_ofsCheckpoint.open( m_config.sCheckpointFile, std::ios::app );
+    if ( !m_ofsCheckpoint.is_open() ) {
+      throw std::runtime_error( "HistoryBulkLoader: can not open checkpoint " + m_config.sCheckpointFile );
+    }
+  }
+}
+
+template<typename T>
+HistoryBulkLoader<T>::~HistoryBulkLoader() {
+  Stop();
+}
+
+template<typename T>
+template<typename Iter>
+void HistoryBulkLoader<T>::Add( Iter begin, Iter end, ERequest eRequest, unsigned int nDatums, unsigned int nIntervalSeconds ) {
+
+  // the request formats of HistoryQuery, with the id appended when sent
+  std::string sCommand;
+  switch ( eRequest ) {
+    case ERequest::EndOfDays: sCommand = "HDX"; break;
+    case ERequest::Intervals: sCommand = "HIX"; break;
+    case ERequest::Ticks:     sCommand = "HTX"; break;
+    case ERequest::TickDays:  sCommand = "HTD"; break;
+  }
+
+  size_t nAdded {};
+  {
+    std::scoped_lock<std::mutex> lock( m_mutex );
+    while ( begin != end ) {
+      std::unique_ptr<Request> pRequest = std::make_unique<Request>();
+      pRequest->sSymbol = *begin;
+      pRequest->eRequest = eRequest;
+      pRequest->sCommand = sCommand;
+      std::stringstream ss;
+      ss << sCommand << "," << pRequest->sSymbol << ",";
+      switch ( eRequest ) {
+        case ERequest::EndOfDays:
+        case ERequest::Ticks:
+          ss << nDatums << ",1";
+          break;
+        case ERequest::Intervals:
+          ss << nIntervalSeconds << "," << nDatums << ",1";
+          break;
+        case ERequest::TickDays:
+          ss << nDatums << ",,,,1";
+          break;
+      }
+      pRequest->sKey = ss.str();
+      ++begin;
+
+      if ( m_setCheckpoint.end() != m_setCheckpoint.find( pRequest->sKey ) ) {
+        m_nSkipped++;
+        continue;
+      }
+      m_dequeNew.push_back( pRequest.get() );
+      m_dequeRequest.emplace_back( std::move( pRequest ) );
+      nAdded++;
+    }
+  }
+  {
+    std::scoped_lock<std::mutex> lock( m_mutexWait );
+    m_nOutstanding += nAdded;
+  }
+  m_nRequests += nAdded;
+  Notify();
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::Start() {
+  assert( !m_bStarted );
+  m_bStarted = true;
+  for ( size_t ix = 0; ix < m_config.nParsers; ix++ ) {
+    m_vParser.emplace_back( std::make_unique<Parser>() );
+  }
+  for ( std::unique_ptr<Parser>& pParser: m_vParser ) {
+    Parser& parser( *pParser );
+    parser.thread = std::thread( [this,&parser](){ Parse( parser ); } );
+  }
+  for ( size_t ix = 0; ix < m_config.nConnections; ix++ ) {
+    m_vConnection.emplace_back( std::make_unique<Connection>( *this, m_config.sAddress, m_config.nPort ) );
+  }
+  m_threadDispatch = std::thread( [this](){ Dispatch(); } );
+
+  std::scoped_lock<std::mutex> lock( m_mutexWait );
+  if ( 0 == m_nOutstanding ) { // all in the checkpoint
+    m_cvWait.notify_all();
+  }
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::Wait() {
+  std::unique_lock<std::mutex> lock( m_mutexWait );
+  m_cvWait.wait( lock, [this](){ return ( 0 == m_nOutstanding ) || m_bStop.load(); } );
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::Stop() {
+
+  if ( !m_bStarted ) return;
+  m_bStarted = false;
+
+  m_bStop = true;
+  Notify();
+  if ( m_threadDispatch.joinable() ) m_threadDispatch.join();
+
+  {
+    std::scoped_lock<std::mutex> lock( m_mutexBatch );
+    m_cvBatch.notify_all();
+  }
+  {
+    std::scoped_lock<std::mutex> lock( m_mutexWait );
+    m_cvWait.notify_all();
+  }
+
+  // connections are to be disconnected before their destruction
+  for ( std::unique_ptr<Connection>& pConnection: m_vConnection ) {
+    if ( Connection::EState::Ready == pConnection->State() ) {
+      pConnection->State( Connection::EState::Disconnecting );
+      pConnection->Disconnect();
+    }
+  }
+  const clock_t::time_point tpGiveUp( clock_t::now() + std::chrono::seconds( 5 ) );
+  for ( std::unique_ptr<Connection>& pConnection: m_vConnection ) {
+    while ( ( Connection::EState::Idle != pConnection->State() ) && ( clock_t::now() < tpGiveUp ) ) {
+      if ( ( Connection::EState::Broken == pConnection->State() ) ) { // after a read error, connect errors disconnect on a timer
+        pConnection->State( Connection::EState::Disconnecting );
+        pConnection->Disconnect();
+      }
+      std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+  }
+
+  // lines in the parser queues are given back to their connections
+  for ( std::unique_ptr<Parser>& pParser: m_vParser ) {
+    {
+      std::scoped_lock<std::mutex> lock( pParser->mutex );
+    }
+    pParser->cv.notify_one();
+    if ( pParser->thread.joinable() ) pParser->thread.join();
+  }
+
+  m_vConnection.clear();
+  m_vParser.clear();
+}
+
+template<typename T>
+typename HistoryBulkLoader<T>::Stats HistoryBulkLoader<T>::GetStats() const {
+  Stats stats;
+  stats.nRequests = m_nRequests;
+  stats.nSkipped = m_nSkipped;
+  stats.nDone = m_nDone;
+  stats.nNoData = m_nNoData;
+  stats.nFailed = m_nFailed;
+  stats.nRetries = m_nRetries;
+  stats.nLines = m_nLines;
+  stats.nDatums = m_nDatums;
+  return stats;
+}
+
+// ==== dispatch
+
+template<typename T>
+void HistoryBulkLoader<T>::Dispatch() {
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while ( !m_bStop ) {
+    const clock_t::time_point now( clock_t::now() );
+    Maintain( now );
+    bool bIssued( false );
+    if (
+         ( m_nQueuedLines.load( std::memory_order_relaxed ) < m_config.nMaxQueuedLines )
+      && ( m_nBatchesOut.load( std::memory_order_relaxed ) < m_config.nMaxBatches )
+    ) {
+      Request* pRequest( Next( now ) );
+      if ( nullptr != pRequest ) {
+        Connection* pConnection( Choose() );
+        if ( ( nullptr != pConnection ) && Credit( now ) ) {
+          Issue( pRequest, pConnection );
+          bIssued = true;
+        }
+      }
+    }
+    if ( !bIssued ) {
+      m_cvDispatch.wait_for( lock, std::chrono::milliseconds( 5 ) );
+    }
+  }
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::Maintain( clock_t::time_point now ) {
+  const bool bWork( !m_dequeNew.empty() || !m_mapRetry.empty() );
+  for ( std::unique_ptr<Connection>& pConnection: m_vConnection ) {
+    switch ( pConnection->State() ) {
+      case Connection::EState::Idle:
+        if ( bWork && ( pConnection->m_tpRetry <= now ) ) {
+          pConnection->State( Connection::EState::Connecting );
+          pConnection->Connect();
+        }
+        break;
+      case Connection::EState::Ready:
+        if ( pConnection->Stalled( now, m_config.secStall ) ) {
+          std::cout << "HistoryBulkLoader connection stalled" << std::endl;
+          pConnection->Fail();
+        }
+        break;
+      case Connection::EState::Broken:
+        // a connect error is followed by the Network's own disconnect
+        break;
+      default:
+        break;
+    }
+    if ( ( Connection::EState::Broken == pConnection->State() ) && ( 0 == pConnection->InFlight() ) ) {
+      // after a read error or a stall, the connection is replaced by a fresh one
+      //   a Connecting connection which failed also lands here, Disconnect copes with either
+      pConnection->State( Connection::EState::Disconnecting );
+      pConnection->Disconnect();
+    }
+  }
+}
+
+template<typename T>
+typename HistoryBulkLoader<T>::Request* HistoryBulkLoader<T>::Next( clock_t::time_point now ) {
+  if ( !m_mapRetry.empty() && ( m_mapRetry.begin()->first <= now ) ) {
+    return m_mapRetry.begin()->second;
+  }
+  if ( !m_dequeNew.empty() ) {
+    return m_dequeNew.front();
+  }
+  return nullptr;
+}
+
+template<typename T>
+typename HistoryBulkLoader<T>::Connection* HistoryBulkLoader<T>::Choose() {
+  Connection* pChosen( nullptr );
+  size_t nInFlight( m_config.nPipeline );
+  for ( std::unique_ptr<Connection>& pConnection: m_vConnection ) {
+    if ( Connection::EState::Ready == pConnection->State() ) {
+      const size_t n( pConnection->InFlight() );
+      if ( n < nInFlight ) {
+        pChosen = pConnection.get();
+        nInFlight = n;
+        if ( 0 == n ) break;
+      }
+    }
+  }
+  return pChosen;
+}
+
+template<typename T>
+bool HistoryBulkLoader<T>::Credit( clock_t::time_point now ) {
+  // a bucket of credits, refilled at the request rate, as the feed does it
+  const double dblElapsed( std::chrono::duration<double>( now - m_tpCredits ).count() );
+  m_tpCredits = now;
+  m_dblCredits = std::min( m_config.dblRequestsPerSecond, m_dblCredits + dblElapsed * m_config.dblRequestsPerSecond );
+  if ( 1.0 <= m_dblCredits ) {
+    m_dblCredits -= 1.0;
+    return true;
+  }
+  return false;
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::Issue( Request* pRequest, Connection* pConnection ) {
+  if ( !m_mapRetry.empty() && ( m_mapRetry.begin()->second == pRequest ) ) {
+    m_mapRetry.erase( m_mapRetry.begin() );
+  }
+  else {
+    assert( m_dequeNew.front() == pRequest );
+    m_dequeNew.pop_front();
+    pRequest->ixParser = m_ixParserNext++ % m_vParser.size(); // a request keeps its parser over retries
+  }
+  const uint64_t id( ++m_idNext );
+  pRequest->id.store( id, std::memory_order_release );
+  pConnection->Issue( pRequest, pRequest->sKey + "," + std::to_string( id ) + "\n" );
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::Route( const Item& item ) {
+  if ( EItem::Line == item.eItem ) m_nQueuedLines++;
+  Parser& parser( *m_vParser[ item.pRequest->ixParser ] );
+  {
+    std::scoped_lock<std::mutex> lock( parser.mutex );
+    parser.deque.push_back( item );
+  }
+  parser.cv.notify_one();
+}
+
+// ==== parse
+
+template<typename T>
+void HistoryBulkLoader<T>::Parse( Parser& parser ) {
+  std::deque<Item> deque;
+  while ( true ) {
+    {
+      std::unique_lock<std::mutex> lock( parser.mutex );
+      parser.cv.wait( lock, [this,&parser](){ return m_bStop.load() || !parser.deque.empty(); } );
+      if ( parser.deque.empty() ) break; // stopped
+      deque.swap( parser.deque );
+    }
+    for ( const Item& item: deque ) {
+      Request& request( *item.pRequest );
+      const bool bCurrent( item.id == request.id.load( std::memory_order_acquire ) );
+      switch ( item.eItem ) {
+        case EItem::Line:
+          m_nQueuedLines--;
+          m_nLines++;
+          if ( bCurrent && !m_bStop ) ParseLine( parser, request, item );
+          item.pConnection->GiveBackBuffer( item.pLine );
+          break;
+        case EItem::End:
+          if ( bCurrent && !m_bStop ) Finish( request, false );
+          break;
+        case EItem::Lost:
+          if ( bCurrent && !m_bStop ) Finish( request, true );
+          break;
+      }
+    }
+    deque.clear();
+  }
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::ParseLine( Parser& parser, Request& request, const Item& item ) {
+
+  using const_iterator_t = typename ou::Network<Connection>::linebuffer_t::const_iterator;
+  const typename ou::Network<Connection>::linebuffer_t& line( *item.pLine );
+  const_iterator_t bgn( line.begin() + item.ixPayload );
+  const const_iterator_t end( line.end() );
+
+  if ( ( 2 <= ( end - bgn ) ) && ( 'E' == *bgn ) && ( ',' == *( bgn + 1 ) ) ) {
+    request.bError = true;
+    request.sError.assign( bgn + 2, end );
+    return;
+  }
+
+  if ( !m_config.sRecordDirectory.empty() ) {
+    request.sRecord.append( bgn, end );
+    request.sRecord.push_back( '\n' );
+  }
+
+  bool bParsed( false );
+  switch ( request.eRequest ) {
+    case ERequest::EndOfDays: {
+        HistoryStructs::EndOfDay eod;
+        bParsed = qi::parse( bgn, end, parser.grammarEndOfDay, eod ) && ( bgn == end );
+        if ( bParsed && ( request.nParsed++ >= request.nDelivered ) ) {
+          Current( request ).bars.Append(
+            Bar(
+              posix_time::ptime(
+                boost::gregorian::date( eod.Year, eod.Month, eod.Day ),
+                boost::posix_time::time_duration( 23, 59, 59 ) ),
+              eod.Open, eod.High, eod.Low, eod.Close, eod.PeriodVolume ) );
+        }
+      }
+      break;
+    case ERequest::Intervals: {
+        HistoryStructs::Interval interval;
+        bParsed = qi::parse( bgn, end, parser.grammarInterval, interval ) && ( bgn == end );
+        if ( bParsed && ( request.nParsed++ >= request.nDelivered ) ) {
+          Current( request ).bars.Append(
+            Bar(
+              posix_time::ptime(
+                boost::gregorian::date( interval.Year, interval.Month, interval.Day ),
+                boost::posix_time::time_duration( interval.Hour, interval.Minute, interval.Second ) ),
+              interval.Open, interval.High, interval.Low, interval.Close, interval.PeriodVolume ) );
+        }
+      }
+      break;
+    case ERequest::Ticks:
+    case ERequest::TickDays: {
+        HistoryStructs::TickDataPoint dp;
+        bParsed = qi::parse( bgn, end, parser.grammarDataPoint, dp ) && ( bgn == end );
+        if ( bParsed && ( request.nParsed++ >= request.nDelivered ) ) {
+          const posix_time::ptime dt(
+            boost::gregorian::date( dp.Year, dp.Month, dp.Day ),
+            boost::posix_time::time_duration( dp.Hour, dp.Minute, dp.Second, dp.Micro ) );
+          Batch& batch( Current( request ) );
+          batch.quotes.Append( Quote( dt, dp.Bid, 0, dp.Ask, 0 ) );
+          batch.trades.Append( Trade( dt, dp.Last, dp.LastSize ) );
+        }
+      }
+      break;
+  }
+
+  if ( !bParsed ) {
+    if ( 0 == request.nBad++ ) {
+      request.sError = "not parsed: " + std::string( line.begin() + item.ixPayload, end );
+    }
+  }
+  else {
+    if ( ( 0 < m_config.nBatchDatums ) && ( nullptr != request.pBatch ) && ( m_config.nBatchDatums <= request.pBatch->Size() ) ) {
+      Deliver( request, false );
+    }
+  }
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::Finish( Request& request, bool bLost ) {
+
+  if ( bLost && request.sError.empty() ) request.sError = "connection lost";
+
+  const bool bNoData(
+       request.bError
+    && ( ( 0 == request.sError.find( "!NO_DATA!" ) ) || ( 0 == request.sError.find( "Invalid symbol" ) ) )
+  );
+
+  if ( !bNoData && ( bLost || request.bError || ( 0 < request.nBad ) ) ) {
+    if ( ++request.nAttempt < m_config.nMaxAttempts ) {
+      // datums not yet handed over are parsed again, those handed over are skipped
+      if ( nullptr != request.pBatch ) {
+        request.pBatch->bars.Clear();
+        request.pBatch->quotes.Clear();
+        request.pBatch->trades.Clear();
+      }
+      std::cout << "HistoryBulkLoader retry " << request.sSymbol << ": " << request.sError << std::endl;
+      request.nParsed = 0;
+      request.nBad = 0;
+      request.bError = false;
+      request.sError.clear();
+      request.sRecord.clear();
+      m_nRetries++;
+      const clock_t::time_point tpRetry( clock_t::now() + m_config.msRetry * ( 1 << ( request.nAttempt - 1 ) ) );
+      {
+        std::scoped_lock<std::mutex> lock( m_mutex );
+        m_mapRetry.emplace( tpRetry, &request );
+      }
+      Notify();
+    }
+    else {
+      std::cout << "HistoryBulkLoader failed " << request.sSymbol << ": " << request.sError << std::endl;
+      Deliver( request, true, EStatus::Failed );
+    }
+  }
+  else {
+    if ( !m_config.sRecordDirectory.empty() && !bNoData ) {
+      const std::string sFileName( ReplayFileName( m_config.sRecordDirectory, request.sCommand, request.sSymbol ) );
+      boost::filesystem::create_directories( boost::filesystem::path( sFileName ).parent_path() );
+      std::ofstream ofs( sFileName, std::ios::binary | std::ios::trunc );
+      ofs.write( request.sRecord.data(), request.sRecord.size() );
+      request.sRecord.clear();
+      request.sRecord.shrink_to_fit();
+    }
+    Deliver( request, true, bNoData ? EStatus::NoData : EStatus::Ok );
+  }
+}
+
+template<typename T>
+typename HistoryBulkLoader<T>::Batch& HistoryBulkLoader<T>::Current( Request& request ) {
+  if ( nullptr == request.pBatch ) {
+    {
+      // backpressure:  the owner has enough to work on
+      std::unique_lock<std::mutex> lock( m_mutexBatch );
+      m_cvBatch.wait( lock, [this](){ return ( m_nBatchesOut.load() < m_config.nMaxBatches ) || m_bStop.load(); } );
+      m_nBatchesOut++;
+    }
+    Batch* pBatch( m_reposBatch.CheckOutL() );
+    pBatch->Clear();
+    pBatch->sSymbol = request.sSymbol;
+    pBatch->eRequest = request.eRequest;
+    pBatch->bLast = false;
+    pBatch->eStatus = EStatus::Ok;
+    pBatch->pRequest = &request;
+    request.pBatch = pBatch;
+  }
+  return *request.pBatch;
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::Deliver( Request& request, bool bLast, EStatus eStatus ) {
+  Batch* pBatch( &Current( request ) );
+  request.pBatch = nullptr;
+  pBatch->nSequence = request.nSequence++;
+  pBatch->bLast = bLast;
+  pBatch->eStatus = eStatus;
+  if ( bLast ) pBatch->sError = request.sError;
+  request.nDelivered += pBatch->Size();
+  m_nDatums += pBatch->Size();
+  static_cast<T*>( this )->OnHistoryBatch( pBatch );
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::Release( Batch* pBatch ) {
+
+  Request* pRequest( pBatch->pRequest );
+  const bool bLast( pBatch->bLast );
+  const EStatus eStatus( pBatch->eStatus );
+
+  pBatch->Clear();
+  m_reposBatch.CheckInL( pBatch );
+  {
+    std::scoped_lock<std::mutex> lock( m_mutexBatch );
+    m_nBatchesOut--;
+  }
+  m_cvBatch.notify_all();
+
+  if ( bLast ) {
+    switch ( eStatus ) {
+      case EStatus::Ok: m_nDone++; Checkpoint( pRequest->sKey ); break;
+      case EStatus::NoData: m_nNoData++; Checkpoint( pRequest->sKey ); break;
+      case EStatus::Failed: m_nFailed++; break; // left for a re-run
+    }
+    bool bComplete( false );
+    {
+      std::scoped_lock<std::mutex> lock( m_mutexWait );
+      bComplete = ( 0 == --m_nOutstanding );
+    }
+    if ( bComplete ) {
+      if ( &HistoryBulkLoader<T>::OnHistoryCompletion != &T::OnHistoryCompletion ) {
+        static_cast<T*>( this )->OnHistoryCompletion();
+      }
+      std::scoped_lock<std::mutex> lock( m_mutexWait );
+      m_cvWait.notify_all();
+    }
+  }
+  Notify();
+}
+
+template<typename T>
+void HistoryBulkLoader<T>::Checkpoint( const std::string& sKey ) {
+  if ( m_ofsCheckpoint.is_open() ) {
+    std::scoped_lock<std::mutex> lock( m_mutexCheckpoint );
+    m_ofsCheckpoint << sKey << std::endl; // flushed, a crash loses at most the line being written
+  }
+}
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,220 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HistoryReplay.cpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFIQFeed
+ * Created: 2026/10/16 20:02:17
+ */
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+
+#include "HistoryReplay.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+namespace asio = boost::asio;
+
+std::string ReplayFileName( const std::string& sDirectory, const std::string& sCommand, const std::string& sSymbol ) {
+  std::string sFile( sSymbol );
+  for ( char& ch: sFile ) {
+    if ( '/' == ch ) ch = '_';
+  }
+  return sDirectory + "/" + sCommand + "/" + sFile;
+}
+
+class HistoryReplay::Session: public std::enable_shared_from_this<Session> {
+public:
+
+  Session( HistoryReplay& replay, asio::ip::tcp::socket&& socket )
+  : m_replay( replay ), m_socket( std::move( socket ) ) {}
+
+  void Read() {
+    auto self( shared_from_this() );
+    asio::async_read_until(
+      m_socket, m_buf, '\n',
+      [this,self]( const boost::system::error_code& ec, std::size_t ){
+        if ( ec ) return; // closed by the peer
+        std::string sRequest;
+        std::istream is( &m_buf );
+        std::getline( is, sRequest );
+        if ( !sRequest.empty() && ( '\r' == sRequest.back() ) ) sRequest.pop_back();
+        m_sReply.clear();
+        const bool bComplete( m_replay.Answer( sRequest, m_sReply ) );
+        if ( !bComplete ) {
+          m_sReply.resize( m_sReply.size() / 2 ); // part way through a line
+        }
+        Write( bComplete );
+      } );
+  }
+
+private:
+
+  HistoryReplay& m_replay;
+  asio::ip::tcp::socket m_socket;
+  asio::streambuf m_buf;
+  std::string m_sReply;
+
+  void Write( bool bComplete ) {
+    auto self( shared_from_this() );
+    asio::async_write(
+      m_socket, asio::buffer( m_sReply ),
+      [this,self,bComplete]( const boost::system::error_code& ec, std::size_t n ){
+        m_replay.m_nBytes += n;
+        if ( ec ) return;
+        if ( bComplete ) {
+          Read();
+        }
+        else {
+          boost::system::error_code ecClose;
+          m_socket.shutdown( asio::ip::tcp::socket::shutdown_both, ecClose );
+          m_socket.close( ecClose );
+        }
+      } );
+  }
+
+};
+
+HistoryReplay::HistoryReplay( const std::string& sDirectory, unsigned short nPort, size_t nThreads )
+: m_sDirectory( sDirectory )
+, m_nErrorInterval {}, m_nDropInterval {}
+, m_nConnections {}, m_nRequests {}, m_nErrors {}, m_nDrops {}, m_nBytes {}
+, m_acceptor( m_context, asio::ip::tcp::endpoint( asio::ip::tcp::v4(), nPort ) )
+{
+  Accept();
+  for ( size_t ix = 0; ix < nThreads; ix++ ) {
+    m_vThread.emplace_back( [this](){ m_context.run(); } );
+  }
+}
+
+HistoryReplay::~HistoryReplay() {
+  m_context.stop();
+  for ( std::thread& thread: m_vThread ) {
+    if ( thread.joinable() ) thread.join();
+  }
+}
+
+HistoryReplay::Stats HistoryReplay::GetStats() const {
+  Stats stats;
+  stats.nConnections = m_nConnections;
+  stats.nRequests = m_nRequests;
+  stats.nErrors = m_nErrors;
+  stats.nDrops = m_nDrops;
+  stats.nBytes = m_nBytes;
+  return stats;
+}
+
+void HistoryReplay::Accept() {
+  m_acceptor.async_accept(
+    [this]( const boost::system::error_code& ec, asio::ip::tcp::socket socket ){
+      if ( ec ) {
+        std::cout << "HistoryReplay accept: " << ec.message() << std::endl;
+        return;
+      }
+      m_nConnections++;
+      socket.set_option( asio::ip::tcp::no_delay( true ) );
+      std::make_shared<Session>( *this, std::move( socket ) )->Read();
+      Accept();
+    } );
+}
+
+HistoryReplay::pContent_t HistoryReplay::Content( const std::string& sCommand, const std::string& sSymbol ) {
+  const std::string sFileName( ReplayFileName( m_sDirectory, sCommand, sSymbol ) );
+  std::scoped_lock<std::mutex> lock( m_mutexCache );
+  auto iter = m_mapContent.find( sFileName );
+  if ( m_mapContent.end() == iter ) {
+    pContent_t pContent;
+    std::ifstream ifs( sFileName, std::ios::binary );
+    if ( ifs.is_open() ) {
+      std::stringstream ss;
+      ss << ifs.rdbuf();
+      pContent = std::make_shared<const std::string>( ss.str() );
+    }
+    iter = m_mapContent.emplace( sFileName, pContent ).first;
+  }
+  return iter->second;
+}
+
+bool HistoryReplay::Answer( const std::string& sRequest, std::string& sReply ) {
+
+  if ( 0 == sRequest.find( "S," ) ) {
+    if ( std::string::npos != sRequest.find( "SET PROTOCOL" ) ) {
+      sReply = "S,CURRENT PROTOCOL,6.2\r\n";
+    }
+    return true;
+  }
+
+  // CMD,SYMBOL,...,<id>
+  const std::string::size_type ixSymbol( sRequest.find( ',' ) );
+  const std::string::size_type ixId( sRequest.rfind( ',' ) );
+  if ( ( std::string::npos == ixSymbol ) || ( ixSymbol == ixId ) ) {
+    sReply = "E,Unknown request.,\r\n";
+    return true;
+  }
+  const std::string::size_type ixSymbolEnd( sRequest.find( ',', ixSymbol + 1 ) );
+  const std::string sCommand( sRequest.substr( 0, ixSymbol ) );
+  const std::string sSymbol( sRequest.substr( ixSymbol + 1, ixSymbolEnd - ixSymbol - 1 ) );
+  const std::string sId( sRequest.substr( ixId + 1 ) );
+
+  const size_t nRequest( ++m_nRequests );
+
+  const size_t nErrorInterval( m_nErrorInterval );
+  if ( ( 0 < nErrorInterval ) && ( 0 == ( nRequest % nErrorInterval ) ) ) {
+    m_nErrors++;
+    sReply = sId + ",E,Too many simultaneous history requests.,\r\n" + sId + ",!ENDMSG!,\r\n";
+    return true;
+  }
+
+  const pContent_t pContent( Content( sCommand, sSymbol ) );
+  if ( !pContent ) {
+    sReply = sId + ",E,Invalid symbol.,\r\n" + sId + ",!ENDMSG!,\r\n";
+    return true;
+  }
+
+  const std::string& sContent( *pContent );
+  sReply.reserve( sContent.size() + ( sContent.size() / 16 + 1 ) * ( sId.size() + 2 ) );
+  std::string::size_type ixLine {};
+  while ( ixLine < sContent.size() ) {
+    std::string::size_type ixEnd( sContent.find( '\n', ixLine ) );
+    if ( std::string::npos == ixEnd ) ixEnd = sContent.size();
+    sReply.append( sId );
+    sReply.push_back( ',' );
+    sReply.append( sContent, ixLine, ixEnd - ixLine );
+    sReply.append( "\r\n" );
+    ixLine = ixEnd + 1;
+  }
+  sReply.append( sId );
+  sReply.append( ",!ENDMSG!,\r\n" );
+
+  const size_t nDropInterval( m_nDropInterval );
+  if ( ( 0 < nDropInterval ) && ( 0 == ( nRequest % nDropInterval ) ) ) {
+    m_nDrops++;
+    return false;
+  }
+  return true;
+}
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
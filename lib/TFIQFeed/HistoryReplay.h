@@ -0,0 +1,100 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HistoryReplay.h
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFIQFeed
+ * Created: 2026/10/16 20:02:17
+ */
+
+#pragma once
+
+// answers history port requests from recorded replies, for benchmarks and tests without a feed
+//   a request 'CMD,SYMBOL,...,<id>' is answered with the lines of <directory>/CMD/SYMBOL,
+//     each as '<id>,<line>', followed by '<id>,!ENDMSG!,'
+//   a missing file is answered with '<id>,E,Invalid symbol.,'
+//   HistoryBulkLoader writes these files with HistoryBulkConfig::sRecordDirectory
+// faults can be injected, a rate error or a dropped connection every n requests
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/io_context.hpp>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+// '/' in a symbol, as in futures and forex, is replaced with '_'
+std::string ReplayFileName( const std::string& sDirectory, const std::string& sCommand, const std::string& sSymbol );
+
+class HistoryReplay {
+public:
+
+  struct Stats {
+    size_t nConnections;
+    size_t nRequests;
+    size_t nErrors; // injected
+    size_t nDrops; // injected
+    size_t nBytes;
+  };
+
+  HistoryReplay( const std::string& sDirectory, unsigned short nPort = 9100, size_t nThreads = 2 );
+  ~HistoryReplay();
+
+  void SetErrorInterval( size_t n ) { m_nErrorInterval = n; } // 0 for none
+  void SetDropInterval( size_t n ) { m_nDropInterval = n; } // 0 for none
+
+  Stats GetStats() const;
+
+protected:
+private:
+
+  class Session;
+
+  const std::string m_sDirectory;
+
+  std::atomic<size_t> m_nErrorInterval;
+  std::atomic<size_t> m_nDropInterval;
+
+  std::atomic<size_t> m_nConnections;
+  std::atomic<size_t> m_nRequests;
+  std::atomic<size_t> m_nErrors;
+  std::atomic<size_t> m_nDrops;
+  std::atomic<size_t> m_nBytes;
+
+  std::mutex m_mutexCache;
+  using pContent_t = std::shared_ptr<const std::string>;
+  std::map<std::string, pContent_t> m_mapContent; // file name, nullptr when missing
+
+  boost::asio::io_context m_context;
+  boost::asio::ip::tcp::acceptor m_acceptor;
+  std::vector<std::thread> m_vThread;
+
+  void Accept();
+  pContent_t Content( const std::string& sCommand, const std::string& sSymbol );
+  bool Answer( const std::string& sRequest, std::string& sReply ); // false to drop the connection part way
+
+};
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
@@ -199,15 +199,15 @@ protected:
 
 private:
 
-  typename ou::BufferRepository<IQFDynamicFeedUpdateMessage> m_reposDynamicFeedUpdateMessages;
-  typename ou::BufferRepository<IQFDynamicFeedSummaryMessage> m_reposDynamicFeedSummaryMessages;
-  typename ou::BufferRepository<IQFUpdateMessage> m_reposUpdateMessages;
-  typename ou::BufferRepository<IQFSummaryMessage> m_reposSummaryMessages;
-  typename ou::BufferRepository<IQFNewsMessage> m_reposNewsMessages;
-  typename ou::BufferRepository<IQFFundamentalMessage> m_reposFundamentalMessages;
-  typename ou::BufferRepository<IQFTimeMessage> m_reposTimeMessages;
-  typename ou::BufferRepository<IQFSystemMessage> m_reposSystemMessages;
-  typename ou::BufferRepository<IQFErrorMessage> m_reposErrorMessages;
+  typename ou::BufferRepositoryMPSC<IQFDynamicFeedUpdateMessage> m_reposDynamicFeedUpdateMessages;
+  typename ou::BufferRepositoryMPSC<IQFDynamicFeedSummaryMessage> m_reposDynamicFeedSummaryMessages;
+  typename ou::BufferRepositoryMPSC<IQFUpdateMessage> m_reposUpdateMessages;
+  typename ou::BufferRepositoryMPSC<IQFSummaryMessage> m_reposSummaryMessages;
+  typename ou::BufferRepositoryMPSC<IQFNewsMessage> m_reposNewsMessages;
+  typename ou::BufferRepositoryMPSC<IQFFundamentalMessage> m_reposFundamentalMessages;
+  typename ou::BufferRepositoryMPSC<IQFTimeMessage> m_reposTimeMessages;
+  typename ou::BufferRepositoryMPSC<IQFSystemMessage> m_reposSystemMessages;
+  typename ou::BufferRepositoryMPSC<IQFErrorMessage> m_reposErrorMessages;
 
   enum Version { v49, v61, v62 };
   Version m_version;
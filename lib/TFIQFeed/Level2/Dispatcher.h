@@ -52,6 +52,10 @@ public:
   void StartPriceLevel( const std::string& ); // not implemented
   void StopPriceLevel( const std::string& );  // not implemented
 
+  // hand written decoders (default), or the spirit grammars,
+  //   a line the hand written decoder rejects is retried with the grammar
+  void FastDecode( bool bFastDecode ) { m_bFastDecode = bFastDecode; }
+
 protected:
 
   // translated from network layer to eliminate name clash
@@ -71,26 +75,47 @@ protected:
 private:
 
   using l2_inherited_t = typename ou::Network<Dispatcher<T> >;
-  using l2_linebuffer_t = typename l2_inherited_t::linebuffer_t;
+  using l2_element_t = typename l2_inherited_t::bufferelement_t;
+  using l2_iterator_t = const l2_element_t*;
 
   bool m_bInitialized;
+  bool m_bFastDecode;
 
-  ou::tf::iqfeed::l2::msg::OrderArrival::parser_decoded<typename l2_linebuffer_t::iterator> m_parserArrival;
-  ou::tf::iqfeed::l2::msg::OrderDelete::parser_decoded<typename l2_linebuffer_t::iterator> m_parserDelete;
+  ou::tf::iqfeed::l2::msg::OrderArrival::parser_decoded<l2_iterator_t> m_parserArrival;
+  ou::tf::iqfeed::l2::msg::OrderDelete::parser_decoded<l2_iterator_t> m_parserDelete;
 
   // called by Network via CRTP
   void OnNetworkConnected();
   void OnNetworkDisconnected();
   void OnNetworkError( size_t e );
   void OnNetworkSendDone();
-  void OnNetworkLineBuffer( l2_linebuffer_t* );  // new line available for processing
+  void OnNetworkLineView( l2_iterator_t begin, l2_iterator_t end );  // new line available for processing, in place
+
+  bool Decode( ou::tf::iqfeed::l2::msg::OrderArrival::decoded& msg, l2_iterator_t begin, l2_iterator_t end ) {
+    namespace OrderArrival = ou::tf::iqfeed::l2::msg::OrderArrival;
+    if ( m_bFastDecode ) {
+      if ( OrderArrival::DecodeFast( msg, reinterpret_cast<const char*>( begin ), reinterpret_cast<const char*>( end ) ) ) return true;
+      msg = OrderArrival::decoded(); // grammar starts from a clean message
+    }
+    return OrderArrival::Decode( m_parserArrival, msg, begin, end );
+  }
+
+  bool Decode( ou::tf::iqfeed::l2::msg::OrderDelete::decoded& msg, l2_iterator_t begin, l2_iterator_t end ) {
+    namespace OrderDelete = ou::tf::iqfeed::l2::msg::OrderDelete;
+    if ( m_bFastDecode ) {
+      if ( OrderDelete::DecodeFast( msg, reinterpret_cast<const char*>( begin ), reinterpret_cast<const char*>( end ) ) ) return true;
+      msg = OrderDelete::decoded(); // grammar starts from a clean message
+    }
+    return OrderDelete::Decode( m_parserDelete, msg, begin, end );
+  }
 
 };
 
 template <typename T>
 Dispatcher<T>::Dispatcher()
 : ou::Network<Dispatcher<T> >( "127.0.0.1", 9200 ),
-  m_bInitialized( false )
+  m_bInitialized( false ),
+  m_bFastDecode( true )
 {}
 
 template <typename T>
@@ -178,10 +203,7 @@ struct SystemStatus {
 bool ParseSystemStatus( const std::string&, SystemStatus& );
 
 template <typename T>
-void Dispatcher<T>::OnNetworkLineBuffer( l2_linebuffer_t* pBuffer ) {
-
-  typename l2_linebuffer_t::iterator iter = (*pBuffer).begin();
-  typename l2_linebuffer_t::iterator end = (*pBuffer).end();
+void Dispatcher<T>::OnNetworkLineView( l2_iterator_t iter, l2_iterator_t end ) {
 
   BOOST_ASSERT( iter != end );
 
@@ -190,7 +212,7 @@ void Dispatcher<T>::OnNetworkLineBuffer( l2_linebuffer_t* pBuffer ) {
       if ( &Dispatcher<T>::OnMBOAdd != &T::OnMBOAdd ) {
         namespace OrderArrival = ou::tf::iqfeed::l2::msg::OrderArrival;
         OrderArrival::decoded msg;
-        if ( OrderArrival::Decode( m_parserArrival, msg, iter, end) ) {
+        if ( Decode( msg, iter, end ) ) {
           static_cast<T*>( this )->OnMBOAdd( msg );
         }
         else {
@@ -202,7 +224,7 @@ void Dispatcher<T>::OnNetworkLineBuffer( l2_linebuffer_t* pBuffer ) {
       if ( &Dispatcher<T>::OnMBOUpdate != &T::OnMBOUpdate ) {
         namespace OrderArrival = ou::tf::iqfeed::l2::msg::OrderArrival;
         OrderArrival::decoded msg;
-        if ( OrderArrival::Decode( m_parserArrival, msg, iter, end) ) {
+        if ( Decode( msg, iter, end ) ) {
           static_cast<T*>( this )->OnMBOUpdate( msg );
         }
         else {
@@ -214,7 +236,7 @@ void Dispatcher<T>::OnNetworkLineBuffer( l2_linebuffer_t* pBuffer ) {
       if ( &Dispatcher<T>::OnMBODelete != &T::OnMBODelete ) {
         namespace OrderDelete = ou::tf::iqfeed::l2::msg::OrderDelete;
         OrderDelete::decoded msg;
-        if ( OrderDelete::Decode( m_parserDelete, msg, iter, end) ) {
+        if ( Decode( msg, iter, end ) ) {
           static_cast<T*>( this )->OnMBODelete( msg );
         }
         else {
@@ -232,7 +254,7 @@ void Dispatcher<T>::OnNetworkLineBuffer( l2_linebuffer_t* pBuffer ) {
       if ( &Dispatcher<T>::OnMBOSummary != &T::OnMBOSummary ) {
         namespace OrderArrival = ou::tf::iqfeed::l2::msg::OrderArrival;
         OrderArrival::decoded msg;
-        if ( OrderArrival::Decode( m_parserArrival, msg, iter, end) ) {
+        if ( Decode( msg, iter, end ) ) {
           static_cast<T*>( this )->OnMBOSummary( msg );
         }
         else {
@@ -346,8 +368,6 @@ void Dispatcher<T>::OnNetworkLineBuffer( l2_linebuffer_t* pBuffer ) {
       break;
   }
 
-  l2_inherited_t::GiveBackBuffer( pBuffer );
-
 }
 
 } // namespace l2
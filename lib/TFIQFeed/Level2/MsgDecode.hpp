@@ -0,0 +1,160 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MsgDecode.hpp
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed/Level2
+ * Created: 2026/10/16 16:05:41
+ */
+
+// single pass field scanner for the hand written OrderArrival/OrderDelete decoders
+// works in place on the line, nothing is allocated, the symbol is returned as a view into the line
+// mirrors what the spirit grammars accept for the fields in use, anything else returns false
+//   so the caller can fall back to the grammar
+
+#pragma once
+
+#include <limits>
+#include <cstdint>
+#include <charconv>
+#include <string_view>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+namespace l2 { // level 2 data
+namespace msg { // message
+
+class Scanner {
+public:
+
+  Scanner( const char* begin, const char* end ): m_cur( begin ), m_end( end ) {}
+
+  bool Comma() {
+    if ( ( m_end == m_cur ) || ( ',' != *m_cur ) ) return false;
+    ++m_cur;
+    return true;
+  }
+
+  bool Char( char& ch ) {
+    if ( m_end == m_cur ) return false;
+    ch = *m_cur++;
+    return true;
+  }
+
+  // the run up to the next comma, which is left in place
+  std::string_view Field() {
+    const char* begin( m_cur );
+    while ( ( m_end != m_cur ) && ( ',' != *m_cur ) ) ++m_cur;
+    return std::string_view( begin, m_cur - begin );
+  }
+
+  // mandatory unsigned value, refused when beyond the range of T, the grammars differ in how they overflow
+  template<typename T>
+  bool Unsigned( T& value ) {
+    uint64_t n;
+    std::from_chars_result result = std::from_chars( m_cur, m_end, n );
+    if ( std::errc() != result.ec ) return false;
+    if ( uint64_t( std::numeric_limits<T>::max() ) < n ) return false;
+    m_cur = result.ptr;
+    value = static_cast<T>( n );
+    return true;
+  }
+
+  // optional unsigned value, value is untouched when absent
+  template<typename T>
+  bool OptionalUnsigned( T& value ) {
+    if ( ( m_end == m_cur ) || ( ',' == *m_cur ) ) return true;
+    return Unsigned( value );
+  }
+
+  // decimal price held as an integer mantissa and count of fractional digits,
+  //   scaled once the precision is known, avoids the general purpose floating point conversion
+  bool Price( int64_t& mantissa, int& nDecimals ) {
+    bool bNegative( false );
+    if ( ( m_end != m_cur ) && ( ( '-' == *m_cur ) || ( '+' == *m_cur ) ) ) {
+      bNegative = ( '-' == *m_cur );
+      ++m_cur;
+    }
+    mantissa = 0;
+    nDecimals = 0;
+    int nDigits {};
+    bool bFraction( false );
+    while ( m_end != m_cur ) {
+      const char ch( *m_cur );
+      if ( ( '0' <= ch ) && ( '9' >= ch ) ) {
+        if ( 15 <= nDigits ) return false; // beyond what a double holds exactly, let the grammar handle it
+        mantissa = 10 * mantissa + ( ch - '0' );
+        ++nDigits;
+        if ( bFraction ) ++nDecimals;
+      }
+      else {
+        if ( ( '.' == ch ) && !bFraction ) bFraction = true;
+        else break;
+      }
+      ++m_cur;
+    }
+    if ( 0 == nDigits ) return false;
+    if ( bNegative ) mantissa = -mantissa;
+    return true;
+  }
+
+  static double Scale( int64_t mantissa, int nDecimals ) {
+    static const double rPower[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+      1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+    };
+    // both operands are exact, so the quotient is the correctly rounded value
+    return static_cast<double>( mantissa ) / rPower[ nDecimals ];
+  }
+
+  // hh:mm:ss.ffffff, optional, untouched when absent
+  template<typename time_t>
+  bool OptionalTime( time_t& time ) {
+    if ( ( m_end == m_cur ) || ( ',' == *m_cur ) ) return true;
+    return
+         Unsigned( time.hours ) && Lit( ':' )
+      && Unsigned( time.minutes ) && Lit( ':' )
+      && Unsigned( time.seconds ) && Lit( '.' )
+      && Unsigned( time.fractional );
+  }
+
+  // yyyy-mm-dd
+  template<typename date_t>
+  bool Date( date_t& date ) {
+    return
+         Unsigned( date.year ) && Lit( '-' )
+      && Unsigned( date.month ) && Lit( '-' )
+      && Unsigned( date.day );
+  }
+
+private:
+
+  const char* m_cur;
+  const char* const m_end;
+
+  bool Lit( char ch ) {
+    if ( ( m_end == m_cur ) || ( ch != *m_cur ) ) return false;
+    ++m_cur;
+    return true;
+  }
+
+};
+
+} // namespace msg
+} // namespace l2
+} // namesapce iqfeed
+} // namespace tf
+} // namespace ou
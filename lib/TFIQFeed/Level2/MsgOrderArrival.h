@@ -22,6 +22,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 
@@ -29,6 +30,8 @@
 
 #include <boost/phoenix/core.hpp>
 
+#include "MsgDecode.hpp"
+
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 namespace iqfeed { // IQFeed
@@ -65,7 +68,8 @@ using ptime = boost::posix_time::ptime;
 
 struct decoded {
   char chMsgType;
-  std::string sSymbolName;
+  std::string sSymbolName; // filled by the grammar only
+  std::string_view svSymbolName; // filled by DecodeFast only, view into the line, valid for the dispatch
   uint64_t nOrderId;
   union MMID {
     uint32_t id;
@@ -81,6 +85,8 @@ struct decoded {
   date_t date;
   decoded(): nOrderId {}, nQuantity {}, nPriority {} {}
   ptime dt() const { return ptime( date.date(), time.time() ); }
+  // from either decoder, never a view into this object, so copies stay valid
+  std::string_view SymbolName() const { return svSymbolName.empty() ? std::string_view( sSymbolName ) : svSymbolName; }
 };
 
 } // namespace OrderArrival
@@ -216,10 +222,59 @@ namespace OrderArrival {
 
     // nasdaq l2: '6,QQQ,,AMEX,A,408.8400,100,,4,17:52:38.059128,2022-04-01,'
     bool bOk = parse( begin, end, parser, out );
+    out.svSymbolName = std::string_view();
 
     return bOk;
   }
 
+  // hand written equivalent of the grammar, single pass, no allocation
+  inline bool DecodeFast( decoded& out, const char* begin, const char* end ) {
+
+    Scanner scan( begin, end );
+
+    if ( !scan.Char( out.chMsgType ) ) return false;
+    switch ( out.chMsgType ) {
+      case '6': // Order Summary
+      case '3': // Order Add
+      case '4': // Order Update
+      case '0': // Price Level Order
+        break;
+      default:
+        return false;
+    }
+    if ( !scan.Comma() ) return false;
+
+    out.sSymbolName.clear();
+    out.svSymbolName = scan.Field();
+    if ( !scan.Comma() ) return false;
+
+    if ( !scan.OptionalUnsigned( out.nOrderId ) || !scan.Comma() ) return false;
+
+    const std::string_view svMMID( scan.Field() );
+    if ( 4 < svMMID.size() ) return false;
+    for ( std::string_view::size_type ix = 0; ix < svMMID.size(); ++ix ) {
+      out.mmid.rch[ ix ] = svMMID[ ix ];
+    }
+    if ( !scan.Comma() ) return false;
+
+    if ( !scan.Char( out.chOrderSide ) ) return false;
+    if ( ( 'A' != out.chOrderSide ) && ( 'B' != out.chOrderSide ) ) return false;
+    if ( !scan.Comma() ) return false;
+
+    int64_t mantissa;
+    int nDecimals;
+    if ( !scan.Price( mantissa, nDecimals ) || !scan.Comma() ) return false;
+    if ( !scan.Unsigned( out.nQuantity ) || !scan.Comma() ) return false;
+    if ( !scan.OptionalUnsigned( out.nPriority ) || !scan.Comma() ) return false;
+    if ( !scan.Unsigned( out.nPrecision ) || !scan.Comma() ) return false;
+    out.dblPrice = Scanner::Scale( mantissa, nDecimals ); // by the decimals sent, nPrecision is kept as is
+
+    if ( !scan.OptionalTime( out.time ) || !scan.Comma() ) return false;
+    if ( !scan.Date( out.date ) || !scan.Comma() ) return false;
+
+    return true;
+  }
+
 } // namespace OrderArrival
 } // namespace msg
 } // namespace l2
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 
@@ -29,6 +30,8 @@
 
 #include <boost/phoenix/core.hpp>
 
+#include "MsgDecode.hpp"
+
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 namespace iqfeed { // IQFeed
@@ -68,7 +71,8 @@ using ptime = boost::posix_time::ptime;
 // '5,QQQ,,MEMX,B,,2022-04-06,'
 struct decoded {
   char chMsgType;
-  std::string sSymbolName;
+  std::string sSymbolName; // filled by the grammar only
+  std::string_view svSymbolName; // filled by DecodeFast only, view into the line, valid for the dispatch
   uint64_t nOrderId;
   union MMID {
     uint32_t id;
@@ -80,6 +84,8 @@ struct decoded {
   date_t date;
   decoded(): nOrderId {} {}
   ptime dt() const { return ptime( date.date(), time.time() ); }
+  // from either decoder, never a view into this object, so copies stay valid
+  std::string_view SymbolName() const { return svSymbolName.empty() ? std::string_view( sSymbolName ) : svSymbolName; }
 };
 
 } // namespace OrderDelete
@@ -203,10 +209,43 @@ namespace OrderDelete {
     // '5,TSLA,,CHXE,B,,2022-04-01,' nasdaq LII
     // "5,@ESZ21,648907593934,,A,20:32:47.333543,2021-10-24,"
     bool bOk = parse( begin, end, parser, out );
+    out.svSymbolName = std::string_view();
 
     return bOk;
   }
 
+  // hand written equivalent of the grammar, single pass, no allocation
+  inline bool DecodeFast( decoded& out, const char* begin, const char* end ) {
+
+    Scanner scan( begin, end );
+
+    if ( !scan.Char( out.chMsgType ) ) return false;
+    if ( '5' != out.chMsgType ) return false; // Order Delete
+    if ( !scan.Comma() ) return false;
+
+    out.sSymbolName.clear();
+    out.svSymbolName = scan.Field();
+    if ( !scan.Comma() ) return false;
+
+    if ( !scan.OptionalUnsigned( out.nOrderId ) || !scan.Comma() ) return false;
+
+    const std::string_view svMMID( scan.Field() );
+    if ( 4 < svMMID.size() ) return false;
+    for ( std::string_view::size_type ix = 0; ix < svMMID.size(); ++ix ) {
+      out.mmid.rch[ ix ] = svMMID[ ix ];
+    }
+    if ( !scan.Comma() ) return false;
+
+    if ( !scan.Char( out.chOrderSide ) ) return false;
+    if ( ( 'A' != out.chOrderSide ) && ( 'B' != out.chOrderSide ) ) return false;
+    if ( !scan.Comma() ) return false;
+
+    if ( !scan.OptionalTime( out.time ) || !scan.Comma() ) return false;
+    if ( !scan.Date( out.date ) || !scan.Comma() ) return false;
+
+    return true;
+  }
+
 } // namespace OrderDelete
 } // namespace msg
 } // namespace l2
@@ -0,0 +1,170 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    OrderTable.hpp
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed/Level2
+ * Created: 2026/10/16 15:22:08
+ */
+
+// order id -> order for OrderBased, replaces std::map<uint64_t,Order>
+// open addressing with linear probing in one contiguous slot array, no per-order allocation
+// deletion shifts following entries back into the hole, so there are no tombstones to accumulate
+// iteration order is unspecified
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <optional>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+namespace l2 { // level 2 data
+
+template<typename value_t>
+class OrderTable {
+public:
+
+  using key_t = uint64_t;
+
+  OrderTable( std::size_t nSlots = 4096 ) // power of two
+  : m_nEntries {}
+  {
+    assert( 2 <= nSlots );
+    assert( 0 == ( nSlots & ( nSlots - 1 ) ) );
+    Resize( nSlots );
+  }
+
+  std::size_t Size() const { return m_nEntries; }
+
+  value_t* Find( key_t key ) {
+    std::size_t ix( Home( key ) );
+    while ( true ) {
+      Slot& slot( m_vSlot[ ix ] );
+      if ( !slot.value ) return nullptr;
+      if ( key == slot.key ) return &*slot.value;
+      ix = ( ix + 1 ) & m_mask;
+    }
+  }
+
+  // returns false, and leaves the existing entry, if the key is present
+  bool Emplace( key_t key, const value_t& value ) {
+    if ( ( 2 * ( m_nEntries + 1 ) ) > m_vSlot.size() ) { // keep load factor at or below 0.5
+      Grow();
+    }
+    std::size_t ix( Home( key ) );
+    while ( true ) {
+      Slot& slot( m_vSlot[ ix ] );
+      if ( !slot.value ) {
+        slot.key = key;
+        slot.value.emplace( value );
+        ++m_nEntries;
+        return true;
+      }
+      if ( key == slot.key ) return false;
+      ix = ( ix + 1 ) & m_mask;
+    }
+  }
+
+  bool Erase( key_t key ) {
+    std::size_t ix( Home( key ) );
+    while ( true ) {
+      Slot& slot( m_vSlot[ ix ] );
+      if ( !slot.value ) return false;
+      if ( key == slot.key ) break;
+      ix = ( ix + 1 ) & m_mask;
+    }
+    // backward shift:  pull later members of the probe run into the hole when their home permits it
+    std::size_t ixHole( ix );
+    std::size_t ixNext( ix );
+    while ( true ) {
+      ixNext = ( ixNext + 1 ) & m_mask;
+      Slot& slot( m_vSlot[ ixNext ] );
+      if ( !slot.value ) break;
+      const std::size_t ixHome( Home( slot.key ) );
+      const bool bStays // home lies cyclically within ( hole, next ]
+        = ( ixHole <= ixNext )
+        ? ( ( ixHole < ixHome ) && ( ixHome <= ixNext ) )
+        : ( ( ixHole < ixHome ) || ( ixHome <= ixNext ) );
+      if ( !bStays ) {
+        m_vSlot[ ixHole ] = std::move( slot );
+        ixHole = ixNext;
+      }
+    }
+    m_vSlot[ ixHole ].value.reset();
+    --m_nEntries;
+    return true;
+  }
+
+  template<typename Function> // void( key_t, value_t& )
+  void ForEach( Function&& f ) {
+    for ( Slot& slot: m_vSlot ) {
+      if ( slot.value ) f( slot.key, *slot.value );
+    }
+  }
+
+  void Clear() {
+    for ( Slot& slot: m_vSlot ) slot.value.reset();
+    m_nEntries = 0;
+  }
+
+private:
+
+  struct Slot {
+    key_t key;
+    std::optional<value_t> value; // engaged when slot is in use
+    Slot(): key {} {}
+  };
+
+  using vSlot_t = std::vector<Slot>;
+  vSlot_t m_vSlot;
+
+  std::size_t m_mask;
+  unsigned int m_nShift;
+  std::size_t m_nEntries;
+
+  std::size_t Home( key_t key ) const { // fibonacci hashing, spreads the near sequential order ids
+    return ( key * 0x9E3779B97F4A7C15ull ) >> m_nShift;
+  }
+
+  void Resize( std::size_t nSlots ) {
+    m_vSlot.clear();
+    m_vSlot.resize( nSlots );
+    m_mask = nSlots - 1;
+    m_nShift = 64;
+    while ( 1 < nSlots ) {
+      nSlots >>= 1;
+      --m_nShift;
+    }
+  }
+
+  void Grow() {
+    vSlot_t vSlot( std::move( m_vSlot ) );
+    Resize( 2 * vSlot.size() );
+    m_nEntries = 0;
+    for ( Slot& slot: vSlot ) {
+      if ( slot.value ) Emplace( slot.key, *slot.value );
+    }
+  }
+
+};
+
+} // namespace l2
+} // namesapce iqfeed
+} // namespace tf
+} // namespace ou
@@ -19,6 +19,8 @@
  * Created  April 15, 2022 18:20
  */
 
+#include <algorithm>
+
 #include <OUCommon/TimeSource.h>
 
 #include <TFTrading/KeyTypes.h>
@@ -371,14 +373,11 @@ void OrderBased::LimitOrderAdd( const ou::tf::DepthByOrder& depth ) {
 
   Order order( depth );
 
-  mapOrder_t::iterator iter = m_mapOrder.find( depth.OrderID() );
-  if ( m_mapOrder.end() != iter ) {
+  if ( !m_tableOrder.Emplace( depth.OrderID(), order ) ) {
     // TODO: reset the order book, this happens upon a disconnect/reconnect, can this state be found?
     BOOST_LOG_TRIVIAL(warning) << "LimitOrderAdd re-add order skipped: " << depth.OrderID();
   }
   else {
-    auto result = m_mapOrder.emplace( std::pair( depth.OrderID(), order ) );
-    assert( result.second );
     m_idOrder = depth.OrderID();
     Add( depth );
   }
@@ -388,8 +387,8 @@ void OrderBased::LimitOrderAdd( const ou::tf::DepthByOrder& depth ) {
 void OrderBased::LimitOrderUpdate( const ou::tf::DepthByOrder& depth ) {
   m_state = EState::Update;
 
-  mapOrder_t::iterator iter = m_mapOrder.find( depth.OrderID() );
-  if ( m_mapOrder.end() == iter ) {
+  Order* pOrder = m_tableOrder.Find( depth.OrderID() );
+  if ( nullptr == pOrder ) {
     BOOST_LOG_TRIVIAL(error) << "LimitOrderUpdate order does not exist: " << depth.OrderID();
   }
   else {
@@ -398,7 +397,7 @@ void OrderBased::LimitOrderUpdate( const ou::tf::DepthByOrder& depth ) {
       BOOST_LOG_TRIVIAL(warning) << "LimitOrderUpdate order " << depth.OrderID() << " warning - zero new quantity";
     }
 
-    Order& order( iter->second );
+    Order& order( *pOrder );
     if ( order.chOrderSide != depth.Side() ) {
       BOOST_LOG_TRIVIAL(error) << "LimitOrderUpdate error - side change " << order.chOrderSide << " to " << depth.Side();
     }
@@ -417,17 +416,16 @@ void OrderBased::LimitOrderUpdate( const ou::tf::DepthByOrder& depth ) {
 void OrderBased::LimitOrderDelete( const ou::tf::DepthByOrder& depth ) {
   m_state = EState::Delete;
 
-  mapOrder_t::iterator iter = m_mapOrder.find( depth.OrderID() );
-  if ( m_mapOrder.end() == iter ) {
+  const Order* pOrder = m_tableOrder.Find( depth.OrderID() );
+  if ( nullptr == pOrder ) {
     BOOST_LOG_TRIVIAL(error) << "LimitOrderDelete order " << depth.OrderID() << " does not exist";
   }
   else {
     m_idOrder = depth.OrderID();
-    const Order& order( iter->second );
-    ou::tf::Depth depth_( depth.DateTime(), depth.Side(), order.dblPrice, order.nQuantity );
+    ou::tf::Depth depth_( depth.DateTime(), depth.Side(), pOrder->dblPrice, pOrder->nQuantity );
     Delete( depth_ );
 
-    m_mapOrder.erase( iter );
+    m_tableOrder.Erase( depth.OrderID() );
   }
   m_state = EState::Ready;
 }
@@ -437,21 +435,23 @@ void OrderBased::LimitOrderClear( const ou::tf::DepthByOrder& depth ) {
 
   std::vector<uint64_t> vOrderId; // delete order ids at end of use
 
-  for ( mapOrder_t::value_type& vt: m_mapOrder ) {
-    // clear only those entries for the side provided
-    if ( depth.Side() == vt.second.chOrderSide ) {
-      m_state = EState::Delete;
-      m_idOrder = vt.first;
-      const Order& order( vt.second );
-      ou::tf::Depth depth_( depth.DateTime(), depth.Side(), order.dblPrice, order.nQuantity );
-      Delete( depth_ );
-      vOrderId.push_back( vt.first );
-      m_state = EState::Clear;
-    }
-  }
+  // clear only those entries for the side provided
+  m_tableOrder.ForEach(
+    [&vOrderId,side=depth.Side()]( uint64_t id, const Order& order ){
+      if ( side == order.chOrderSide ) vOrderId.push_back( id );
+    } );
+
+  // the table is unordered, keep the emission in order id sequence
+  std::sort( vOrderId.begin(), vOrderId.end() );
 
   for ( uint64_t id: vOrderId ) {
-    size_t num = m_mapOrder.erase( id );
+    m_state = EState::Delete;
+    m_idOrder = id;
+    const Order& order( *m_tableOrder.Find( id ) );
+    ou::tf::Depth depth_( depth.DateTime(), depth.Side(), order.dblPrice, order.nQuantity );
+    Delete( depth_ );
+    m_tableOrder.Erase( id );
+    m_state = EState::Clear;
   }
 
   m_state = EState::Ready;
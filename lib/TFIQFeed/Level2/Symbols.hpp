@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <cmath>
 #include <memory>
+#include <vector>
+#include <string_view>
 
 #include <boost/log/trivial.hpp>
 
@@ -31,6 +34,7 @@
 #include <TFTimeSeries/TimeSeries.h>
 
 #include "Dispatcher.h"
+#include "OrderTable.hpp"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -234,6 +238,150 @@ private:
   fVolumeAtPrice_t m_fVolumeAtPrice;
 }; // class MapLevelAggregate
 
+// ==== FlatLevelAggregate
+// same interface and callbacks as MapLevelAggregate, stored contiguously:
+//   levels are kept in a vector ordered from worst to best, top of book is back(),
+//   so the level index is computed from the position (no renumbering walk),
+//   and inserts/erases near the touch move only the few levels between it and the touch
+// prices are keyed as integers so equality does not depend on the double representation
+
+template<typename Compare>  // ask is std::less<key>, bid is std::greater<key>
+class FlatLevelAggregate {
+  friend class Symbols;
+private:
+
+  using key_t = int64_t;
+
+  struct LevelAggregate { // aggregates limit orders at each level
+    key_t key;
+    price_t price;
+    volume_t nQuantity;
+    int nOrders;
+    LevelAggregate( key_t key_, price_t price_, volume_t nQuantity_ )
+    : key( key_ ), price( price_ ), nQuantity( nQuantity_ ), nOrders( 1 ) {}
+  };
+
+  using vLevelAggregate_t = std::vector<LevelAggregate>;
+
+public:
+
+  static const unsigned int max_ix = 10;
+
+  FlatLevelAggregate()
+  : m_fVolumeAtPrice( nullptr )
+  {
+    m_vLevelAggregate.reserve( 256 );
+  }
+
+  void Set( fVolumeAtPrice_t&& fVolumeAtPrice ) { // simple callback
+    m_fVolumeAtPrice = std::move( fVolumeAtPrice );
+  }
+
+  void Set( fBookChanges_t&& fBookChanges ) {
+    m_fBookChanges = std::move( fBookChanges );
+  }
+
+  void Add( const ou::tf::Depth& depth ) {
+
+    price_t price( depth.Price() );
+    volume_t volume( depth.Volume() );
+    const key_t key( Key( price ) );
+
+    typename vLevelAggregate_t::iterator iterLevelAggregate = Find( key );
+    if ( ( m_vLevelAggregate.end() == iterLevelAggregate ) || ( key != iterLevelAggregate->key ) ) {
+      iterLevelAggregate = m_vLevelAggregate.emplace( iterLevelAggregate, key, price, volume );
+      if ( m_fBookChanges ) {
+        m_fBookChanges( EOp::Insert, Ix( iterLevelAggregate ), depth );
+      }
+    }
+    else { // exising level
+      iterLevelAggregate->nQuantity += volume;
+      iterLevelAggregate->nOrders++;
+      if ( m_fBookChanges ) {
+        ou::tf::Depth depth_( depth.DateTime(), price, iterLevelAggregate->nQuantity );
+        m_fBookChanges( EOp::Increase, Ix( iterLevelAggregate ), depth_ );
+      }
+    }
+
+    if ( m_fVolumeAtPrice ) m_fVolumeAtPrice( price, iterLevelAggregate->nQuantity, true );
+  }
+
+  void Delete( const ou::tf::Depth& depth ) {
+
+    price_t price( depth.Price() );
+    volume_t volume( depth.Volume() );
+    const key_t key( Key( price ) );
+
+    typename vLevelAggregate_t::iterator iterLevelAggregate = Find( key );
+    if ( ( m_vLevelAggregate.end() == iterLevelAggregate ) || ( key != iterLevelAggregate->key ) ) {
+      BOOST_LOG_TRIVIAL(error) << "FlatLevelAggregate::Delete price not found: " << price;
+    }
+    else {
+      assert( volume <= iterLevelAggregate->nQuantity ); // ensure no wrap around
+      iterLevelAggregate->nQuantity -= volume;
+      iterLevelAggregate->nOrders--;
+
+      if ( m_fVolumeAtPrice ) m_fVolumeAtPrice( price, iterLevelAggregate->nQuantity, false );
+
+      const unsigned int ix( Ix( iterLevelAggregate ) );
+
+      if ( 0 == iterLevelAggregate->nQuantity ) { // level to be removed
+        assert( 0 == iterLevelAggregate->nOrders );
+        if ( m_fBookChanges ) {
+          ou::tf::Depth depth_( depth.DateTime(), price, 0 );
+          m_fBookChanges( EOp::Delete, ix, depth_ );
+        }
+        m_vLevelAggregate.erase( iterLevelAggregate );
+      }
+      else { // level changes but is not removed
+        if ( m_fBookChanges ) {
+          ou::tf::Depth depth_( depth.DateTime(), price, iterLevelAggregate->nQuantity );
+          m_fBookChanges( EOp::Decrease, ix, depth_ );
+        }
+      }
+    }
+  }
+
+  void Clear( const ou::tf::Depth& depth ) {
+    // clear a single entry
+  }
+
+protected:
+
+  vLevelAggregate_t m_vLevelAggregate;
+
+private:
+  fBookChanges_t m_fBookChanges;
+  fVolumeAtPrice_t m_fVolumeAtPrice;
+
+  static key_t Key( price_t price ) { return std::llround( price * 1e8 ); }
+
+  static bool Better( key_t lhs, key_t rhs ) { return Compare()( lhs, rhs ); }
+
+  // first level at or better than key, end() if key is better than the touch
+  typename vLevelAggregate_t::iterator Find( key_t key ) {
+    // most activity is near the touch, so check the top few before the binary search
+    static const std::size_t nScan( 8 );
+    typename vLevelAggregate_t::iterator iter = m_vLevelAggregate.end();
+    const typename vLevelAggregate_t::iterator begin = m_vLevelAggregate.begin();
+    for ( std::size_t n = 0; ( n < nScan ) && ( begin != iter ); ++n ) {
+      typename vLevelAggregate_t::iterator prior = iter - 1;
+      if ( Better( key, prior->key ) ) return iter; // key is better than prior, so belongs at iter
+      iter = prior;
+    }
+    return std::lower_bound(
+      begin, iter, key,
+      []( const LevelAggregate& level, key_t key_ ){ return Better( key_, level.key ); } );
+  }
+
+  // 1 is the top of the book, zero is beyond max_ix
+  unsigned int Ix( typename vLevelAggregate_t::const_iterator iter ) const {
+    const std::size_t ix( m_vLevelAggregate.cend() - iter );
+    return ( max_ix >= ix ) ? ix : 0;
+  }
+
+}; // class FlatLevelAggregate
+
 // ==== L2Base
 // ==== common code for MarketMaker, OrderBased
 
@@ -264,11 +412,17 @@ public:
 
 protected:
 
-  using MapLevelAggregateAsk_t = MapLevelAggregate<std::less<double> >;    // top of book: lowest price
-  using MapLevelAggregateBid_t = MapLevelAggregate<std::greater<double> >; // top of book: highest price
+  // the flat book is the default, define TFIQFEED_L2_MAP_BOOK to use the std::map based book
+#if defined( TFIQFEED_L2_MAP_BOOK )
+  using LevelAggregateAsk_t = MapLevelAggregate<std::less<double> >;    // top of book: lowest price
+  using LevelAggregateBid_t = MapLevelAggregate<std::greater<double> >; // top of book: highest price
+#else
+  using LevelAggregateAsk_t = FlatLevelAggregate<std::less<double> >;    // top of book: lowest price
+  using LevelAggregateBid_t = FlatLevelAggregate<std::greater<double> >; // top of book: highest price
+#endif
 
-  MapLevelAggregateAsk_t m_LevelAggregateAsk;
-  MapLevelAggregateBid_t m_LevelAggregateBid;
+  LevelAggregateAsk_t m_LevelAggregateAsk;
+  LevelAggregateBid_t m_LevelAggregateBid;
 
   fMarketDepthByMM_t m_fMarketDepthByMM;
   fMarketDepthByOrder_t m_fMarketDepthByOrder;
@@ -401,8 +555,8 @@ private:
     {}
   };
 
-  using mapOrder_t = std::map<uint64_t,Order>; // key is order id
-  mapOrder_t m_mapOrder;
+  using tableOrder_t = OrderTable<Order>; // key is order id
+  tableOrder_t m_tableOrder;
 
   EState m_state;
   idOrder_t m_idOrder;  // active when m_state other than Ready
@@ -534,9 +688,16 @@ private:
   using mapL2Base_t = std::map<std::string,pL2Base_t>; // symbol name, L2Processing
   mapL2Base_t m_mapL2Base; //used for batch operations
 
+  // arrival/delete carry a view into the line or their own string, clear carries its own string
+  static std::string_view SymbolName( const msg::OrderClear::decoded& msg ) { return msg.sSymbolName; }
+  template<typename Msg>
+  static std::string_view SymbolName( const Msg& msg ) { return msg.SymbolName(); }
+
   template<typename Msg>
   void SetCarrier( Carrier& carrier, const Msg& msg ) {
 
+    const std::string sSymbolName( SymbolName( msg ) );
+
     pL2Base_t pL2Base;
     if ( ( 0 != msg.nOrderId ) || ( 'C' == msg.chMsgType ) ) {
       assert( 0 == msg.mmid.rch[0] );
@@ -546,12 +707,12 @@ private:
       //assert( 4 == msg.sMarketMaker.size() ); // TODO: check each character is non-zero
       pL2Base = MarketMaker::Factory();
     }
-    m_mapL2Base.emplace( msg.sSymbolName, pL2Base );
+    m_mapL2Base.emplace( sSymbolName, pL2Base );
     carrier = pL2Base.get();
 
     {
       // may need mutex on this, vs foreground
-      mapBookChangeFunctions_t::iterator iter = m_mapBookChangeFunctions.find( msg.sSymbolName );
+      mapBookChangeFunctions_t::iterator iter = m_mapBookChangeFunctions.find( sSymbolName );
       if ( m_mapBookChangeFunctions.end() != iter ) {
         carrier.pL2Base->Set( std::move( iter->second.fBid ), std::move( iter->second.fAsk ) );
         m_mapBookChangeFunctions.erase( iter );
@@ -560,7 +721,7 @@ private:
 
     {
       // may need mutex on this, vs foreground
-      mapVolumeAtPriceFunctions_t::iterator iter = m_mapVolumeAtPriceFunctions.find( msg.sSymbolName );
+      mapVolumeAtPriceFunctions_t::iterator iter = m_mapVolumeAtPriceFunctions.find( sSymbolName );
       if ( m_mapVolumeAtPriceFunctions.end() != iter ) {
         carrier.pL2Base->Set( std::move( iter->second.fBid ), std::move( iter->second.fAsk ) );
         m_mapVolumeAtPriceFunctions.erase( iter );
@@ -568,7 +729,7 @@ private:
     }
 
     {
-      mapMarketDepthFunctionByMM_t::iterator iterDelegate = m_mapMarketDepthFunctionByMM.find( msg.sSymbolName );
+      mapMarketDepthFunctionByMM_t::iterator iterDelegate = m_mapMarketDepthFunctionByMM.find( sSymbolName );
       if ( m_mapMarketDepthFunctionByMM.end() != iterDelegate ) {
         carrier.pL2Base->Set( std::move( iterDelegate->second ) );
         m_mapMarketDepthFunctionByMM.erase( iterDelegate );
@@ -576,7 +737,7 @@ private:
     }
 
     {
-      mapMarketDepthFunctionByOrder_t::iterator iterDelegate = m_mapMarketDepthFunctionByOrder.find( msg.sSymbolName );
+      mapMarketDepthFunctionByOrder_t::iterator iterDelegate = m_mapMarketDepthFunctionByOrder.find( sSymbolName );
       if ( m_mapMarketDepthFunctionByOrder.end() != iterDelegate ) {
         carrier.pL2Base->Set( std::move( iterDelegate->second ) );
         m_mapMarketDepthFunctionByOrder.erase( iterDelegate );
@@ -595,10 +756,10 @@ private:
       (m_single.pL2Base->*f)( msg );
     }
     else {
-      Carrier carrier = m_luSymbol.FindMatch( msg.sSymbolName );
+      Carrier carrier = m_luSymbol.FindMatch( SymbolName( msg ) );
       if ( carrier.IsNull() ) {
         SetCarrier( carrier, msg );
-        m_luSymbol.AddPattern( msg.sSymbolName, carrier );
+        m_luSymbol.AddPattern( std::string( SymbolName( msg ) ), carrier );
       }
       (carrier.pL2Base->*f)( msg );
     }
@@ -18,6 +18,8 @@
 
 #include <fstream>
 
+#include <boost/filesystem.hpp>
+
 #include "CurlGetMktSymbols.h"
 #include "UnzipMktSymbols.h"
 #include "ParseMktSymbolDiskFile.h"
@@ -33,6 +35,7 @@ namespace detail {
   // shared between debug and release
   const std::string sFileNameMarketSymbolsText( "../mktsymbols_v2.txt" );
   const std::string sFileNameMarketSymbolsBinary( "../symbols.ser" );
+  const std::string sFileNameMarketSymbolsTable( "../symbols.tbl" );
 }
 
 typedef MarketSymbol::TableRowDef trd_t;
@@ -114,6 +117,22 @@ void LoadMktSymbols( InMemoryMktSymbolList& symbols, MktSymbolLoadType::Enum e,
 
 }
 
+std::unique_ptr<SymbolTable> OpenMktSymbolTable( const std::string& sTable, const std::string& sBinary ) {
+  namespace fs = boost::filesystem;
+  const bool bTable( fs::exists( sTable ) );
+  const bool bBinary( fs::exists( sBinary ) );
+  if ( !bTable && !bBinary ) {
+    throw std::runtime_error( "OpenMktSymbolTable: neither " + sTable + " nor " + sBinary + " exists" );
+  }
+  if ( bBinary && ( !bTable || ( fs::last_write_time( sTable ) < fs::last_write_time( sBinary ) ) ) ) {
+    std::cout << "Writing Symbol Table from " << sBinary << std::endl;
+    InMemoryMktSymbolList symbols;
+    symbols.LoadFromFile( sBinary );
+    SymbolTable::Write( symbols, sTable );
+  }
+  return std::make_unique<SymbolTable>( sTable );
+}
+
 } // namespace iqfeed
 } // namespace tf
 } // namespace ou
@@ -16,6 +16,9 @@
 
 // Started 2012/10/14
 
+#include <memory>
+
+#include "SymbolTable.h"
 #include "InMemoryMktSymbolList.h"
 
 namespace ou { // One Unified
@@ -26,6 +29,7 @@ namespace detail {
   // shared between debug and release
   extern const std::string sFileNameMarketSymbolsText;
   extern const std::string sFileNameMarketSymbolsBinary;
+  extern const std::string sFileNameMarketSymbolsTable; // SymbolTable snapshot, written beside the binary
 }
 
 namespace MktSymbolLoadType {
@@ -34,6 +38,11 @@ namespace MktSymbolLoadType {
 
 void LoadMktSymbols( InMemoryMktSymbolList& symbols, MktSymbolLoadType::Enum, bool bSaveTextToDisk, const std::string& sName = detail::sFileNameMarketSymbolsText );
 
+// for read only use:  opens the SymbolTable snapshot, first rewriting it from the binary list when it is missing or older
+std::unique_ptr<SymbolTable> OpenMktSymbolTable(
+  const std::string& sTable = detail::sFileNameMarketSymbolsTable,
+  const std::string& sBinary = detail::sFileNameMarketSymbolsBinary );
+
 } // namespace iqfeed
 } // namespace tf
 } // namespace ou
@@ -16,9 +16,13 @@
 
 #include <string>
 #include <vector>
+#include <charconv>
+#include <string_view>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <boost/container/small_vector.hpp>
+
 #include <boost/spirit/include/qi.hpp>
 
 #include <boost/phoenix/core.hpp>
@@ -30,42 +34,8 @@
 // field offsets are 1 based, in order to easily match up with documentation
 // for all the charT =  = unsigned char template parameters, need to turn into a trait
 //   trait is shared with IQFeedMessages and Network
-
-namespace ou { // One Unified
-namespace tf { // TradeFrame
-namespace iqfeed { // IQFeed
-
-struct date_values {
-  uint16_t year;
-  uint16_t month;
-  uint16_t day;
-  date_values(): year {}, month {}, day {} {}
-};
-
-struct time_values {
-  uint16_t hours;
-  uint16_t minutes;
-  uint16_t seconds;
-  time_values(): hours {}, minutes {}, seconds {} {}
-};
-
-} // namespace iqfeed
-} // namespace tf
-} // namespace ou
-
-BOOST_FUSION_ADAPT_STRUCT( // iqfeed format mm/dd/yyyy
-  ou::tf::iqfeed::date_values,
-  (uint16_t, month)
-  (uint16_t, day)
-  (uint16_t, year)
-  )
-
-BOOST_FUSION_ADAPT_STRUCT(
-  ou::tf::iqfeed::time_values,
-  (uint16_t, hours)
-  (uint16_t, minutes)
-  (uint16_t, seconds)
-  )
+// the field index is held in-object, sized by nFields, so re-tokenizing a pooled message does not allocate,
+//   messages with more fields than nFields (news headlines with commas) spill to the heap
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -75,7 +45,17 @@ using date = boost::gregorian::date;
 using time = boost::posix_time::time_duration;
 using ptime = boost::posix_time::ptime;
 
-template <class T, class charT = unsigned char>
+// number of comma separated names in a field selector
+constexpr std::size_t CountSelectorFields( const char* selector ) {
+  std::size_t n( 1 );
+  for ( ; 0 != *selector; ++selector ) {
+    if ( ',' == *selector ) ++n;
+  }
+  return n;
+}
+
+// nFields: in-object capacity of the field index, includes entry 0 (whole message)
+template <class T, class charT = unsigned char, std::size_t nFields = 80>
 class IQFBaseMessage {
 public:
 
@@ -85,6 +65,7 @@ public:
   using iterator_t = typename linebuffer_t::iterator;  // TODO: need to use const_iterator
   using fielddelimiter_t = std::pair<iterator_t, iterator_t>;
   using ixFields_t = typename linebuffer_t::size_type;
+  using vFieldDelimiters_t = boost::container::small_vector<fielddelimiter_t, nFields>;
 
   IQFBaseMessage( void );
   IQFBaseMessage( iterator_t& current, iterator_t& end );
@@ -93,8 +74,9 @@ public:
 
   // change to return a fielddelimiter_t
   const std::string Field( ixFields_t ) const;
-  double Double( ixFields_t ) const;  // use boost::spirit?
-  int Integer( ixFields_t ) const;  // use boost::spirit?
+  std::string_view FieldView( ixFields_t ) const; // valid while the line buffer is held
+  double Double( ixFields_t ) const;
+  int Integer( ixFields_t ) const;
   date Date( ixFields_t ) const;
   time Time( ixFields_t ) const;
 
@@ -105,12 +87,14 @@ protected:
 
   ~IQFBaseMessage(void);
 
-  std::vector<fielddelimiter_t> m_vFieldDelimiters;
+  vFieldDelimiters_t m_vFieldDelimiters;
 
   void Tokenize( iterator_t& begin, iterator_t& end );  // scans for ',' and builds the m_vFieldDelimiters vector
 
 private:
 
+  static std::string_view view( const fielddelimiter_t& );
+
   int parse_int( fielddelimiter_t ) const;
   double parse_double(  fielddelimiter_t ) const;
   date parse_date( fielddelimiter_t ) const; // MM/DD/YYYY
@@ -386,8 +370,13 @@ private:
 // *******
 
 //**** IQFDynamicFeedMessage ( root for IQFDynamicFeedSummaryMessage, IQFDynamicFeedUpdateMessage)
+
+constexpr char szDynamicFeedSelector[] = "Symbol,Total Volume,Bid,Ask,Bid Size,Ask Size,Number of Trades Today,Most Recent Trade,Most Recent Trade Size,Most Recent Trade Time,Most Recent Trade Conditions,Most Recent Trade Market Center,Message Contents,Most Recent Trade Aggressor,Open Interest";
+// entry 0, message type, selected fields, empty field following the trailing comma
+constexpr std::size_t nDynamicFeedFields = 3 + CountSelectorFields( szDynamicFeedSelector );
+
 template <class T, class charT = unsigned char>
-class IQFDynamicFeedMessage: public IQFBaseMessage<IQFDynamicFeedMessage<T, charT> > { // Q, P
+class IQFDynamicFeedMessage: public IQFBaseMessage<IQFDynamicFeedMessage<T, charT>, charT, nDynamicFeedFields> { // Q, P
 public:
 
   enum enumFieldIds {
@@ -409,15 +398,16 @@ public:
     _DFLastEntry
   };
 
-  using iterator_t = typename IQFBaseMessage<IQFDynamicFeedMessage<T, charT> >::iterator_t;
-  using fielddelimiter_t = typename IQFBaseMessage<IQFDynamicFeedMessage<T, charT> >::fielddelimiter_t;
+  using base_t = IQFBaseMessage<IQFDynamicFeedMessage<T, charT>, charT, nDynamicFeedFields>;
+  using iterator_t = typename base_t::iterator_t;
+  using fielddelimiter_t = typename base_t::fielddelimiter_t;
 
   static const std::string selector;
 
   IQFDynamicFeedMessage( void )
-  : IQFBaseMessage<IQFDynamicFeedMessage<T, charT> >() {}
+  : base_t() {}
   IQFDynamicFeedMessage( iterator_t& current, iterator_t& end )
-  : IQFBaseMessage<IQFDynamicFeedMessage<T, charT> >( current, end ) {}
+  : base_t( current, end ) {}
 
 protected:
   ~IQFDynamicFeedMessage(void){}
@@ -425,7 +415,7 @@ private:
 };
 
 template <class T, class charT>
-const std::string IQFDynamicFeedMessage<T, charT>::selector( "Symbol,Total Volume,Bid,Ask,Bid Size,Ask Size,Number of Trades Today,Most Recent Trade,Most Recent Trade Size,Most Recent Trade Time,Most Recent Trade Conditions,Most Recent Trade Market Center,Message Contents,Most Recent Trade Aggressor,Open Interest" );
+const std::string IQFDynamicFeedMessage<T, charT>::selector( szDynamicFeedSelector );
 //                                     S,SELECT UPDATE FIELDS,Symbol,Total Volume,Bid,Ask,Bid Size,Ask Size,Number of Trades Today,Most Recent Trade,Most Recent Trade Size,Most Recent Trade Time,Most Recent Trade Conditions,Most Recent Trade Market Center,Message Contents,Most Recent Trade Aggressor
 // S,SET PROTOCOL,6.1
 // rTST$Y
@@ -531,28 +521,28 @@ private:
 
 // *******
 
-template <class T, class charT>
-IQFBaseMessage<T, charT>::IQFBaseMessage( void )
+template <class T, class charT, std::size_t nFields>
+IQFBaseMessage<T, charT, nFields>::IQFBaseMessage( void )
 {
 }
 
-template <class T, class charT>
-IQFBaseMessage<T, charT>::IQFBaseMessage( iterator_t& current, iterator_t& end )
+template <class T, class charT, std::size_t nFields>
+IQFBaseMessage<T, charT, nFields>::IQFBaseMessage( iterator_t& current, iterator_t& end )
 {
   Tokenize( current, end );
 }
 
-template <class T, class charT>
-IQFBaseMessage<T, charT>::~IQFBaseMessage(void) {
+template <class T, class charT, std::size_t nFields>
+IQFBaseMessage<T, charT, nFields>::~IQFBaseMessage(void) {
 }
 
-template <class T, class charT>
-void IQFBaseMessage<T, charT>::Assign( iterator_t& current, iterator_t& end ) {
+template <class T, class charT, std::size_t nFields>
+void IQFBaseMessage<T, charT, nFields>::Assign( iterator_t& current, iterator_t& end ) {
   Tokenize( current, end );
 }
 
-template <class T, class charT>
-void IQFBaseMessage<T, charT>::Tokenize( iterator_t& current, iterator_t& end ) {
+template <class T, class charT, std::size_t nFields>
+void IQFBaseMessage<T, charT, nFields>::Tokenize( iterator_t& current, iterator_t& end ) {
   // used in IQFeedLookupPort::Parse
 
   m_vFieldDelimiters.clear();
@@ -573,8 +563,8 @@ void IQFBaseMessage<T, charT>::Tokenize( iterator_t& current, iterator_t& end )
   m_vFieldDelimiters.push_back( fielddelimiter_t( begin, current ) );
 }
 
-template <class T, class charT>
-const std::string IQFBaseMessage<T, charT>::Field( ixFields_t fld ) const {
+template <class T, class charT, std::size_t nFields>
+const std::string IQFBaseMessage<T, charT, nFields>::Field( ixFields_t fld ) const {
   std::string sField;
   BOOST_ASSERT( 0 != fld );
   BOOST_ASSERT( fld <= m_vFieldDelimiters.size() - 1 );
@@ -585,8 +575,15 @@ const std::string IQFBaseMessage<T, charT>::Field( ixFields_t fld ) const {
   return sField;
 }
 
-template <class T, class charT>
-double IQFBaseMessage<T, charT>::Double( ixFields_t fld ) const {
+template <class T, class charT, std::size_t nFields>
+std::string_view IQFBaseMessage<T, charT, nFields>::FieldView( ixFields_t fld ) const {
+  BOOST_ASSERT( 0 != fld );
+  BOOST_ASSERT( fld <= m_vFieldDelimiters.size() - 1 );
+  return view( m_vFieldDelimiters[ fld ] );
+}
+
+template <class T, class charT, std::size_t nFields>
+double IQFBaseMessage<T, charT, nFields>::Double( ixFields_t fld ) const {
   BOOST_ASSERT( 0 != fld );
   BOOST_ASSERT( fld <= m_vFieldDelimiters.size() - 1 );
 
@@ -599,8 +596,8 @@ double IQFBaseMessage<T, charT>::Double( ixFields_t fld ) const {
   return value;
 }
 
-template <class T, class charT>
-int IQFBaseMessage<T, charT>::Integer( ixFields_t fld ) const {
+template <class T, class charT, std::size_t nFields>
+int IQFBaseMessage<T, charT, nFields>::Integer( ixFields_t fld ) const {
   BOOST_ASSERT( 0 != fld );
   BOOST_ASSERT( fld <= m_vFieldDelimiters.size() - 1 );
 
@@ -613,8 +610,8 @@ int IQFBaseMessage<T, charT>::Integer( ixFields_t fld ) const {
   return value;
 }
 
-template <class T, class charT>
-date IQFBaseMessage<T, charT>::Date( ixFields_t fld ) const {
+template <class T, class charT, std::size_t nFields>
+date IQFBaseMessage<T, charT, nFields>::Date( ixFields_t fld ) const {
   BOOST_ASSERT( 0 != fld );
   BOOST_ASSERT( fld <= m_vFieldDelimiters.size() - 1 );
 
@@ -629,8 +626,8 @@ date IQFBaseMessage<T, charT>::Date( ixFields_t fld ) const {
   return d;
 }
 
-template <class T, class charT>
-time IQFBaseMessage<T, charT>::Time( ixFields_t fld ) const {
+template <class T, class charT, std::size_t nFields>
+time IQFBaseMessage<T, charT, nFields>::Time( ixFields_t fld ) const {
   BOOST_ASSERT( 0 != fld );
   BOOST_ASSERT( fld <= m_vFieldDelimiters.size() - 1 );
 
@@ -644,15 +641,15 @@ time IQFBaseMessage<T, charT>::Time( ixFields_t fld ) const {
   return t;
 }
 
-template <class T, class charT>
-typename IQFBaseMessage<T, charT>::iterator_t IQFBaseMessage<T, charT>::FieldBegin( ixFields_t fld ) const {
+template <class T, class charT, std::size_t nFields>
+typename IQFBaseMessage<T, charT, nFields>::iterator_t IQFBaseMessage<T, charT, nFields>::FieldBegin( ixFields_t fld ) const {
   BOOST_ASSERT( 0 != fld );
   BOOST_ASSERT( fld <= m_vFieldDelimiters.size() - 1 );
   return m_vFieldDelimiters[ fld ].first;
 }
 
-template <class T, class charT>
-typename IQFBaseMessage<T, charT>::iterator_t IQFBaseMessage<T, charT>::FieldEnd( ixFields_t fld ) const {
+template <class T, class charT, std::size_t nFields>
+typename IQFBaseMessage<T, charT, nFields>::iterator_t IQFBaseMessage<T, charT, nFields>::FieldEnd( ixFields_t fld ) const {
   BOOST_ASSERT( 0 != fld );
   BOOST_ASSERT( fld <= m_vFieldDelimiters.size() - 1 );
   return m_vFieldDelimiters[ fld ].second;
@@ -660,62 +657,56 @@ typename IQFBaseMessage<T, charT>::iterator_t IQFBaseMessage<T, charT>::FieldEnd
 
 namespace qi = boost::spirit::qi;
 
-template <class T, class charT>
-int IQFBaseMessage<T, charT>::parse_int( fielddelimiter_t fd ) const {
-
-  using namespace boost::phoenix::arg_names;
+template <class T, class charT, std::size_t nFields>
+std::string_view IQFBaseMessage<T, charT, nFields>::view( const fielddelimiter_t& fd ) {
+  if ( fd.first == fd.second ) return std::string_view();
+  return std::string_view( reinterpret_cast<const char*>( &*fd.first ), fd.second - fd.first );
+}
 
-  using boost::spirit::qi::_1;
-  using boost::phoenix::ref;
-  using namespace boost::spirit::qi;
+template <class T, class charT, std::size_t nFields>
+int IQFBaseMessage<T, charT, nFields>::parse_int( fielddelimiter_t fd ) const {
 
   int value {};
 
-  bool b = qi::parse( fd.first, fd.second, int_[ref( value ) = _1] );
+  std::string_view sv( view( fd ) );
+  if ( '+' == sv.front() ) sv.remove_prefix( 1 );
+  std::from_chars( sv.data(), sv.data() + sv.size(), value );
 
   return value;
 }
 
-template <class T, class charT>
-double IQFBaseMessage<T, charT>::parse_double( fielddelimiter_t fd ) const {
-
-  using namespace boost::phoenix::arg_names;
-
-  using boost::spirit::qi::_1;
-  using boost::phoenix::ref;
-  using namespace boost::spirit::qi;
+template <class T, class charT, std::size_t nFields>
+double IQFBaseMessage<T, charT, nFields>::parse_double( fielddelimiter_t fd ) const {
 
   double value {};
 
-  bool b = qi::parse( fd.first, fd.second, double_[ref( value ) = _1] );
+  std::string_view sv( view( fd ) );
+  if ( '+' == sv.front() ) sv.remove_prefix( 1 );
+  std::from_chars( sv.data(), sv.data() + sv.size(), value );
+
   return value;
 }
 
-template<typename Iterator>
-struct DateParser: qi::grammar<Iterator, date_values()> {
+template <class T, class charT, std::size_t nFields>
+date IQFBaseMessage<T, charT, nFields>::parse_date( fielddelimiter_t fd ) const {
 
-  DateParser(): DateParser::base_type( start ) {
+  // mm/dd/yyyy, length validated by caller
+  const std::string_view sv( view( fd ) );
+  const char* p( sv.data() );
 
-    value %= qi::uint_;
-    start %= value >> qi::lit( '/') >> value >> qi::lit( '/' ) >> value; // mm/dd/yyyy
-
-  }
-
-  qi::rule<Iterator, uint16_t()> value;
-  qi::rule<Iterator, date_values()> start;
-};
-
-template <class T, class charT>
-date IQFBaseMessage<T, charT>::parse_date( fielddelimiter_t fd ) const {
-
-  date_values values;
-  DateParser<iterator_t> grammarDateParser;
+  unsigned int month {};
+  unsigned int day {};
+  unsigned int year {};
   date value( boost::posix_time::not_a_date_time );
 
-  bool bOk = parse( fd.first, fd.second, grammarDateParser, values );
+  bool bOk
+    =  ( '/' == p[ 2 ] ) && ( '/' == p[ 5 ] )
+    && ( std::errc() == std::from_chars( p + 0, p +  2, month ).ec )
+    && ( std::errc() == std::from_chars( p + 3, p +  5, day   ).ec )
+    && ( std::errc() == std::from_chars( p + 6, p + 10, year  ).ec );
 
   try {
-    if ( bOk ) value = date( values.year, values.month, values.day );
+    if ( bOk ) value = date( year, month, day );
   }
   catch (...) {
     std::string s( fd.first, fd.second );
@@ -725,29 +716,33 @@ date IQFBaseMessage<T, charT>::parse_date( fielddelimiter_t fd ) const {
   return value;
 }
 
-template<typename Iterator>
-struct TimeParser: qi::grammar<Iterator, time_values()> {
-
-  TimeParser(): TimeParser::base_type( start ) {
+template <class T, class charT, std::size_t nFields>
+time IQFBaseMessage<T, charT, nFields>::parse_time( fielddelimiter_t fd ) const {
 
-    value %= qi::uint_;
-    start %= value >> qi::lit( ':') >> value >> qi::lit( ':' ) >> value; // hh:mm:ss
-
-  }
+  // hh:mm:ss, length validated by caller
+  const std::string_view sv( view( fd ) );
+  const char* p( sv.data() );
 
-  qi::rule<Iterator, uint16_t()> value;
-  qi::rule<Iterator, time_values()> start;
-};
+  unsigned int hours {};
+  unsigned int minutes {};
+  unsigned int seconds {};
+  time value( boost::posix_time::not_a_date_time );
 
-template <class T, class charT>
-time IQFBaseMessage<T, charT>::parse_time( fielddelimiter_t fd ) const {
+  auto digits = []( const char* first, const char* last, unsigned int& n )->bool {
+    const std::from_chars_result result( std::from_chars( first, last, n ) );
+    return ( std::errc() == result.ec ) && ( last == result.ptr );
+  };
 
-  time_values values {};
-  TimeParser<iterator_t> grammarTimeParser;
-  time value( boost::posix_time::not_a_date_time );
+  bool bOk
+    =  ( ':' == p[ 2 ] ) && ( ':' == p[ 5 ] )
+    && digits( p + 0, p + 2, hours )
+    && digits( p + 3, p + 5, minutes )
+    && digits( p + 6, p + 8, seconds );
 
-  bool bOk = parse( fd.first, fd.second, grammarTimeParser, values );
-  value = time( values.hours, values.minutes, values.seconds );
+  if ( bOk ) value = time( hours, minutes, seconds );
+  else {
+    std::cout << "IQFBaseMessage<T, charT>::parse_time ill formed time: " << sv << std::endl;
+  }
 
   return value;
 }
@@ -189,12 +189,10 @@ void Provider::StopTradeWatch(pSymbol_t pSymbol) {
 }
 
 void Provider::OnIQFeedDynamicFeedUpdateMessage( linebuffer_t* pBuffer, IQFDynamicFeedUpdateMessage *pMsg ) {
-  inherited_t::mapSymbols_t::iterator mapSymbols_iter;
-  auto field = pMsg->Field( IQFDynamicFeedSummaryMessage::DFSymbol );
-  mapSymbols_iter = m_mapSymbols.find( field );
-  if ( m_mapSymbols.end() != mapSymbols_iter ) {
-    pSymbol_t pSym = mapSymbols_iter -> second;
-    pSym ->HandleDynamicFeedUpdateMessage( pMsg );
+  const std::string_view field = pMsg->FieldView( IQFDynamicFeedSummaryMessage::DFSymbol );
+  const pSymbol_t* ppSym = m_indexSymbols.Find( field, m_cacheSymbol );
+  if ( nullptr != ppSym ) {
+    (*ppSym)->HandleDynamicFeedUpdateMessage( pMsg );
   }
   else {
     std::cout << "field " << field << " update not found" << std::endl;
@@ -203,12 +201,10 @@ void Provider::OnIQFeedDynamicFeedUpdateMessage( linebuffer_t* pBuffer, IQFDynam
 }
 
 void Provider::OnIQFeedDynamicFeedSummaryMessage( linebuffer_t* pBuffer, IQFDynamicFeedSummaryMessage *pMsg ) {
-  inherited_t::mapSymbols_t::iterator mapSymbols_iter;
-  auto field = pMsg->Field( IQFDynamicFeedSummaryMessage::DFSymbol );
-  mapSymbols_iter = m_mapSymbols.find( field );
-  if ( m_mapSymbols.end() != mapSymbols_iter ) {
-    pSymbol_t  pSym = mapSymbols_iter -> second;
-    pSym ->HandleDynamicFeedSummaryMessage( pMsg );
+  const std::string_view field = pMsg->FieldView( IQFDynamicFeedSummaryMessage::DFSymbol );
+  const pSymbol_t* ppSym = m_indexSymbols.Find( field, m_cacheSymbol );
+  if ( nullptr != ppSym ) {
+    (*ppSym)->HandleDynamicFeedSummaryMessage( pMsg );
   }
   else {
     std::cout << "field " << field << " summary not found" << std::endl;
@@ -217,34 +213,25 @@ void Provider::OnIQFeedDynamicFeedSummaryMessage( linebuffer_t* pBuffer, IQFDyna
 }
 
 void Provider::OnIQFeedUpdateMessage( linebuffer_t* pBuffer, IQFUpdateMessage *pMsg ) {
-  inherited_t::mapSymbols_t::iterator mapSymbols_iter;
-  mapSymbols_iter = m_mapSymbols.find( pMsg->Field( IQFUpdateMessage::QPSymbol ) );
-  pSymbol_t pSym;
-  if ( m_mapSymbols.end() != mapSymbols_iter ) {
-    pSym = mapSymbols_iter -> second;
-    pSym ->HandleUpdateMessage( pMsg );
+  const pSymbol_t* ppSym = m_indexSymbols.Find( pMsg->FieldView( IQFUpdateMessage::QPSymbol ), m_cacheSymbol );
+  if ( nullptr != ppSym ) {
+    (*ppSym)->HandleUpdateMessage( pMsg );
   }
   this->UpdateDone( pBuffer, pMsg );
 }
 
 void Provider::OnIQFeedSummaryMessage( linebuffer_t* pBuffer, IQFSummaryMessage *pMsg ) {
-  inherited_t::mapSymbols_t::iterator mapSymbols_iter;
-  mapSymbols_iter = m_mapSymbols.find( pMsg->Field( IQFSummaryMessage::QPSymbol ) );
-  pSymbol_t pSym;
-  if ( m_mapSymbols.end() != mapSymbols_iter ) {
-    pSym = mapSymbols_iter -> second;
-    pSym ->HandleSummaryMessage( pMsg );
+  const pSymbol_t* ppSym = m_indexSymbols.Find( pMsg->FieldView( IQFSummaryMessage::QPSymbol ), m_cacheSymbol );
+  if ( nullptr != ppSym ) {
+    (*ppSym)->HandleSummaryMessage( pMsg );
   }
   this->SummaryDone( pBuffer, pMsg );
 }
 
 void Provider::OnIQFeedFundamentalMessage( linebuffer_t* pBuffer, IQFFundamentalMessage *pMsg ) {
-  inherited_t::mapSymbols_t::iterator mapSymbols_iter;
-  mapSymbols_iter = m_mapSymbols.find( pMsg->Field( IQFFundamentalMessage::FSymbol ) );
-  pSymbol_t pSym;
-  if ( m_mapSymbols.end() != mapSymbols_iter ) {
-    pSym = mapSymbols_iter -> second;
-    pSym ->HandleFundamentalMessage(
+  const pSymbol_t* ppSym = m_indexSymbols.Find( pMsg->FieldView( IQFFundamentalMessage::FSymbol ), m_cacheSymbol );
+  if ( nullptr != ppSym ) {
+    (*ppSym)->HandleFundamentalMessage(
       pMsg,
       [this](int nSecurityType )->ESecurityType { return LookupSecurityType( nSecurityType ); },
       [this](std::string sExchangeId)->std::string{ // supplied string is in hex
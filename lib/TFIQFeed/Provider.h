@@ -86,6 +86,8 @@ protected:
 
 private:
 
+  inherited_t::indexSymbols_t::Cache m_cacheSymbol; // last hit on the feed connection
+
   void UpdateQuoteTradeWatch( char command, IQFeedSymbol::WatchState next, IQFeedSymbol *pSymbol );
 
   void HandleExecution( Order::idOrder_t orderId, const Execution &exec );
@@ -110,7 +110,7 @@ void IQFeedSymbol::DecodeDynamicFeedMessage( IQFDynamicFeedMessage<T>* pMsg )  {
 
   summary.bNewTrade = summary.bNewQuote = summary.bNewOpen = false;
 
-  std::string content = pMsg->Field( IQFDynamicFeedMessage<T>::DFMessageContents );
+  const std::string_view content = pMsg->FieldView( IQFDynamicFeedMessage<T>::DFMessageContents );
   for ( const char id: content ) {
     switch ( id ) {
       case 'C':
@@ -177,7 +177,7 @@ void IQFeedSymbol::DecodePricingMessage( IQFPricingMessage<T>* pMsg ) {
   double dblOpen, dblBid, dblAsk;
   int nBidSize, nAskSize;
 
-  std::string sLastTradeTime = pMsg->Field( IQFPricingMessage<T>::QPLastTradeTime );
+  const std::string_view sLastTradeTime = pMsg->FieldView( IQFPricingMessage<T>::QPLastTradeTime );
   if ( sLastTradeTime.length() > 0 ) {
     chType = sLastTradeTime[ sLastTradeTime.length() - 1 ];
   }
@@ -262,7 +262,7 @@ void IQFeedSymbol::HandleSummaryMessage( IQFSummaryMessage* pMsg ) {
 void IQFeedSymbol::HandleUpdateMessage( IQFUpdateMessage* pMsg ) {
 
   if ( qUnknown == m_QStatus ) {
-    m_QStatus = ( "Not Found" == pMsg->Field( IQFPricingMessage<IQFUpdateMessage>::QPLast ) ) ? qNotFound : qFound;
+    m_QStatus = ( "Not Found" == pMsg->FieldView( IQFPricingMessage<IQFUpdateMessage>::QPLast ) ) ? qNotFound : qFound;
     if ( qNotFound == m_QStatus ) {
       BOOST_LOG_TRIVIAL(error)
         << "IQFeedSymbol::HandleUpdateMessage: " << GetId() << " not found";
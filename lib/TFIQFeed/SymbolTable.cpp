@@ -0,0 +1,307 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    SymbolTable.cpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFIQFeed
+ * Created: 2026/10/16 21:12:36
+ */
+
+#include <vector>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <fstream>
+#include <algorithm>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "SymbolTable.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+namespace {
+
+  const char c_rchMagic[ 8 ] = { 'T', 'F', 'S', 'Y', 'M', 'T', 'B', 'L' };
+  const uint32_t c_nVersion = 1;
+
+  // file:  header, records, exchange index, security type index, underlying index, arena
+  struct FileHeader {
+    char rchMagic[ 8 ];
+    uint32_t nVersion;
+    uint32_t nRecordSize;
+    uint32_t nRows;
+    uint32_t nArena; // bytes
+    uint64_t ixRecord; // byte offsets
+    uint64_t ixExchange;
+    uint64_t ixSecurityType;
+    uint64_t ixUnderlying;
+    uint64_t ixArena;
+    uint64_t nSize; // of the file, a short file is refused
+  };
+
+  static_assert( 0 == sizeof( FileHeader ) % 8, "records follow the header, 8 byte aligned" );
+
+  void Put( std::ofstream& ofs, const void* p, size_t n ) {
+    ofs.write( reinterpret_cast<const char*>( p ), n );
+  }
+
+} // namespace anonymous
+
+// ==== Row
+
+SymbolTable::trd_t SymbolTable::Row::Trd() const {
+  trd_t trd;
+  trd.sSymbol = Symbol();
+  trd.sDescription = Description();
+  trd.sExchange = Exchange();
+  trd.sListedMarket = ListedMarket();
+  trd.sc = SecurityType();
+  trd.nMultiplier = m_record.nMultiplier;
+  trd.nSIC = m_record.nSIC;
+  trd.nNAICS = m_record.nNAICS;
+  trd.sUnderlying = Underlying();
+  trd.eOptionSide = OptionSide();
+  trd.dblStrike = m_record.dblStrike;
+  trd.nYear = m_record.nYear;
+  trd.nMonth = m_record.nMonth;
+  trd.nDay = m_record.nDay;
+  trd.bFrontMonth = FrontMonth();
+  trd.bHasOptions = HasOptions();
+  return trd;
+}
+
+// ==== SymbolTable
+
+SymbolTable::SymbolTable( const std::string& sFileName )
+: m_fd( -1 ), m_pData( nullptr ), m_nSize {}
+, m_nRows {}, m_pRecord( nullptr )
+, m_pixExchange( nullptr ), m_pixSecurityType( nullptr ), m_pixUnderlying( nullptr )
+, m_pArena( nullptr ), m_nArena {}
+{
+  m_fd = ::open( sFileName.c_str(), O_RDONLY | O_CLOEXEC );
+  if ( 0 > m_fd ) {
+    throw std::runtime_error( "SymbolTable: can not open " + sFileName );
+  }
+
+  struct stat st;
+  if ( ( 0 != ::fstat( m_fd, &st ) ) || ( sizeof( FileHeader ) > size_t( st.st_size ) ) ) {
+    ::close( m_fd );
+    throw std::runtime_error( "SymbolTable: no header in " + sFileName );
+  }
+  m_nSize = st.st_size;
+
+  void* p = ::mmap( nullptr, m_nSize, PROT_READ, MAP_SHARED, m_fd, 0 );
+  if ( MAP_FAILED == p ) {
+    ::close( m_fd );
+    throw std::runtime_error( "SymbolTable: can not map " + sFileName );
+  }
+  m_pData = reinterpret_cast<const uint8_t*>( p );
+
+  const FileHeader& header( *reinterpret_cast<const FileHeader*>( m_pData ) );
+  const bool bValid(
+       ( 0 == std::memcmp( header.rchMagic, c_rchMagic, sizeof( c_rchMagic ) ) )
+    && ( c_nVersion == header.nVersion )
+    && ( sizeof( Record ) == header.nRecordSize )
+    && ( m_nSize == header.nSize )
+    && ( header.ixRecord + uint64_t( header.nRows ) * sizeof( Record ) <= header.ixExchange )
+    && ( header.ixExchange + uint64_t( header.nRows ) * sizeof( uint32_t ) <= header.ixSecurityType )
+    && ( header.ixSecurityType + uint64_t( header.nRows ) * sizeof( uint32_t ) <= header.ixUnderlying )
+    && ( header.ixUnderlying + uint64_t( header.nRows ) * sizeof( uint32_t ) <= header.ixArena )
+    && ( header.ixArena + header.nArena <= m_nSize )
+  );
+  if ( !bValid ) {
+    ::munmap( p, m_nSize );
+    ::close( m_fd );
+    throw std::runtime_error( "SymbolTable: not a symbol table, or a different version, " + sFileName );
+  }
+
+  m_nRows = header.nRows;
+  m_pRecord = reinterpret_cast<const Record*>( m_pData + header.ixRecord );
+  m_pixExchange = reinterpret_cast<const uint32_t*>( m_pData + header.ixExchange );
+  m_pixSecurityType = reinterpret_cast<const uint32_t*>( m_pData + header.ixSecurityType );
+  m_pixUnderlying = reinterpret_cast<const uint32_t*>( m_pData + header.ixUnderlying );
+  m_pArena = m_pData + header.ixArena;
+  m_nArena = header.nArena;
+}
+
+SymbolTable::~SymbolTable() {
+  ::munmap( const_cast<uint8_t*>( m_pData ), m_nSize );
+  ::close( m_fd );
+}
+
+std::string_view SymbolTable::String( uint32_t ix ) const {
+  assert( ix + sizeof( uint16_t ) <= m_nArena );
+  uint16_t n;
+  std::memcpy( &n, m_pArena + ix, sizeof( n ) );
+  return std::string_view( reinterpret_cast<const char*>( m_pArena + ix + sizeof( n ) ), n );
+}
+
+template<typename Key>
+SymbolTable::range_t SymbolTable::EqualRange( const uint32_t* pIndex, Key ( SymbolTable::*key )( uint32_t ) const, Key k ) const {
+  auto at = [this,pIndex,key]( uint32_t ix ){ return ( this->*key )( ( nullptr == pIndex ) ? ix : pIndex[ ix ] ); };
+  uint32_t ixLower {};
+  uint32_t n( m_nRows );
+  while ( 0 < n ) { // first not less than k
+    const uint32_t half( n / 2 );
+    if ( at( ixLower + half ) < k ) {
+      ixLower += half + 1;
+      n -= half + 1;
+    }
+    else n = half;
+  }
+  uint32_t ixUpper( ixLower );
+  n = m_nRows - ixLower;
+  while ( 0 < n ) { // first greater than k
+    const uint32_t half( n / 2 );
+    if ( !( k < at( ixUpper + half ) ) ) {
+      ixUpper += half + 1;
+      n -= half + 1;
+    }
+    else n = half;
+  }
+  return range_t( iterator( *this, pIndex, ixLower ), iterator( *this, pIndex, ixUpper ) );
+}
+
+SymbolTable::range_t SymbolTable::EqualRange( ixSymbol, std::string_view sKey ) const {
+  return EqualRange( nullptr, &SymbolTable::KeySymbol, sKey ); // the records are in symbol order
+}
+
+SymbolTable::range_t SymbolTable::EqualRange( ixExchange, std::string_view sKey ) const {
+  return EqualRange( m_pixExchange, &SymbolTable::KeyExchange, sKey );
+}
+
+SymbolTable::range_t SymbolTable::EqualRange( ixSymbolClass, ESecurityType sc ) const {
+  return EqualRange( m_pixSecurityType, &SymbolTable::KeySecurityType, static_cast<uint8_t>( sc ) );
+}
+
+SymbolTable::range_t SymbolTable::EqualRange( ixUnderlying, std::string_view sKey ) const {
+  return EqualRange( m_pixUnderlying, &SymbolTable::KeyUnderlying, sKey );
+}
+
+void SymbolTable::Write( const InMemoryMktSymbolList& list, const std::string& sFileName ) {
+
+  std::vector<Record> vRecord;
+  vRecord.reserve( list.Size() );
+
+  std::string sArena;
+  std::unordered_map<std::string, uint32_t> mapInterned;
+
+  auto intern = [&sArena,&mapInterned]( const std::string& s )->uint32_t {
+    auto iter = mapInterned.find( s );
+    if ( mapInterned.end() == iter ) {
+      const uint16_t n( std::min<size_t>( s.size(), UINT16_MAX ) );
+      if ( UINT32_MAX < sArena.size() + sizeof( n ) + n ) {
+        throw std::runtime_error( "SymbolTable: strings exceed the arena" );
+      }
+      iter = mapInterned.emplace( s, sArena.size() ).first;
+      sArena.append( reinterpret_cast<const char*>( &n ), sizeof( n ) );
+      sArena.append( s, 0, n );
+    }
+    return iter->second;
+  };
+
+  list.ScanSymbols( // in symbol order
+    [&vRecord,&intern]( const trd_t& trd ){
+      Record record;
+      std::memset( &record, 0, sizeof( record ) );
+      record.dblStrike = trd.dblStrike;
+      record.ixSymbol = intern( trd.sSymbol );
+      record.ixDescription = intern( trd.sDescription );
+      record.ixExchange = intern( trd.sExchange );
+      record.ixListedMarket = intern( trd.sListedMarket );
+      record.ixUnderlying = intern( trd.sUnderlying );
+      record.nSIC = trd.nSIC;
+      record.nNAICS = trd.nNAICS;
+      record.nMultiplier = trd.nMultiplier;
+      record.nYear = trd.nYear;
+      record.nMonth = trd.nMonth;
+      record.nDay = trd.nDay;
+      record.sc = static_cast<uint8_t>( trd.sc );
+      record.eOptionSide = static_cast<uint8_t>( trd.eOptionSide );
+      record.nFlags = ( trd.bFrontMonth ? c_flagFrontMonth : 0 ) | ( trd.bHasOptions ? c_flagHasOptions : 0 );
+      vRecord.push_back( record );
+    } );
+
+  auto string = [&sArena]( uint32_t ix )->std::string_view {
+    uint16_t n;
+    std::memcpy( &n, sArena.data() + ix, sizeof( n ) );
+    return std::string_view( sArena.data() + ix + sizeof( n ), n );
+  };
+
+  // symbol order within a key, as stable sorts of the rows
+  std::vector<uint32_t> vixExchange( vRecord.size() );
+  std::iota( vixExchange.begin(), vixExchange.end(), 0 );
+  std::vector<uint32_t> vixSecurityType( vixExchange );
+  std::vector<uint32_t> vixUnderlying( vixExchange );
+
+  std::stable_sort(
+    vixExchange.begin(), vixExchange.end(),
+    [&vRecord,&string]( uint32_t a, uint32_t b ){ return string( vRecord[ a ].ixExchange ) < string( vRecord[ b ].ixExchange ); } );
+  std::stable_sort(
+    vixSecurityType.begin(), vixSecurityType.end(),
+    [&vRecord]( uint32_t a, uint32_t b ){ return vRecord[ a ].sc < vRecord[ b ].sc; } );
+  std::stable_sort(
+    vixUnderlying.begin(), vixUnderlying.end(),
+    [&vRecord,&string]( uint32_t a, uint32_t b ){ return string( vRecord[ a ].ixUnderlying ) < string( vRecord[ b ].ixUnderlying ); } );
+
+  const uint64_t nIndex( vRecord.size() * sizeof( uint32_t ) );
+
+  FileHeader header;
+  std::memset( &header, 0, sizeof( header ) );
+  std::memcpy( header.rchMagic, c_rchMagic, sizeof( c_rchMagic ) );
+  header.nVersion = c_nVersion;
+  header.nRecordSize = sizeof( Record );
+  header.nRows = vRecord.size();
+  header.nArena = sArena.size();
+  header.ixRecord = sizeof( FileHeader );
+  header.ixExchange = header.ixRecord + vRecord.size() * sizeof( Record );
+  header.ixSecurityType = header.ixExchange + nIndex;
+  header.ixUnderlying = header.ixSecurityType + nIndex;
+  header.ixArena = header.ixUnderlying + nIndex;
+  header.nSize = header.ixArena + sArena.size();
+
+  const std::string sTemporary( sFileName + ".tmp" );
+  {
+    std::ofstream ofs( sTemporary, std::ios::binary | std::ios::trunc );
+    if ( !ofs.is_open() ) {
+      throw std::runtime_error( "SymbolTable: can not create " + sTemporary );
+    }
+    Put( ofs, &header, sizeof( header ) );
+    Put( ofs, vRecord.data(), vRecord.size() * sizeof( Record ) );
+    Put( ofs, vixExchange.data(), nIndex );
+    Put( ofs, vixSecurityType.data(), nIndex );
+    Put( ofs, vixUnderlying.data(), nIndex );
+    Put( ofs, sArena.data(), sArena.size() );
+    ofs.close();
+    if ( !ofs ) {
+      throw std::runtime_error( "SymbolTable: can not write " + sTemporary );
+    }
+  }
+  if ( 0 != std::rename( sTemporary.c_str(), sFileName.c_str() ) ) {
+    throw std::runtime_error( "SymbolTable: can not rename " + sTemporary + " to " + sFileName );
+  }
+}
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
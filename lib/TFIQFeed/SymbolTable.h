@@ -0,0 +1,231 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    SymbolTable.h
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFIQFeed
+ * Created: 2026/10/16 21:12:36
+ */
+
+#pragma once
+
+// a read only market symbol list, mapped from a snapshot written from an InMemoryMktSymbolList
+//   rows are fixed size records in symbol order, their strings are interned in one arena
+//   row numbers are prebuilt into sorted indexes by exchange, security type, and underlying
+//   opening maps the file, pages are read in as queries touch them
+// queries follow InMemoryMktSymbolList and its index tags:  the Select/Scan functions hand over
+//   a trd_t built from the record, EqualRange<tag> hands over Row, which reads the record in place
+// errors throw std::runtime_error
+
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+#include "InMemoryMktSymbolList.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+class SymbolTable {
+public:
+
+  using trd_t = InMemoryMktSymbolList::trd_t;
+
+  // index tags, as in InMemoryMktSymbolList
+  using ixSymbol = InMemoryMktSymbolList::ixSymbol;
+  using ixExchange = InMemoryMktSymbolList::ixExchange;
+  using ixSymbolClass = InMemoryMktSymbolList::ixSymbolClass;
+  using ixUnderlying = InMemoryMktSymbolList::ixUnderlying;
+
+  struct Record { // on disk
+    double dblStrike;
+    uint32_t ixSymbol; // string offsets into the arena
+    uint32_t ixDescription;
+    uint32_t ixExchange;
+    uint32_t ixListedMarket;
+    uint32_t ixUnderlying;
+    uint32_t nSIC;
+    uint32_t nNAICS;
+    uint16_t nMultiplier;
+    uint16_t nYear;
+    uint8_t nMonth;
+    uint8_t nDay;
+    uint8_t sc; // ESecurityType
+    uint8_t eOptionSide; // OptionSide::EOptionSide
+    uint8_t nFlags; // FrontMonth, HasOptions
+    uint8_t rPad[ 3 ];
+  };
+
+  static_assert( 48 == sizeof( Record ), "Record is part of the file format" );
+
+  class Row {
+  public:
+    Row( const SymbolTable& table, uint32_t ix ): m_table( table ), m_record( table.m_pRecord[ ix ] ) {}
+    std::string_view Symbol() const { return m_table.String( m_record.ixSymbol ); }
+    std::string_view Description() const { return m_table.String( m_record.ixDescription ); }
+    std::string_view Exchange() const { return m_table.String( m_record.ixExchange ); }
+    std::string_view ListedMarket() const { return m_table.String( m_record.ixListedMarket ); }
+    std::string_view Underlying() const { return m_table.String( m_record.ixUnderlying ); }
+    ESecurityType SecurityType() const { return static_cast<ESecurityType>( m_record.sc ); }
+    ou::tf::OptionSide::EOptionSide OptionSide() const { return static_cast<ou::tf::OptionSide::EOptionSide>( m_record.eOptionSide ); }
+    double Strike() const { return m_record.dblStrike; }
+    uint16_t Year() const { return m_record.nYear; }
+    uint8_t Month() const { return m_record.nMonth; }
+    uint8_t Day() const { return m_record.nDay; }
+    uint16_t Multiplier() const { return m_record.nMultiplier; }
+    uint32_t SIC() const { return m_record.nSIC; }
+    uint32_t NAICS() const { return m_record.nNAICS; }
+    bool FrontMonth() const { return 0 != ( m_record.nFlags & c_flagFrontMonth ); }
+    bool HasOptions() const { return 0 != ( m_record.nFlags & c_flagHasOptions ); }
+    trd_t Trd() const;
+  private:
+    const SymbolTable& m_table;
+    const Record& m_record;
+  };
+
+  class iterator { // rows in the order of an index
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Row;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Row;
+    iterator( const SymbolTable& table, const uint32_t* pIndex, uint32_t ix ) // pIndex nullptr for symbol order
+    : m_pTable( &table ), m_pIndex( pIndex ), m_ix( ix ) {}
+    Row operator*() const { return Row( *m_pTable, ( nullptr == m_pIndex ) ? m_ix : m_pIndex[ m_ix ] ); }
+    iterator& operator++() { ++m_ix; return *this; }
+    bool operator==( const iterator& rhs ) const { return m_ix == rhs.m_ix; }
+    bool operator!=( const iterator& rhs ) const { return m_ix != rhs.m_ix; }
+    difference_type operator-( const iterator& rhs ) const { return difference_type( m_ix ) - difference_type( rhs.m_ix ); }
+  private:
+    const SymbolTable* m_pTable;
+    const uint32_t* m_pIndex;
+    uint32_t m_ix;
+  };
+
+  using range_t = std::pair<iterator, iterator>;
+
+  explicit SymbolTable( const std::string& sFileName );
+  SymbolTable( const SymbolTable& ) = delete;
+  SymbolTable( SymbolTable&& ) = delete;
+  ~SymbolTable();
+
+  // written beside sFileName, then renamed over it, so a mapped table stays intact
+  static void Write( const InMemoryMktSymbolList&, const std::string& sFileName );
+
+  size_t Size() const { return m_nRows; }
+
+  iterator begin() const { return iterator( *this, nullptr, 0 ); }
+  iterator end() const { return iterator( *this, nullptr, m_nRows ); }
+
+  // rows with the key, as InMemoryMktSymbolList's index of the tag:
+  //   ixSymbol, ixExchange, ixUnderlying take a string, ixSymbolClass an ESecurityType
+  template<typename Tag, typename Key>
+  range_t EqualRange( const Key& key ) const { return EqualRange( Tag(), key ); }
+
+  bool Exists( const std::string& sName ) const {
+    const range_t range( EqualRange<ixSymbol>( sName ) );
+    return range.first != range.second;
+  }
+
+  trd_t GetTrd( const std::string& sName ) const {
+    const range_t range( EqualRange<ixSymbol>( sName ) );
+    if ( range.first == range.second ) {
+      throw std::runtime_error( "GetTrd can't find " + sName );
+    }
+    return ( *range.first ).Trd();
+  }
+
+  template<typename Function>  // same walk as InMemoryMktSymbolList::SelectOptionsBySymbol
+  void SelectOptionsBySymbol( const std::string& sUnderlying, Function f ) const {
+    const range_t range( EqualRange<ixSymbol>( sUnderlying ) );
+    if ( range.first == range.second ) return; // not in the table, the walk would start at the next symbol
+    for ( iterator iter = range.first; end() != iter; ++iter ) {
+      const Row row( *iter );
+      if ( ou::tf::iqfeed::ESecurityType::IEOption == row.SecurityType() ) {
+        if ( row.Underlying() != sUnderlying ) break;
+        f( row.Trd() );
+      }
+    }
+  }
+
+  template<typename Function>
+  void SelectOptionsByUnderlying( const std::string& sUnderlying, Function f ) const {
+    const range_t range( EqualRange<ixUnderlying>( sUnderlying ) );
+    for ( iterator iter = range.first; range.second != iter; ++iter ) {
+      f( ( *iter ).Trd() );
+    }
+  }
+
+  template<typename ExchangeIterator, typename Function>
+  void SelectSymbolsByExchange( ExchangeIterator beginExchange, ExchangeIterator endExchange, Function f ) const {
+    while ( beginExchange != endExchange ) {
+      const range_t range( EqualRange<ixExchange>( *beginExchange ) );
+      for ( iterator iter = range.first; range.second != iter; ++iter ) {
+        f( ( *iter ).Trd() );
+      }
+      beginExchange++;
+    }
+  }
+
+  template<typename Function>
+  void ScanSymbols( Function f ) const {
+    for ( iterator iter = begin(); end() != iter; ++iter ) {
+      f( ( *iter ).Trd() );
+    }
+  }
+
+protected:
+private:
+
+  static const uint8_t c_flagFrontMonth = 0x01;
+  static const uint8_t c_flagHasOptions = 0x02;
+
+  int m_fd;
+  const uint8_t* m_pData;
+  size_t m_nSize;
+
+  uint32_t m_nRows;
+  const Record* m_pRecord;
+  const uint32_t* m_pixExchange;
+  const uint32_t* m_pixSecurityType;
+  const uint32_t* m_pixUnderlying;
+  const uint8_t* m_pArena;
+  uint32_t m_nArena;
+
+  std::string_view String( uint32_t ix ) const; // length prefixed
+
+  range_t EqualRange( ixSymbol, std::string_view ) const;
+  range_t EqualRange( ixExchange, std::string_view ) const;
+  range_t EqualRange( ixSymbolClass, ESecurityType ) const;
+  range_t EqualRange( ixUnderlying, std::string_view ) const;
+
+  template<typename Key>
+  range_t EqualRange( const uint32_t* pIndex, Key ( SymbolTable::*key )( uint32_t ) const, Key ) const;
+
+  std::string_view KeySymbol( uint32_t ix ) const { return String( m_pRecord[ ix ].ixSymbol ); }
+  std::string_view KeyExchange( uint32_t ix ) const { return String( m_pRecord[ ix ].ixExchange ); }
+  std::string_view KeyUnderlying( uint32_t ix ) const { return String( m_pRecord[ ix ].ixUnderlying ); }
+  uint8_t KeySecurityType( uint32_t ix ) const { return m_pRecord[ ix ].sc; }
+
+};
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
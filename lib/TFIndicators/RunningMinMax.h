@@ -15,12 +15,139 @@
 #pragma once
 
 #include <map>
+#include <vector>
+#include <cstdint>
 #include <stdexcept>
 
+// RunningMinMax tracks the min and max of the values currently added
+// the Storage policy selects how:
+//   runningminmax::Map:        counted values in a std::map, values may be removed in any order
+//   runningminmax::Monotonic:  paired monotonic deques in ring storage, O(1) amortized,
+//                              values must be removed in the order added, as a sliding window does,
+//                              the value supplied to Remove is not consulted
+
 namespace ou { // One Unified
 namespace tf { // TradeFrame
+namespace runningminmax {
+
+template<typename value_t>
+class Map {
+public:
+
+  bool Empty() const { return m_mapValueCount.empty(); }
+  value_t Min() const { return m_mapValueCount.begin()->first; }
+  value_t Max() const { return m_mapValueCount.rbegin()->first; }
+
+  void Add( const value_t& value ) {
+    typename mapValueCount_t::iterator iter = m_mapValueCount.find( value );
+    if ( m_mapValueCount.end() == iter ) {
+      m_mapValueCount.insert( typename mapValueCount_t::value_type( value, 1 ) );
+    }
+    else {
+      (iter->second)++;
+    }
+  }
+
+  void Remove( const value_t& value ) {
+    typename mapValueCount_t::iterator iter = m_mapValueCount.find( value );
+    if ( (m_mapValueCount.end() == iter) ) {
+      // shouldn't land here, a bug if we do
+    }
+    else {
+      (iter->second)--;
+      if ( 0 == iter->second ) {
+        m_mapValueCount.erase( iter );
+      }
+    }
+  }
 
-template<typename CRTP, typename value_t>
+  void Reset() { m_mapValueCount.clear(); }
+
+private:
+  using mapValueCount_t = std::map<value_t,unsigned int>;
+  mapValueCount_t m_mapValueCount;
+};
+
+template<typename value_t>
+class Monotonic {
+public:
+
+  Monotonic(): m_seqLeading {}, m_seqTrailing {} {}
+
+  bool Empty() const { return m_seqLeading == m_seqTrailing; }
+  value_t Min() const { return m_ringMin.Front().value; }
+  value_t Max() const { return m_ringMax.Front().value; }
+
+  void Add( const value_t& value ) {
+    // a value which can no longer be the extreme is dropped, each value is pushed and popped once
+    while ( !m_ringMax.Empty() && !( value < m_ringMax.Back().value ) ) m_ringMax.PopBack();
+    m_ringMax.PushBack( entry_t( m_seqLeading, value ) );
+    while ( !m_ringMin.Empty() && !( m_ringMin.Back().value < value ) ) m_ringMin.PopBack();
+    m_ringMin.PushBack( entry_t( m_seqLeading, value ) );
+    ++m_seqLeading;
+  }
+
+  void Remove( const value_t& ) { // removes the oldest value
+    if ( Empty() ) return;
+    if ( m_seqTrailing == m_ringMax.Front().seq ) m_ringMax.PopFront();
+    if ( m_seqTrailing == m_ringMin.Front().seq ) m_ringMin.PopFront();
+    ++m_seqTrailing;
+  }
+
+  void Reset() {
+    m_ringMax.Clear();
+    m_ringMin.Clear();
+    m_seqLeading = m_seqTrailing = 0;
+  }
+
+private:
+
+  struct entry_t {
+    uint64_t seq; // order of addition
+    value_t value;
+    entry_t(): seq {}, value {} {}
+    entry_t( uint64_t seq_, const value_t& value_ ): seq( seq_ ), value( value_ ) {}
+  };
+
+  class Ring { // deque on a power of two vector, doubles when full
+  public:
+    Ring(): m_ixFront {}, m_ixBack {}, m_mask {} {}
+    bool Empty() const { return m_ixFront == m_ixBack; }
+    const entry_t& Front() const { return m_vEntry[ m_ixFront & m_mask ]; }
+    const entry_t& Back() const { return m_vEntry[ ( m_ixBack - 1 ) & m_mask ]; }
+    void PopFront() { ++m_ixFront; }
+    void PopBack() { --m_ixBack; }
+    void PushBack( const entry_t& entry ) {
+      if ( ( m_ixBack - m_ixFront ) == m_vEntry.size() ) Grow();
+      m_vEntry[ m_ixBack & m_mask ] = entry;
+      ++m_ixBack;
+    }
+    void Clear() { m_ixFront = m_ixBack = 0; }
+  private:
+    size_t m_ixFront;
+    size_t m_ixBack; // one past the last entry
+    size_t m_mask;
+    std::vector<entry_t> m_vEntry;
+    void Grow() {
+      std::vector<entry_t> vEntry( m_vEntry.empty() ? 16 : 2 * m_vEntry.size() );
+      const size_t mask( vEntry.size() - 1 );
+      for ( size_t ix = m_ixFront; ix != m_ixBack; ++ix ) {
+        vEntry[ ix & mask ] = m_vEntry[ ix & m_mask ];
+      }
+      m_vEntry.swap( vEntry );
+      m_mask = mask;
+    }
+  };
+
+  uint64_t m_seqLeading;  // sequence of next Add
+  uint64_t m_seqTrailing; // sequence of oldest value still present
+  Ring m_ringMax; // values decreasing front to back
+  Ring m_ringMin; // values increasing front to back
+};
+
+} // namespace runningminmax
+
+template<typename CRTP, typename value_t, typename Storage = runningminmax::Map<value_t> >
 class RunningMinMax {
 public:
 
@@ -33,12 +160,12 @@ public:
   void Remove( const value_t& );
 
   value_t Min() const {
-    if ( 0 == m_mapValueCount.size() ) throw std::runtime_error( "no value available" );
-    return m_mapValueCount.begin()->first;
+    if ( m_storage.Empty() ) throw std::runtime_error( "no value available" );
+    return m_storage.Min();
   };
   value_t Max() const {
-    if ( 0 == m_mapValueCount.size() ) throw std::runtime_error( "no value available" );
-    return m_mapValueCount.rbegin()->first;
+    if ( m_storage.Empty() ) throw std::runtime_error( "no value available" );
+    return m_storage.Max();
   };
 
   void Reset();
@@ -47,71 +174,54 @@ protected:
   void UpdateOnAdd( const value_t min, const value_t max ) {} // CRTP callback
   void UpdateOnDel( const value_t min, const value_t max ) {} // CRTP callback
 private:
-  using mapValueCount_t = std::map<value_t,unsigned int>;
-  mapValueCount_t m_mapValueCount;
+  Storage m_storage;
 };
 
-template<typename CRTP, typename value_t>
-RunningMinMax<CRTP,value_t>::RunningMinMax() {}
+template<typename CRTP, typename value_t, typename Storage>
+RunningMinMax<CRTP,value_t,Storage>::RunningMinMax() {}
 
-template<typename CRTP, typename value_t>
-RunningMinMax<CRTP,value_t>::RunningMinMax( const RunningMinMax& rhs )
-  : m_mapValueCount( rhs.m_mapValueCount )
+template<typename CRTP, typename value_t, typename Storage>
+RunningMinMax<CRTP,value_t,Storage>::RunningMinMax( const RunningMinMax& rhs )
+  : m_storage( rhs.m_storage )
 {
 }
 
-template<typename CRTP, typename value_t>
-RunningMinMax<CRTP,value_t>::RunningMinMax( RunningMinMax&& rhs )
-  : m_mapValueCount( std::move( rhs.m_mapValueCount ) )
+template<typename CRTP, typename value_t, typename Storage>
+RunningMinMax<CRTP,value_t,Storage>::RunningMinMax( RunningMinMax&& rhs )
+  : m_storage( std::move( rhs.m_storage ) )
 {
 }
 
-template<typename CRTP, typename value_t>
-RunningMinMax<CRTP,value_t>::~RunningMinMax() {
-  m_mapValueCount.clear();
+template<typename CRTP, typename value_t, typename Storage>
+RunningMinMax<CRTP,value_t,Storage>::~RunningMinMax() {
+  m_storage.Reset();
 }
 
-template<typename CRTP, typename value_t>
-void RunningMinMax<CRTP,value_t>::Add(const value_t& value) {
+template<typename CRTP, typename value_t, typename Storage>
+void RunningMinMax<CRTP,value_t,Storage>::Add(const value_t& value) {
 
-  typename mapValueCount_t::iterator iter = m_mapValueCount.find( value );
-  if ( m_mapValueCount.end() == iter ) {
-    m_mapValueCount.insert( typename mapValueCount_t::value_type( value, 1 ) );
-  }
-  else {
-    (iter->second)++;
-  }
-  if ( &RunningMinMax<CRTP,value_t>::UpdateOnAdd != &CRTP::UpdateOnAdd ) {
-    static_cast<CRTP*>(this)->UpdateOnAdd( m_mapValueCount.begin()->first, m_mapValueCount.rbegin()->first );
+  m_storage.Add( value );
+  if ( &RunningMinMax<CRTP,value_t,Storage>::UpdateOnAdd != &CRTP::UpdateOnAdd ) {
+    static_cast<CRTP*>(this)->UpdateOnAdd( m_storage.Min(), m_storage.Max() );
   }
 
 }
 
-template<typename CRTP, typename value_t>
-void RunningMinMax<CRTP,value_t>::Remove( const value_t& value ) {
+template<typename CRTP, typename value_t, typename Storage>
+void RunningMinMax<CRTP,value_t,Storage>::Remove( const value_t& value ) {
 
-  if ( &RunningMinMax<CRTP,value_t>::UpdateOnDel != &CRTP::UpdateOnDel ) {
-    static_cast<CRTP*>(this)->UpdateOnDel( m_mapValueCount.begin()->first, m_mapValueCount.rbegin()->first );
-  }
-
-  typename mapValueCount_t::iterator iter = m_mapValueCount.find( value );
-  if ( (m_mapValueCount.end() == iter) ) {
-    int i = 1;  // shouldn't land here, a bug if we do
-  }
-  else {
-    (iter->second)--;
-    if ( 0 == iter->second ) {
-      m_mapValueCount.erase( iter );
-      if ( !m_mapValueCount.empty() ) {
-
-      }
+  if ( &RunningMinMax<CRTP,value_t,Storage>::UpdateOnDel != &CRTP::UpdateOnDel ) {
+    if ( !m_storage.Empty() ) {
+      static_cast<CRTP*>(this)->UpdateOnDel( m_storage.Min(), m_storage.Max() );
     }
   }
+
+  m_storage.Remove( value );
 }
 
-template<typename CRTP, typename value_t>
-void RunningMinMax<CRTP,value_t>::Reset() {
-  m_mapValueCount.clear();
+template<typename CRTP, typename value_t, typename Storage>
+void RunningMinMax<CRTP,value_t,Storage>::Reset() {
+  m_storage.Reset();
 }
 
 } // namespace tf
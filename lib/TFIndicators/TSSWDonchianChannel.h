@@ -29,17 +29,17 @@ namespace ou { // One Unified
 namespace tf { // TradeFrame
 
 class TSSWDonchianChannel:
-  public RunningMinMax<TSSWDonchianChannel,double>,
+  public RunningMinMax<TSSWDonchianChannel,double,runningminmax::Monotonic<double> >,
   public TimeSeriesSlidingWindow<TSSWDonchianChannel,Price>
 {
-  friend RunningMinMax<TSSWDonchianChannel,double>;
+  friend RunningMinMax<TSSWDonchianChannel,double,runningminmax::Monotonic<double> >;
   friend TimeSeriesSlidingWindow<TSSWDonchianChannel,Price>;
 public:
   TSSWDonchianChannel( Prices& prices, time_duration tdWindowWidth, size_t nWindowWidth );
   //TSSWDonchianChannel( const TSSWDonchianChannel& orig );
   virtual ~TSSWDonchianChannel( );
 
-  using minmax = RunningMinMax<TSSWDonchianChannel,double>;
+  using minmax = RunningMinMax<TSSWDonchianChannel,double,runningminmax::Monotonic<double> >;
 
   double Max() const { return minmax::Max(); }
   double Min() const { return minmax::Min(); }
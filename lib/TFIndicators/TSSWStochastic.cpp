@@ -17,7 +17,7 @@
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 
-using minmax = RunningMinMax<TSSWStochastic,double>;
+using minmax = RunningMinMax<TSSWStochastic,double,runningminmax::Monotonic<double> >;
 
 TSSWStochastic::TSSWStochastic( Quotes& quotes, time_duration tdWindowWidth )
   : TimeSeriesSlidingWindow<TSSWStochastic, Quote>( quotes, tdWindowWidth ),
@@ -27,10 +27,10 @@ namespace tf { // TradeFrame
 // TODO: implement CRTP?
 
 class TSSWStochastic:
-  public RunningMinMax<TSSWStochastic,double>,
+  public RunningMinMax<TSSWStochastic,double,runningminmax::Monotonic<double> >,
   public TimeSeriesSlidingWindow<TSSWStochastic, Quote>
 {
-  friend RunningMinMax<TSSWStochastic,double>;
+  friend RunningMinMax<TSSWStochastic,double,runningminmax::Monotonic<double> >;
   friend TimeSeriesSlidingWindow<TSSWStochastic, Quote>;
 public:
 
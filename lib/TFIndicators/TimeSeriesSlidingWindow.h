@@ -19,6 +19,14 @@
 // Each time timeseries updated, run Update to continue
 // useful when timeseries serves multiple windows
 
+// storage:  by default the window indexes back into the source series, which must retain its history
+//   with RingStorage, or when the source series has appending disabled, admitted datums are copied into
+//   a ring owned by the window, only the datums within the window are retained
+//   the ring starts at the supplied capacity (or a default based upon the count limit) and doubles when full,
+//   so time and count expiry behave the same in either mode
+
+#include <vector>
+
 #include <TFTimeSeries/TimeSeries.h>
 
 namespace ou { // One Unified
@@ -36,6 +44,8 @@ public:
   TimeSeriesSlidingWindow<T,D>( TimeSeriesSlidingWindow<T,D>&& ); // limited to the initial emplace operations
   virtual ~TimeSeriesSlidingWindow<T,D>();
   virtual void Reset();
+  // call before the first datum arrives, nCapacity of 0 selects a default
+  void RingStorage( size_type nCapacity = 0 ) { m_bRingRequested = true; m_nRingCapacity = nCapacity; }
   ou::Delegate<const D&> OnAppend;
 protected:
   ptime m_dtZero;  // datetime of first element, used as offset
@@ -56,7 +66,20 @@ private:
   bool m_bFirstDatumFound;
   bool m_bAutoUpdate; // use the OnAppend event to update stuff, else use the Update method to process
 
+  // ring storage, m_ixTrailing and m_ixLeading are then absolute counts, masked into the ring
+  bool m_bRingRequested;
+  bool m_bRing; // latched at the first datum
+  size_type m_nRingCapacity;
+  size_type m_ixRingEnd; // count of datums copied into the ring
+  size_type m_maskRing;
+  std::vector<D> m_vRing;
+
+  const D& Datum( size_type ix ) const { return m_bRing ? m_vRing[ ix & m_maskRing ] : m_Series[ ix ]; }
+  size_type End() const { return m_bRing ? m_ixRingEnd : m_Series.Size(); }
+
   void Init();  // called in constructors
+  void InitRing();
+  void PushRing( const D& );
   void HandleDatum( const D& );
 };
 
@@ -66,7 +89,8 @@ TimeSeriesSlidingWindow<T,D>::TimeSeriesSlidingWindow(
 : m_Series( Series ), //m_iterTrailing( Series.begin() ),
   m_ixTrailing( 0 ), m_ixLeading( 0 ), m_dtLeading( not_a_date_time ),
   m_tdWindowWidth( tdWindowWidth ), m_nWindowSizeCount( WindowSizeCount ),
-  m_bFirstDatumFound( false ), m_bAutoUpdate( true )
+  m_bFirstDatumFound( false ), m_bAutoUpdate( true ),
+  m_bRingRequested( false ), m_bRing( false ), m_nRingCapacity {}, m_ixRingEnd {}, m_maskRing {}
 {
   assert( seconds( 0 ) <= tdWindowWidth );
   assert( 0 <= WindowSizeCount );
@@ -79,7 +103,8 @@ TimeSeriesSlidingWindow<T,D>::TimeSeriesSlidingWindow(
 : m_Series( Series ), //m_iterTrailing( Series.begin() ),
   m_ixTrailing( 0 ), m_ixLeading( 0 ), m_dtLeading( not_a_date_time ),
   m_tdWindowWidth( tdPeriodWidth ), m_nWindowSizeCount( WindowSizeCount ),
-  m_bFirstDatumFound( false ), m_bAutoUpdate( true )
+  m_bFirstDatumFound( false ), m_bAutoUpdate( true ),
+  m_bRingRequested( false ), m_bRing( false ), m_nRingCapacity {}, m_ixRingEnd {}, m_maskRing {}
 {
   assert( seconds( 0 ) <= tdPeriodWidth );
   assert( 0 <= WindowSizeCount );
@@ -98,7 +123,9 @@ TimeSeriesSlidingWindow<T,D>::TimeSeriesSlidingWindow( const TimeSeriesSlidingWi
   : m_Series( rhs.m_Series ),
   m_tdWindowWidth( rhs.m_tdWindowWidth ), m_nWindowSizeCount( rhs.m_nWindowSizeCount ),
   m_ixTrailing( rhs.m_ixTrailing ), m_ixLeading( rhs.m_ixLeading ), m_dtLeading( rhs.m_dtLeading ),
-  m_bFirstDatumFound( rhs.m_bFirstDatumFound ), m_dtZero( rhs.m_dtZero ), m_bAutoUpdate( true )
+  m_bFirstDatumFound( rhs.m_bFirstDatumFound ), m_dtZero( rhs.m_dtZero ), m_bAutoUpdate( true ),
+  m_bRingRequested( rhs.m_bRingRequested ), m_bRing( rhs.m_bRing ), m_nRingCapacity( rhs.m_nRingCapacity ),
+  m_ixRingEnd( rhs.m_ixRingEnd ), m_maskRing( rhs.m_maskRing ), m_vRing( rhs.m_vRing )
 {
   // best used when originating timeseries is empty
   Init();
@@ -110,6 +137,8 @@ TimeSeriesSlidingWindow<T,D>::TimeSeriesSlidingWindow( TimeSeriesSlidingWindow<T
 , m_tdWindowWidth( rhs.m_tdWindowWidth ), m_nWindowSizeCount( rhs.m_nWindowSizeCount )
 , m_ixTrailing( rhs.m_ixTrailing ), m_ixLeading( rhs.m_ixLeading ), m_dtLeading( rhs.m_dtLeading )
 , m_bFirstDatumFound( rhs.m_bFirstDatumFound ), m_dtZero( rhs.m_dtZero ), m_bAutoUpdate( true )
+, m_bRingRequested( rhs.m_bRingRequested ), m_bRing( rhs.m_bRing ), m_nRingCapacity( rhs.m_nRingCapacity )
+, m_ixRingEnd( rhs.m_ixRingEnd ), m_maskRing( rhs.m_maskRing ), m_vRing( std::move( rhs.m_vRing ) )
 , OnAppend( std::move( rhs.OnAppend ) )
 {
   // best used when originating timeseries is empty
@@ -129,20 +158,52 @@ void TimeSeriesSlidingWindow<T,D>::Init() {
 template<class T, class D>
 void TimeSeriesSlidingWindow<T,D>::Reset() {
   m_ixTrailing = m_ixLeading = 0;
+  m_ixRingEnd = 0; // the ring holds only the window, nothing to replay
   m_dtLeading = not_a_date_time;
 }
 
+template<class T, class D>
+void TimeSeriesSlidingWindow<T,D>::InitRing() {
+  size_type nCapacity( m_nRingCapacity );
+  if ( 0 == nCapacity ) {
+    nCapacity = ( ( 0 < m_nWindowSizeCount ) && ( 0 == m_tdWindowWidth.total_milliseconds() ) )
+      ? m_nWindowSizeCount + 1 // holds the window plus the arriving datum, never grows
+      : 1024;
+  }
+  size_type nRing( 1 );
+  while ( nRing < nCapacity ) nRing <<= 1;
+  m_vRing.resize( nRing );
+  m_maskRing = nRing - 1;
+  m_bRing = true;
+}
+
+template<class T, class D>
+void TimeSeriesSlidingWindow<T,D>::PushRing( const D& datum ) {
+  if ( ( m_ixRingEnd - m_ixTrailing ) == m_vRing.size() ) { // full, double, re-seat the live datums
+    std::vector<D> vRing( 2 * m_vRing.size() );
+    const size_type mask( vRing.size() - 1 );
+    for ( size_type ix = m_ixTrailing; ix < m_ixRingEnd; ++ix ) {
+      vRing[ ix & mask ] = m_vRing[ ix & m_maskRing ];
+    }
+    m_vRing.swap( vRing );
+    m_maskRing = mask;
+  }
+  m_vRing[ m_ixRingEnd & m_maskRing ] = datum;
+  ++m_ixRingEnd;
+}
+
 template<class T, class D>
 void TimeSeriesSlidingWindow<T,D>::Update() {
   if ( !m_bFirstDatumFound ) {
-    if ( 0 < m_Series.Size() ) {
-      m_dtZero = m_Series[ 0 ].DateTime();  // used for zeroing the statistics
+    if ( 0 < End() ) {
+      m_dtZero = Datum( 0 ).DateTime();  // used for zeroing the statistics
       m_bFirstDatumFound = true;
     }
   }
   bool bMovedIndex = false;
-  while ( m_ixLeading < m_Series.Size() ) {
-    const D& datum( m_Series[ m_ixLeading ] );
+  const size_type ixEnd( End() );
+  while ( m_ixLeading < ixEnd ) {
+    const D& datum( Datum( m_ixLeading ) );
     m_dtLeading = datum.DateTime();
     if ( &TimeSeriesSlidingWindow<T,D>::Add != &T::Add ) {
       static_cast<T*>( this )->Add( datum ); // add datum to stats
@@ -154,7 +215,7 @@ void TimeSeriesSlidingWindow<T,D>::Update() {
   if ( bMovedIndex ) {
     if ( 0 < m_nWindowSizeCount ) {
       while ( ( m_ixLeading - m_ixTrailing ) > m_nWindowSizeCount ) {
-        const D& datum( m_Series[ m_ixTrailing ] );
+        const D& datum( Datum( m_ixTrailing ) );
         if ( &TimeSeriesSlidingWindow<T,D>::Add != &T::Add ) {
           static_cast<T*>( this )->Expire( datum );  // expire datum from stats
         }
@@ -162,9 +223,11 @@ void TimeSeriesSlidingWindow<T,D>::Update() {
       }
     }
     if ( 0 < m_tdWindowWidth.total_milliseconds() ) {
-      while ( ( m_dtLeading - m_Series[ m_ixTrailing ].DateTime() ) > m_tdWindowWidth ) {
+      // ( leading - trailing ) > width, with the subtraction hoisted out of the loop
+      const ptime dtCutoff( m_dtLeading - m_tdWindowWidth );
+      while ( Datum( m_ixTrailing ).DateTime() < dtCutoff ) {
         if ( &TimeSeriesSlidingWindow<T,D>::Add != &T::Add ) {
-          static_cast<T*>( this )->Expire( m_Series[ m_ixTrailing ] );  // expire datum from stats
+          static_cast<T*>( this )->Expire( Datum( m_ixTrailing ) );  // expire datum from stats
         }
         ++m_ixTrailing;
         if ( m_ixTrailing >= m_ixLeading ) {
@@ -180,6 +243,18 @@ void TimeSeriesSlidingWindow<T,D>::Update() {
 
 template<class T, class D>
 void TimeSeriesSlidingWindow<T,D>::HandleDatum( const D& datum ) {
+  if ( !m_bRing && ( 0 == m_ixLeading ) && ( m_bRingRequested || !m_Series.AppendEnabled() ) ) {
+    InitRing();
+    if ( m_Series.AppendEnabled() ) { // pick up any history, this datum is already in the series
+      for ( size_type ix = 0; ix < m_Series.Size(); ++ix ) PushRing( m_Series[ ix ] );
+    }
+    else {
+      PushRing( datum );
+    }
+  }
+  else {
+    if ( m_bRing ) PushRing( datum );
+  }
   if ( m_bAutoUpdate ) Update();
   OnAppend( datum );
 }
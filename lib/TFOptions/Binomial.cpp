@@ -30,129 +30,256 @@ namespace tf { // TradeFrame
 namespace option { // options
 namespace binomial { // binomial
 
-void CRR( const structInput& input, structOutput& output ) {
+namespace {
 
-  std::vector<double> v; v.resize( input.n + 1 );
-  double u, d, p;
-  double dt;
-  double df;
-  double z;
-
-  switch ( input.optionSide ) {
-  case ou::tf::OptionSide::Call:
-    z = 1;
-    break;
-  case ou::tf::OptionSide::Put:
-    z = -1;
-    break;
-  }
+// scratch re-used across calls, per thread, grows to the largest tree seen
+struct Arena {
+  std::vector<double> v;  // option values, one row of the tree, interleaved by lane
+  std::vector<double> ex; // intrinsic value at S * u^k, k = -n .. n, interleaved by lane
+};
+
+Arena& LocalArena() {
+  static thread_local Arena arena;
+  return arena;
+}
+
+// L options sharing n and style are evaluated side by side, values are interleaved [node][lane]
+//   so the inner lane loop is straight line arithmetic the compiler can vectorize
+// node ( j, i ) is S * u^i * d^(j-i) = S * u^(2i-j), the intrinsic value table is indexed by 2i-j+n,
+//   which removes pow() from the backward induction
+template<size_t L>
+void Tree( const structInput* const rpInput[ L ], structOutput* const rpOutput[ L ] ) {
+
+  const long n( rpInput[ 0 ]->n );
+  const bool bAmerican( ou::tf::OptionStyle::American == rpInput[ 0 ]->optionStyle );
+
+  double u[ L ], d[ L ], p[ L ], q[ L ], df[ L ], dt[ L ];
+
+  Arena& arena( LocalArena() );
+  if ( arena.v.size() < L * ( n + 1 ) ) arena.v.resize( L * ( n + 1 ) );
+  if ( arena.ex.size() < L * ( 2 * n + 1 ) ) arena.ex.resize( L * ( 2 * n + 1 ) );
+  double* const v( arena.v.data() );
+  double* const ex( arena.ex.data() );
 
-  dt = input.T / input.n;
-  u = exp( input.v * sqrt( dt ) );
-  d = 1.0 / u;
-  p = ( exp( input.b * dt ) - d ) / ( u - d );
-  df = exp( -input.r * dt );
+  for ( size_t l = 0; l < L; ++l ) {
+    const structInput& input( *rpInput[ l ] );
+    assert( n == input.n );
 
-  for ( int ix = 0; ix <= input.n; ++ix ) {
-    v[ ix ] = std::max<double>( 0.0, z * ( input.S * pow( u, ix ) * pow( d, input.n - ix ) - input.X ) );
+    double z {};
+    switch ( input.optionSide ) {
+    case ou::tf::OptionSide::Call:
+      z = 1;
+      break;
+    case ou::tf::OptionSide::Put:
+      z = -1;
+      break;
+    }
+
+    dt[ l ] = input.T / n;
+    u[ l ] = exp( input.v * sqrt( dt[ l ] ) );
+    d[ l ] = 1.0 / u[ l ];
+    p[ l ] = ( exp( input.b * dt[ l ] ) - d[ l ] ) / ( u[ l ] - d[ l ] );
+    q[ l ] = 1.0 - p[ l ];
+    df[ l ] = exp( -input.r * dt[ l ] );
+
+    // power table, built outward from S so the error does not accumulate across the whole range
+    double up( input.S );
+    double dn( input.S );
+    ex[ n * L + l ] = z * ( input.S - input.X );
+    for ( long k = 1; k <= n; ++k ) {
+      up *= u[ l ];
+      dn *= d[ l ];
+      ex[ ( n + k ) * L + l ] = z * ( up - input.X );
+      ex[ ( n - k ) * L + l ] = z * ( dn - input.X );
+    }
+  }
+
+  // leaves: node ( n, i ) is at 2i
+  for ( long i = 0; i <= n; ++i ) {
+    for ( size_t l = 0; l < L; ++l ) {
+      v[ i * L + l ] = std::max<double>( 0.0, ex[ 2 * i * L + l ] );
+    }
   }
-  for ( int j = input.n - 1; j >= 0; --j ) {
-    for ( int i = 0; i <= j; ++i ) {
-      double europrice = df * ( p * v[ i + 1 ] + ( 1.0 - p ) * v[ i ] );
-      double exerciseprice;
-      switch ( input.optionStyle ) {
-      case ou::tf::OptionStyle::American:
-        exerciseprice = z * ( input.S * pow( u, i ) * pow( d, j - i ) - input.X );
-        v[ i ] = std::max<double>( exerciseprice, europrice );
-        break;
-      case ou::tf::OptionStyle::European:
-        v[ i ] = europrice;
-        break;
+
+  double v2[ 3 ][ L ] {}; // values at step 2, for gamma and theta
+  double v1[ 2 ][ L ] {}; // values at step 1, for delta
+
+  for ( long j = n - 1; j >= 0; --j ) {
+    if ( bAmerican ) {
+      for ( long i = 0; i <= j; ++i ) {
+        const double* const pex( &ex[ ( 2 * i - j + n ) * L ] );
+        double* const pv( &v[ i * L ] );
+        for ( size_t l = 0; l < L; ++l ) {
+          const double europrice = df[ l ] * ( p[ l ] * pv[ L + l ] + q[ l ] * pv[ l ] );
+          pv[ l ] = std::max<double>( pex[ l ], europrice );
+        }
       }
-      if ( 2 == j ) {
-        output.gamma = ( ( v[ 2 ] - v[ 1 ] ) / ( input.S * u * u - input.S )
-          - ( v[ 1 ] - v[ 0 ] ) / ( input.S - input.S * d * d ) )
-          / ( 0.5 * ( input.S * u * u - input.S * d * d ) );
-        output.theta = v[ 1 ];
+    }
+    else {
+      for ( long i = 0; i <= j; ++i ) {
+        double* const pv( &v[ i * L ] );
+        for ( size_t l = 0; l < L; ++l ) {
+          pv[ l ] = df[ l ] * ( p[ l ] * pv[ L + l ] + q[ l ] * pv[ l ] );
+        }
       }
-      if ( 1 == j ) {
-        output.delta = ( v[ 1 ] - v[ 0 ] ) / ( input.S * ( u - d ) );
+    }
+    if ( 2 == j ) {
+      for ( size_t i = 0; i < 3; ++i ) for ( size_t l = 0; l < L; ++l ) v2[ i ][ l ] = v[ i * L + l ];
+    }
+    if ( 1 == j ) {
+      for ( size_t i = 0; i < 2; ++i ) for ( size_t l = 0; l < L; ++l ) v1[ i ][ l ] = v[ i * L + l ];
+    }
+  }
+
+  for ( size_t l = 0; l < L; ++l ) {
+    const double S( rpInput[ l ]->S );
+    structOutput& output( *rpOutput[ l ] );
+    if ( 2 <= n ) {
+      output.gamma = ( ( v2[ 2 ][ l ] - v2[ 1 ][ l ] ) / ( S * u[ l ] * u[ l ] - S )
+        - ( v2[ 1 ][ l ] - v2[ 0 ][ l ] ) / ( S - S * d[ l ] * d[ l ] ) )
+        / ( 0.5 * ( S * u[ l ] * u[ l ] - S * d[ l ] * d[ l ] ) );
+      output.theta = ( v2[ 1 ][ l ] - v[ l ] ) / ( 2.0 * dt[ l ] ) / 365.0;
+    }
+    if ( 1 <= n ) {
+      output.delta = ( v1[ 1 ][ l ] - v1[ 0 ][ l ] ) / ( S * ( u[ l ] - d[ l ] ) );
+    }
+    output.option = v[ l ];
+  }
+}
+
+} // namespace anonymous
+
+void CRR( const structInput& input, structOutput& output ) {
+  const structInput* rpInput[ 1 ] = { &input };
+  structOutput* rpOutput[ 1 ] = { &output };
+  Tree<1>( rpInput, rpOutput );
+}
+
+void CRR( const structInput* pInput, structOutput* pOutput, size_t nOptions ) {
+
+  static const size_t nLanes = 4;
+
+  // order by step count and style, so options sharing a tree shape are priced side by side
+  static thread_local std::vector<size_t> vIndex;
+  vIndex.resize( nOptions );
+  for ( size_t ix = 0; ix < nOptions; ++ix ) vIndex[ ix ] = ix;
+  std::stable_sort(
+    vIndex.begin(), vIndex.end(),
+    [pInput]( size_t lhs, size_t rhs ){
+      const structInput& l( pInput[ lhs ] );
+      const structInput& r( pInput[ rhs ] );
+      return ( l.n < r.n ) || ( ( l.n == r.n ) && ( l.optionStyle < r.optionStyle ) );
+    } );
+
+  size_t ix = 0;
+  while ( ix < nOptions ) {
+    const structInput& first( pInput[ vIndex[ ix ] ] );
+    size_t cnt = 1;
+    while ( ( cnt < nLanes ) && ( ( ix + cnt ) < nOptions ) ) {
+      const structInput& next( pInput[ vIndex[ ix + cnt ] ] );
+      if ( ( first.n != next.n ) || ( first.optionStyle != next.optionStyle ) ) break;
+      ++cnt;
+    }
+    if ( nLanes == cnt ) {
+      const structInput* rpInput[ nLanes ];
+      structOutput* rpOutput[ nLanes ];
+      for ( size_t l = 0; l < nLanes; ++l ) {
+        rpInput[ l ] = &pInput[ vIndex[ ix + l ] ];
+        rpOutput[ l ] = &pOutput[ vIndex[ ix + l ] ];
       }
+      Tree<nLanes>( rpInput, rpOutput );
     }
+    else {
+      for ( size_t l = 0; l < cnt; ++l ) {
+        CRR( pInput[ vIndex[ ix + l ] ], pOutput[ vIndex[ ix + l ] ] );
+      }
+    }
+    ix += cnt;
   }
-  output.theta = ( output.theta - v[ 0 ] ) / ( 2.0 * dt ) / 365.0;
-  output.option = v[ 0 ];
 }
 
-double CalcImpliedVolatility( const structInput& input_, double option, structOutput& output, double epsilon ) {
-  // Black Scholes and Beyond, page 336  -- not sure if this is correct model used.  I didn't document model used
-  // Option Pricing Formulas, page 453  -- or might have been this one
-  // New vega portion taken from top of page 288 (Option Pricing Formulas) ,
-  // and uses the 1% description from pg 166 of Black Scholes and Beyond
+double CalcImpliedVolatility( const structInput& input, double option, structOutput& output, double epsilon ) {
+  size_t nIterations;
+  return CalcImpliedVolatility( input, option, output, epsilon, nIterations );
+}
 
-  // page 163 - 164 provides vega calc
-  // page 337 provides newton-raphson method of iv calc
-  size_t cnt = 10;
-  structInput input( input_ );  // copy rather than reference to keep local copy of parameters
+double CalcImpliedVolatility( const structInput& input_, double option, structOutput& output, double epsilon, size_t& nIterations ) {
+  // safeguarded newton:  the price is monotonic in volatility, so each evaluation narrows a bracket [lo,hi],
+  //   a newton step which leaves the bracket, or has no usable slope, is replaced by bisection
+  // vega for the first step comes from a bump of the same tree (1% description from pg 166 of Black Scholes and Beyond),
+  //   after that the slope is the secant through the last two evaluations, so each iteration costs one tree
+  // input.v is the starting point:  the previous solution when warm starting, a Manaster Koehler guess otherwise
 
-  ou::tf::option::binomial::CRR( input, output );
-  double option1 = output.option;
+  static const size_t nMaxIterations = 50;
+  static const double dblVolMin = 0.0001;
+  static const double dblVolMax = 5.0;
+  static const double dblVolSeed = 0.25; // when the supplied starting point is unusable
+  static const double dblBracketMin = 1e-6; // bracket has collapsed, price not attainable by any volatility
+  static const double pct = 0.01;  // 1% change in volatility
 
-  //std::cout << "CRRp basic: P=" << output.option << ",D=" << output.delta << ",G=" << output.gamma << ",T=" << output.theta << std::endl;
+  structInput input( input_ );  // copy rather than reference to keep local copy of parameters
 
-  static double pct = 0.01;  // 1% change in volatility
+  double lo( dblVolMin );
+  double hi( dblVolMax );
 
-  double diff = 2 * epsilon; // set > epsilon
-  while ( epsilon < diff ) { // epsilon
+  double vol( input.v );
+  if ( !( ( lo < vol ) && ( vol < hi ) ) ) vol = dblVolSeed;
 
-    double vol = input.v;
-    double deltaVol = pct * vol;  // do we use pct * vol or just pct?
-    double volInput1 = input.v = vol + deltaVol;  // adjust by 1% to calc vega
+  input.v = vol;
+  ou::tf::option::binomial::CRR( input, output );
+  double diff = output.option - option;
+  nIterations = 1;
 
-    ou::tf::option::binomial::CRR( input, output );
-    double option2 = output.option;
+  double volPrev = input.v = vol + pct * vol;  // adjust by 1% to calc vega
+  structOutput outputTmp;
+  ou::tf::option::binomial::CRR( input, outputTmp );
+  double diffPrev = outputTmp.option - option;
 
-    output.vega = ( option2 - option1 ) / ( deltaVol );
-    double volInput2 = output.iv = input.v = vol - ( ( option1 - option ) / output.vega ); // new volatility value
+  while ( epsilon < std::fabs( diff ) ) {
 
-    ou::tf::option::binomial::CRR( input, output );  // calc new option values with new IV
-    option1 = output.option;  // keep for next go around if needed
-    diff = std::fabs( (double) ( output.option - option ) );
+    if ( 0.0 < diff ) hi = vol;
+    else lo = vol;
 
-    output.vega = ( ( output.option - option2 ) / ( volInput2 - volInput1 ) ) * 0.01;  // see if this works, if so then can remove one CRR calc below (not sure why need the 1/100 factor (maybe to undo pct variable)
+    if ( ( hi - lo ) < dblBracketMin ) {
+      const std::string sError(
+        "IVp in CRR bracket: "
+        + boost::lexical_cast<std::string>( lo )
+        + "," + boost::lexical_cast<std::string>( diff )
+      );
+      throw std::runtime_error( sError );
+    }
 
-    --cnt;
-    if ( 0 == cnt ) {
+    ++nIterations;
+    if ( nMaxIterations < nIterations ) {
       const std::string sError(
         "IVp in CRR: "
-        + boost::lexical_cast<std::string>( epsilon)
+        + boost::lexical_cast<std::string>( epsilon )
         + "," + boost::lexical_cast<std::string>( diff )
       );
       throw std::runtime_error( sError );
     }
-  }
 
-//  std::cout << "IV1=" << output.iv << ",O=" << output.option << ",D=" << output.delta << ",G=" << output.gamma << ",T=" << output.theta << ",V=" << output.vega << "," << cnt << std::endl;
+    const double slope = ( diff - diffPrev ) / ( vol - volPrev );
+    double volNext = ( 0.0 < slope ) ? vol - diff / slope : 0.0;  // nan fails the bracket test below
+    if ( !( ( lo < volNext ) && ( volNext < hi ) ) ) volNext = 0.5 * ( lo + hi );
 
-  // calculate CRR deltaVol to obtain new vega, as current calculated vega is for iteration n-1.
-  // close enough so don't bother
-  structOutput outputTmp;
-//  double vol = input.v;  // keep old value
-//  input.v += pct * vol;  // add a delta
-//  ou::tf::option::binomial::CRR( input, outputTmp );
-//  output.vega = ( outputTmp.option - output.option ) / ( pct * vol );
+    volPrev = vol;
+    diffPrev = diff;
 
-//  std::cout << "IV2=" << output.iv << ",O=" << output.option << ",D=" << output.delta << ",G=" << output.gamma << ",T=" << output.theta << ",V=" << output.vega << "," << cnt << std::endl;
+    vol = input.v = volNext;
+    ou::tf::option::binomial::CRR( input, output );
+    diff = output.option - option;
+  }
+
+  output.iv = vol;
+  output.vega = ( ( diff - diffPrev ) / ( vol - volPrev ) ) * 0.01; // per 1% change in volatility
 
   // need one more calc to do rho.  formulas on page 313 of black scholes and beyond
-//  input.v = vol;  // reset vol
   double r = input.r; // keep old r
   input.r += pct * r;  // add a delta
   ou::tf::option::binomial::CRR( input, outputTmp );
   output.rho = ( outputTmp.option - output.option ) / ( pct * r );
 
-//  std::cout << "IV3=" << output.iv << ",O=" << output.option << ",D=" << output.delta << ",G=" << output.gamma << ",T=" << output.theta << ",V=" << output.vega << "," << output.rho << "," << cnt << std::endl;
-
   return output.iv;
 }
 
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 
 #include <TFTrading/TradingEnumerations.h>
 
@@ -67,7 +68,13 @@ struct structOutput {
 // Cox Ross Rubinstein American Binomial Tree
 // pg 284 Option Pricing Formulas, 2e
 void CRR( const structInput& input, structOutput& output );
+// batch:  pOutput[ ix ] receives the result for pInput[ ix ], option, delta, gamma, theta are filled in
+//   options with the same step count and style are priced four at a time
+void CRR( const structInput* pInput, structOutput* pOutput, size_t nOptions );
+// input.v is the starting point for the solve, throws std::runtime_error when there is no solution
 double CalcImpliedVolatility( const structInput& input, double option, structOutput& output, double epsilon = 0.0001 );
+// as above, nIterations receives the number of tree evaluations used in the search
+double CalcImpliedVolatility( const structInput& input, double option, structOutput& output, double epsilon, size_t& nIterations );
 
 } // namespace binomial
 } // namespace option
@@ -22,13 +22,16 @@
 #ifndef CHAIN_H
 #define CHAIN_H
 
+#include <cmath>
+#include <atomic>
+#include <memory>
 #include <cassert>
 #include <iostream>
 #include <algorithm>
 #include <functional>
 
-#include <map>
 #include <string>
+#include <vector>
 #include <stdexcept>
 
 // use this for light weight strike calculations and name lookups
@@ -74,6 +77,13 @@ namespace chain {
   };
 }
 
+// strikes are held in a sorted contiguous vector, the options for each strike are allocated separately
+//   so references returned by GetStrike/SetIQFeedName* remain valid as strikes are added
+// queries are resolved to an index into the strike vector:
+//   when the strikes are evenly spaced, the index is computed from the increment,
+//   otherwise the search starts at the index found by the previous query,
+//   so as the underlying moves, a query is normally a step or two from the previous answer
+
 template<typename Option>
 class Chain {
 public:
@@ -83,10 +93,13 @@ public:
 
   using fStrike_t = std::function<void( double, const strike_t& )>;
 
-  Chain() {}
-  Chain( Chain&& rhs ) {
-    m_mapChain = std::move( rhs.m_mapChain );
-  }
+  Chain(): m_dblIncrement {}, m_ixHint {} {}
+  Chain( Chain&& rhs )
+  : m_vStrike( std::move( rhs.m_vStrike ) )
+  , m_vOptions( std::move( rhs.m_vOptions ) )
+  , m_dblIncrement( rhs.m_dblIncrement )
+  , m_ixHint( rhs.m_ixHint.load( std::memory_order_relaxed ) )
+  {}
   virtual ~Chain() {};
 
   struct exception_strike_not_found: public std::runtime_error {
@@ -127,14 +140,12 @@ public:
   int AdjacentStrikes( double strikeSource, double& strikeLower, double& strikeUpper ) const;
 
   void Strikes( fStrike_t&& fStrike ) const {
-    for ( const typename mapChain_t::value_type& vt: m_mapChain ) {
-      fStrike( vt.first, vt.second );
+    for ( size_t ix = 0; ix < m_vStrike.size(); ix++ ) {
+      fStrike( m_vStrike[ ix ], *m_vOptions[ ix ] );
     }
   }
 
-  using mapChain_t = std::map<double, strike_t>;
-
-  typename mapChain_t::size_type Size() const { return m_mapChain.size(); }
+  size_t Size() const { return m_vStrike.size(); }
   size_t EmitValues() const;
   size_t EmitSummary() const;
 
@@ -142,57 +153,122 @@ public:
 
 protected:
 
-  typename mapChain_t::const_iterator FindStrike( const double strike ) const;
-  typename mapChain_t::iterator FindStrike( const double strike );
+  size_t FindStrike( const double strike ) const; // index of an existing strike, throws when not found
 
 private:
 
-  mapChain_t m_mapChain;
+  using pStrike_t = std::unique_ptr<strike_t>;
+
+  using vStrike_t = std::vector<double>;
+  using vOptions_t = std::vector<pStrike_t>;
+
+  vStrike_t m_vStrike;   // ascending
+  vOptions_t m_vOptions; // parallel to m_vStrike
+
+  double m_dblIncrement; // non-zero when the strikes are evenly spaced
+  mutable std::atomic<size_t> m_ixHint; // index found by the previous query
+
+  size_t LowerBound( const double value ) const; // index of first strike >= value, or Size()
+  size_t UpperBound( const double value ) const; // index of first strike > value, or Size()
+  size_t Find( const double strike ) const; // index of strike, or Size()
+  size_t Insert( const double strike ); // index of strike, created if missing
+  void UpdateIncrement();
 
 };
 
 // methods:
 
+template<typename Option>
+size_t Chain<Option>::LowerBound( const double value ) const {
+  const size_t n( m_vStrike.size() );
+  if ( ( 0 == n ) || ( value <= m_vStrike.front() ) ) return 0;
+  if ( m_vStrike.back() < value ) return n;
+  // from here, m_vStrike[ 0 ] < value <= m_vStrike[ n - 1 ]
+  size_t ix;
+  if ( 0.0 < m_dblIncrement ) {
+    const double offset = std::ceil( ( value - m_vStrike.front() ) / m_dblIncrement );
+    ix = std::min<size_t>( (size_t) offset, n - 1 );
+  }
+  else {
+    ix = std::min<size_t>( m_ixHint.load( std::memory_order_relaxed ), n - 1 );
+  }
+  while ( m_vStrike[ ix ] < value ) ix++;
+  while ( !( m_vStrike[ ix - 1 ] < value ) ) ix--;
+  m_ixHint.store( ix, std::memory_order_relaxed );
+  return ix;
+}
+
+template<typename Option>
+size_t Chain<Option>::UpperBound( const double value ) const {
+  size_t ix = LowerBound( value );
+  if ( ( m_vStrike.size() != ix ) && ( value == m_vStrike[ ix ] ) ) ix++;
+  return ix;
+}
+
+template<typename Option>
+size_t Chain<Option>::Find( const double strike ) const {
+  const size_t ix = LowerBound( strike );
+  if ( ( m_vStrike.size() != ix ) && ( strike == m_vStrike[ ix ] ) ) return ix;
+  return m_vStrike.size();
+}
+
+template<typename Option>
+size_t Chain<Option>::Insert( const double strike ) {
+  const size_t ix = LowerBound( strike );
+  if ( ( m_vStrike.size() == ix ) || ( strike != m_vStrike[ ix ] ) ) {
+    m_vStrike.insert( m_vStrike.begin() + ix, strike );
+    m_vOptions.insert( m_vOptions.begin() + ix, std::make_unique<strike_t>() );
+    UpdateIncrement();
+  }
+  return ix;
+}
+
+template<typename Option>
+void Chain<Option>::UpdateIncrement() {
+  m_dblIncrement = 0.0;
+  if ( 2 <= m_vStrike.size() ) {
+    const double increment = m_vStrike[ 1 ] - m_vStrike[ 0 ];
+    const double tolerance = increment * 1e-9;
+    for ( size_t ix = 2; ix < m_vStrike.size(); ix++ ) {
+      if ( tolerance < std::abs( ( m_vStrike[ ix ] - m_vStrike[ ix - 1 ] ) - increment ) ) return;
+    }
+    m_dblIncrement = increment;
+  }
+}
+
 template<typename Option>
 double Chain<Option>::Put_Itm( double value ) const { // price < strike
-  typename mapChain_t::const_iterator iter = std::upper_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](double value, const typename mapChain_t::value_type& vt)->bool{ return value < vt.first; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Put_Itm not found" );
-  return iter->first;
+  const size_t ix = UpperBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Put_Itm not found" );
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Put_ItmAtm( double value ) const { // price <= strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Put_ItmAtm not found" );
-  return iter->first;
+  const size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Put_ItmAtm not found" );
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Put_Atm( double value ) const { // closest strike (use itm vs otm)
   double atm {};
-  typename mapChain_t::const_iterator iter1 = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter1 ) throw exception_strike_not_found( "Put_Atm not found" );
-  if ( value == iter1->first ) {
+  const size_t ix1 = LowerBound( value );
+  if ( m_vStrike.size() == ix1 ) throw exception_strike_not_found( "Put_Atm not found" );
+  if ( value == m_vStrike[ ix1 ] ) {
     atm = value;
   }
   else {
-    if ( m_mapChain.begin() == iter1 ) {
+    if ( 0 == ix1 ) {
       atm = value;
     }
     else {
-      typename mapChain_t::const_iterator iter2 = iter1;
-      iter2--;
-      if ( ( iter1->first - value ) < ( value - iter2->first ) ) {
-        atm = iter1->first;
+      const size_t ix2 = ix1 - 1;
+      if ( ( m_vStrike[ ix1 ] - value ) < ( value - m_vStrike[ ix2 ] ) ) {
+        atm = m_vStrike[ ix1 ];
       }
       else {
-        atm = iter2->first;
+        atm = m_vStrike[ ix2 ];
       }
     }
   }
@@ -202,96 +278,85 @@ double Chain<Option>::Put_Atm( double value ) const { // closest strike (use itm
 
 template<typename Option>
 double Chain<Option>::Put_OtmAtm( double value ) const { // price >= strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Put_OtmAtm not found" );
-  if ( value == iter->first ) {
+  size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Put_OtmAtm not found" );
+  if ( value == m_vStrike[ ix ] ) {
     // atm
   }
   else {
-    if ( m_mapChain.begin() == iter ) {
+    if ( 0 == ix ) {
       throw exception_at_start_of_chain( "Put_OtmAtm at begin of chain" );
     }
     else {
-      iter--; // strike will be OTM
+      ix--; // strike will be OTM
     }
   }
-  return iter->first;
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Put_Otm( double value ) const { // price > strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Put_Otm not found" );
-  if ( m_mapChain.begin() == iter ) {
+  size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Put_Otm not found" );
+  if ( 0 == ix ) {
     throw exception_at_start_of_chain( "Put_Otm at begin of chain" );
   }
   else {
-    iter--; // strike will be OTM
+    ix--; // strike will be OTM
   }
-  return iter->first;
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Call_Itm( double value ) const { // price > strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Call_Itm not found" );
-    if ( m_mapChain.begin() == iter ) {
-      throw exception_at_start_of_chain( "Call_Itm at begin of chain" );
-    }
-    else {
-      iter--;
-    }
-  return iter->first;
+  size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Call_Itm not found" );
+  if ( 0 == ix ) {
+    throw exception_at_start_of_chain( "Call_Itm at begin of chain" );
+  }
+  else {
+    ix--;
+  }
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Call_ItmAtm( double value ) const { // price >= strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Call_ItmAtm not found" );
-  if ( value == iter->first ) {
+  size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Call_ItmAtm not found" );
+  if ( value == m_vStrike[ ix ] ) {
     // atm
   }
   else {
-    if ( m_mapChain.begin() == iter ) {
+    if ( 0 == ix ) {
       throw exception_at_start_of_chain( "Call_ItmAtm at begin of chain" );
     }
     else {
-      iter--; // strike will be Itm
+      ix--; // strike will be Itm
     }
   }
-  return iter->first;
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Call_Atm( double value ) const { // closest strike (use itm vs otm)
   double atm {};
-  typename mapChain_t::const_iterator iter1 = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter1 ) throw exception_strike_not_found( "Call_Atm not found" );
-  if ( value == iter1->first ) {
+  const size_t ix1 = LowerBound( value );
+  if ( m_vStrike.size() == ix1 ) throw exception_strike_not_found( "Call_Atm not found" );
+  if ( value == m_vStrike[ ix1 ] ) {
     atm = value;
   }
   else {
-    if ( m_mapChain.begin() == iter1 ) {
+    if ( 0 == ix1 ) {
       atm = value;
     }
     else {
-      typename mapChain_t::const_iterator iter2 = iter1;
-      iter2--;
-      if ( ( iter1->first - value ) < ( value - iter2->first ) ) {
-        atm = iter1->first;
+      const size_t ix2 = ix1 - 1;
+      if ( ( m_vStrike[ ix1 ] - value ) < ( value - m_vStrike[ ix2 ] ) ) {
+        atm = m_vStrike[ ix1 ];
       }
       else {
-        atm = iter2->first;
+        atm = m_vStrike[ ix2 ];
       }
     }
   }
@@ -301,44 +366,37 @@ double Chain<Option>::Call_Atm( double value ) const { // closest strike (use it
 
 template<typename Option>
 double Chain<Option>::Call_OtmAtm( double value ) const { // price <= strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Call_OtmAtm not found" );
-  return iter->first;
+  const size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Call_OtmAtm not found" );
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Call_Otm( double value ) const { // price < strike
-  typename mapChain_t::const_iterator iter = std::upper_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](double value, const typename mapChain_t::value_type& vt)->bool{ return value < vt.first; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Call_Otm not found" );
-  return iter->first;
+  const size_t ix = UpperBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Call_Otm not found" );
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Atm( double value ) const { // closest strike (use itm vs otm)
   double atm {};
-  typename mapChain_t::const_iterator iter1 = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter1 ) throw exception_strike_not_found( "Call_Atm not found" );
-  if ( value == iter1->first ) {
+  const size_t ix1 = LowerBound( value );
+  if ( m_vStrike.size() == ix1 ) throw exception_strike_not_found( "Call_Atm not found" );
+  if ( value == m_vStrike[ ix1 ] ) {
     atm = value;
   }
   else {
-    if ( m_mapChain.begin() == iter1 ) {
+    if ( 0 == ix1 ) {
       atm = value;
     }
     else {
-      typename mapChain_t::const_iterator iter2 = iter1;
-      iter2--;
-      if ( ( iter1->first - value ) < ( value - iter2->first ) ) {
-        atm = iter1->first;
+      const size_t ix2 = ix1 - 1;
+      if ( ( m_vStrike[ ix1 ] - value ) < ( value - m_vStrike[ ix2 ] ) ) {
+        atm = m_vStrike[ ix1 ];
       }
       else {
-        atm = iter2->first;
+        atm = m_vStrike[ ix2 ];
       }
     }
   }
@@ -350,18 +408,14 @@ template<typename Option>
 int Chain<Option>::AdjacentStrikes( double strikeSource, double& strikeLower, double& strikeUpper ) const {
   strikeLower = strikeUpper = 0.0;
   int nReturn {};
-  typename mapChain_t::const_iterator iterSource = m_mapChain.find( strikeSource );
-  if ( m_mapChain.end() != iterSource ) {
-    typename mapChain_t::const_iterator iterLower = iterSource;
-    if ( m_mapChain.begin() != iterLower ) {
-      iterLower--;
-      strikeLower = iterLower->first;
+  const size_t ixSource = Find( strikeSource );
+  if ( m_vStrike.size() != ixSource ) {
+    if ( 0 != ixSource ) {
+      strikeLower = m_vStrike[ ixSource - 1 ];
       nReturn++;
     }
-    typename mapChain_t::const_iterator iterUpper = iterSource;
-    iterUpper++;
-    if ( m_mapChain.end() != iterUpper ) {
-      strikeUpper = iterUpper->first;
+    if ( m_vStrike.size() != ( ixSource + 1 ) ) {
+      strikeUpper = m_vStrike[ ixSource + 1 ];
       nReturn++;
     }
   }
@@ -370,138 +424,102 @@ int Chain<Option>::AdjacentStrikes( double strikeSource, double& strikeLower, do
 
 template<typename Option>
 Option& Chain<Option>::SetIQFeedNameCall( double dblStrike, const std::string& sIQFeedSymbolName ) {
-  typename mapChain_t::iterator iter = m_mapChain.find( dblStrike );
-  if ( m_mapChain.end() == iter ) {
-    auto result = m_mapChain.emplace( typename mapChain_t::value_type( dblStrike, strike_t() ) );
-    assert( result.second );
-    iter = result.first;
-  }
-  if ( iter->second.call.sIQFeedSymbolName.empty() ) {
-    iter->second.call.sIQFeedSymbolName = sIQFeedSymbolName;
+  strike_t& strike( *m_vOptions[ Insert( dblStrike ) ] );
+  if ( strike.call.sIQFeedSymbolName.empty() ) {
+    strike.call.sIQFeedSymbolName = sIQFeedSymbolName;
   }
   else {
     std::cout
       << "Chain<Option>::SetIQFeedNameCall duplicate existing: "
-      << iter->second.call.sIQFeedSymbolName
+      << strike.call.sIQFeedSymbolName
       << ", new "
       << sIQFeedSymbolName
       << ", skipped"
       << std::endl;
     throw std::runtime_error( "duplicate call" );
     // maybe throw an exception and let caller handle it: ignore or not
-    //assert( iter->second.call.sIQFeedSymbolName == sIQFeedSymbolName );
+    //assert( strike.call.sIQFeedSymbolName == sIQFeedSymbolName );
   }
-  return iter->second.call;
+  return strike.call;
 }
 
 template<typename Option>
 Option& Chain<Option>::SetIQFeedNamePut( double dblStrike, const std::string& sIQFeedSymbolName ) {
-  typename mapChain_t::iterator iter = m_mapChain.find( dblStrike );
-  if ( m_mapChain.end() == iter ) {
-    auto result = m_mapChain.emplace( typename mapChain_t::value_type( dblStrike, strike_t() ) );
-    assert( result.second );
-    iter = result.first;
-  }
-  if ( iter->second.put.sIQFeedSymbolName.empty() ) {
-    iter->second.put.sIQFeedSymbolName = sIQFeedSymbolName;
+  strike_t& strike( *m_vOptions[ Insert( dblStrike ) ] );
+  if ( strike.put.sIQFeedSymbolName.empty() ) {
+    strike.put.sIQFeedSymbolName = sIQFeedSymbolName;
   }
   else {
     std::cout
       << "Chain<Option>::SetIQFeedNamePut duplicate existing: "
-      << iter->second.put.sIQFeedSymbolName
+      << strike.put.sIQFeedSymbolName
       << ", new "
       << sIQFeedSymbolName
       << ", skipped"
       << std::endl;
     throw std::runtime_error( "duplicate put" );
     // maybe throw an exception and let caller handle it: ignore or not
-    //assert( iter->second.put.sIQFeedSymbolName == sIQFeedSymbolName );
+    //assert( strike.put.sIQFeedSymbolName == sIQFeedSymbolName );
   }
-  return iter->second.put;
+  return strike.put;
 }
 
 template<typename Option>
 const std::string Chain<Option>::GetIQFeedNameCall( double dblStrike ) const {
-  typename mapChain_t::const_iterator iter = FindStrike( dblStrike );
-  return iter->second.call.sIQFeedSymbolName;
+  return m_vOptions[ FindStrike( dblStrike ) ]->call.sIQFeedSymbolName;
 }
 
 template<typename Option>
 const std::string Chain<Option>::GetIQFeedNamePut( double dblStrike ) const {
-  typename mapChain_t::const_iterator iter = FindStrike( dblStrike );
-  return iter->second.put.sIQFeedSymbolName;
+  return m_vOptions[ FindStrike( dblStrike ) ]->put.sIQFeedSymbolName;
 }
 
 template<typename Option>
 void Chain<Option>::Erase( double dblStrike ) {
-  typename mapChain_t::const_iterator iter = FindStrike( dblStrike );
-  m_mapChain.erase( iter );
+  const size_t ix = FindStrike( dblStrike );
+  m_vStrike.erase( m_vStrike.begin() + ix );
+  m_vOptions.erase( m_vOptions.begin() + ix );
+  UpdateIncrement();
 }
 
 template<typename Option>
 const chain::Strike<Option>& Chain<Option>::GetExistingStrike( double dblStrike ) const { // this one doesn't make much sense
-  typename mapChain_t::const_iterator citer = m_mapChain.find( dblStrike );
-  if ( m_mapChain.end() == citer ) {
+  const size_t ix = Find( dblStrike );
+  if ( m_vStrike.size() == ix ) {
     throw exception_strike_not_found( "Chain::GetExistingStrike const: no strike" );
   }
-  return citer->second;
+  return *m_vOptions[ ix ];
 }
 
-//template<typename Option>
-//const chain::Strike<Option>& Chain<Option>::GetStrike( double dblStrike ) const { // this one doesn't make much sense
-//  typename mapChain_t::iterator iter = m_mapChain.find( dblStrike );
-//  if ( m_mapChain.end() == iter ) {
-//    iter = m_mapChain.insert( m_mapChain.begin(), std::move( typename mapChain_t::value_type( dblStrike, strike_t() ) ) );
-//  }
-//  return iter->second;
-//}
-
 template<typename Option>
 chain::Strike<Option>& Chain<Option>::GetStrike( double dblStrike ) {
-  typename mapChain_t::iterator iter = m_mapChain.find( dblStrike );
-  if ( m_mapChain.end() == iter ) {
-    auto result = m_mapChain.emplace( typename mapChain_t::value_type( dblStrike, strike_t() ) );
-    assert( result.second );
-    iter = result.first;
-  }
-  return iter->second;
-}
-
-// const iterator
-template<typename Option>
-typename Chain<Option>::mapChain_t::const_iterator Chain<Option>::FindStrike( const double strike ) const {
-  typename mapChain_t::const_iterator iter = m_mapChain.find( strike );
-  if ( m_mapChain.end() == iter ) {
-    throw exception_strike_not_found( "Chain::FindStrike const: no strike" );
-  }
-  return iter;
+  return *m_vOptions[ Insert( dblStrike ) ];
 }
 
-// regular iterator
 template<typename Option>
-typename Chain<Option>::mapChain_t::iterator Chain<Option>::FindStrike( const double strike ) {
-  typename mapChain_t::iterator iter = m_mapChain.find( strike );
-  if ( m_mapChain.end() == iter ) {
+size_t Chain<Option>::FindStrike( const double strike ) const {
+  const size_t ix = Find( strike );
+  if ( m_vStrike.size() == ix ) {
     std::cout
       << "Chain::FindStrike error: "
       << "strike " << strike
-      << ", m_mapChain size=" << m_mapChain.size()
+      << ", chain size=" << m_vStrike.size()
       << std::endl;
     throw exception_strike_not_found( "Chain::FindStrike: no strike" );
   }
-  return iter;
+  return ix;
 }
 
 template<typename Option>
 size_t Chain<Option>::EmitValues() const { // TODO: supply output stream
   size_t cnt {};
-  std::for_each( m_mapChain.begin(), m_mapChain.end(), [&cnt](const typename mapChain_t::value_type& vt){
+  Strikes( [&cnt]( double strike, const strike_t& options ){
     cnt++;
     std::cout
-      << vt.first << ": "
-      << vt.second.call.sIQFeedSymbolName
+      << strike << ": "
+      << options.call.sIQFeedSymbolName
       << ", "
-      << vt.second.put.sIQFeedSymbolName
+      << options.put.sIQFeedSymbolName
       << std::endl;
   });
   return cnt;
@@ -512,10 +530,10 @@ size_t Chain<Option>::EmitSummary() const { // TODO: supply output stream
   size_t nStrikes {};
   size_t nCalls {};
   size_t nPuts {};
-  std::for_each( m_mapChain.begin(), m_mapChain.end(), [ &nStrikes, &nCalls, &nPuts](const typename mapChain_t::value_type& vt){
+  Strikes( [ &nStrikes, &nCalls, &nPuts]( double strike, const strike_t& options ){
     nStrikes++;
-    if ( 0 != vt.second.call.sIQFeedSymbolName.size() ) nCalls++;
-    if ( 0 != vt.second.put.sIQFeedSymbolName.size() ) nPuts++;
+    if ( 0 != options.call.sIQFeedSymbolName.size() ) nCalls++;
+    if ( 0 != options.put.sIQFeedSymbolName.size() ) nPuts++;
   });
     std::cout
       << "  #strikes=" << nStrikes
@@ -29,6 +29,7 @@
 // old way: https://www.boost.org/doc/libs/1_67_0/doc/html/boost_asio/reference/io_service.html
 // new way: https://www.boost.org/doc/libs/1_67_0/doc/html/boost_asio/reference/io_context.html
 
+#include <thread>
 #include <algorithm>
 
 #include <boost/bind/bind.hpp>
@@ -42,70 +43,20 @@ namespace ou { // One Unified
 namespace tf { // TradeFrame
 namespace option { // options
 
-OptionEntry::OptionEntry( OptionEntry&& rhs ) {
-  if ( 0 < rhs.m_cntInstances ) {
-    rhs.m_pUnderlying->OnQuote.Remove( MakeDelegate( &rhs, &OptionEntry::HandleUnderlyingQuote ) );
-  }
-  m_cntInstances = rhs.m_cntInstances;
-  m_pOption = std::move( rhs.m_pOption );
-  m_pUnderlying = std::move( rhs.m_pUnderlying );
-  m_fGreek = std::move( rhs.m_fGreek );
-  //m_bStartedWatch = rhs.m_bStartedWatch;
-  //rhs.m_bStartedWatch = false;
-  rhs.m_cntInstances = 0; // can this be set, what happens on delete?  what happens when tied to m_bStartedWatch?
-  //if ( m_bStartedWatch ) {
-  if ( 0 < m_cntInstances ) {
-    m_pUnderlying->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote) );
-  }
-  //PrintState( "OptionEntry::OptionEntry(0)" );
-}
-
-//OptionEntry::OptionEntry( pOption_t pOption_): m_pOption( pOption_ ), /*m_bStartedWatch( false ),*/ m_cntInstances( 0 ) {
-//  std::cout << "*** should not be here, does nothing ***" << std::endl;
-  //PrintState( "OptionEntry::OptionEntry(1)" );
-//}  // can't start with out an underlying
-
-OptionEntry::OptionEntry( pWatch_t pUnderlying_, pOption_t pOption_, fCallbackWithGreek_t&& fGreek_ ):
-  m_pUnderlying( pUnderlying_ ), m_pOption( pOption_ ), m_fGreek( std::move( fGreek_ ) ),
-  //m_bStartedWatch( false ),
-  m_cntInstances( 0 ) // handled by Inc, Dec
-{
-  //m_pUnderlying->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote) );
-  //m_pUnderlying->StartWatch();
-  //pOption->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleOptionQuote ) );
-  //m_pOption->StartWatch();
-  //m_bStartedWatch = true;
-  //PrintState( "OptionEntry::OptionEntry(2)" );
-}
-
-OptionEntry::OptionEntry( pWatch_t pUnderlying_, pOption_t pOption_ ):
-  m_pUnderlying( pUnderlying_ ), m_pOption( pOption_ ),
-  //m_bStartedWatch( false ),
-  m_cntInstances( 0 )
+OptionEntry::OptionEntry( idEntry_t id, pWatch_t pUnderlying_, pOption_t pOption_, const AtomicTolerance& tolerance, fDirty_t&& fDirty ):
+  m_cntInstances( 0 ), // handled by Inc, Dec
+  m_pOption( pOption_ ), m_pUnderlying( pUnderlying_ ),
+  m_id( id ), m_fDirty( std::move( fDirty ) ), m_tolerance( tolerance ),
+  m_dblUnderlying {}, m_dblOption {}, m_dblUnderlyingAtCalc {}, m_dblOptionAtCalc {},
+  m_bDirty( false ), m_bInFlight( false ), m_nsDirty {}, m_nsCalc {}
 {
-  //m_pUnderlying->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote) );
-  //m_pUnderlying->StartWatch();
-  //pOption->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleOptionQuote ) );
-  //m_pOption->StartWatch();
-  //m_bStartedWatch = true;
-  //PrintState( "OptionEntry::OptionEntry(3)" );
 }
 
-// need to properly work with m_bStartedWatch and cntInstances
 OptionEntry::~OptionEntry() {
-  //pOption->OnQuote.Remove( MakeDelegate( this, &OptionEntry::HandleOptionQuote ) );
-  //PrintState( "OptionEntry::~OptionEntry" );
-  //if ( m_bStartedWatch ) {
-
   if ( 0 < m_cntInstances ) {
     std::cout << "OptionEntry::~OptionEntry m_cntInstances was not zero: " << m_cntInstances << "," << m_pOption->GetInstrument()->GetInstrumentName() << std::endl;
     m_cntInstances = 1;
     Dec();
-    //m_pUnderlying->StopWatch();
-    //m_pOption->StopWatch();
-    //m_pUnderlying->OnQuote.Remove( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote ) );
-    //m_cntInstances = 0;
-    //m_bStartedWatch = false;
   }
 }
 
@@ -118,52 +69,92 @@ void OptionEntry::PrintState( const std::string id ) {
   if ( 0 < m_pOption.use_count() ) {
     sOption = m_pOption->GetInstrument()->GetInstrumentName();
   }
-  std::cout << id << ": U(" << sUnderlying << "),O(" << sOption /* << "), B(" << m_bStartedWatch */ << ")" << std::endl;
+  std::cout << id << ": U(" << sUnderlying << "),O(" << sOption << ")" << std::endl;
 }
 
 void OptionEntry::Inc() {
   if ( 0 == m_cntInstances ) {
     m_pUnderlying->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote ) );
+    m_pOption->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleOptionQuote ) );
     m_pUnderlying->StartWatch();
-    m_pOption->StartWatch();  }
+    m_pOption->StartWatch();
+  }
   m_cntInstances++;
 }
+
 size_t OptionEntry::Dec() {
   assert( 0 < m_cntInstances );
   m_cntInstances--;
   if ( 0 == m_cntInstances ) {
     m_pUnderlying->StopWatch();
     m_pOption->StopWatch();
+    m_pOption->OnQuote.Remove( MakeDelegate( this, &OptionEntry::HandleOptionQuote ) );
     m_pUnderlying->OnQuote.Remove( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote ) );
   }
   return m_cntInstances;
 }
 
+void OptionEntry::HandleUnderlyingQuote( const ou::tf::Quote& quote ) {
+  if ( quote.IsNonZero() ) {
+    const double dblMid( quote.Midpoint() );
+    if ( 0.0 < dblMid ) {
+      m_dblUnderlying.store( dblMid, std::memory_order_relaxed );
+      const double dblAtCalc( m_dblUnderlyingAtCalc.load( std::memory_order_relaxed ) );
+      if ( std::abs( dblMid - dblAtCalc ) > ( dblAtCalc * m_tolerance.dblUnderlying.load( std::memory_order_relaxed ) ) ) {
+        MarkDirty();
+      }
+    }
+  }
+}
+
+void OptionEntry::HandleOptionQuote( const ou::tf::Quote& quote ) {
+  const double dblMid( quote.Midpoint() );
+  m_dblOption.store( dblMid, std::memory_order_relaxed );
+  if ( std::abs( dblMid - m_dblOptionAtCalc.load( std::memory_order_relaxed ) ) > m_tolerance.dblOption.load( std::memory_order_relaxed ) ) {
+    MarkDirty();
+  }
+}
 
-void OptionEntry::HandleUnderlyingQuote(const ou::tf::Quote& quote_) {
-  m_quoteLastUnderlying = quote_;
+void OptionEntry::MarkDirty() {
+  if ( !m_bDirty.exchange( true, std::memory_order_acq_rel ) ) {
+    m_nsDirty.store( Now(), std::memory_order_relaxed );
+    m_fDirty( m_id );
+  }
 }
 
-//void OptionEntry::HandleOptionQuote(const ou::tf::Quote& quote_) { // should this be kept?
-//  if ( ! m_quoteLastOption.SameBidAsk( quote_ ) ) {
-//    m_quoteLastOption = quote_;
-//    m_bChanged = true;
-//  }
-//}
+double OptionEntry::Dispatch() {
+  m_bInFlight.store( true, std::memory_order_release );
+  m_bDirty.store( false, std::memory_order_release ); // quotes from here on mark it dirty again
+  const double dblUnderlying( m_dblUnderlying.load( std::memory_order_relaxed ) );
+  m_dblUnderlyingAtCalc.store( dblUnderlying, std::memory_order_relaxed );
+  m_dblOptionAtCalc.store( m_dblOption.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+  return dblUnderlying;
+}
 
-void OptionEntry::Calc( const fCalc_t& fCalc ) {
-  fCalc( m_pOption, m_quoteLastUnderlying, m_fGreek );
+int64_t OptionEntry::Complete() {
+  const int64_t ns( Now() );
+  m_nsCalc.store( ns, std::memory_order_relaxed );
+  m_bInFlight.store( false, std::memory_order_release );
+  return ns - m_nsDirty.load( std::memory_order_relaxed );
 }
 
 // ====================
 
-Engine::Engine( const ou::tf::NoRiskInterestRateSeries& feed ):
+Engine::Engine( const ou::tf::NoRiskInterestRateSeries& feed, size_t nThreads ):
   m_InterestRateFeed( feed ),
-  m_srvcWork(boost::asio::make_work_guard( m_srvc )),
-  m_timerScan( m_srvc )
+  m_srvcWork( boost::asio::make_work_guard( m_srvc ) ),
+  m_strandCycle( boost::asio::make_strand( m_srvc ) ),
+  m_timerScan( m_srvc ),
+  m_nOperationQueueDepthMax {},
+  m_nEntries {},
+  m_nsRefresh( std::chrono::nanoseconds( std::chrono::seconds( 30 ) ).count() ),
+  m_nDirtyMax {},
+  m_bCycleScheduled( false ),
+  m_nRecalc {}, m_nsLatencyTotal {}, m_nsLatencyMax {}
 {
 
-  for ( std::size_t ix = 0; ix < 1; ix++ ) {  // change the final value to add threads, and fix the TODO further down
+  nThreads = std::max<size_t>( 1, nThreads );
+  for ( std::size_t ix = 0; ix < nThreads; ix++ ) {
     m_threads.create_thread( boost::bind( &boost::asio::io_context::run, &m_srvc ) ); // add handlers
   }
 
@@ -178,21 +169,20 @@ Engine::Engine( const ou::tf::NoRiskInterestRateSeries& feed ):
 
 Engine::~Engine( ) {
 
-  // TODO: perform a deque of all operations?
-
-  if ( !m_dequeOptionEntryOperation.empty() ) {
-    std::cout << "Engine::~Engine: operations still remaining in the queue" << std::endl;
-  }
-
   {
     std::lock_guard<std::mutex> lock(m_mutexOptionEntryOperationQueue);
+    if ( !m_dequeOptionEntryOperation.empty() ) {
+      std::cout << "Engine::~Engine: operations still remaining in the queue" << std::endl;
+    }
     m_dequeOptionEntryOperation.clear();
   }
 
+  m_timerScan.cancel();
   m_srvcWork.reset();
   m_threads.join_all();
 
-  m_mapOptionEntry.clear();
+  m_mapEntry.clear();
+  m_vEntry.clear();
 
   m_mapKnownOptions.clear();
   m_mapKnownWatches.clear();
@@ -224,16 +214,8 @@ void Engine::RegisterOption( const pOption_t& pOption) {
   }
 }
 
-// if used, then need to perform a lookup on the underlying first to prevent duplicated effort
-//void Engine::Register( pOption_t& pOption, pWatch_t& pWatch) {
-//  Register( pWatch );
-//  Register( pOption );
-//}
-
 // needs to be used to load up underlying watch
 ou::tf::Watch::pWatch_t Engine::FindWatch( const pInstrument_t pInstrument ) {
-  //std::cout << "Engine::Find Watch: " << pWatch->GetInstrument()->GetInstrumentName() << std::endl;
-  //std::cout << "Engine::Find Watch: " << pInstrument->GetInstrumentName() << std::endl;
   pWatch_t pWatch;
   std::lock_guard<std::mutex> lock(m_mutexOptionEntryOperationQueue);
   mapKnownWatches_t::iterator iter = m_mapKnownWatches.find( pInstrument->GetInstrumentName() );
@@ -256,8 +238,6 @@ ou::tf::Watch::pWatch_t Engine::FindWatch( const pInstrument_t pInstrument ) {
 
 // needs to be used to load up options
 Option::pOption_t Engine::FindOption( const pInstrument_t pInstrument ) {
-  //std::cout << "Engine::Find Option: " << pOption->GetInstrument()->GetInstrumentName() << std::endl;
-  //std::cout << "Engine::Find Option: " << pInstrument->GetInstrumentName() << std::endl;
   pOption_t pOption;
   std::lock_guard<std::mutex> lock(m_mutexOptionEntryOperationQueue);
   mapKnownOptions_t::iterator iter = m_mapKnownOptions.find( pInstrument->GetInstrumentName() );
@@ -279,21 +259,43 @@ Option::pOption_t Engine::FindOption( const pInstrument_t pInstrument ) {
 }
 
 void Engine::Add( pOption_t pOption, pWatch_t pUnderlying ) {
-//  if ( m_srvcWork.owns_work() ) {
-    assert( ( 0 != pOption.use_count() ) && ( 0 != pUnderlying.use_count() ) );
-    OptionEntry oe( pUnderlying, pOption );
+  assert( ( 0 != pOption.use_count() ) && ( 0 != pUnderlying.use_count() ) );
+  {
     std::lock_guard<std::mutex> lock(m_mutexOptionEntryOperationQueue);
-    m_dequeOptionEntryOperation.push_back( OptionEntryOperation( Action::AddOption, std::move(oe) ) );
-//  }
+    m_dequeOptionEntryOperation.emplace_back( Action::AddOption, std::move( pOption ), std::move( pUnderlying ) );
+    m_nOperationQueueDepthMax = std::max( m_nOperationQueueDepthMax, m_dequeOptionEntryOperation.size() );
+  }
+  ScheduleCycle();
 }
 
 void Engine::Remove( pOption_t pOption, pWatch_t pUnderlying ) {
-//  if ( m_srvcWork.owns_work() ) {
-    assert( ( 0 != pOption.use_count() ) && ( 0 != pUnderlying.use_count() ) );
-    OptionEntry oe( pUnderlying, pOption );
+  assert( ( 0 != pOption.use_count() ) && ( 0 != pUnderlying.use_count() ) );
+  {
     std::scoped_lock<std::mutex> lock(m_mutexOptionEntryOperationQueue);
-    m_dequeOptionEntryOperation.push_back( OptionEntryOperation( Action::RemoveOption, std::move(oe) ) );
-//  }
+    m_dequeOptionEntryOperation.emplace_back( Action::RemoveOption, std::move( pOption ), std::move( pUnderlying ) );
+    m_nOperationQueueDepthMax = std::max( m_nOperationQueueDepthMax, m_dequeOptionEntryOperation.size() );
+  }
+  ScheduleCycle();
+}
+
+Engine::Stats Engine::GetStats() {
+  Stats stats;
+  {
+    std::lock_guard<std::mutex> lock(m_mutexOptionEntryOperationQueue);
+    stats.nOperationQueueDepth = m_dequeOptionEntryOperation.size();
+    stats.nOperationQueueDepthMax = m_nOperationQueueDepthMax;
+  }
+  {
+    std::lock_guard<std::mutex> lock( m_mutexDirty );
+    stats.nDirty = m_vDirty.size();
+    stats.nDirtyMax = m_nDirtyMax;
+  }
+  stats.nEntries = m_nEntries.load( std::memory_order_relaxed );
+  stats.nRecalc = m_nRecalc.load( std::memory_order_relaxed );
+  const double dblNsPerMs( 1e6 );
+  stats.dblLatencyAvgMs = ( 0 == stats.nRecalc ) ? 0.0 : (double) m_nsLatencyTotal.load( std::memory_order_relaxed ) / stats.nRecalc / dblNsPerMs;
+  stats.dblLatencyMaxMs = (double) m_nsLatencyMax.load( std::memory_order_relaxed ) / dblNsPerMs;
+  return stats;
 }
 
 void Engine::HandleTimerScan( const boost::system::error_code &ec ) {
@@ -302,21 +304,17 @@ void Engine::HandleTimerScan( const boost::system::error_code &ec ) {
   }
   else {
     if ( m_srvcWork.owns_work() ) {
-      try {
-        ScanOptionEntryQueue();
-      }
-      catch ( std::runtime_error& e ) {
-        std::cout << "Engine::HandleTimerScan runtime: " << e.what() << std::endl;
-      }
-      catch (...) {
-        std::cout << "Engine::HandleTimerScan exception: unknown" << std::endl;
-      }
+      // greeks decay with time, refresh entries which have not moved for a while
+      boost::asio::post(
+        m_strandCycle,
+        [this](){
+          const int64_t nsStale( OptionEntry::Now() - m_nsRefresh.load( std::memory_order_relaxed ) );
+          for ( pOptionEntry_t& pEntry: m_vEntry ) {
+            if ( pEntry && ( pEntry->LastCalc() < nsStale ) ) pEntry->MarkDirty();
+          }
+        } );
 
-    // other ways:
-      //timer_.expires_at(timer_.expiry() + boost::asio::chrono::seconds(1));
-      //m_timerScan.expires_after( boost::asio::chrono::milliseconds(250) );
-      m_timerScan.expires_after( boost::asio::chrono::milliseconds(495) );
-      //m_timerScan.expires_after( boost::asio::chrono::milliseconds(750) );
+      m_timerScan.expires_after( boost::asio::chrono::milliseconds(1000) );
       m_timerScan.async_wait(
         boost::bind(
           &Engine::HandleTimerScan, this,
@@ -327,118 +325,183 @@ void Engine::HandleTimerScan( const boost::system::error_code &ec ) {
   }
 }
 
+void Engine::MarkDirty( idEntry_t id ) {
+  {
+    std::lock_guard<std::mutex> lock( m_mutexDirty );
+    m_vDirty.push_back( id );
+    m_nDirtyMax = std::max( m_nDirtyMax, m_vDirty.size() );
+  }
+  ScheduleCycle();
+}
+
+void Engine::ScheduleCycle() {
+  if ( !m_bCycleScheduled.exchange( true, std::memory_order_acq_rel ) ) {
+    boost::asio::post( m_strandCycle, [this](){ Cycle(); } );
+  }
+}
+
+// runs on m_strandCycle
 void Engine::ProcessOptionEntryOperationQueue() {
-  std::lock_guard<std::mutex> lock(m_mutexOptionEntryOperationQueue);
-  if ( !m_dequeOptionEntryOperation.empty() ) {
-    OptionEntryOperation& oe( m_dequeOptionEntryOperation.front() );
-    const std::string& sUnderlying( oe.m_oe.UnderlyingName() );
-    const std::string& sOption( oe.m_oe.OptionName() );
-    std::string MapKey( sUnderlying + "_" + sOption );
-
-    switch( oe.m_action ) {
-      case Action::AddOption: {
-          //std::cout << "Engine::AddOption: " << MapKey << " " << oe.m_oe.GetOption().get() << std::endl;
-
-          mapKnownWatches_t::iterator iterWatches = m_mapKnownWatches.find( sUnderlying );
-          if ( m_mapKnownWatches.end() == iterWatches ) {
-            //m_mapKnownWatches.insert( mapKnownWatches_t::value_type( sUnderlying, iterOption->second.GetUnderlying() ) );
-            throw  std::runtime_error( "Engine::ProcessOptionEntryOperationQueue doesn't find known watch: " + sUnderlying );
-          }
 
-          mapKnownOptions_t::iterator iterOptions = m_mapKnownOptions.find( sOption );
-          if ( m_mapKnownOptions.end() == iterOptions ) {
-            //m_mapKnownOptions.insert( mapKnownOptions_t::value_type( sOption, iterOption->second.GetOption() ) );
-            throw  std::runtime_error( "Engine::ProcessOptionEntryOperationQueue doesn't find known option " + sOption );
-          }
+  dequeOptionEntryOperation_t deque;
+  {
+    std::lock_guard<std::mutex> lock(m_mutexOptionEntryOperationQueue);
+    deque.swap( m_dequeOptionEntryOperation );
+  }
 
-          mapOptionEntry_t::iterator iterOption = m_mapOptionEntry.find( MapKey );
-          if ( m_mapOptionEntry.end() == iterOption ) {
-            iterOption = m_mapOptionEntry.insert( m_mapOptionEntry.begin(), mapOptionEntry_t::value_type(MapKey, std::move( oe.m_oe ) ) );
-            //std::cout << "Engine::AddOption: " << MapKey << " added" << std::endl;
-          }
-          else {
-            //std::cout << "Engine::AddOption: " << MapKey << " dropped" << std::endl;
-          }
-          iterOption->second.Inc();
-        }
-        break;
-      case Action::RemoveOption: {
-          // should option and instrument be removed from m_mapKnownWatches, m_mapKnownOptions?
-          // if so, then maps require counters, or use the pOption_t use_count?
-          //std::cout << "Engine::RemoveOption: " << MapKey << std::endl;
-          mapOptionEntry_t::iterator iterOption = m_mapOptionEntry.find( MapKey );
-          if ( m_mapOptionEntry.end() == iterOption ) {
-            throw std::runtime_error( "Engine::Remove: can't find option" + MapKey );
+  for ( OptionEntryOperation& oe: deque ) {
+
+    const keyEntry_t key( oe.m_pUnderlying.get(), oe.m_pOption.get() );
+
+    try {
+      switch( oe.m_action ) {
+        case Action::AddOption: {
+            mapEntry_t::iterator iterEntry = m_mapEntry.find( key );
+            if ( m_mapEntry.end() == iterEntry ) {
+              const std::string& sUnderlying( oe.m_pUnderlying->GetInstrument()->GetInstrumentName() );
+              const std::string& sOption( oe.m_pOption->GetInstrument()->GetInstrumentName() );
+              {
+                std::lock_guard<std::mutex> lock(m_mutexOptionEntryOperationQueue); // known maps are shared with Register/Find
+                if ( m_mapKnownWatches.end() == m_mapKnownWatches.find( sUnderlying ) ) {
+                  throw  std::runtime_error( "Engine::ProcessOptionEntryOperationQueue doesn't find known watch: " + sUnderlying );
+                }
+                if ( m_mapKnownOptions.end() == m_mapKnownOptions.find( sOption ) ) {
+                  throw  std::runtime_error( "Engine::ProcessOptionEntryOperationQueue doesn't find known option " + sOption );
+                }
+              }
+
+              idEntry_t id;
+              if ( m_vFreeEntry.empty() ) {
+                id = m_vEntry.size();
+                m_vEntry.emplace_back( nullptr );
+              }
+              else {
+                id = m_vFreeEntry.back();
+                m_vFreeEntry.pop_back();
+              }
+              m_vEntry[ id ] = std::make_shared<OptionEntry>(
+                id, oe.m_pUnderlying, oe.m_pOption, m_tolerance,
+                [this]( idEntry_t id ){ MarkDirty( id ); } );
+              iterEntry = m_mapEntry.emplace( key, id ).first;
+              m_nEntries.fetch_add( 1, std::memory_order_relaxed );
+            }
+            m_vEntry[ iterEntry->second ]->Inc();
           }
+          break;
+        case Action::RemoveOption: {
+            // should option and instrument be removed from m_mapKnownWatches, m_mapKnownOptions?
+            // if so, then maps require counters, or use the pOption_t use_count?
+            mapEntry_t::iterator iterEntry = m_mapEntry.find( key );
+            if ( m_mapEntry.end() == iterEntry ) {
+              throw std::runtime_error( "Engine::Remove: can't find option " + oe.m_pOption->GetInstrument()->GetInstrumentName() );
+            }
 
-          OptionEntry::size_type cnt = iterOption->second.Dec();
-          if ( 0 == cnt ) {
-            m_mapOptionEntry.erase( iterOption );
-            //std::cout << "Engine::RemoveOption: " << MapKey << " erased" << std::endl;
-          }
-          else {
-            //std::cout << "Engine::RemoveOption: " << MapKey << " count " << cnt << std::endl;
+            const idEntry_t id( iterEntry->second );
+            if ( 0 == m_vEntry[ id ]->Dec() ) {
+              m_vEntry[ id ].reset(); // a calculation in flight holds its own reference
+              m_vFreeEntry.push_back( id );
+              m_mapEntry.erase( iterEntry );
+              m_nEntries.fetch_sub( 1, std::memory_order_relaxed );
+            }
           }
-        }
-        break;
-      case Action::Unknown:
-        break;
+          break;
+        case Action::Unknown:
+          break;
+      }
+    }
+    catch ( std::runtime_error& e ) {
+      std::cout << "Engine::ProcessOptionEntryOperationQueue: " << e.what() << std::endl;
     }
-    m_dequeOptionEntryOperation.pop_front();
   }
 }
 
-// TODO: sort map by expiry?  // then Option::CalcRate is required less often
-void Engine::ScanOptionEntryQueue() {
+// runs on m_strandCycle
+void Engine::Cycle() {
+
+  m_bCycleScheduled.store( false, std::memory_order_release ); // requests from here on schedule another cycle
 
   ProcessOptionEntryOperationQueue();
 
+  m_vCycle.clear();
+  {
+    std::lock_guard<std::mutex> lock( m_mutexDirty );
+    m_vCycle.swap( m_vDirty );
+  }
+  if ( m_vCycle.empty() ) return;
+
   // dtUtcNow needs to be passed by value
-  boost::posix_time::ptime dtUtcNow = ou::TimeSource::GlobalInstance().External();
-
-  // TODO:  process only those being watched
-
-  // three step lambda call:
-  //  1) lambda for each active mapOptionEntry
-  //  2) capture private values from the OptionEntry
-  //  3) use the values in a background thread for calculations via post to io_service
-  std::for_each(
-    m_mapOptionEntry.begin(), m_mapOptionEntry.end(),
-    [this, dtUtcNow](mapOptionEntry_t::value_type& vt){
-      //std::cout << "for each " << vt.second.GetUnderlying()->GetInstrument()->GetInstrumentName() << std::endl;
-      //std::cout << "         " << vt.second.GetOption()->GetInstrument()->GetInstrumentName() << std::endl;
-      vt.second.Calc(
-        [this, dtUtcNow](OptionEntry::pOption_t pOption, const ou::tf::Quote& quoteUnderlying, fCallbackWithGreek_t& fCallbackWithGreek ){
-          if ( !quoteUnderlying.IsNonZero() ) {
-            // underlying is unstable
-          }
-          else {
-            double midpointUnderlying( quoteUnderlying.Midpoint() );
-            if ( 0.0 < midpointUnderlying ) {  // only start calculations once underlying has quotes
-              // TODO: add flag to start calculation only after previous calculation is complete
-              boost::asio::post( m_srvc,
-                [this, dtUtcNow, pOption, midpointUnderlying, fCallbackWithGreek](){
-                  try {
-                    //boost::timer::auto_cpu_timer t;
-                    ou::tf::option::binomial::structInput input;
-                    input.S = midpointUnderlying;
-                    pOption->CalcRate( input, dtUtcNow, m_InterestRateFeed );
-                    pOption->CalcGreeks( input, dtUtcNow, true ); // TODO, don't proceed if option quote is bad (test on exit)
-                    if ( nullptr != fCallbackWithGreek ) {
-                      fCallbackWithGreek( pOption->LastGreek() ); // need to create the method
-                    }
-                  }
-                  catch ( std::runtime_error& e ) {
-                    std::cout << "Engine::ScanOptionEntryQueue runtime: " << e.what() << std::endl;
-                  }
-                  catch (...) {
-                    std::cout << "Engine::ScanOptionEntryQueue exception: unknown" << std::endl;
-                  }
-              });
-            }
-          }
-      });
-    });
+  const boost::posix_time::ptime dtUtcNow = ou::TimeSource::GlobalInstance().External();
+
+  static const size_t nBatchSize = 16;
+
+  using vBatch_t = std::vector<std::pair<pOptionEntry_t,double> >; // entry, underlying midpoint
+  vBatch_t vBatch;
+  vId_t vDeferred;
+
+  for ( const idEntry_t id: m_vCycle ) {
+    if ( m_vEntry.size() <= id ) continue;
+    pOptionEntry_t& pEntry( m_vEntry[ id ] );
+    if ( !pEntry ) continue; // removed since marked dirty
+    if ( pEntry->InFlight() ) {
+      vDeferred.push_back( id ); // stays dirty, picked up once the current calculation completes
+      continue;
+    }
+    const double dblUnderlying( pEntry->Dispatch() );
+    vBatch.emplace_back( pEntry, dblUnderlying );
+    if ( nBatchSize == vBatch.size() ) {
+      boost::asio::post( m_srvc, [this, dtUtcNow, vBatch_ = std::move( vBatch )]() mutable { Calc( std::move( vBatch_ ), dtUtcNow ); } );
+      vBatch = vBatch_t();
+    }
+  }
+  if ( !vBatch.empty() ) {
+    boost::asio::post( m_srvc, [this, dtUtcNow, vBatch_ = std::move( vBatch )]() mutable { Calc( std::move( vBatch_ ), dtUtcNow ); } );
+  }
+
+  if ( !vDeferred.empty() ) {
+    std::lock_guard<std::mutex> lock( m_mutexDirty );
+    m_vDirty.insert( m_vDirty.end(), vDeferred.begin(), vDeferred.end() );
+  }
+}
+
+// runs on the pool
+void Engine::Calc( std::vector<std::pair<pOptionEntry_t,double> >&& vBatch, ptime dtUtcNow ) {
+  for ( auto& [pEntry, dblUnderlying]: vBatch ) {
+    bool bCalculated( false );
+    if ( 0.0 < dblUnderlying ) {  // only start calculations once underlying has quotes
+      pOption_t pOption( pEntry->GetOption() );
+      try {
+        ou::tf::option::binomial::structInput input;
+        input.S = dblUnderlying;
+        pOption->CalcRate( input, dtUtcNow, m_InterestRateFeed );
+        pOption->CalcGreeks( input, dtUtcNow, true ); // TODO, don't proceed if option quote is bad (test on exit)
+        bCalculated = true;
+        fCallbackWithGreek_t& fCallbackWithGreek( pEntry->GetCallbackWithGreek() );
+        if ( nullptr != fCallbackWithGreek ) {
+          fCallbackWithGreek( pOption->LastGreek() );
+        }
+      }
+      catch ( std::runtime_error& e ) {
+        std::cout << "Engine::Calc runtime: " << e.what() << std::endl;
+      }
+      catch (...) {
+        std::cout << "Engine::Calc exception: unknown" << std::endl;
+      }
+    }
+    const int64_t nsLatency( pEntry->Complete() ); // clears in flight, calculated or not
+    if ( bCalculated ) {
+      m_nRecalc.fetch_add( 1, std::memory_order_relaxed );
+      m_nsLatencyTotal.fetch_add( nsLatency, std::memory_order_relaxed );
+      int64_t nsMax( m_nsLatencyMax.load( std::memory_order_relaxed ) );
+      while ( ( nsMax < nsLatency ) && !m_nsLatencyMax.compare_exchange_weak( nsMax, nsLatency, std::memory_order_relaxed ) ) {}
+    }
+  }
+  // entries deferred while this batch was in flight
+  bool bDirty;
+  {
+    std::lock_guard<std::mutex> lock( m_mutexDirty );
+    bDirty = !m_vDirty.empty();
+  }
+  if ( bDirty ) ScheduleCycle();
 }
 
 } // namespace option
@@ -22,14 +22,18 @@
 #ifndef ENGINE_H
 #define ENGINE_H
 
+#include <map>
 #include <queue>
 #include <mutex>
+#include <atomic>
 #include <chrono>
+#include <vector>
 #include <functional>
 #include <unordered_map>
 
 #include <boost/asio.hpp>
 #include <boost/thread.hpp>
+#include <boost/asio/strand.hpp>
 #include <boost/asio/steady_timer.hpp>
 
 #include <TFTimeSeries/DatedDatum.h>
@@ -49,51 +53,92 @@ namespace option { // options
 
 // ================ OptionEntry =================
 
+// an entry is marked dirty when the underlying or the option quote moves beyond the engine's tolerance
+//   relative to the inputs used by the last calculation, the engine only recalculates dirty entries
+
 class OptionEntry {
 public:
   using size_type = size_t;
+  using idEntry_t = uint32_t;
   using pWatch_t = ou::tf::Watch::pWatch_t;
   using pOption_t = Option::pOption_t;
   using fCallbackWithGreek_t = Option::fCallbackWithGreek_t;
-  using fCalc_t = std::function<void(pOption_t, const ou::tf::Quote&, fCallbackWithGreek_t&)>; // underlying quote
+  using fDirty_t = std::function<void(idEntry_t)>;
+
+  struct Tolerance {
+    double dblUnderlying; // relative move of the underlying midpoint
+    double dblOption;     // absolute move of the option midpoint
+    Tolerance(): dblUnderlying( 0.0001 ), dblOption( 0.005 ) {}
+  };
+
+  // the engine's copy, shared by its entries:  SetTolerance writes it while the quote callbacks read it
+  struct AtomicTolerance {
+    std::atomic<double> dblUnderlying;
+    std::atomic<double> dblOption;
+    AtomicTolerance(): AtomicTolerance( Tolerance() ) {}
+    explicit AtomicTolerance( const Tolerance& tolerance )
+    : dblUnderlying( tolerance.dblUnderlying ), dblOption( tolerance.dblOption ) {}
+    void Set( const Tolerance& tolerance ) {
+      dblUnderlying.store( tolerance.dblUnderlying, std::memory_order_relaxed );
+      dblOption.store( tolerance.dblOption, std::memory_order_relaxed );
+    }
+  };
 
 private:
   size_type m_cntInstances; // when pOption and pUnderlying are added in
-  //bool m_bStartedWatch; // needs to be based upon cntInstances
   pOption_t m_pOption;
   pWatch_t m_pUnderlying;
   fCallbackWithGreek_t m_fGreek;
 
-  ou::tf::Quote m_quoteLastUnderlying;
-  //ou::tf::Quote m_quoteLastOption;  // is this actually needed?
-  //double m_dblLastUnderlyingQuote;  // should these be atomic as well?  can doubles be atomic?
-  //double m_dblLastOptionQuote;
+  idEntry_t m_id;
+  fDirty_t m_fDirty;
+  const AtomicTolerance& m_tolerance;
+
+  // written from the quote callbacks, read by the engine
+  std::atomic<double> m_dblUnderlying;  // last non-zero underlying midpoint
+  std::atomic<double> m_dblOption;      // last option midpoint
+
+  // inputs of the last dispatched calculation, used for the tolerance test
+  std::atomic<double> m_dblUnderlyingAtCalc;
+  std::atomic<double> m_dblOptionAtCalc;
+
+  std::atomic<bool> m_bDirty;    // in the engine's dirty list
+  std::atomic<bool> m_bInFlight; // calculation posted to the pool, not yet complete
+  std::atomic<int64_t> m_nsDirty; // steady clock, when last marked dirty
+  std::atomic<int64_t> m_nsCalc;  // steady clock, when last calculated
 
 public:
 
-  OptionEntry(): m_cntInstances( 0 ) {};
-  //OptionEntry( pOption_t pOption);  // used for storing deletion aspect
+  OptionEntry( idEntry_t, pWatch_t pUnderlying_, pOption_t pOption_, const AtomicTolerance&, fDirty_t&& );
   OptionEntry( const OptionEntry& rhs ) = delete;
-  OptionEntry( OptionEntry&& rhs );
-
-  OptionEntry( pWatch_t pUnderlying_, pOption_t pOption_, fCallbackWithGreek_t&& fGreek_ );  // unused for now
-  OptionEntry( pWatch_t pUnderlying_, pOption_t pOption_ );
+  OptionEntry( OptionEntry&& rhs ) = delete;
   virtual ~OptionEntry();
 
   const std::string& OptionName() { return m_pOption->GetInstrument()->GetInstrumentName(); }
   const std::string& UnderlyingName() { return m_pUnderlying->GetInstrument()->GetInstrumentName(); }
 
+  idEntry_t Id() const { return m_id; }
+
   void Inc();
   size_t Dec();
 
-  void Calc( const fCalc_t& );  // supply underlying and option quotes
+  static int64_t Now() { return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count(); }
+
+  void MarkDirty();
+  // engine side:  Dispatch clears the dirty flag and records the inputs, returns the underlying midpoint
+  bool InFlight() const { return m_bInFlight.load( std::memory_order_acquire ); }
+  double Dispatch();
+  int64_t Complete(); // returns nanoseconds since marked dirty
+  int64_t LastCalc() const { return m_nsCalc.load( std::memory_order_relaxed ); }
 
   pWatch_t GetUnderlying() { return m_pUnderlying; }
   pOption_t GetOption() { return m_pOption; }
+  fCallbackWithGreek_t& GetCallbackWithGreek() { return m_fGreek; }
 
 private:
 
   void HandleUnderlyingQuote( const ou::tf::Quote& );
+  void HandleOptionQuote( const ou::tf::Quote& );
   void PrintState( const std::string id );
 
 };
@@ -103,27 +148,35 @@ private:
 class Engine {
 public:
 
-  // locking on the polling, rather than the callback from the quote
-  // allows full speed on the callbacks, and not time critical on the polling and locking
-  // continuous scanning?  1/10 sec scanning? once a second scanning?
-  // run with futures?
-  // need to loop through map on each scan
-  // need to lock the scan from add/deletions
-  // meed to queue additions and deletions with each scan (something like Delegate)
-  // prevents map iterators from being invalidated (check invalidation - invalidation does not occur on insertion )
-  // interleave add/delete  chronologically, so enum the operation.
+  // entries are held in a slot vector, addressed by an integer handle, (underlying, option) maps to the handle
+  // quote callbacks put the handle of a dirty entry in the dirty list and schedule a cycle
+  // a cycle, serialized on a strand:  drain the whole add/remove queue, then dispatch the dirty entries
+  //   to the pool in batches, an entry is never calculated twice at the same time
+  // the scan timer only refreshes entries whose greeks are older than the refresh interval (time decay)
 
   using pInstrument_t = ou::tf::Instrument::pInstrument_t;
   using pWatch_t = ou::tf::Watch::pWatch_t;
   using pOption_t = Option::pOption_t;
   using fCallbackWithGreek_t = OptionEntry::fCallbackWithGreek_t;
+  using Tolerance = OptionEntry::Tolerance;
 
   using fBuildWatch_t = std::function<pWatch_t(pInstrument_t)>;  // constructed elsewhere as it needs provider
   using fBuildOption_t = std::function<pOption_t(pInstrument_t)>;  // constructed elsewhere as it needs provider
 
+  struct Stats {
+    size_t nEntries;
+    size_t nOperationQueueDepth;     // add/remove waiting for a cycle
+    size_t nOperationQueueDepthMax;
+    size_t nDirty;                   // entries waiting for a cycle
+    size_t nDirtyMax;
+    uint64_t nRecalc;                // calculations completed, not counting entries without an underlying quote
+    double dblLatencyAvgMs;          // marked dirty to greek callback
+    double dblLatencyMaxMs;
+  };
+
   //Engine( const ou::tf::LiborFromIQFeed& );
   //Engine( const ou::tf::FedRateFromIQFeed& );
-  Engine( const ou::tf::NoRiskInterestRateSeries& );
+  Engine( const ou::tf::NoRiskInterestRateSeries&, size_t nThreads = 1 ); // a larger pool is opt in, 0 is taken as 1
   virtual ~Engine( );
 
   // these register the underlying, an option, or both [may deprecate the Find functions)
@@ -141,23 +194,32 @@ public:
   fBuildOption_t m_fBuildOption;
   pOption_t FindOption( const pInstrument_t pInstrument );  // if Option not found, construct one.  Then provide the option.
 
+  void SetTolerance( const Tolerance& tolerance ) { m_tolerance.Set( tolerance ); } // applies to subsequent quotes, callable while running
+  void SetRefreshInterval( std::chrono::seconds secs ) { m_nsRefresh.store( std::chrono::nanoseconds( secs ).count(), std::memory_order_relaxed ); }
+
+  Stats GetStats();
 
 private:
 
   enum Action { Unknown, AddOption, RemoveOption };
 
   using idInstrument_t = ou::tf::Instrument::idInstrument_t;
+  using idEntry_t = OptionEntry::idEntry_t;
+  using pOptionEntry_t = std::shared_ptr<OptionEntry>;
 
   using mapKnownWatches_t = std::unordered_map<idInstrument_t, pWatch_t>;
   using mapKnownOptions_t = std::unordered_map<idInstrument_t, pOption_t>;
-  using mapOptionEntry_t  = std::unordered_map<idInstrument_t, OptionEntry>;
+  using keyEntry_t = std::pair<const ou::tf::Watch*, const ou::tf::Watch*>; // underlying, option
+  using mapEntry_t = std::map<keyEntry_t, idEntry_t>;
+  using vEntry_t = std::vector<pOptionEntry_t>; // indexed by idEntry_t, nullptr for a free slot
+  using vId_t = std::vector<idEntry_t>;
 
-  //std::atomic<size_t> m_cntOptionEntryOperationQueueCount;
   std::mutex m_mutexOptionEntryOperationQueue;
 
   boost::asio::io_context m_srvc;
   boost::thread_group m_threads;
   boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_srvcWork;
+  boost::asio::strand<boost::asio::io_context::executor_type> m_strandCycle;
   boost::asio::steady_timer m_timerScan;
 
   //const LiborFromIQFeed& m_InterestRateFeed;
@@ -166,25 +228,45 @@ private:
 
   struct OptionEntryOperation {
     Action m_action;
-    OptionEntry m_oe;
-    OptionEntryOperation(): m_action( Action::Unknown ) {}
-    OptionEntryOperation( Action action, OptionEntry&& oe ): m_action( action ), m_oe( std::move( oe ) ) {}
-    OptionEntryOperation( const OptionEntryOperation& rhs ) = delete;
-    OptionEntryOperation( OptionEntryOperation&& rhs ): m_action( rhs.m_action ), m_oe( std::move( rhs.m_oe ) ) {}
-    virtual ~OptionEntryOperation() {}
+    pOption_t m_pOption;
+    pWatch_t m_pUnderlying;
+    OptionEntryOperation( Action action, pOption_t pOption, pWatch_t pUnderlying )
+    : m_action( action ), m_pOption( std::move( pOption ) ), m_pUnderlying( std::move( pUnderlying ) ) {}
   };
 
   using dequeOptionEntryOperation_t = std::deque<OptionEntryOperation>;
 
   dequeOptionEntryOperation_t m_dequeOptionEntryOperation;
+  size_t m_nOperationQueueDepthMax;
 
   mapKnownWatches_t m_mapKnownWatches;
   mapKnownOptions_t m_mapKnownOptions;
-  mapOptionEntry_t m_mapOptionEntry;
+
+  // owned by the cycle strand
+  mapEntry_t m_mapEntry;
+  vEntry_t m_vEntry;
+  vId_t m_vFreeEntry;
+  vId_t m_vCycle; // dirty list being processed
+  std::atomic<size_t> m_nEntries;
+
+  OptionEntry::AtomicTolerance m_tolerance;
+  std::atomic<int64_t> m_nsRefresh;
+
+  std::mutex m_mutexDirty;
+  vId_t m_vDirty;
+  size_t m_nDirtyMax;
+  std::atomic<bool> m_bCycleScheduled;
+
+  std::atomic<uint64_t> m_nRecalc;
+  std::atomic<int64_t> m_nsLatencyTotal;
+  std::atomic<int64_t> m_nsLatencyMax;
 
   void HandleTimerScan( const boost::system::error_code &ec );
   void ProcessOptionEntryOperationQueue();
-  void ScanOptionEntryQueue();
+  void MarkDirty( idEntry_t );
+  void ScheduleCycle();
+  void Cycle();
+  void Calc( std::vector<std::pair<pOptionEntry_t,double> >&& vBatch, ptime dtUtcNow );
 
 };
 
@@ -169,9 +169,9 @@ void IvAtm::UpdateATMWatch( double dblUnderlying ) {
       case EOWSNoWatch:
         break;
       case EOWSWatching:
-        m_iterUpper->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
-        m_iterMid  ->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
-        m_iterLower->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
+        m_iterUpper->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption, m_constructed );
+        m_iterMid  ->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption, m_constructed );
+        m_iterLower->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption, m_constructed );
         break;
     }
     break;
@@ -186,9 +186,9 @@ void IvAtm::UpdateATMWatch( double dblUnderlying ) {
         case EOWSNoWatch: 
           break;
         case EOWSWatching:
-          m_iterUpper->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
-          m_iterMid  ->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
-          m_iterLower->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
+          m_iterUpper->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption, m_constructed );
+          m_iterMid  ->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption, m_constructed );
+          m_iterLower->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption, m_constructed );
           break;
       }
       iterUpper->second.Stop( m_fStopCalc, m_pWatchUnderlying );
@@ -207,39 +207,13 @@ void IvAtm::CalcIvAtm( ptime dtNow, fOnPriceIV_t& fOnPriceIV ) {
   double dblUnderlying = CurrentUnderlying();
   
   UpdateATMWatch( dblUnderlying );
+  m_constructed.Drain( m_smile ); // options constructed since the last call
 
   switch ( m_stateOptionWatch ) {
     case EOWSWatching:
-      if ( dblUnderlying == m_iterMid->first ) {
-        dblIvCall = m_iterMid->second.pCall->ImpliedVolatility();
-        dblIvPut = m_iterMid->second.pPut->ImpliedVolatility();
-      }
-      else {
-        if ( dblUnderlying > m_iterMid->first ) { // linear interpolation
-          double ratio = ( dblUnderlying - m_iterMid->first ) / ( m_iterUpper->first - m_iterMid->first );
-
-          double iv1, iv2;
-          iv1 = m_iterMid->second.pCall->ImpliedVolatility();
-          iv2 = m_iterUpper->second.pCall->ImpliedVolatility();
-          dblIvCall = iv1 + ( iv2 - iv1 ) * ratio; 
-
-          iv1 = m_iterMid->second.pPut->ImpliedVolatility();
-          iv2 = m_iterUpper->second.pPut->ImpliedVolatility();
-          dblIvPut = iv1 + ( iv2 - iv1 ) * ratio; 
-        }
-        else { // linear interpolation
-          double ratio = ( dblUnderlying - m_iterLower->first ) / ( m_iterMid->first - m_iterLower->first );
-
-          double iv1, iv2;
-          iv1 = m_iterLower->second.pCall->ImpliedVolatility();
-          iv2 = m_iterMid->second.pCall->ImpliedVolatility();
-          dblIvCall = iv1 + ( iv2 - iv1 ) * ratio; 
-
-          iv1 = m_iterLower->second.pPut->ImpliedVolatility();
-          iv2 = m_iterMid->second.pPut->ImpliedVolatility();
-          dblIvPut = iv1 + ( iv2 - iv1 ) * ratio; 
-        }
-      }
+      // the watched strikes bracket the underlying, so the smile interpolates between the same pair as before
+      dblIvCall = m_smile.Interpolate( dblUnderlying, ou::tf::OptionSide::Call );
+      dblIvPut = m_smile.Interpolate( dblUnderlying, ou::tf::OptionSide::Put );
       PriceIV ivATM( dtNow, dblUnderlying, dblIvCall, dblIvPut);
       m_tsIvAtm.Append( ivATM );
       //m_bfIVUnderlyingCall.Add( now, dblIvCall, 0 );
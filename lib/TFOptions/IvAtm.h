@@ -23,11 +23,15 @@
 
 #include <map>
 #include <tuple>
+#include <mutex>
 #include <string>
+#include <vector>
 #include <functional>
 
 #include <TFOptions/Option.h>
 
+#include "Smile.h"
+
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 namespace option { // options
@@ -68,12 +72,32 @@ public:
 
   void CalcIvAtm( ptime dtNow, fOnPriceIV_t& );
 
+  const Smile& GetSmile() const { return m_smile; } // volatilities of the options started so far, query on the CalcIvAtm thread
+
   void EmitValues( void );
   void SaveSeries( const std::string& sPrefix60sec, const std::string& sPrefix86400sec );
 
 protected:
 private:
 
+  // options are constructed on the caller's thread, CalcIvAtm adds them to the smile on its own, between queries
+  struct Constructed {
+    std::mutex mutex;
+    std::vector<pOption_t> vOption;
+    void Push( pOption_t pOption ) {
+      std::lock_guard<std::mutex> lock( mutex );
+      vOption.push_back( std::move( pOption ) );
+    }
+    void Drain( Smile& smile ) {
+      std::vector<pOption_t> v;
+      {
+        std::lock_guard<std::mutex> lock( mutex );
+        v.swap( vOption );
+      }
+      for ( pOption_t& pOption: v ) smile.Add( pOption );
+    }
+  };
+
   struct OptionsAtStrike {
     typedef ou::tf::option::Option::pOption_t pOption_t;
     std::string sCall;
@@ -90,21 +114,23 @@ private:
       bStarted( rhs.bStarted )
     { }
 
-    void Start( fStartCalc_t& fStart, pWatch_t pWatchUnderlying, fConstructOption_t& fConstruct ) {
+    void Start( fStartCalc_t& fStart, pWatch_t pWatchUnderlying, fConstructOption_t& fConstruct, Constructed& constructed ) {
       assert( !bStarted );
 
       pInstrument_t pInstrumentUnderlying = pWatchUnderlying->GetInstrument();
 
       if ( nullptr == pCall.get() ) {
-        fConstruct( sCall, pInstrumentUnderlying, [this,pWatchUnderlying,fStart](pOption_t pOption){
+        fConstruct( sCall, pInstrumentUnderlying, [this,pWatchUnderlying,fStart,&constructed](pOption_t pOption){
           pCall = pOption;
+          constructed.Push( pCall );
           fStart( pCall, pWatchUnderlying );
         } );
       }
 
       if ( nullptr == pPut.get() ) {
-        fConstruct( sPut, pInstrumentUnderlying, [this,pWatchUnderlying,fStart](pOption_t pOption){
+        fConstruct( sPut, pInstrumentUnderlying, [this,pWatchUnderlying,fStart,&constructed](pOption_t pOption){
           pPut = pOption;
+          constructed.Push( pPut );
          fStart( pPut, pWatchUnderlying );
         } );
       }
@@ -149,6 +175,9 @@ private:
 
   ou::tf::PriceIVs m_tsIvAtm;
 
+  Smile m_smile;
+  Constructed m_constructed;
+
   double CurrentUnderlying() const { return m_pWatchUnderlying->LastQuote().Midpoint(); }
 
   tupleAdjacentStrikes_t FindAdjacentStrikes() const;
@@ -150,10 +150,17 @@ void Option::CalcGreeks( // TODO: need to not calc if quote is bad
   // todo: use the haskell book to get an estimator
   // Manaster and Koehler Start Value, Option Pricing Formulas, pg 454
   if ( bNeedsGuess ) {
-//  double dblVolatilityGuess = dblVolHistorical / 100.0;
-//  input.v = dblVolatilityGuess;
-    double dblVolatilityGuess = std::sqrt( std::abs( std::log( input.S / input.X ) + input.r * input.T ) * 2.0 / input.T );
-    input.v = dblVolatilityGuess;
+    // warm start:  the previous solution is normally within a step or two of the new one
+    const double dblVolatilityLast( m_greek.ImpliedVolatility() );
+    if ( 0.0 < dblVolatilityLast ) {
+      input.v = dblVolatilityLast;
+    }
+    else {
+//    double dblVolatilityGuess = dblVolHistorical / 100.0;
+//    input.v = dblVolatilityGuess;
+      double dblVolatilityGuess = std::sqrt( std::abs( std::log( input.S / input.X ) + input.r * input.T ) * 2.0 / input.T );
+      input.v = dblVolatilityGuess;
+    }
   }
 
 //  std::cout << "Guess " << input.v << std::endl;
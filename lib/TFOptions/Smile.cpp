@@ -0,0 +1,144 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Smile.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFOptions
+ * Created: 2026/10/16 19:40:12
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "Smile.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace option { // options
+
+Smile::Leg& Smile::Strike::Side( ou::tf::OptionSide::EOptionSide side ) {
+  switch ( side ) {
+    case ou::tf::OptionSide::Call:
+      return call;
+    case ou::tf::OptionSide::Put:
+      return put;
+    default:
+      throw std::runtime_error( "Smile::Strike::Side: unknown option side" );
+  }
+}
+
+Smile::Smile()
+: m_ixHint {}
+{}
+
+Smile::~Smile() {
+  for ( pStrike_t& pStrike: m_vStrike ) {
+    for ( Leg* pLeg: { &pStrike->call, &pStrike->put } ) {
+      if ( pLeg->pOption ) {
+        pLeg->pOption->OnGreek.Remove( MakeDelegate( pLeg, &Leg::HandleGreek ) );
+        pLeg->pOption.reset();
+      }
+    }
+  }
+  m_vStrike.clear();
+}
+
+Smile::Strike& Smile::Find( double strike ) {
+  vStrike_t::iterator iter = std::lower_bound(
+    m_vStrike.begin(), m_vStrike.end(), strike,
+    []( const pStrike_t& pStrike, double strike ){ return pStrike->strike < strike; } );
+  if ( ( m_vStrike.end() == iter ) || ( strike != (*iter)->strike ) ) {
+    iter = m_vStrike.insert( iter, std::make_unique<Strike>( strike ) );
+  }
+  return **iter;
+}
+
+void Smile::Add( pOption_t pOption ) {
+  assert( pOption );
+  Leg& leg( Find( pOption->GetStrike() ).Side( pOption->GetOptionSide() ) );
+  if ( leg.pOption ) {
+    throw std::runtime_error( "Smile::Add: strike already has an option - " + pOption->GetInstrumentName() );
+  }
+  leg.pOption = pOption;
+  leg.iv.store( pOption->ImpliedVolatility(), std::memory_order_relaxed );
+  pOption->OnGreek.Add( MakeDelegate( &leg, &Leg::HandleGreek ) );
+}
+
+void Smile::Remove( pOption_t pOption ) {
+  assert( pOption );
+  Leg& leg( Find( pOption->GetStrike() ).Side( pOption->GetOptionSide() ) );
+  if ( leg.pOption != pOption ) {
+    throw std::runtime_error( "Smile::Remove: option not found - " + pOption->GetInstrumentName() );
+  }
+  pOption->OnGreek.Remove( MakeDelegate( &leg, &Leg::HandleGreek ) );
+  leg.pOption.reset();
+  leg.iv.store( 0.0, std::memory_order_relaxed );
+}
+
+size_t Smile::Bracket( double price ) const {
+  const size_t n( m_vStrike.size() );
+  if ( 2 > n ) return n;
+  if ( ( price < m_vStrike.front()->strike ) || ( price > m_vStrike.back()->strike ) ) return n;
+  size_t ix = std::min( m_ixHint.load( std::memory_order_relaxed ), n - 2 );
+  while ( price < m_vStrike[ ix ]->strike ) --ix;
+  while ( m_vStrike[ ix + 1 ]->strike < price ) ++ix;
+  m_ixHint.store( ix, std::memory_order_relaxed );
+  return ix;
+}
+
+Smile::Strike* Smile::Exact( double strike ) const {
+  const size_t n( m_vStrike.size() );
+  if ( 1 == n ) { // no pair to bracket with
+    return ( strike == m_vStrike.front()->strike ) ? m_vStrike.front().get() : nullptr;
+  }
+  const size_t ix( Bracket( strike ) );
+  if ( n != ix ) {
+    for ( size_t ixStrike: { ix, ix + 1 } ) {
+      if ( strike == m_vStrike[ ixStrike ]->strike ) {
+        return m_vStrike[ ixStrike ].get();
+      }
+    }
+  }
+  return nullptr;
+}
+
+void Smile::Update( double strike, ou::tf::OptionSide::EOptionSide side, double iv ) {
+  Strike* pStrike( Exact( strike ) );
+  if ( nullptr == pStrike ) {
+    throw std::runtime_error( 2 > m_vStrike.size() ? "Smile::Update: not enough strikes" : "Smile::Update: strike not found" );
+  }
+  pStrike->Side( side ).iv.store( iv, std::memory_order_relaxed );
+}
+
+double Smile::IV( double strike, ou::tf::OptionSide::EOptionSide side ) const {
+  const Strike* pStrike( Exact( strike ) );
+  return ( nullptr == pStrike ) ? 0.0 : pStrike->Side( side ).iv.load( std::memory_order_relaxed );
+}
+
+double Smile::Interpolate( double price, ou::tf::OptionSide::EOptionSide side ) const {
+  const size_t ix( Bracket( price ) );
+  if ( m_vStrike.size() == ix ) return 0.0;
+  const Strike& lower( *m_vStrike[ ix ] );
+  const Strike& upper( *m_vStrike[ ix + 1 ] );
+  const double iv1( lower.Side( side ).iv.load( std::memory_order_relaxed ) );
+  const double iv2( upper.Side( side ).iv.load( std::memory_order_relaxed ) );
+  if ( ( 0.0 == iv1 ) || ( 0.0 == iv2 ) ) return 0.0;
+  const double ratio = ( price - lower.strike ) / ( upper.strike - lower.strike );
+  return iv1 + ( iv2 - iv1 ) * ratio;
+}
+
+} // namespace option
+} // namespace tf
+} // namespace ou
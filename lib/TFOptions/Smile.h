@@ -0,0 +1,99 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Smile.h
+ * Author:  raymond@burkholder.net
+ * Project: TFOptions
+ * Created: 2026/10/16 19:40:12
+ */
+
+// implied volatility by strike for a single expiry
+//   options are attached with Add, each greek emitted by an option updates its strike in place
+//   strikes are set up with Add/Remove, which insert into the strike vector, so they run on the
+//   thread which queries, the volatilities are atomics, so queries may run concurrently with the
+//   greek calculations
+//   queries start from the strike found by the previous query, with a slowly moving underlying
+//   the lookup is a step or two, rather than a search
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Option.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace option { // options
+
+class Smile {
+public:
+
+  using pOption_t = Option::pOption_t;
+
+  Smile();
+  Smile( const Smile& ) = delete;
+  Smile( Smile&& ) = delete;
+  ~Smile();
+
+  void Add( pOption_t );    // attaches to the option's greek updates
+  void Remove( pOption_t );
+
+  // for volatilities calculated elsewhere, strike must exist, throws otherwise
+  void Update( double strike, ou::tf::OptionSide::EOptionSide, double iv );
+
+  size_t Size() const { return m_vStrike.size(); }
+
+  // 0.0 when not yet available
+  double IV( double strike, ou::tf::OptionSide::EOptionSide ) const;
+  // linear interpolation between the strikes bracketing price, 0.0 when outside the strikes or not available
+  double Interpolate( double price, ou::tf::OptionSide::EOptionSide ) const;
+
+protected:
+private:
+
+  struct Leg {
+    std::atomic<double> iv;
+    pOption_t pOption;
+    Leg(): iv {} {}
+    void HandleGreek( const ou::tf::Greek& greek ) {
+      iv.store( greek.ImpliedVolatility(), std::memory_order_relaxed );
+    }
+  };
+
+  struct Strike {
+    const double strike;
+    Leg call;
+    Leg put;
+    Strike( double strike_ ): strike( strike_ ) {}
+    Leg& Side( ou::tf::OptionSide::EOptionSide );
+    const Leg& Side( ou::tf::OptionSide::EOptionSide side ) const { return const_cast<Strike*>( this )->Side( side ); }
+  };
+
+  using pStrike_t = std::unique_ptr<Strike>;
+  using vStrike_t = std::vector<pStrike_t>; // ascending by strike, Strike itself does not move
+  vStrike_t m_vStrike;
+
+  mutable std::atomic<size_t> m_ixHint; // lower of the two strikes used by the previous query
+
+  size_t Bracket( double price ) const; // ix such that strike[ix] <= price < strike[ix+1], or Size()
+  Strike* Exact( double strike ) const; // nullptr when strike is not in the smile
+  Strike& Find( double strike ); // creates when missing
+};
+
+} // namespace option
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,216 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    BacktestRunner.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFSimulation
+ * Created: 2026/10/16 22:51:40
+ */
+
+#include <chrono>
+#include <thread>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/thread/thread.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+
+#include <OUCommon/TimeSource.h>
+
+#include <TFTrading/OrderManager.h>
+
+#include "BacktestRunner.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+namespace {
+
+// the session's own instances, assigned to whichever thread is running the session
+class Instances {
+public:
+  Instances()
+  : m_pTimeSource( new ou::TimeSource )
+  , m_pOrderManager( new ou::tf::OrderManager )
+  {}
+  void Assign() {
+    ou::TimeSource::SetLocalCommonInstance( m_pTimeSource.get() );
+    ou::tf::OrderManager::SetLocalCommonInstance( m_pOrderManager.get() );
+  }
+  void Release() { // the instances are owned here, not by the thread
+    ou::TimeSource::ReleaseLocalCommonInstance();
+    ou::tf::OrderManager::ReleaseLocalCommonInstance();
+  }
+private:
+  std::unique_ptr<ou::TimeSource> m_pTimeSource;
+  std::unique_ptr<ou::tf::OrderManager> m_pOrderManager;
+};
+
+} // namespace anonymous
+
+BacktestRunner::BacktestRunner( size_t nThreads )
+: m_nThreads( nThreads )
+{
+  if ( 0 == m_nThreads ) {
+    m_nThreads = std::max<size_t>( 1, std::thread::hardware_concurrency() );
+  }
+}
+
+BacktestRunner::~BacktestRunner() {}
+
+void BacktestRunner::Add( const std::string& sName, const std::string& sGroupDirectory, fSetup_t&& fSetup, fTeardown_t&& fTeardown ) {
+  assert( nullptr != fSetup );
+  m_vSession.emplace_back( Session { sName, sGroupDirectory, std::move( fSetup ), std::move( fTeardown ) } );
+}
+
+BacktestRunner::vResult_t BacktestRunner::Run() {
+
+  vSession_t vSession;
+  vSession.swap( m_vSession );
+  vResult_t vResult( vSession.size() );
+
+  ou::TimeSource::GlobalInstance(); // the time zone database is loaded once, before the sessions construct their own
+
+  const SingletonBase::ELocalCommonInstanceSource_t source( SingletonBase::GetLocalCommonInstanceSource() );
+  SingletonBase::SetLocalCommonInstanceSource( SingletonBase::Assigned );
+
+  {
+    boost::asio::io_context srvc;
+    boost::thread_group threads;
+    {
+      auto work = boost::asio::make_work_guard( srvc ); // keep things running while the sessions are posted
+      for ( size_t ix = 0; ix < std::min( m_nThreads, vSession.size() ); ix++ ) {
+        threads.create_thread( [&srvc](){ srvc.run(); } );
+      }
+      for ( vSession_t::size_type ix = 0; ix < vSession.size(); ix++ ) {
+        boost::asio::post( srvc, [&vSession, &vResult, ix](){ RunSession( vSession[ ix ], vResult[ ix ] ); } );
+      }
+    }
+    threads.join_all(); // the threads finish once the posted sessions have run
+  }
+
+  SingletonBase::SetLocalCommonInstanceSource( source );
+
+  return vResult;
+}
+
+void BacktestRunner::RunSession( Session& session, Result& result ) {
+
+  using clock = std::chrono::steady_clock;
+  const clock::time_point start( clock::now() );
+
+  result.sName = session.sName;
+
+  Instances instances;
+  instances.Assign();
+
+  SimulationProvider::OnSimulationThreadStarted_t fAssign( &instances, &Instances::Assign );
+  SimulationProvider::OnSimulationThreadEnded_t fRelease( &instances, &Instances::Release );
+
+  try {
+    Context context( session.sName );
+
+    context.pProvider = SimulationProvider::Factory();
+    context.pProvider->SetGroupDirectory( session.sGroupDirectory );
+    context.pProvider->SetOnSimulationThreadStarted( fAssign ); // the merge runs on a thread of its own
+    context.pProvider->SetOnSimulationThreadEnded( fRelease );
+    context.pProvider->Connect();
+
+    context.pPortfolio = std::make_shared<Portfolio>(
+      session.sName, "", "", Portfolio::Standard, Currency::Name[ Currency::USD ], "backtest" );
+
+    session.fSetup( context );
+
+    context.pProvider->Run( false );  // returns upon completion of simulation
+
+    if ( nullptr != session.fTeardown ) session.fTeardown( context );
+
+    result.nDatums = context.pProvider->GetCountProcessedDatums();
+    context.pPortfolio->QueryStats( result.dblUnRealized, result.dblRealized, result.dblCommissions, result.dblTotal );
+    result.bOk = true;
+
+    context.pProvider->Disconnect();
+    context.pStrategy.reset();
+  }
+  catch ( const std::exception& e ) {
+    result.sError = e.what();
+    std::cout << "BacktestRunner session " << session.sName << ": " << e.what() << std::endl;
+  }
+
+  instances.Release();
+
+  result.dblSeconds = std::chrono::duration<double>( clock::now() - start ).count();
+}
+
+void BacktestRunner::Summary( const vResult_t& vResult, std::ostream& os ) {
+
+  os
+    << std::left << std::setw( 24 ) << "session" << std::right
+    << std::setw( 12 ) << "datums"
+    << std::setw( 10 ) << "seconds"
+    << std::setw( 12 ) << "realized"
+    << std::setw( 12 ) << "unrealized"
+    << std::setw( 12 ) << "commission"
+    << std::setw( 12 ) << "total"
+    << std::endl;
+
+  Result sum;
+  size_t nFailed {};
+  for ( const Result& result: vResult ) {
+    os << std::left << std::setw( 24 ) << result.sName << std::right;
+    if ( result.bOk ) {
+      os
+        << std::setw( 12 ) << result.nDatums
+        << std::fixed << std::setprecision( 2 )
+        << std::setw( 10 ) << result.dblSeconds
+        << std::setw( 12 ) << result.dblRealized
+        << std::setw( 12 ) << result.dblUnRealized
+        << std::setw( 12 ) << result.dblCommissions
+        << std::setw( 12 ) << result.dblTotal
+        << std::endl;
+      sum.nDatums += result.nDatums;
+      sum.dblSeconds += result.dblSeconds;
+      sum.dblRealized += result.dblRealized;
+      sum.dblUnRealized += result.dblUnRealized;
+      sum.dblCommissions += result.dblCommissions;
+      sum.dblTotal += result.dblTotal;
+    }
+    else {
+      nFailed++;
+      os << "  failed: " << result.sError << std::endl;
+    }
+  }
+
+  os
+    << std::left << std::setw( 24 ) << "total" << std::right
+    << std::setw( 12 ) << sum.nDatums
+    << std::fixed << std::setprecision( 2 )
+    << std::setw( 10 ) << sum.dblSeconds
+    << std::setw( 12 ) << sum.dblRealized
+    << std::setw( 12 ) << sum.dblUnRealized
+    << std::setw( 12 ) << sum.dblCommissions
+    << std::setw( 12 ) << sum.dblTotal
+    << std::endl;
+  if ( 0 < nFailed ) {
+    os << nFailed << " of " << vResult.size() << " sessions failed" << std::endl;
+  }
+}
+
+} // namespace tf
+} // namespace ou
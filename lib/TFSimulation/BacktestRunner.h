@@ -0,0 +1,109 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    BacktestRunner.h
+ * Author:  raymond@burkholder.net
+ * Project: TFSimulation
+ * Created: 2026/10/16 22:51:40
+ */
+
+// runs a set of independent simulations concurrently, one per group directory / parameter set
+//   each session has its own SimulationProvider, Portfolio, and its own TimeSource and OrderManager,
+//   assigned as the LocalCommonInstance on the threads running the session (see Singleton.h)
+//   so simulated time and order flow of one session are not seen by another
+// generalizes the approach in OptimizeStrategy/StrategyWrapper
+// during Run, LocalCommonInstance is in Assigned mode for the whole process:  other threads making use
+//   of TimeSource/OrderManager LocalCommonInstance need their own assignment
+// hdf5 reads are serialized through HDF5Mutex, preloaded series (the default) keep that to the session setup
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <functional>
+
+#include <TFTrading/Portfolio.h>
+
+#include "SimulationProvider.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+class BacktestRunner {
+public:
+
+  using pProvider_t = SimulationProvider::pProvider_t;
+  using pPortfolio_t = Portfolio::pPortfolio_t;
+
+  // available to the session's callbacks, all of it private to the session
+  struct Context {
+    const std::string& sName;
+    pProvider_t pProvider;   // connected, data and execution
+    pPortfolio_t pPortfolio; // positions of the session are added here for the summary
+    std::shared_ptr<void> pStrategy; // optional, kept for the length of the session, released on the session's thread
+    Context( const std::string& sName_ ): sName( sName_ ) {}
+  };
+
+  // fSetup: construct watches, positions and strategy, called on the session's thread before the run
+  // fTeardown: optional, called after the run, before the portfolio is summarized, ie to close positions
+  using fSetup_t = std::function<void(Context&)>;
+  using fTeardown_t = std::function<void(Context&)>;
+
+  struct Result {
+    std::string sName;
+    bool bOk;
+    std::string sError;
+    unsigned long nDatums;
+    double dblSeconds;  // wall clock, setup through teardown
+    double dblRealized;
+    double dblUnRealized;
+    double dblCommissions;
+    double dblTotal;
+    Result(): bOk( false ), nDatums {}, dblSeconds {}, dblRealized {}, dblUnRealized {}, dblCommissions {}, dblTotal {} {}
+  };
+  using vResult_t = std::vector<Result>;
+
+  BacktestRunner( size_t nThreads = 0 ); // 0: one per hardware thread
+  ~BacktestRunner();
+
+  void Add( const std::string& sName, const std::string& sGroupDirectory, fSetup_t&&, fTeardown_t&& = nullptr );
+
+  // blocks until every session has completed, results are in the order sessions were added
+  // sessions are consumed, the runner can be re-used
+  vResult_t Run();
+
+  static void Summary( const vResult_t&, std::ostream& );
+
+protected:
+private:
+
+  struct Session {
+    std::string sName;
+    std::string sGroupDirectory;
+    fSetup_t fSetup;
+    fTeardown_t fTeardown;
+  };
+  using vSession_t = std::vector<Session>;
+
+  size_t m_nThreads;
+  vSession_t m_vSession;
+
+  static void RunSession( Session&, Result& );
+};
+
+} // namespace tf
+} // namespace ou
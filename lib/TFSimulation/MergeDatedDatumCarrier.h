@@ -19,6 +19,7 @@
 #include <OUCommon/FastDelegate.h>
 using namespace fastdelegate;
 
+#include <OUCommon/Timestamp.h>
 #include <OUCommon/TimeSource.h>
 
 #include <TFTimeSeries/TimeSeries.h>
@@ -26,6 +27,7 @@ using namespace fastdelegate;
 // Each carrier holds a TimeSeries.  The carrier holds an index to the current DatedDatum in each TimeSeries.
 // The current DatedDatum timestamp is maintained for the merge process to figure out which DatedDatum to
 // send into the merge process
+// The heap compares the integer m_ts, converted once per datum, rather than the ptime
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -44,13 +46,20 @@ public:
     { throw std::runtime_error( "Reset not defined" ); };
   inline const ptime &GetDateTime() { return m_dt; };
   const DatedDatum* GetDatedDatum() const { return m_pDatum; };
-  bool operator<( const MergeCarrierBase& other ) const { return m_dt < other.m_dt; };
-  bool operator<( const MergeCarrierBase* pOther ) const { return m_dt < pOther->m_dt; };
-  static bool lt( MergeCarrierBase* plhs, MergeCarrierBase *prhs ) { return plhs->m_dt < prhs->m_dt; };
+  bool operator<( const MergeCarrierBase& other ) const { return m_ts < other.m_ts; };
+  bool operator<( const MergeCarrierBase* pOther ) const { return m_ts < pOther->m_ts; };
+  static bool lt( MergeCarrierBase* plhs, MergeCarrierBase *prhs ) { return plhs->m_ts < prhs->m_ts; };
 protected:
-  ptime m_dt;  // datetime of datum to be merged (used in comparison)
+  ptime m_dt;  // datetime of datum to be merged
+  ou::Timestamp m_ts; // m_dt as integer, used in comparison
   const DatedDatum* m_pDatum;
   OnDatumHandler OnDatum;
+  void SetDateTime() {
+    m_dt = ( nullptr == m_pDatum )
+      ? boost::date_time::special_values::not_a_date_time
+      : m_pDatum->DateTime();
+    m_ts = ou::Timestamp( m_dt );
+  }
 private:
 };
 
@@ -76,9 +85,7 @@ MergeCarrier<T>::MergeCarrier( TimeSeries<T>& series, OnDatumHandler function )
   assert( 0 != m_series.Size() );
   OnDatum = function;
   m_pDatum = m_series.First();  // preload with first datum so we have it's time available for comparison
-  m_dt = ( 0 == m_pDatum )
-    ? boost::date_time::special_values::not_a_date_time
-    : m_pDatum->DateTime();
+  SetDateTime();
 }
 
 template<class T>
@@ -93,17 +100,13 @@ void MergeCarrier<T>::ProcessDatum() {
   if ( nullptr != OnDatum )
     OnDatum( *m_pDatum );
   m_pDatum = m_series.Next();
-  m_dt = ( nullptr == m_pDatum )
-    ? boost::date_time::special_values::not_a_date_time
-    : m_pDatum->DateTime();
+  SetDateTime();
 }
 
 template<class T>
 void MergeCarrier<T>::Reset() {
   m_pDatum = m_series.First();  // preload with first datum so we have it's time available for comparison
-  m_dt = ( 0 == m_pDatum )
-    ? boost::date_time::special_values::not_a_date_time
-    : m_pDatum->DateTime();
+  SetDateTime();
 }
 
 } // namespace tf
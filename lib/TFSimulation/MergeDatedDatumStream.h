@@ -0,0 +1,177 @@
+/************************************************************************
+ * Copyright(c) 2009, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ * without even the implied warranty of                                 *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                 *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include <future>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesAccessor.h>
+
+#include "MergeDatedDatumCarrier.h"
+
+// MergeCarrierStream is the streaming alternative to MergeCarrier:  rather than a preloaded TimeSeries,
+//   the carrier reads the dataset in fixed size hyperslab chunks, two chunks resident at a time:
+//   the chunk being merged, and the next chunk, which is read on a background task
+// the first chunk is read in the constructor, so the first datum is available as soon as the carrier exists
+// the serial hdf5 library is not thread safe, all hdf5 calls made by the stream carriers are serialized
+//   through HDF5Mutex(), as are the preloads in SimulationSymbol, so simulations may run in parallel,
+//   other hdf5 access should not overlap a streamed run
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+inline std::mutex& HDF5Mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+template<class T> // T is a DatedDatum type
+class MergeCarrierStream: public MergeCarrierBase {
+  friend class MergeDatedDatums;
+public:
+
+  using size_type = hsize_t;
+  static constexpr size_type nDefaultChunkSize = 64 * 1024; // elements
+
+  MergeCarrierStream( const std::string& sPath, OnDatumHandler function, size_type nChunkSize = nDefaultChunkSize );
+  virtual ~MergeCarrierStream();
+
+  void ProcessDatum();
+  void Reset();
+
+  size_type Size() const { return m_nElements; }
+
+protected:
+private:
+
+  using vDatum_t = std::vector<T>;
+
+  const size_type m_nChunkSize;
+  size_type m_nElements; // in the dataset
+  size_type m_ixNextChunk; // dataset index of the chunk to be prefetched
+
+  std::unique_ptr<HDF5DataManager> m_pdm;
+  std::unique_ptr<HDF5TimeSeriesAccessor<T> > m_pAccessor;
+
+  vDatum_t m_vActive;   // chunk being merged
+  vDatum_t m_vPrefetch; // next chunk, owned by the background task while m_futurePrefetch is valid
+  typename vDatum_t::size_type m_ixActive;
+
+  std::future<void> m_futurePrefetch;
+
+  void Read( size_type ixStart, vDatum_t& );
+  void Prefetch();
+  void WaitPrefetch();
+  void LoadFirst();
+};
+
+template<class T>
+MergeCarrierStream<T>::MergeCarrierStream( const std::string& sPath, OnDatumHandler function, size_type nChunkSize )
+: MergeCarrierBase()
+, m_nChunkSize( 0 == nChunkSize ? nDefaultChunkSize : nChunkSize )
+, m_nElements {}, m_ixNextChunk {}, m_ixActive {}
+{
+  OnDatum = function;
+  {
+    std::scoped_lock<std::mutex> lock( HDF5Mutex() );
+    m_pdm = std::make_unique<HDF5DataManager>( HDF5DataManager::RO );
+    m_pAccessor = std::make_unique<HDF5TimeSeriesAccessor<T> >( *m_pdm, sPath ); // throws std::runtime_error if not available
+    m_nElements = m_pAccessor->size();
+  }
+  m_vActive.reserve( std::min( m_nChunkSize, m_nElements ) );
+  m_vPrefetch.reserve( std::min( m_nChunkSize, m_nElements ) );
+  LoadFirst();
+}
+
+template<class T>
+MergeCarrierStream<T>::~MergeCarrierStream() {
+  WaitPrefetch();
+  std::scoped_lock<std::mutex> lock( HDF5Mutex() );
+  m_pAccessor.reset();
+  m_pdm.reset();
+}
+
+template<class T>
+void MergeCarrierStream<T>::Read( size_type ixStart, vDatum_t& v ) {
+  const size_type nCount( std::min( m_nChunkSize, m_nElements - ixStart ) );
+  v.resize( nCount );
+  if ( 0 < nCount ) {
+    std::scoped_lock<std::mutex> lock( HDF5Mutex() );
+    H5::DataSpace dsMemory( 1, &nCount );
+    m_pAccessor->Read( ixStart, nCount, &dsMemory, v.data() );
+    dsMemory.close();
+  }
+}
+
+template<class T>
+void MergeCarrierStream<T>::Prefetch() {
+  if ( m_ixNextChunk < m_nElements ) {
+    const size_type ixStart( m_ixNextChunk );
+    m_ixNextChunk += std::min( m_nChunkSize, m_nElements - ixStart );
+    m_futurePrefetch = std::async( std::launch::async, [this, ixStart](){ Read( ixStart, m_vPrefetch ); } );
+  }
+  else {
+    m_vPrefetch.clear();
+  }
+}
+
+template<class T>
+void MergeCarrierStream<T>::WaitPrefetch() {
+  if ( m_futurePrefetch.valid() ) {
+    m_futurePrefetch.get();
+  }
+}
+
+template<class T>
+void MergeCarrierStream<T>::LoadFirst() {
+  WaitPrefetch();
+  Read( 0, m_vActive );
+  m_ixNextChunk = m_vActive.size();
+  m_ixActive = 0;
+  m_pDatum = m_vActive.empty() ? nullptr : &m_vActive[ 0 ];  // preload with first datum so we have it's time available for comparison
+  SetDateTime();
+  Prefetch();
+}
+
+template<class T>
+void MergeCarrierStream<T>::ProcessDatum() {
+  if ( ou::TimeSource::LocalCommonInstance().GetSimulationMode() ) {
+    ou::TimeSource::LocalCommonInstance().SetSimulationTime( m_pDatum->DateTime() );
+  }
+  if ( nullptr != OnDatum )
+    OnDatum( *m_pDatum );
+  ++m_ixActive;
+  if ( m_vActive.size() == m_ixActive ) {
+    WaitPrefetch();
+    m_vActive.swap( m_vPrefetch );
+    m_ixActive = 0;
+    Prefetch();
+  }
+  m_pDatum = ( m_vActive.size() == m_ixActive ) ? nullptr : &m_vActive[ m_ixActive ];
+  SetDateTime();
+}
+
+template<class T>
+void MergeCarrierStream<T>::Reset() {
+  LoadFirst();
+}
+
+} // namespace tf
+} // namespace ou
@@ -25,6 +25,7 @@ using namespace fastdelegate;
 #include <TFTimeSeries/TimeSeries.h>
 
 #include "MergeDatedDatumCarrier.h"
+#include "MergeDatedDatumStream.h"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -45,6 +46,20 @@ public:
   void Add( TimeSeries<Greek>& series, OnDatumHandler );
   void Add( TimeSeries<DepthByMM>& series, OnDatumHandler );
   void Add( TimeSeries<DepthByOrder>& series, OnDatumHandler );
+
+  // stream the hdf5 dataset at sPath in chunks rather than from a preloaded series
+  template<class T>
+  void Add( const std::string& sPath, OnDatumHandler function, hsize_t nChunkSize ) {
+    try {
+      MergeCarrierStream<T>* pCarrier = new MergeCarrierStream<T>( sPath, function, nChunkSize );
+      if ( nullptr == pCarrier->GetDatedDatum() ) delete pCarrier; // empty dataset
+      else m_mhCarriers.Append( pCarrier );
+    }
+    catch ( std::runtime_error& e ) {
+      // couldn't open the dataset, so nothing to merge
+    }
+  }
+
   void Run();
   void Stop();
 
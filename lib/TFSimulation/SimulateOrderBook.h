@@ -0,0 +1,335 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    SimulateOrderBook.h
+ * Author:  raymond@burkholder.net
+ * Project: TFSimulation
+ * Created: 2026/10/16 23:18:26
+ */
+
+// building blocks for OrderExecution, the simulated exchange of a symbol
+//   Pool:  nodes in one contiguous vector, linked by index, released nodes are re-used
+//   Fifo:  intrusive queue of pool nodes, O(1) append and removal from anywhere
+//   PriceLevels:  one side of a book, a contiguous array of Fifo levels indexed by tick,
+//     with the best non-empty level tracked
+//   DelayWheel:  hashed timing wheel, events come back out in time order
+// nodes used in a Fifo or PriceLevels have members:  book::ix_t next, prev;  book::tick_t tick;
+
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace sim { // simulation
+namespace book {
+
+using ix_t = uint32_t;
+using tick_t = int64_t;
+
+static constexpr ix_t nil = std::numeric_limits<ix_t>::max();
+
+// ==== Pool
+
+template<typename node_t>
+class Pool {
+public:
+
+  Pool(): m_ixFree( nil ), m_nInUse {} {}
+
+  ix_t Allocate() {
+    ++m_nInUse;
+    if ( nil == m_ixFree ) {
+      m_vNode.emplace_back();
+      return m_vNode.size() - 1;
+    }
+    const ix_t ix( m_ixFree );
+    m_ixFree = m_vNode[ ix ].next;
+    m_vNode[ ix ].next = nil;
+    return ix;
+  }
+
+  void Release( ix_t ix ) { // the node is reset, releasing what it holds
+    assert( 0 < m_nInUse );
+    --m_nInUse;
+    m_vNode[ ix ] = node_t();
+    m_vNode[ ix ].next = m_ixFree;
+    m_ixFree = ix;
+  }
+
+  node_t& operator[]( ix_t ix ) { return m_vNode[ ix ]; }
+  const node_t& operator[]( ix_t ix ) const { return m_vNode[ ix ]; }
+
+  std::size_t Size() const { return m_nInUse; }
+
+private:
+  std::vector<node_t> m_vNode; // nodes are referred to by index, addresses change on growth
+  ix_t m_ixFree;
+  std::size_t m_nInUse;
+};
+
+// ==== Fifo
+
+template<typename node_t>
+class Fifo {
+public:
+
+  Fifo(): m_ixHead( nil ), m_ixTail( nil ), m_nNodes {} {}
+
+  bool Empty() const { return nil == m_ixHead; }
+  ix_t Front() const { return m_ixHead; }
+  uint32_t Size() const { return m_nNodes; }
+
+  void PushBack( Pool<node_t>& pool, ix_t ix ) {
+    node_t& node( pool[ ix ] );
+    node.prev = m_ixTail;
+    node.next = nil;
+    if ( nil == m_ixTail ) m_ixHead = ix;
+    else pool[ m_ixTail ].next = ix;
+    m_ixTail = ix;
+    ++m_nNodes;
+  }
+
+  void Remove( Pool<node_t>& pool, ix_t ix ) {
+    node_t& node( pool[ ix ] );
+    if ( nil == node.prev ) m_ixHead = node.next;
+    else pool[ node.prev ].next = node.next;
+    if ( nil == node.next ) m_ixTail = node.prev;
+    else pool[ node.next ].prev = node.prev;
+    node.next = node.prev = nil;
+    --m_nNodes;
+  }
+
+private:
+  ix_t m_ixHead;
+  ix_t m_ixTail;
+  uint32_t m_nNodes;
+};
+
+// ==== PriceLevels
+
+template<typename node_t>
+class PriceLevels {
+public:
+
+  using fifo_t = Fifo<node_t>;
+
+  // bHighestBest: true for bids, best is the highest price, otherwise the lowest price
+  PriceLevels( Pool<node_t>& pool, bool bHighestBest )
+  : m_pool( pool ), m_bHighestBest( bHighestBest ), m_tickBase {}, m_tickBest {}, m_nNodes {}
+  {}
+
+  bool Empty() const { return 0 == m_nNodes; }
+  std::size_t Size() const { return m_nNodes; }
+
+  tick_t Best() const { assert( !Empty() ); return m_tickBest; }
+  ix_t Front() const { return Empty() ? nil : m_vLevel[ m_tickBest - m_tickBase ].Front(); } // first in line at the best level
+
+  bool Better( tick_t a, tick_t b ) const { return m_bHighestBest ? ( a > b ) : ( a < b ); }
+
+  // nullptr when there is nothing at the tick
+  const fifo_t* Level( tick_t tick ) const {
+    if ( ( tick < m_tickBase ) || ( ( m_tickBase + (tick_t)m_vLevel.size() ) <= tick ) ) return nullptr;
+    const fifo_t& level( m_vLevel[ tick - m_tickBase ] );
+    return level.Empty() ? nullptr : &level;
+  }
+
+  // the next non-empty level worse than the tick, false when there is none
+  bool Next( tick_t tick, tick_t& next ) const {
+    const tick_t tickLast( m_tickBase + (tick_t)m_vLevel.size() - 1 );
+    const tick_t step( m_bHighestBest ? -1 : 1 );
+    const tick_t tickStart( m_bHighestBest ? std::min( tick - 1, tickLast ) : std::max( tick + 1, m_tickBase ) );
+    const tick_t tickEnd( m_bHighestBest ? m_tickBase - 1 : tickLast + 1 );
+    if ( m_bHighestBest ? ( tickStart <= tickEnd ) : ( tickStart >= tickEnd ) ) return false;
+    for ( tick_t t = tickStart; t != tickEnd; t += step ) {
+      if ( !m_vLevel[ t - m_tickBase ].Empty() ) {
+        next = t;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Append( ix_t ix ) { // to the back of its level
+    const tick_t tick( m_pool[ ix ].tick );
+    At( tick ).PushBack( m_pool, ix );
+    if ( ( 0 == m_nNodes ) || Better( tick, m_tickBest ) ) m_tickBest = tick;
+    ++m_nNodes;
+  }
+
+  void Remove( ix_t ix ) {
+    const tick_t tick( m_pool[ ix ].tick );
+    fifo_t& level( m_vLevel[ tick - m_tickBase ] );
+    level.Remove( m_pool, ix );
+    --m_nNodes;
+    if ( level.Empty() && ( tick == m_tickBest ) && ( 0 < m_nNodes ) ) {
+      const bool bFound( Next( tick, m_tickBest ) );
+      assert( bFound );
+    }
+  }
+
+private:
+
+  Pool<node_t>& m_pool;
+  const bool m_bHighestBest;
+
+  using vLevel_t = std::vector<fifo_t>;
+  vLevel_t m_vLevel; // m_vLevel[ 0 ] is at m_tickBase
+  tick_t m_tickBase;
+  tick_t m_tickBest; // valid when not empty
+  std::size_t m_nNodes;
+
+  fifo_t& At( tick_t tick ) { // grows the array to include the tick
+    const tick_t nLevels( m_vLevel.size() );
+    if ( 0 == nLevels ) {
+      m_tickBase = tick - 64;
+      m_vLevel.resize( 128 );
+    }
+    else {
+      if ( ( tick < m_tickBase ) || ( ( m_tickBase + nLevels ) <= tick ) ) {
+        const tick_t tickLow( std::min( tick, m_tickBase ) );
+        const tick_t tickHigh( std::max( tick + 1, m_tickBase + nLevels ) );
+        const tick_t nMargin( std::max<tick_t>( 64, ( tickHigh - tickLow ) / 2 ) ); // room to move without another copy
+        const tick_t tickBase( tickLow - ( ( tick < m_tickBase ) ? nMargin : 0 ) );
+        vLevel_t vLevel( tickHigh - tickBase + ( ( tick < m_tickBase ) ? 0 : nMargin ) );
+        std::copy( m_vLevel.begin(), m_vLevel.end(), vLevel.begin() + ( m_tickBase - tickBase ) );
+        m_vLevel.swap( vLevel );
+        m_tickBase = tickBase;
+      }
+    }
+    return m_vLevel[ tick - m_tickBase ];
+  }
+
+};
+
+// ==== DelayWheel
+
+template<typename event_t>
+class DelayWheel {
+public:
+
+  using ptime = boost::posix_time::ptime;
+  using time_duration = boost::posix_time::time_duration;
+
+  // the wheel spans nSlots * dtResolution, events further out wait for additional revolutions
+  DelayWheel( const time_duration& dtResolution = boost::posix_time::milliseconds( 1 ), std::size_t nSlots = 1024 ) // power of two
+  : m_nResolution( dtResolution.ticks() )
+  , m_vBucket( nSlots, nil )
+  , m_mask( nSlots - 1 )
+  , m_nCursor {}
+  , m_nSequence {}
+  {
+    assert( 0 < m_nResolution );
+    assert( 0 == ( nSlots & ( nSlots - 1 ) ) );
+  }
+
+  std::size_t Size() const { return m_pool.Size(); }
+
+  void Schedule( const ptime& dtDue, event_t&& event ) {
+    if ( m_dtBase.is_not_a_date_time() ) {
+      m_dtBase = dtDue;
+      m_nCursor = 0;
+    }
+    const ix_t ix( m_pool.Allocate() );
+    Entry& entry( m_pool[ ix ] );
+    entry.dtDue = dtDue;
+    entry.nSequence = m_nSequence++;
+    entry.event = std::move( event );
+    const int64_t nSlot( std::max( Slot( dtDue ), m_nCursor ) ); // late arrivals are picked up by the next Advance
+    ix_t& head( m_vBucket[ nSlot & m_mask ] );
+    entry.next = head;
+    head = ix;
+  }
+
+  // f( event_t& ) for each event due before dtNow, in order of due time, then of scheduling
+  template<typename Function>
+  void Advance( const ptime& dtNow, Function&& f ) {
+    if ( m_dtBase.is_not_a_date_time() ) return;
+    const int64_t nSlotNow( Slot( dtNow ) );
+    if ( 0 < m_pool.Size() ) {
+      const int64_t nSteps( std::min<int64_t>( nSlotNow - m_nCursor + 1, m_vBucket.size() ) );
+      for ( int64_t nSlot = m_nCursor; nSlot < m_nCursor + nSteps; nSlot++ ) {
+        ix_t* pLink( &m_vBucket[ nSlot & m_mask ] );
+        while ( nil != *pLink ) {
+          Entry& entry( m_pool[ *pLink ] );
+          if ( entry.dtDue < dtNow ) {
+            m_vFire.push_back( *pLink );
+            *pLink = entry.next;
+          }
+          else {
+            pLink = &entry.next;
+          }
+        }
+      }
+    }
+    if ( m_nCursor < nSlotNow ) m_nCursor = nSlotNow;
+
+    if ( !m_vFire.empty() ) {
+      std::sort(
+        m_vFire.begin(), m_vFire.end(),
+        [this]( ix_t a, ix_t b ){
+          const Entry& ea( m_pool[ a ] );
+          const Entry& eb( m_pool[ b ] );
+          return ( ea.dtDue < eb.dtDue ) || ( ( ea.dtDue == eb.dtDue ) && ( ea.nSequence < eb.nSequence ) );
+        } );
+      vIx_t vFire;
+      vFire.swap( m_vFire ); // f may schedule
+      for ( ix_t ix: vFire ) {
+        f( m_pool[ ix ].event );
+        m_pool.Release( ix );
+      }
+      vFire.clear();
+      if ( m_vFire.empty() ) m_vFire.swap( vFire ); // keep the capacity
+    }
+  }
+
+private:
+
+  struct Entry {
+    ptime dtDue;
+    uint64_t nSequence;
+    event_t event;
+    ix_t next;
+    Entry(): nSequence {}, next( nil ) {}
+  };
+
+  using vIx_t = std::vector<ix_t>;
+
+  const int64_t m_nResolution; // time_duration ticks
+  Pool<Entry> m_pool;
+  vIx_t m_vBucket; // singly linked entries per slot, unordered
+  vIx_t m_vFire;
+  const int64_t m_mask;
+  ptime m_dtBase; // slot 0
+  int64_t m_nCursor; // slots before this one have been emptied of due events
+  uint64_t m_nSequence;
+
+  int64_t Slot( const ptime& dt ) const {
+    const int64_t nTicks( ( dt - m_dtBase ).ticks() );
+    return ( nTicks < 0 ) ? -1 : ( nTicks / m_nResolution );
+  }
+
+};
+
+} // namespace book
+} // namespace sim
+} // namespace tf
+} // namespace ou
@@ -12,6 +12,8 @@
  * See the file LICENSE.txt for redistribution information.             *
  ************************************************************************/
 
+#include <cmath>
+
 #include <boost/log/trivial.hpp>
 
 #include <boost/lexical_cast.hpp>
@@ -24,21 +26,38 @@ namespace ou { // One Unified
 namespace tf { // TradeFrame
 namespace sim { // simulation
 
-int OrderExecution::m_nExecId( 1000 );
+std::atomic<int> OrderExecution::m_nExecId( 1000 );
 
 OrderExecution::OrderExecution()
 : m_dtQueueDelay( milliseconds( 250 ) )
 , m_dblCommission( 1.00 )
+, m_dblTickSize( 0.01 )
+, m_bQueuePosition( false )
+, m_bDepthByOrder( false )
+, m_levelsAsk( m_poolEntry, false )
+, m_levelsSellStop( m_poolEntry, false )
+, m_levelsBid( m_poolEntry, true )
+, m_levelsBuyStop( m_poolEntry, true )
+, m_nSequence {}
 {
 }
 
 OrderExecution::~OrderExecution() {
 }
 
-std::string OrderExecution::GetExecId() {
-  std::string sId = boost::lexical_cast<std::string>( m_nExecId++ );
-  assert( 0 != sId.length() );
-  return sId;
+int OrderExecution::GetExecId() {
+  return m_nExecId.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void OrderExecution::SetTickSize( double dblTickSize ) {
+  assert( 0.0 < dblTickSize );
+  assert( 0 == m_poolEntry.Size() ); // levels already in use are not re-indexed
+  assert( m_mapMarketOrder.empty() );
+  m_dblTickSize = dblTickSize;
+}
+
+OrderExecution::tick_t OrderExecution::ToTick( double dblPrice ) const {
+  return std::llround( dblPrice / m_dblTickSize );
 }
 
 void OrderExecution::NewQuote( const Quote& quote ) {
@@ -50,9 +69,50 @@ void OrderExecution::NewDepthByMM( const DepthByMM& depth ) {
 }
 
 void OrderExecution::NewDepthByOrder( const DepthByOrder& depth ) {
-  // might use this to populate the bid/ask tables
-  // queue in the locally generated orders for proper execution sequencing
-  // then apply the ou::tf::Trade orders against this list
+  // the market's orders are tracked to find the volume in front of the locally generated orders
+  if ( m_bQueuePosition ) {
+    m_bDepthByOrder = true;
+    switch ( depth.MsgType() ) {
+      case '3': // add
+      case '6': // summary
+        QueueAdd( depth.OrderID(), MarketOrder { depth.Side(), ToTick( depth.Price() ), depth.Volume(), depth.Priority(), 0 } );
+        break;
+      case '4': // update
+        {
+          mapMarketOrder_t::iterator iter = m_mapMarketOrder.find( depth.OrderID() );
+          const tick_t tick( ToTick( depth.Price() ) );
+          if ( m_mapMarketOrder.end() == iter ) { // add was not seen
+            QueueAdd( depth.OrderID(), MarketOrder { depth.Side(), tick, depth.Volume(), depth.Priority(), 0 } );
+          }
+          else {
+            MarketOrder& mo( iter->second );
+            if ( ( tick != mo.tick ) || ( depth.Priority() != mo.nPriority ) || ( depth.Side() != mo.chSide ) ) {
+              // priority lost, to the back of the level
+              QueueDelete( depth.OrderID() );
+              QueueAdd( depth.OrderID(), MarketOrder { depth.Side(), tick, depth.Volume(), depth.Priority(), 0 } );
+            }
+            else {
+              if ( depth.Volume() < mo.nQuantity ) {
+                QueueReduce( mo, mo.nQuantity - depth.Volume() );
+              }
+              else { // keeps its place, the increase is not counted against orders behind it
+                ( ( 'A' == mo.chSide ) ? m_mapMarketVolumeAsk : m_mapMarketVolumeBid )[ mo.tick ] += depth.Volume() - mo.nQuantity;
+                mo.nQuantity = depth.Volume();
+              }
+            }
+          }
+        }
+        break;
+      case '5': // delete
+        QueueDelete( depth.OrderID() );
+        break;
+      case 'C': // clear
+        QueueClear( depth.Side() );
+        break;
+      default:
+        break;
+    }
+  }
 }
 
 void OrderExecution::NewTrade( const Trade& trade ) {
@@ -64,15 +124,16 @@ void OrderExecution::SubmitOrder( pOrder_t pOrder ) {
   Order::idOrder_t idOrder( pOrder->GetOrderId() );
   BOOST_LOG_TRIVIAL(info)
     << "simulate," << idOrder << ",queued,submit," << pOrder->GetInstrument()->GetInstrumentName();
-  m_lOrderDelay.push_back( pOrder );
+  const ptime dtDue( pOrder->GetDateTimeOrderSubmitted() + m_dtQueueDelay );
+  m_wheelDelay.Schedule( dtDue, Pending( Pending::EType::Submit, std::move( pOrder ), idOrder ) );
   TrackOrder( idOrder, OrderState::State::Delay ); // might be new or a change
 }
 
 void OrderExecution::CancelOrder( Order::idOrder_t idOrder ) {
   BOOST_LOG_TRIVIAL(info)
     << "simulate," << idOrder << ",queued,cancel";
-  QueuedCancelOrder qco( ou::TimeSource::LocalCommonInstance().Internal(), idOrder );
-  m_lCancelDelay.push_back( qco );
+  const ptime dtDue( ou::TimeSource::LocalCommonInstance().Internal() + m_dtQueueDelay );
+  m_wheelDelay.Schedule( dtDue, Pending( Pending::EType::Cancel, nullptr, idOrder ) );
   TrackOrder( idOrder, OrderState::State::Delay ); // should match an existing order
 }
 
@@ -112,6 +173,7 @@ void OrderExecution::CalculateCommission( Order& order, Trade::tradesize_t quan
   }
 }
 
+
 void OrderExecution::ProcessOrderQueues( const Quote &quote ) {
   // called with each new quote
 
@@ -120,9 +182,7 @@ void OrderExecution::ProcessOrderQueues( const Quote &quote ) {
   //  return;
   //}
 
-  ProcessCancelQueue( quote );
-
-  ProcessDelayQueue( quote );
+  ProcessDelayQueue( quote ); // submits and cancels, in the sequence they were made
 
   ProcessStopOrders( quote ); // places orders into market orders queue
 
@@ -138,30 +198,137 @@ void OrderExecution::ProcessStopOrders( const Quote& quote ) {
   // not yet implemented
 }
 
+void OrderExecution::Activate( ix_t ix, EBook eBook, const Quote& quote ) {
+  Entry& entry( m_poolEntry[ ix ] );
+  switch ( eBook ) {
+    case EBook::Market:
+      m_fifoMarket.PushBack( m_poolEntry, ix );
+      break;
+    case EBook::Ask:
+    case EBook::Bid:
+      {
+        const bool bAsk( EBook::Ask == eBook );
+        if ( m_bQueuePosition ) {
+          entry.nSequence = ++m_nSequence; // behind everything the market has at the level
+          if ( m_bDepthByOrder ) {
+            const mapMarketVolume_t& map( bAsk ? m_mapMarketVolumeAsk : m_mapMarketVolumeBid );
+            mapMarketVolume_t::const_iterator iter = map.find( entry.tick );
+            entry.nAhead = ( map.end() == iter ) ? 0 : iter->second;
+          }
+          else { // estimate, the quote size when joining the best level
+            if ( bAsk ? ( ToTick( quote.Ask() ) == entry.tick ) : ( ToTick( quote.Bid() ) == entry.tick ) ) {
+              entry.nAhead = bAsk ? quote.AskSize() : quote.BidSize();
+            }
+          }
+          entry.bTaker
+            = bAsk
+            ? ( ( 0 < quote.BidSize() ) && ( quote.Bid() >= entry.dblPrice ) )
+            : ( ( 0 < quote.AskSize() ) && ( quote.Ask() <= entry.dblPrice ) );
+        }
+        ( bAsk ? m_levelsAsk : m_levelsBid ).Append( ix );
+      }
+      break;
+    case EBook::SellStop:
+      m_levelsSellStop.Append( ix );
+      break;
+    case EBook::BuyStop:
+      m_levelsBuyStop.Append( ix );
+      break;
+    default:
+      assert( false );
+      break;
+  }
+}
+
+void OrderExecution::Remove( ix_t ix, EBook eBook ) {
+  switch ( eBook ) {
+    case EBook::Market:
+      m_fifoMarket.Remove( m_poolEntry, ix );
+      break;
+    case EBook::Ask:
+      m_levelsAsk.Remove( ix );
+      break;
+    case EBook::Bid:
+      m_levelsBid.Remove( ix );
+      break;
+    case EBook::SellStop:
+      m_levelsSellStop.Remove( ix );
+      break;
+    case EBook::BuyStop:
+      m_levelsBuyStop.Remove( ix );
+      break;
+    default:
+      assert( false );
+      break;
+  }
+}
+
+void OrderExecution::Fill( ix_t ix, EBook eBook, double dblPrice, volume_t quan, const char* szExchange ) {
+
+  pOrder_t pOrder( m_poolEntry[ ix ].pOrder ); // the entry may be released
+  ou::tf::Order& order( *pOrder );
+  const ou::tf::Order::idOrder_t idOrder( order.GetOrderId() );
+  const OrderSide::EOrderSide orderSide( order.GetOrderSide() );
+
+  uint32_t& nRemaining( m_poolEntry[ ix ].nRemaining );
+  assert( 0 < quan );
+  assert( quan <= nRemaining );
+  nRemaining -= quan;
+  const uint32_t nOrderQuanRemaining( nRemaining );
+
+  const int nId( GetExecId() );
+  const std::string id( boost::lexical_cast<std::string>( nId ) );
+  BOOST_LOG_TRIVIAL(info)
+    << "simulate,"
+    << idOrder
+    << "," << szExchange
+    << "," << nId
+    << "," << orderSide
+    << "," << nOrderQuanRemaining << "-" << quan << "," << dblPrice
+    ;
+
+  if ( 0 == nOrderQuanRemaining ) { // out of the book before the handlers see the fill
+    Remove( ix, eBook );
+    m_poolEntry.Release( ix );
+  }
+
+  // OrderManager should be calling Order::ReportExecution to update
+  if ( nullptr != OnOrderFill ) {
+    Execution exec( nId, idOrder, dblPrice, quan, orderSide, szExchange, id );
+    OnOrderFill( idOrder, exec );
+  }
+
+  CalculateCommission( order, quan );
+
+  if ( 0 == nOrderQuanRemaining ) {
+    MigrateActiveToArchive( idOrder );
+  }
+}
+
 bool OrderExecution::ProcessMarketOrders( const Quote& quote ) {
 
   bool bProcessed = false;
 
   // process market orders
-  if ( !m_lOrderMarket.empty() ) {
+  if ( !m_fifoMarket.Empty() ) {
 
-    ou::tf::Order& order( *m_lOrderMarket.front() );
+    const ix_t ix( m_fifoMarket.Front() );
+    const Entry& entry( m_poolEntry[ ix ] );
     bProcessed = true;
 
-    boost::uint32_t nOrderQuanRemaining = order.GetQuanRemaining();
-    assert( 0 != nOrderQuanRemaining );
+    assert( 0 != entry.nRemaining );
 
     // figure out price of execution
     Trade::tradesize_t quanApplied;
     double dblPrice;
-    OrderSide::EOrderSide orderSide = order.GetOrderSide();
+    OrderSide::EOrderSide orderSide = entry.pOrder->GetOrderSide();
     switch ( orderSide ) {
       case OrderSide::Buy:
-        quanApplied = std::min<Trade::tradesize_t>( nOrderQuanRemaining, quote.AskSize() );
+        quanApplied = std::min<Trade::tradesize_t>( entry.nRemaining, quote.AskSize() );
         dblPrice = quote.Ask();
         break;
       case OrderSide::Sell:
-        quanApplied = std::min<Trade::tradesize_t>( nOrderQuanRemaining, quote.BidSize() );
+        quanApplied = std::min<Trade::tradesize_t>( entry.nRemaining, quote.BidSize() );
         dblPrice = quote.Bid();
         break;
       default:
@@ -169,41 +336,12 @@ bool OrderExecution::ProcessMarketOrders( const Quote& quote ) {
         break;
     }
 
-    nOrderQuanRemaining -= quanApplied;
-
-    // execute order
-    ou::tf::Order::idOrder_t idOrder( order.GetOrderId() );
-    int nId( m_nExecId );  // before it gets incremented in next function
-    std::string id = GetExecId();
-    BOOST_LOG_TRIVIAL(info)
-      << "simulate,"
-      << idOrder
-      << ",mkt"
-      << "," << nId
-      << "," << orderSide
-      << "," << nOrderQuanRemaining << "-" << quanApplied << "," << dblPrice
-      ;
-
-    // OrderManager should be calling Order::ReportExecution to update
-    if ( nullptr != OnOrderFill ) {
-      // using id in first parameter may or may not work
-      Execution exec( nId, idOrder, dblPrice, quanApplied, orderSide, "SIMMkt", id );
-      OnOrderFill( idOrder, exec );
-    }
-    else {
-      int i = 1;  // we have a problem as nOrderQuanRemaining won't be updated for the next pass through on partial orders
+    if ( nullptr == OnOrderFill ) {
       throw std::runtime_error( "no onorderfill to keep housekeeping in place" );
     }
 
-    CalculateCommission( order, quanApplied );
-
-    // when order done, commission and toss away
-    // what happens on cancelled orders and partial fills?
-    if ( 0 == nOrderQuanRemaining ) {
-      m_lOrderMarket.pop_front();
-      MigrateActiveToArchive( idOrder );
-    }
-    else {
+    if ( 0 < quanApplied ) { // nothing on offer, wait for the next quote
+      Fill( ix, EBook::Market, dblPrice, quanApplied, "SIMMkt" );
     }
   }
 
@@ -212,138 +350,31 @@ bool OrderExecution::ProcessMarketOrders( const Quote& quote ) {
 
 bool OrderExecution::ProcessLimitOrders( const Quote& quote ) {
 
+  if ( m_bQueuePosition ) {
+    return QueueQuote( quote );
+  }
+
   bool bProcessed( false );
-  boost::uint32_t nOrderQuanRemaining {};
 
   // todo: what about self's own crossing orders, could fill with out qoute
 
-  if ( !m_mapAsks.empty() ) {
-    mapOrderBook_ask_t::iterator iterOrderBook( m_mapAsks.begin() );
-    //mapOrderBook_t::value_type& entry( *m_mapAsks.begin() );
-    mapOrderBook_ask_t::value_type& entry( *iterOrderBook );
+  if ( !m_levelsAsk.Empty() ) {
+    const ix_t ix( m_levelsAsk.Front() );
+    const Entry& entry( m_poolEntry[ ix ] );
     const double bid( quote.Bid() );
-    if ( bid >= entry.first ) {
-      if ( 0 < quote.BidSize() ) {
-
-        bProcessed = true;
-
-        ou::tf::Order& order( *entry.second );
-        ou::tf::Order::idOrder_t idOrder( order.GetOrderId() );
-        int nId( m_nExecId );  // before it gets incremented in next function
-        std::string id = GetExecId();
-
-        nOrderQuanRemaining = order.GetQuanRemaining();
-        if ( 0 == nOrderQuanRemaining ) {
-          BOOST_LOG_TRIVIAL(info)
-            << "simulate,error"
-            << ",lmt_ask"
-            << ",size_map=" << m_mapAsks.size()
-            << ",order_id=" << idOrder
-            << ",exec_id=" << id
-            << "," << nOrderQuanRemaining
-            << "," << order.GetInstrument()->GetInstrumentName()
-            ;
-          assert( false );
-        }
-
-        Trade::tradesize_t quanApplied = std::min<Trade::tradesize_t>( nOrderQuanRemaining, quote.BidSize() );
-
-        BOOST_LOG_TRIVIAL(info)
-          << "simulate"
-          << ",lmt_ask"
-          << ",size_map=" << m_mapAsks.size()
-          << ",order_id=" << idOrder
-          << ",exec_id=" << id
-          << "," << nOrderQuanRemaining << "-" << quanApplied << "," << bid
-          << "," << order.GetInstrument()->GetInstrumentName()
-          ;
-        nOrderQuanRemaining -= quanApplied;
-
-        if ( nullptr != OnOrderFill ) {
-          Execution exec( nId, idOrder, bid, quanApplied, OrderSide::Sell, "SIMLmtSell", id );
-          OnOrderFill( idOrder, exec );
-        }
-        else {
-          // OrderManager should be calling Order::ReportExecution to update
-        }
-
-        CalculateCommission( order, quanApplied );
-
-        if ( 0 == nOrderQuanRemaining ) {
-          BOOST_LOG_TRIVIAL(info)
-            << "simulate,lmt_ask,erase=("
-            << idOrder << "," << id << ")"
-            ;
-          m_mapAsks.erase( iterOrderBook );
-          MigrateActiveToArchive( idOrder );
-        }
-
-      }
+    if ( ( bid >= entry.dblPrice ) && ( 0 < quote.BidSize() ) ) {
+      bProcessed = true;
+      Fill( ix, EBook::Ask, bid, std::min<volume_t>( entry.nRemaining, quote.BidSize() ), "SIMLmtSell" );
     }
   }
 
-  if ( !m_mapBids.empty() && !bProcessed) {
-    mapOrderBook_bid_t::iterator iterOrderBook( m_mapBids.begin() );
-    //mapOrderBook_t::value_type& entry( *m_mapBids.rbegin() );
-    mapOrderBook_bid_t::value_type& entry( *iterOrderBook );
+  if ( !m_levelsBid.Empty() && !bProcessed ) {
+    const ix_t ix( m_levelsBid.Front() );
+    const Entry& entry( m_poolEntry[ ix ] );
     const double ask( quote.Ask() );
-    if ( ask <= entry.first ) {
-      if ( 0 < quote.AskSize() ) {
-
-        bProcessed = true;
-
-        ou::tf::Order& order( *entry.second );
-        ou::tf::Order::idOrder_t idOrder( order.GetOrderId() );
-        int nId( m_nExecId );  // before it gets incremented in next function
-        std::string id = GetExecId();
-
-        nOrderQuanRemaining = order.GetQuanRemaining();
-        if ( 0 == nOrderQuanRemaining ) {
-          BOOST_LOG_TRIVIAL(info)
-            << "simulate,error"
-            << ",lmt_bid"
-            << ",size_map=" << m_mapBids.size()
-            << ",order_id=" << idOrder
-            << ",exec_id=" << id
-            << "," << nOrderQuanRemaining
-            << "," << order.GetInstrument()->GetInstrumentName()
-            ;
-          assert( false );
-        }
-
-        Trade::tradesize_t quanApplied = std::min<Trade::tradesize_t>( nOrderQuanRemaining, quote.AskSize() );
-
-        BOOST_LOG_TRIVIAL(info)
-          << "simulate"
-          << ",lmt_bid"
-          << ",size_map=" << m_mapBids.size()
-          << ",order_id=" << idOrder
-          << ",exec_id=" << id
-          << "," << nOrderQuanRemaining << "-" << quanApplied << "," << ask
-          << "," << order.GetInstrument()->GetInstrumentName()
-          ;
-        nOrderQuanRemaining -= quanApplied;
-
-        if ( nullptr != OnOrderFill ) {
-          Execution exec( nId, idOrder, ask, quanApplied, OrderSide::Buy, "SIMLmtBuy", id );
-          OnOrderFill( idOrder, exec );
-        }
-        else {
-          // OrderManager should be calling Order::ReportExecution to update
-        }
-
-        CalculateCommission( order, quanApplied );
-
-        if ( 0 == nOrderQuanRemaining ) {
-          BOOST_LOG_TRIVIAL(info)
-            << "simulate,lmt_bid,erase=("
-            << idOrder << "," << id << ")"
-            ;
-          // https://stackoverflow.com/questions/1830158/how-to-call-erase-with-a-reverse-iterator
-          m_mapBids.erase( iterOrderBook );
-          MigrateActiveToArchive( idOrder );
-        }
-      }
+    if ( ( ask <= entry.dblPrice ) && ( 0 < quote.AskSize() ) ) {
+      bProcessed = true;
+      Fill( ix, EBook::Bid, ask, std::min<volume_t>( entry.nRemaining, quote.AskSize() ), "SIMLmtBuy" );
     }
   }
 
@@ -351,256 +382,302 @@ bool OrderExecution::ProcessLimitOrders( const Quote& quote ) {
 }
 
 bool OrderExecution::ProcessLimitOrders( const Trade& trade ) {
-  // will need analysis of quote/trade, quotes should reflect results of depletion by a trade
-
-  if ( false ) { // disable this for now
-    double ask( trade.Price() );
-    if ( !m_mapAsks.empty() ) {
-      if ( m_lastQuote.Ask() <= m_mapAsks.begin()->first ) {
-        ask = m_lastQuote.Ask();
-      }
-    }
+  // without queue position, fills come from quotes only
+  //   quotes should reflect results of depletion by a trade
 
-    double bid( trade.Price() );
-    if ( !m_mapBids.empty() ) {
-      if ( m_lastQuote.Bid() >= m_mapBids.begin()->first ) {
-        bid = m_lastQuote.Bid();
-      }
-    }
-
-    Quote quote( trade.DateTime(), bid, trade.Volume(), ask, trade.Volume() );
-    //return ProcessLimitOrders( quote );
+  bool bProcessed( false );
+  if ( m_bQueuePosition ) {
+    const tick_t tick( ToTick( trade.Price() ) );
+    bProcessed = QueueTrade( m_levelsAsk, EBook::Ask, tick, trade.Volume() );
+    bProcessed = QueueTrade( m_levelsBid, EBook::Bid, tick, trade.Volume() ) || bProcessed;
   }
-  return false;
+  return bProcessed;
 }
 
-void OrderExecution::ProcessDelayQueue( const Quote& quote ) {
+bool OrderExecution::QueueQuote( const Quote& quote ) {
+  bool bProcessed( false );
+  bProcessed = QueueQuote( m_levelsAsk, EBook::Ask, quote.Bid(), quote.BidSize() );
+  bProcessed = QueueQuote( m_levelsBid, EBook::Bid, quote.Ask(), quote.AskSize() ) || bProcessed;
+  if ( !m_bDepthByOrder ) {
+    QueueEstimate( m_levelsAsk, ToTick( quote.Ask() ), quote.AskSize() );
+    QueueEstimate( m_levelsBid, ToTick( quote.Bid() ), quote.BidSize() );
+  }
+  return bProcessed;
+}
 
-  // process the delay list
-  while ( !m_lOrderDelay.empty() ) {
+// dblQuote, nSize: the other side of the market
+bool OrderExecution::QueueQuote( levels_t& levels, EBook eBook, double dblQuote, volume_t nSize ) {
+  const bool bAsk( EBook::Ask == eBook );
+  bool bProcessed( false );
+  while ( ( 0 < nSize ) && !levels.Empty() ) {
+    const ix_t ix( levels.Front() );
+    const Entry& entry( m_poolEntry[ ix ] );
+    const bool bCrossed( bAsk ? ( dblQuote > entry.dblPrice ) : ( dblQuote < entry.dblPrice ) ); // the market moved through the level
+    const bool bTouched( bAsk ? ( dblQuote >= entry.dblPrice ) : ( dblQuote <= entry.dblPrice ) );
+    if ( !bCrossed && !( bTouched && entry.bTaker ) ) break;
+    const volume_t quan( std::min<volume_t>( entry.nRemaining, nSize ) );
+    nSize -= quan;
+    bProcessed = true;
+    Fill( ix, eBook, entry.bTaker ? dblQuote : entry.dblPrice, quan, bAsk ? "SIMLmtSell" : "SIMLmtBuy" );
+  }
+  return bProcessed;
+}
 
-    pOrder_t pOrderFrontOfQueue = m_lOrderDelay.front();
-    ou::tf::Order& order( *pOrderFrontOfQueue );
+// without depth by order, what is in front can not be more than what is showing at the level
+void OrderExecution::QueueEstimate( levels_t& levels, tick_t tickQuote, volume_t nSize ) {
+  const fifo_t* pLevel( levels.Level( tickQuote ) );
+  if ( nullptr != pLevel ) {
+    for ( ix_t ix = pLevel->Front(); book::nil != ix; ix = m_poolEntry[ ix ].next ) {
+      Entry& entry( m_poolEntry[ ix ] );
+      if ( nSize < entry.nAhead ) entry.nAhead = nSize;
+    }
+  }
+}
 
-    if ( ( order.GetDateTimeOrderSubmitted() + m_dtQueueDelay ) >= quote.DateTime() ) {
-      break;
+// the trade volume goes first to the levels it went through, then to the front of its own level,
+//   the market's orders in front of a local order, and earlier local orders, are filled before it is
+bool OrderExecution::QueueTrade( levels_t& levels, EBook eBook, tick_t tickTrade, volume_t nVolume ) {
+  const bool bAsk( EBook::Ask == eBook );
+  const char* szExchange( bAsk ? "SIMLmtSell" : "SIMLmtBuy" );
+  bool bProcessed( false );
+  while ( ( 0 < nVolume ) && !levels.Empty() ) {
+    const tick_t tick( levels.Best() );
+    if ( levels.Better( tickTrade, tick ) ) break; // the trade did not reach the level
+    if ( tick != tickTrade ) { // traded through the level
+      const ix_t ix( levels.Front() );
+      const Entry& entry( m_poolEntry[ ix ] );
+      const volume_t quan( std::min<volume_t>( entry.nRemaining, nVolume ) );
+      nVolume -= quan;
+      bProcessed = true;
+      Fill( ix, eBook, entry.dblPrice, quan, szExchange );
     }
     else {
+      volume_t nOursAhead {}; // local orders in front, before this trade
+      volume_t nFilled {};    // local orders filled by this trade
+      ix_t ix( levels.Level( tick )->Front() );
+      while ( book::nil != ix ) {
+        Entry& entry( m_poolEntry[ ix ] );
+        const ix_t ixNext( entry.next );
+        const volume_t nRemaining( entry.nRemaining );
+        const volume_t nAhead( entry.nAhead - std::min( entry.nAhead, entry.nTraded ) ); // not yet traded against
+        const volume_t nMarket( std::min( nAhead, nVolume - std::min( nVolume, nFilled ) ) ); // market's orders in front traded against
+        if ( m_bDepthByOrder ) entry.nTraded += nMarket; // depth removes them later
+        else entry.nAhead -= nMarket;
+        const volume_t nFront( nAhead + nOursAhead );
+        nOursAhead += nRemaining;
+        if ( nFront < nVolume ) {
+          const volume_t quan( std::min<volume_t>( nRemaining, nVolume - nFront ) );
+          nFilled += quan;
+          bProcessed = true;
+          Fill( ix, eBook, entry.dblPrice, quan, szExchange );
+        }
+        ix = ixNext;
+      }
+      break;
+    }
+  }
+  return bProcessed;
+}
 
-      //BOOST_LOG_TRIVIAL(info)
-      //  << "simulate"
-      //  << ",dequeue,"
-      //  << order.GetOrderId()
-      //  ;
+void OrderExecution::QueueAdd( DepthByOrder::idorder_t idOrder, const MarketOrder& mo_ ) {
+  if ( m_mapMarketOrder.end() != m_mapMarketOrder.find( idOrder ) ) {
+    QueueDelete( idOrder ); // re-add, as after a reconnect
+  }
+  MarketOrder& mo( m_mapMarketOrder.emplace( idOrder, mo_ ).first->second );
+  mo.nSequence = ++m_nSequence;
+  ( ( 'A' == mo.chSide ) ? m_mapMarketVolumeAsk : m_mapMarketVolumeBid )[ mo.tick ] += mo.nQuantity;
+}
 
-      m_lOrderDelay.pop_front();
+void OrderExecution::QueueDelete( DepthByOrder::idorder_t idOrder ) {
+  mapMarketOrder_t::iterator iter = m_mapMarketOrder.find( idOrder );
+  if ( m_mapMarketOrder.end() != iter ) {
+    QueueReduce( iter->second, iter->second.nQuantity );
+    m_mapMarketOrder.erase( iter );
+  }
+}
 
-      Order::idOrder_t idOrder( order.GetOrderId() );
+void OrderExecution::QueueReduce( MarketOrder& mo, volume_t nReduce ) {
+  const bool bAsk( 'A' == mo.chSide );
+  nReduce = std::min( nReduce, mo.nQuantity );
+  mo.nQuantity -= nReduce;
 
-      if ( IsOrderArchive( idOrder ) ) {
-        BOOST_LOG_TRIVIAL(info)
-          << "simulate,"
-          << idOrder
-          << ",archived"
-          ;
-      }
-      else {
-
-        if ( IsOrderActive( idOrder ) ) { // a change order is occuring, so remove old version
-          switch ( order.GetOrderType() ) {
-            case OrderType::Market:
-              assert( false ); // doesn't make sense to do anything else
-              break;
-            case OrderType::Limit:
-              // update the order
-                {
-                  bool bFound( false );
-                  for ( mapOrderBook_ask_t::iterator iter = m_mapAsks.begin(); iter != m_mapAsks.end(); ++iter ) {
-                    if ( idOrder == order.GetOrderId() ) {
-                      ou::tf::Order& old( *iter->second );
-                      assert( OrderType::Limit == old.GetOrderType() );
-                      assert( order.GetOrderSide() == old.GetOrderSide() );
-                      m_mapAsks.erase( iter );
-                      bFound = true;
-                      break;
-                    }
-                  }
-                  if ( !bFound ) {
-                    for ( mapOrderBook_bid_t::iterator iter = m_mapBids.begin(); iter != m_mapBids.end(); ++iter ) {
-                      if ( idOrder == order.GetOrderId() ) {
-                        ou::tf::Order& old( *iter->second );
-                        assert( OrderType::Limit == old.GetOrderType() );
-                        assert( order.GetOrderSide() == old.GetOrderSide() );
-                        m_mapBids.erase( iter );
-                        break;
-                      }
-                    }
-                  }
-                }
-              break;
-            case OrderType::Stop:
-              // update the order
-              break;
-            default:
-              assert( false );
-              break;
-          }
-        }
-        else {
-          MigrateDelayToActive( idOrder );
-        }
+  mapMarketVolume_t& map( bAsk ? m_mapMarketVolumeAsk : m_mapMarketVolumeBid );
+  mapMarketVolume_t::iterator iter = map.find( mo.tick );
+  if ( map.end() != iter ) {
+    iter->second -= std::min( iter->second, nReduce );
+    if ( 0 == iter->second ) map.erase( iter );
+  }
 
-        switch ( order.GetOrderType() ) {
-          case OrderType::Market:
-            // place into market order book
-            m_lOrderMarket.push_back( pOrderFrontOfQueue );
-            //if ( nullptr != OnOrderCancelled ) OnOrderCancelled( order.GetOrderId() );
-            break;
-          case OrderType::Limit:
-            // place into limit book
-            // TODO: can't have limit orders in two different directions
-            assert( 0 < order.GetPrice1() );
-
-            switch ( order.GetOrderSide() ) {
-              case OrderSide::Sell:
-                m_mapAsks.insert( mapOrderBook_ask_t::value_type( order.GetPrice1(), pOrderFrontOfQueue ) );
-                break;
-              case OrderSide::Buy:
-                m_mapBids.insert( mapOrderBook_bid_t::value_type( order.GetPrice1(), pOrderFrontOfQueue ) );
-                break;
-              default:
-                assert( false );
-                break;
-            }
-            break;
-          case OrderType::Stop:
-            // place into stop book
-            assert( 0 < order.GetPrice1() );
-            switch ( order.GetOrderSide() ) {
-              case OrderSide::Sell:
-                m_mapSellStops.insert( mapOrderBook_ask_t::value_type( order.GetPrice1(), pOrderFrontOfQueue ) );
-                break;
-              case OrderSide::Buy:
-                m_mapBuyStops.insert( mapOrderBook_bid_t::value_type( order.GetPrice1(), pOrderFrontOfQueue ) );
-                break;
-              default:
-                assert( false );
-                break;
-            }
-            break;
-          default:
-            assert( false );
-            break;
-        }
+  const fifo_t* pLevel( ( bAsk ? m_levelsAsk : m_levelsBid ).Level( mo.tick ) );
+  if ( nullptr != pLevel ) {
+    for ( ix_t ix = pLevel->Front(); book::nil != ix; ix = m_poolEntry[ ix ].next ) {
+      Entry& entry( m_poolEntry[ ix ] );
+      if ( mo.nSequence < entry.nSequence ) { // was in front
+        entry.nAhead -= std::min( entry.nAhead, nReduce );
+        entry.nTraded -= std::min( entry.nTraded, nReduce );
       }
     }
   }
-
 }
 
-void OrderExecution::ProcessCancelQueue( const Quote& quote ) {
-
-  // process cancels list
-  while ( !m_lCancelDelay.empty() ) {
-    if ( ( m_lCancelDelay.front().dtCancellation + m_dtQueueDelay ) >= quote.DateTime() ) {
-      break;  // havn't waited long enough to simulate cancel submission
-    }
-    else {
-      QueuedCancelOrder& qco = m_lCancelDelay.front();  // capture the information
-      bool bOrderFound = false;
-
-      // need a fusion array based upon orders so can zero in on order without looping through all the structures
-
-      // check the delay queue - change this to a while do
-      // not sure if this is even reachable as the cancel comes after an order, which should have no delay remaining
-      // right, don't process the delay queue, doesn't make sense temporaly or logically
-      //for ( lOrderQueue_iter_t iter = m_lOrderDelay.begin(); iter != m_lOrderDelay.end(); ++iter ) {
-      //  ou::tf::Order& order( **iter );
-      //  if ( qco.nOrderId == order.GetOrderId() ) {
-      //    m_lOrderDelay.erase( iter );
-      //    bOrderFound = true;
-      //    break;
-      //  }
-      //}
-
-      // check the market order queue
-      if ( !bOrderFound ) {
-        for ( lOrderQueue_iter_t iter = m_lOrderMarket.begin(); iter != m_lOrderMarket.end(); ++iter ) {
-          ou::tf::Order& order( **iter );
-          if ( qco.nOrderId == order.GetOrderId() ) {
-            m_lOrderMarket.erase( iter );
-            bOrderFound = true;
-            break;
-          }
-        }
+void OrderExecution::QueueClear( char chSide ) {
+  const bool bAsk( 'A' == chSide );
+  for ( mapMarketOrder_t::iterator iter = m_mapMarketOrder.begin(); iter != m_mapMarketOrder.end(); ) {
+    if ( bAsk == ( 'A' == iter->second.chSide ) ) iter = m_mapMarketOrder.erase( iter );
+    else ++iter;
+  }
+  ( bAsk ? m_mapMarketVolumeAsk : m_mapMarketVolumeBid ).clear();
+
+  levels_t& levels( bAsk ? m_levelsAsk : m_levelsBid );
+  if ( !levels.Empty() ) {
+    tick_t tick( levels.Best() );
+    do {
+      for ( ix_t ix = levels.Level( tick )->Front(); book::nil != ix; ix = m_poolEntry[ ix ].next ) {
+        Entry& entry( m_poolEntry[ ix ] );
+        entry.nAhead = 0;
+        entry.nTraded = 0;
       }
+    } while ( levels.Next( tick, tick ) );
+  }
+}
 
-      // need to check orders in ask limit list
-      if ( !bOrderFound ) {
-        for ( mapOrderBook_ask_t::iterator iter = m_mapAsks.begin(); iter != m_mapAsks.end(); ++iter ) {
-          ou::tf::Order& order( *iter->second );
-          if ( qco.nOrderId == order.GetOrderId() ) {
-            m_mapAsks.erase( iter );
-            bOrderFound = true;
-            break;
-          }
-        }
+void OrderExecution::ProcessDelayQueue( const Quote& quote ) {
+  // submits and cancels which have waited long enough, in time order
+  m_wheelDelay.Advance(
+    quote.DateTime(),
+    [this,&quote]( Pending& pending ){
+      switch ( pending.type ) {
+        case Pending::EType::Submit:
+          ProcessSubmit( pending.pOrder, quote );
+          break;
+        case Pending::EType::Cancel:
+          ProcessCancel( pending.idOrder );
+          break;
       }
+    } );
+}
 
-      // need to check orders in bid limit list
-      if ( !bOrderFound ) {
-        for ( mapOrderBook_bid_t::iterator iter = m_mapBids.begin(); iter != m_mapBids.end(); ++iter ) {
-          ou::tf::Order& order( *iter->second );
-          if ( qco.nOrderId == order.GetOrderId() ) {
-            m_mapBids.erase( iter );
-            bOrderFound = true;
-            break;
-          }
-        }
-      }
+void OrderExecution::ProcessSubmit( const pOrder_t& pOrder, const Quote& quote ) {
 
-      // need to check orders in stop list sells, any partial remaining to commission out? (stop may not be implemented yet)
-      if ( !bOrderFound ) {
-        for ( mapOrderBook_ask_t::iterator iter = m_mapSellStops.begin(); iter != m_mapSellStops.end(); ++iter ) {
-          if ( qco.nOrderId == iter->second->GetOrderId() ) {
-            m_mapSellStops.erase( iter );
-            bOrderFound = true;
-            break;
-          }
-        }
-      }
+  ou::tf::Order& order( *pOrder );
+  Order::idOrder_t idOrder( order.GetOrderId() );
 
-      // need to check orders in stop list buys, any partial remaining to commission out? (stop may not be implemented yet)
-      if ( !bOrderFound ) {
-        for ( mapOrderBook_bid_t::iterator iter = m_mapBuyStops.begin(); iter != m_mapBuyStops.end(); ++iter ) {
-          if ( qco.nOrderId == iter->second->GetOrderId() ) {
-            m_mapBuyStops.erase( iter );
-            bOrderFound = true;
-            break;
-          }
+  mapOrderState_t::iterator iterState = m_mapOrderState.find( idOrder );
+  assert( m_mapOrderState.end() != iterState );
+  OrderState& state( iterState->second );
+
+  if ( OrderState::State::Archive == state.state ) {
+    BOOST_LOG_TRIVIAL(info)
+      << "simulate,"
+      << idOrder
+      << ",archived"
+      ;
+    return;
+  }
+
+  if ( OrderState::State::Active == state.state ) { // a change order is occuring, so remove old version
+    switch ( order.GetOrderType() ) {
+      case OrderType::Market:
+        assert( false ); // doesn't make sense to do anything else
+        break;
+      case OrderType::Limit:
+      case OrderType::Stop:
+        if ( book::nil != state.ixEntry ) {
+          Remove( state.ixEntry, state.eBook );
+          m_poolEntry.Release( state.ixEntry );
+          state.eBook = EBook::None;
+          state.ixEntry = book::nil;
         }
-      }
+        break;
+      default:
+        assert( false );
+        break;
+    }
+  }
+  else {
+    assert( OrderState::State::Delay == state.state );
+    state.state = OrderState::State::Active;
+  }
 
-      if ( bOrderFound ) {  // need an event for this, as it could be legitimate crossing execution prior to cancel
-        if ( nullptr != OnOrderCancelled ) OnOrderCancelled( qco.nOrderId );
-        MigrateActiveToArchive( qco.nOrderId );
+  EBook eBook( EBook::None );
+  switch ( order.GetOrderType() ) {
+    case OrderType::Market:
+      // place into market order book
+      eBook = EBook::Market;
+      break;
+    case OrderType::Limit:
+      // place into limit book
+      // TODO: can't have limit orders in two different directions
+      assert( 0 < order.GetPrice1() );
+      switch ( order.GetOrderSide() ) {
+        case OrderSide::Sell:
+          eBook = EBook::Ask;
+          break;
+        case OrderSide::Buy:
+          eBook = EBook::Bid;
+          break;
+        default:
+          assert( false );
+          break;
       }
-      else {
-        //std::cout << "no order found to cancel: " << co.nOrderId << std::endl;
-        // todo:  propogate this into the OrderManager
-        //   this actually means that cancel comes through, but order was actually processed
-        if ( nullptr != OnNoOrderFound ) OnNoOrderFound( qco.nOrderId );
-
-        // confirm that the order has already been processed
-        mapOrderState_t::iterator iter = m_mapOrderState.find( qco.nOrderId );
-        assert( m_mapOrderState.end() != iter );
-        assert( OrderState::State::Archive == iter->second.state );
+      break;
+    case OrderType::Stop:
+      // place into stop book
+      assert( 0 < order.GetPrice1() );
+      switch ( order.GetOrderSide() ) {
+        case OrderSide::Sell:
+          eBook = EBook::SellStop;
+          break;
+        case OrderSide::Buy:
+          eBook = EBook::BuyStop;
+          break;
+        default:
+          assert( false );
+          break;
       }
+      break;
+    default:
+      assert( false );
+      break;
+  }
 
-      m_lCancelDelay.pop_front();  // remove from list
+  if ( EBook::None != eBook ) {
+    const ix_t ix( m_poolEntry.Allocate() );
+    Entry& entry( m_poolEntry[ ix ] );
+    entry.pOrder = pOrder;
+    entry.nRemaining = order.GetQuanRemaining();
+    assert( 0 < entry.nRemaining );
+    if ( EBook::Market != eBook ) {
+      entry.dblPrice = order.GetPrice1();
+      entry.tick = ToTick( entry.dblPrice );
     }
+    Activate( ix, eBook, quote );
+    state.eBook = eBook;
+    state.ixEntry = ix;
   }
+}
+
+void OrderExecution::ProcessCancel( Order::idOrder_t idOrder ) {
 
+  mapOrderState_t::iterator iter = m_mapOrderState.find( idOrder );
+  assert( m_mapOrderState.end() != iter );
+  OrderState& state( iter->second );
+
+  if ( ( OrderState::State::Active == state.state ) && ( book::nil != state.ixEntry ) ) {
+    Remove( state.ixEntry, state.eBook );
+    m_poolEntry.Release( state.ixEntry );
+    // need an event for this, as it could be legitimate crossing execution prior to cancel
+    if ( nullptr != OnOrderCancelled ) OnOrderCancelled( idOrder );
+    MigrateActiveToArchive( idOrder );
+  }
+  else {
+    // todo:  propogate this into the OrderManager
+    //   this actually means that cancel comes through, but order was actually processed
+    if ( nullptr != OnNoOrderFound ) OnNoOrderFound( idOrder );
+
+    // confirm that the order has already been processed
+    assert( OrderState::State::Archive == state.state );
+  }
 }
 
 void OrderExecution::TrackOrder( Order::idOrder_t idOrder, OrderState::State state ) {
@@ -644,6 +721,8 @@ void OrderExecution::MigrateActiveToArchive( Order::idOrder_t idOrder ) {
   assert( m_mapOrderState.end() != iter );
   assert( OrderState::State::Active == iter->second.state );
   iter->second.state = OrderState::State::Archive;
+  iter->second.eBook = EBook::None;
+  iter->second.ixEntry = book::nil;
 }
 
 } // namespace simulation
@@ -17,8 +17,7 @@
 // 2012/01/01  could find a way to feed live data in and simulate executions against live quote/tick data
 // is this really needed?  useful if no paper trading available
 
-#include <map>
-#include <list>
+#include <atomic>
 #include <string>
 #include <unordered_map>
 
@@ -32,16 +31,31 @@ using namespace fastdelegate;
 #include <TFTrading/Order.h>
 #include <TFTrading/Execution.h>
 
+#include "SimulateOrderBook.h"
+
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 namespace sim { // simulation
 
+// 2026/10/16 resting orders are kept in price level arrays with fifo queues (SimulateOrderBook.h),
+//   cancels and changes find their order through the order state, submits and cancels pass
+//   through one time ordered delay wheel
+// default fills:  one execution per quote, market orders first, then the best limit order touched by the quote,
+//   filled at the quote's price for up to the quote's size
+// queue position fills (SetQueuePosition):  a limit order joins the back of its price level,
+//   it fills at its own price when a trade at its level has used up the volume ahead of it,
+//   when a trade goes through its level, or when the quote crosses its level
+//   with DepthByOrder events, the volume ahead is the market's orders at the level which arrived before it,
+//   reduced as those orders are updated, deleted or traded against
+//   without DepthByOrder events, the volume ahead is estimated from the quote size at the level
+
 class OrderExecution {  // one instance per symbol
 public:
 
   using pOrder_t = Order::pOrder_t;
 
   OrderExecution();
+  OrderExecution( const OrderExecution& ) = delete;
   ~OrderExecution();
 
   using OnOrderCancelledHandler = FastDelegate1<Order::idOrder_t>;
@@ -63,11 +77,13 @@ public:
 
   void SetOrderDelay( const time_duration &dtOrderDelay ) { m_dtQueueDelay = dtOrderDelay; };
   void SetCommission( double dblCommission ) { m_dblCommission = dblCommission; };
+  void SetTickSize( double dblTickSize ); // price levels, set before orders or depth arrive
+  void SetQueuePosition( bool bQueuePosition ) { m_bQueuePosition = bQueuePosition; } // set before orders or depth arrive
 
   void NewQuote( const Quote& quote );
   void NewDepthByMM( const DepthByMM& depth ); // has no influence on the self administred order books
-  void NewDepthByOrder( const DepthByOrder& depth ); // has no influence on the self administred order books
-  void NewTrade( const Trade& trade );
+  void NewDepthByOrder( const DepthByOrder& depth ); // tracks queue position when enabled
+  void NewTrade( const Trade& trade ); // fills when queue position is enabled
 
   void SubmitOrder( pOrder_t pOrder );
   void CancelOrder( Order::idOrder_t nOrderId );
@@ -75,13 +91,40 @@ public:
 protected:
 private:
 
+  using ix_t = book::ix_t;
+  using tick_t = book::tick_t;
+  using volume_t = DatedDatum::volume_t;
+
+  // a simulated order, resting in a book, or queued as a market order
+  struct Entry {
+    pOrder_t pOrder;
+    tick_t tick;
+    double dblPrice;
+    uint32_t nRemaining;
+    uint64_t nSequence; // queue position:  place in the level relative to the market's orders
+    volume_t nAhead;    // queue position:  market volume in front
+    volume_t nTraded;   // queue position:  part of nAhead traded, the orders not yet reduced by depth
+    bool bTaker;        // queue position:  marketable on arrival, takes the quote's price
+    ix_t next;
+    ix_t prev;
+    Entry(): tick {}, dblPrice {}, nRemaining {}, nSequence {}, nAhead {}, nTraded {}, bTaker( false ), next( book::nil ), prev( book::nil ) {}
+  };
+
+  using pool_t = book::Pool<Entry>;
+  using levels_t = book::PriceLevels<Entry>;
+  using fifo_t = book::Fifo<Entry>;
+
+  enum class EBook { None, Market, Ask, Bid, SellStop, BuyStop }; // where an active order is held
+
   struct OrderState {
     // prevent repeats, changes, etc
     enum State { Unknown, Delay, Active, Archive } state;
     size_t nEncounter;
-    OrderState(): nEncounter( 1 ), state( State::Unknown ) {}
-    OrderState( State state_ ): nEncounter( 1 ), state( state_ ) {}
-    OrderState( const OrderState& rhs ): nEncounter( rhs.nEncounter ), state( rhs.state ) {}
+    EBook eBook;
+    ix_t ixEntry;
+    OrderState(): nEncounter( 1 ), state( State::Unknown ), eBook( EBook::None ), ixEntry( book::nil ) {}
+    OrderState( State state_ ): nEncounter( 1 ), state( state_ ), eBook( EBook::None ), ixEntry( book::nil ) {}
+    OrderState( const OrderState& rhs ) = default;
   };
 
   using mapOrderState_t = std::unordered_map<Order::idOrder_t,OrderState>;
@@ -94,14 +137,21 @@ private:
   void MigrateDelayToActive( Order::idOrder_t );
   void MigrateActiveToArchive( Order::idOrder_t );
 
-  struct QueuedCancelOrder {
-    ptime dtCancellation;
-    Order::idOrder_t nOrderId;
-    QueuedCancelOrder( const ptime &dtCancellation_, unsigned long nOrderId_ )
-      : dtCancellation( dtCancellation_ ), nOrderId( nOrderId_ ) {};
+  // submissions and cancellations, in the delay wheel until they reach the 'exchange'
+  struct Pending {
+    enum class EType { Submit, Cancel } type;
+    pOrder_t pOrder; // submit
+    Order::idOrder_t idOrder;
+    Pending(): type( EType::Submit ), idOrder {} {}
+    Pending( EType type_, pOrder_t pOrder_, Order::idOrder_t idOrder_ )
+    : type( type_ ), pOrder( std::move( pOrder_ ) ), idOrder( idOrder_ ) {}
   };
+
   boost::posix_time::time_duration m_dtQueueDelay; // used to simulate network / handling delays
   double m_dblCommission;  // currency, per share (need also per trade)
+  double m_dblTickSize;
+  bool m_bQueuePosition;
+  bool m_bDepthByOrder; // depth by order has been seen, volume ahead is tracked, not estimated
 
   Quote m_lastQuote;
 
@@ -110,33 +160,58 @@ private:
   OnNoOrderFoundHandler OnNoOrderFound;
   OnCommissionHandler OnCommission;
 
-  using lOrderQueue_t = std::list<pOrder_t>;
-  using lOrderQueue_iter_t = lOrderQueue_t::iterator;
+  book::DelayWheel<Pending> m_wheelDelay; // all orders and cancels, taken out then processed as limit or market or stop
 
-  std::list<QueuedCancelOrder> m_lCancelDelay; // separate structure for the cancellations, since not an order
+  pool_t m_poolEntry;
+  fifo_t m_fifoMarket;  // market orders to be processed
 
-  lOrderQueue_t m_lOrderDelay;  // all orders put in delay queue, taken out then processed as limit or market or stop
-  lOrderQueue_t m_lOrderMarket;  // market orders to be processed
+  levels_t m_levelsAsk; // lowest at beginning
+  levels_t m_levelsSellStop;  // pending sell stops, turned into market order when touched
+  levels_t m_levelsBid; // highest at beginning
+  levels_t m_levelsBuyStop;  // pending buy stops, turned into market order when touched
 
-  using mapOrderBook_ask_t = std::multimap<double,pOrder_t, std::less<double> >;
-  mapOrderBook_ask_t m_mapAsks; // lowest at beginning
-  mapOrderBook_ask_t m_mapSellStops;  // pending sell stops, turned into market order when touched
+  // queue position:  the market's orders, and the volume at each price level
+  struct MarketOrder {
+    char chSide;
+    tick_t tick;
+    volume_t nQuantity;
+    uint64_t nPriority;
+    uint64_t nSequence;
+  };
+  using mapMarketOrder_t = std::unordered_map<DepthByOrder::idorder_t,MarketOrder>;
+  mapMarketOrder_t m_mapMarketOrder;
+  using mapMarketVolume_t = std::unordered_map<tick_t,volume_t>;
+  mapMarketVolume_t m_mapMarketVolumeAsk;
+  mapMarketVolume_t m_mapMarketVolumeBid;
+  uint64_t m_nSequence;
 
-  using mapOrderBook_bid_t = std::multimap<double,pOrder_t, std::greater<double> >;
-  mapOrderBook_bid_t m_mapBids; // highest at beginning
-  mapOrderBook_bid_t m_mapBuyStops;  // pending buy stops, turned into market order when touched
+  tick_t ToTick( double dblPrice ) const;
 
   void ProcessOrderQueues( const Quote& quote );
   void CalculateCommission( Order&, Trade::tradesize_t quan );
-  void ProcessCancelQueue( const Quote& quote );
   void ProcessDelayQueue( const Quote& quote );
+  void ProcessSubmit( const pOrder_t&, const Quote& quote );
+  void ProcessCancel( Order::idOrder_t );
   void ProcessStopOrders( const Quote& quote ); // true if order executed, not yet implemented
   bool ProcessMarketOrders( const Quote& quote ); // true if order executed
   bool ProcessLimitOrders( const Quote& quote ); // true if order executed
   bool ProcessLimitOrders( const Trade& trade );
 
-  static int m_nExecId;  // static provides unique number across universe of symbols
-  std::string GetExecId();
+  void Activate( ix_t, EBook, const Quote& quote ); // into a book
+  void Remove( ix_t, EBook ); // out of its book, the entry remains
+  void Fill( ix_t, EBook, double dblPrice, volume_t quan, const char* szTag ); // the entry is released once filled
+
+  bool QueueQuote( const Quote& quote ); // crosses, true if order executed
+  bool QueueQuote( levels_t&, EBook, double dblQuote, volume_t nSize );
+  bool QueueTrade( levels_t&, EBook, tick_t tickTrade, volume_t nVolume );
+  void QueueEstimate( levels_t&, tick_t tickQuote, volume_t nSize );
+  void QueueReduce( MarketOrder&, volume_t nReduce );
+  void QueueAdd( DepthByOrder::idorder_t, const MarketOrder& );
+  void QueueDelete( DepthByOrder::idorder_t );
+  void QueueClear( char chSide );
+
+  static std::atomic<int> m_nExecId;  // static provides unique number across universe of symbols, simulators may run on separate threads
+  static int GetExecId();
 
 };
 
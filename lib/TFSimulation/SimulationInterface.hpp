@@ -118,6 +118,9 @@ typename SimulationInterface<P,S>::pSymbol_t SimulationInterface<P,S>::AddCSymbo
       iter = pair.first;
       EventHolders& eh( iter->second );
       OrderExecution& oe( eh.oe );
+      if ( 0.0 < pSymbol->GetInstrument()->GetMinTick() ) {
+        oe.SetTickSize( pSymbol->GetInstrument()->GetMinTick() );
+      }
       oe.SetOnOrderFill( MakeDelegate( dynamic_cast<P*>( this ), &P::HandleExecution ) );
       oe.SetOnCommission( MakeDelegate( dynamic_cast<P*>( this ), &P::HandleCommission ) );
       oe.SetOnOrderCancelled( MakeDelegate( dynamic_cast<P*>( this ), &P::HandleCancellation ) );
@@ -28,6 +28,8 @@ namespace tf { // TradeFrame
 
 SimulationProvider::SimulationProvider()
 : sim::SimulationInterface<SimulationProvider,SimulationSymbol>()
+, m_nReplayChunkSize {}
+, m_nProcessedDatums {}
 , m_pMerge( nullptr )
 {
   m_sName = "Simulator";
@@ -53,6 +55,7 @@ SimulationProvider::~SimulationProvider() {
 }
 
 void SimulationProvider::SetGroupDirectory( const std::string sGroupDirectory ) {
+  std::scoped_lock<std::mutex> lock( HDF5Mutex() );
   HDF5DataManager dm( HDF5DataManager::RO );
   std::string s;
   if( !dm.GroupExists( sGroupDirectory ) )
@@ -85,7 +88,7 @@ void SimulationProvider::Disconnect() {
 }
 
 SimulationProvider::pSymbol_t SimulationProvider::NewCSymbol( pInstrument_t pInstrument ) {
-  pSymbol_t pSymbol( new SimulationSymbol( pInstrument->GetInstrumentName( ID() ), pInstrument, m_sGroupDirectory) );
+  pSymbol_t pSymbol( new SimulationSymbol( pInstrument->GetInstrumentName( ID() ), pInstrument, m_sGroupDirectory, m_nReplayChunkSize ) );
   inherited_t::AddCSymbol( pSymbol );
   return pSymbol;
 }
@@ -150,6 +153,12 @@ void SimulationProvider::Merge() {
           quotes,
           MakeDelegate( iter->second.get(), &SimulationSymbol::HandleQuoteEvent ) );
       }
+      else if ( !sym->m_sStreamQuotes.empty() ) {
+        m_pMerge -> Add<Quote>(
+          sym->m_sStreamQuotes,
+          MakeDelegate( iter->second.get(), &SimulationSymbol::HandleQuoteEvent ),
+          m_nReplayChunkSize );
+      }
 
       DepthsByMM& depths_mm( sym->m_depths_mm );
       if ( 0 != depths_mm.Size() ) {
@@ -157,6 +166,12 @@ void SimulationProvider::Merge() {
           depths_mm,
           MakeDelegate( iter->second.get(), &SimulationSymbol::HandleDepthByMMEvent ) );
       }
+      else if ( !sym->m_sStreamDepthsByMM.empty() ) {
+        m_pMerge -> Add<DepthByMM>(
+          sym->m_sStreamDepthsByMM,
+          MakeDelegate( iter->second.get(), &SimulationSymbol::HandleDepthByMMEvent ),
+          m_nReplayChunkSize );
+      }
 
       DepthsByOrder& depths_order( sym->m_depths_order );
       if ( 0 != depths_order.Size() ) {
@@ -164,6 +179,12 @@ void SimulationProvider::Merge() {
           depths_order,
           MakeDelegate( iter->second.get(), &SimulationSymbol::HandleDepthByOrderEvent ) );
       }
+      else if ( !sym->m_sStreamDepthsByOrder.empty() ) {
+        m_pMerge -> Add<DepthByOrder>(
+          sym->m_sStreamDepthsByOrder,
+          MakeDelegate( iter->second.get(), &SimulationSymbol::HandleDepthByOrderEvent ),
+          m_nReplayChunkSize );
+      }
 
       Trades& trades( sym->m_trades );
       if ( 0 != trades.Size() ) {
@@ -171,6 +192,12 @@ void SimulationProvider::Merge() {
           trades,
           MakeDelegate( iter->second.get(), &SimulationSymbol::HandleTradeEvent ) );
       }
+      else if ( !sym->m_sStreamTrades.empty() ) {
+        m_pMerge -> Add<Trade>(
+          sym->m_sStreamTrades,
+          MakeDelegate( iter->second.get(), &SimulationSymbol::HandleTradeEvent ),
+          m_nReplayChunkSize );
+      }
 
       Greeks& greeks( sym->m_greeks );
       if ( 0 != greeks.Size() ) {
@@ -178,6 +205,12 @@ void SimulationProvider::Merge() {
           greeks,
           MakeDelegate( iter->second.get(), &SimulationSymbol::HandleGreekEvent ) );
       }
+      else if ( !sym->m_sStreamGreeks.empty() ) {
+        m_pMerge -> Add<Greek>(
+          sym->m_sStreamGreeks,
+          MakeDelegate( iter->second.get(), &SimulationSymbol::HandleGreekEvent ),
+          m_nReplayChunkSize );
+      }
 
   }
 
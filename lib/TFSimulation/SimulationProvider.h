@@ -73,6 +73,12 @@ public:
   void SetGroupDirectory( const std::string sGroupDirectory );  // eg /basket/20080620
   const std::string& GetGroupDirectory() const { return m_sGroupDirectory; };
 
+  // 0 (default): each series is read into memory when its watch starts
+  // otherwise:  series are streamed during the run in chunks of this many datums, two chunks resident per series
+  // like the group directory, set before symbols are added
+  void SetReplayChunkSize( hsize_t nChunkSize ) { m_nReplayChunkSize = nChunkSize; }
+  hsize_t GetReplayChunkSize() const { return m_nReplayChunkSize; }
+
   void Run( bool bAsync = true );
   void Stop();
 
@@ -91,10 +97,12 @@ public:
   }
 
   void EmitStats( std::stringstream& ss );
+  unsigned long GetCountProcessedDatums() const { return m_nProcessedDatums; } // available once the run completes
 
 protected:
 
   std::string m_sGroupDirectory;
+  hsize_t m_nReplayChunkSize;
 
   ptime m_dtSimStart;
   ptime m_dtSimStop;
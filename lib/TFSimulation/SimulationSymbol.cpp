@@ -18,6 +18,7 @@
 #include <TFHDF5TimeSeries/HDF5TimeSeriesContainer.h>
 
 #include "SimulationSymbol.h"
+#include "MergeDatedDatumStream.h" // HDF5Mutex
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -26,26 +27,37 @@ namespace tf { // TradeFrame
 SimulationSymbol::SimulationSymbol(
   const std::string &sSymbol,
   pInstrument_cref pInstrument,
-  const std::string &sGroup
+  const std::string &sGroup,
+  hsize_t nReplayChunkSize
   )
 : Symbol<SimulationSymbol>( pInstrument ), m_sDirectory( sGroup )
+, m_nReplayChunkSize( nReplayChunkSize )
 {
 }
 
 SimulationSymbol::~SimulationSymbol() {
 }
 
-void SimulationSymbol::StartTradeWatch() {
-  if ( 0 == m_trades.Size() ) {
+// preload:  read the whole dataset into the series
+// stream:  only note the path, MergeCarrierStream reads the dataset in chunks during the run
+template<class DD>
+void SimulationSymbol::Load( const std::string& sDirectory, TimeSeries<DD>& series, std::string& sStream ) {
+  if ( ( 0 == series.Size() ) && sStream.empty() ) {
     try {
-      std::string sPath( m_sDirectory + Trades::Directory() + GetId() );
+      std::scoped_lock<std::mutex> lock( HDF5Mutex() ); // simulations may be set up in parallel
+      std::string sPath( m_sDirectory + sDirectory + GetId() );
       ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
-      HDF5TimeSeriesContainer<Trade> tradeRepository( dm, sPath );
-      HDF5TimeSeriesContainer<Trade>::iterator begin, end;
-      begin = tradeRepository.begin();
-      end = tradeRepository.end();
-      m_trades.Resize( end - begin );
-      tradeRepository.Read( begin, end, &m_trades );
+      HDF5TimeSeriesContainer<DD> repository( dm, sPath );
+      typename HDF5TimeSeriesContainer<DD>::iterator begin, end;
+      begin = repository.begin();
+      end = repository.end();
+      if ( 0 != m_nReplayChunkSize ) {
+        if ( begin != end ) sStream = sPath;
+      }
+      else {
+        series.Resize( end - begin );
+        repository.Read( begin, end, &series );
+      }
     }
     catch ( std::runtime_error &e ) {
       // couldn't do read, so leave as empty
@@ -53,45 +65,23 @@ void SimulationSymbol::StartTradeWatch() {
   }
 }
 
+void SimulationSymbol::StartTradeWatch() {
+  Load( Trades::Directory(), m_trades, m_sStreamTrades );
+}
+
 void SimulationSymbol::StopTradeWatch() {
 }
 
 void SimulationSymbol::StartQuoteWatch() {
-  if ( 0 == m_quotes.Size() ) {
-    try {
-      std::string sPath( m_sDirectory + Quotes::Directory() + GetId() );
-      ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
-      HDF5TimeSeriesContainer<Quote> quoteRepository( dm, sPath );
-      HDF5TimeSeriesContainer<Quote>::iterator begin, end;
-      begin = quoteRepository.begin();
-      end = quoteRepository.end();
-      m_quotes.Resize( end - begin );
-      quoteRepository.Read( begin, end, &m_quotes );
-    }
-    catch ( std::runtime_error &e ) {
-      // couldn't do read, so leave as empty
-    }
-  }
+  Load( Quotes::Directory(), m_quotes, m_sStreamQuotes );
 }
 
 void SimulationSymbol::StopQuoteWatch() {
 }
 
 void SimulationSymbol::StartGreekWatch() {
-  if ( ( 0 == m_greeks.Size() ) && ( m_pInstrument->IsOption() ) )  {
-    try {
-      std::string sPath( m_sDirectory + Greeks::Directory() + GetId() );
-      ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
-      HDF5TimeSeriesContainer<Greek> greekRepository( dm, sPath );
-      HDF5TimeSeriesContainer<Greek>::iterator begin, end;
-      begin = greekRepository.begin();
-      end = greekRepository.end();
-      m_greeks.Resize( end - begin );
-      greekRepository.Read( begin, end, &m_greeks );
-    }
-    catch ( std::runtime_error &e ) {
-      // couldn't do read, so leave as empty
-    }
+  if ( m_pInstrument->IsOption() ) {
+    Load( Greeks::Directory(), m_greeks, m_sStreamGreeks );
   }
 }
 
@@ -99,69 +89,41 @@ void SimulationSymbol::StopGreekWatch() {
 }
 
 void SimulationSymbol::StartDepthByMMWatch() {
-  if ( 0 == m_depths_mm.Size() )  {
-    try {
-      std::string sPath( m_sDirectory + DepthsByMM::Directory() + GetId() );
-      ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
-      HDF5TimeSeriesContainer<DepthByMM> depthRepository( dm, sPath );
-      HDF5TimeSeriesContainer<DepthByMM>::iterator begin, end;
-      begin = depthRepository.begin();
-      end = depthRepository.end();
-      m_depths_mm.Resize( end - begin );
-      depthRepository.Read( begin, end, &m_depths_mm );
-    }
-    catch ( std::runtime_error &e ) {
-      // couldn't do read, so leave as empty
-    }
-  }
+  Load( DepthsByMM::Directory(), m_depths_mm, m_sStreamDepthsByMM );
 }
 
 void SimulationSymbol::StopDepthByMMWatch() {
 }
 
 void SimulationSymbol::StartDepthByOrderWatch() {
-  if ( 0 == m_depths_order.Size() )  {
-    try {
-      std::string sPath( m_sDirectory + DepthsByOrder::Directory() + GetId() );
-      ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
-      HDF5TimeSeriesContainer<DepthByOrder> depthRepository( dm, sPath );
-      HDF5TimeSeriesContainer<DepthByOrder>::iterator begin, end;
-      begin = depthRepository.begin();
-      end = depthRepository.end();
-      m_depths_order.Resize( end - begin );
-      depthRepository.Read( begin, end, &m_depths_order );
-    }
-    catch ( std::runtime_error &e ) {
-      // couldn't do read, so leave as empty
-    }
-  }
+  Load( DepthsByOrder::Directory(), m_depths_order, m_sStreamDepthsByOrder );
 }
 
 void SimulationSymbol::StopDepthByOrderWatch() {
 }
 
 void SimulationSymbol::HandleQuoteEvent( const DatedDatum &datum ) {
-  const Quote& quote( dynamic_cast<const Quote &>( datum ) );
+  const Quote& quote( static_cast<const Quote &>( datum ) );
   STRAND_CAPTURE( (m_OnQuote( quote )), quote )
 }
 
 void SimulationSymbol::HandleTradeEvent( const DatedDatum &datum ) {
-  const Trade& trade( dynamic_cast<const Trade &>( datum ) );
+  const Trade& trade( static_cast<const Trade &>( datum ) );
   STRAND_CAPTURE( (m_OnTrade( trade )), trade )
 }
 
 void SimulationSymbol::HandleGreekEvent( const DatedDatum &datum ) {
-  const Greek& greek( dynamic_cast<const Greek &>( datum ) );
+  const Greek& greek( static_cast<const Greek &>( datum ) );
   STRAND_CAPTURE( (m_OnGreek( greek )), greek )
 }
 
 void SimulationSymbol::HandleDepthByMMEvent( const DatedDatum &datum ) {
-  const DepthByMM& md( dynamic_cast<const DepthByMM &>( datum ) );
+  const DepthByMM& md( static_cast<const DepthByMM &>( datum ) );
   STRAND_CAPTURE( (m_OnDepthByMM( md )), md )
 }
 
 void SimulationSymbol::HandleDepthByOrderEvent( const DatedDatum &datum ) {
-  const DepthByOrder& md( dynamic_cast<const DepthByOrder &>( datum ) );
+  const DepthByOrder& md( static_cast<const DepthByOrder &>( datum ) );
   STRAND_CAPTURE( (m_OnDepthByOrder( md )), md )
 }
 
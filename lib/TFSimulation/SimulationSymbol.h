@@ -18,6 +18,8 @@
 
 #include <TFTimeSeries/TimeSeries.h>
 
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+
 #include <TFTrading/Symbol.h>
 
 namespace ou { // One Unified
@@ -33,7 +35,8 @@ public:
 
   SimulationSymbol( const std::string& sSymbol,
                     pInstrument_cref pInstrument,
-                    const std::string& sGroup ); // base with trades/ quotes/, greeks/, depths/
+                    const std::string& sGroup, // base with trades/ quotes/, greeks/, depths/
+                    hsize_t nReplayChunkSize = 0 ); // 0: preload series, otherwise stream in chunks of this many datums
   virtual ~SimulationSymbol();
 
 protected:
@@ -63,6 +66,7 @@ protected:
 private:
 
   std::string m_sDirectory;
+  hsize_t m_nReplayChunkSize;
 
   Quotes m_quotes;
   Trades m_trades;
@@ -70,6 +74,16 @@ private:
   DepthsByOrder m_depths_order;
   Greeks m_greeks;
 
+  // dataset paths when streaming, empty when preloaded or not available
+  std::string m_sStreamQuotes;
+  std::string m_sStreamTrades;
+  std::string m_sStreamDepthsByMM;
+  std::string m_sStreamDepthsByOrder;
+  std::string m_sStreamGreeks;
+
+  template<class DD>
+  void Load( const std::string& sDirectory, TimeSeries<DD>& series, std::string& sStream );
+
 };
 
 } // namespace tf
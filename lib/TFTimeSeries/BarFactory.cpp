@@ -22,7 +22,7 @@ namespace ou { // One Unified
 namespace tf { // TradeFrame
 
 BarFactory::BarFactory(duration_t nSeconds) : 
-  m_nBarWidthSeconds( std::max<duration_t>( 1, nSeconds ) ), m_1Sec( time_duration( 0, 0, 1 ) ), m_curInterval( 0 ) 
+  m_nBarWidthSeconds( std::max<duration_t>( 1, nSeconds ) ), m_curInterval( 0 ) 
 {
 }
 
@@ -33,6 +33,7 @@ BarFactory::~BarFactory(void) {
 }
 
 void BarFactory::Add(const ptime &dt, price_t val, volume_t volume) {
+  const ou::Timestamp ts( dt );
   duration_t seconds = dt.time_of_day().total_seconds();
   duration_t interval = seconds / m_nBarWidthSeconds;
   if ( m_bar.IsNull() ) {
@@ -43,7 +44,7 @@ void BarFactory::Add(const ptime &dt, price_t val, volume_t volume) {
     m_bar.Volume( volume );
     m_curInterval = interval;
     m_bar.DateTime( ptime( dt.date(), time_duration( 0, 0, interval * m_nBarWidthSeconds, 0 ) ) );
-    m_dtLastIntermediateEmission = dt - m_1Sec; // prime the value
+    m_tsLastIntermediateEmission = ts - ou::Timestamp::nsPerSecond; // prime the value
     if ( 0 != OnNewBarStarted ) OnNewBarStarted( m_bar );
   }
   else {
@@ -66,9 +67,9 @@ void BarFactory::Add(const ptime &dt, price_t val, volume_t volume) {
 
     }
   }
-  if ( m_1Sec <= ( dt - m_dtLastIntermediateEmission ) ) {
+  if ( ou::Timestamp::nsPerSecond <= ( ts - m_tsLastIntermediateEmission ) ) {
     if ( 0 != OnBarUpdated ) OnBarUpdated( m_bar );
-    m_dtLastIntermediateEmission = dt;
+    m_tsLastIntermediateEmission = ts;
   }
   
 }
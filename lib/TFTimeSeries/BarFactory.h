@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <OUCommon/Timestamp.h>
+
 #include "DatedDatum.h"
 
 #include <OUCommon/FastDelegate.h>
@@ -55,8 +57,7 @@ protected:
   duration_t m_nBarWidthSeconds;
   duration_t m_curInterval; // current bar interval
   ptime m_dtBarStart;
-  ptime m_dtLastIntermediateEmission; // changes emitted no less than 1 second apart
-  boost::posix_time::time_duration m_1Sec;
+  ou::Timestamp m_tsLastIntermediateEmission; // changes emitted no less than 1 second apart
 
   Bar m_bar;
 
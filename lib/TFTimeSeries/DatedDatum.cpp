@@ -31,10 +31,6 @@ DatedDatum::DatedDatum( const boost::posix_time::ptime dt )
 : m_dt( dt )
 {}
 
-DatedDatum::DatedDatum( const DatedDatum& datum )
-: m_dt( datum.m_dt )
-{}
-
 DatedDatum::DatedDatum(const std::string& dt) {
   //m_dt = boost::posix_time::time_from_string(dt);
   assert( dt.length() == 19 );
@@ -44,9 +40,6 @@ DatedDatum::DatedDatum(const std::string& dt) {
     boost::posix_time::time_duration( atoi( s + 11 ), atoi( s + 14 ), atoi( s + 17 ) ) );
 }
 
-DatedDatum::~DatedDatum() {
-}
-
 H5::CompType* DatedDatum::DefineDataType( H5::CompType* pComp ) {
   if ( NULL == pComp ) pComp = new H5::CompType( sizeof( DatedDatum ) );
   pComp->insertMember( "DateTime", HOFFSET( DatedDatum, m_dt ), H5::PredType::NATIVE_LLONG );
@@ -65,12 +58,6 @@ Quote::Quote( const ptime dt )
 : DatedDatum(dt), m_dblBid( 0 ), m_dblAsk( 0 ), m_nBidSize( 0 ), m_nAskSize( 0 )
 {}
 
-Quote::Quote( const Quote& quote )
-: DatedDatum( quote.m_dt )
-, m_dblBid( quote.m_dblBid ), m_dblAsk( quote.m_dblAsk )
-, m_nBidSize( quote.m_nBidSize ), m_nAskSize( quote.m_nAskSize )
-{}
-
 Quote::Quote( const ptime dt, price_t dblBid, bidsize_t nBidSize, price_t dblAsk, asksize_t nAskSize )
 : DatedDatum( dt )
 , m_dblBid( dblBid ), m_dblAsk( dblAsk )
@@ -88,9 +75,6 @@ Quote::Quote( const std::string& dt, const std::string& bid,
   m_nAskSize = atoi( asksize.c_str() );
 }
 
-Quote::~Quote() {
-}
-
 bool Quote::IsValid() const {
   bool bOk( true );
   //bOk &= ( ( 0 == m_nBidSize ) && ( 0.0 == m_dblBid ) ); // NOTE: some options are zero bid
@@ -132,10 +116,6 @@ Trade::Trade( const ptime dt )
 : DatedDatum(dt), m_dblPrice( 0 ), m_nTradeSize( 0 )
 {}
 
-Trade::Trade( const Trade& trade )
-: DatedDatum( trade.m_dt ), m_dblPrice( trade.m_dblPrice ), m_nTradeSize( trade.m_nTradeSize )
-{}
-
 Trade::Trade( const ptime dt, price_t dblTrade, volume_t nTradeSize )
 : DatedDatum( dt ), m_dblPrice( dblTrade ), m_nTradeSize( nTradeSize )
 {}
@@ -148,9 +128,6 @@ Trade::Trade( const std::string& dt, const std::string& trade, const std::string
   m_nTradeSize = atoi( size.c_str() );
 }
 
-Trade::~Trade() {
-}
-
 H5::CompType* Trade::DefineDataType( H5::CompType* pComp ) {
   if ( NULL == pComp ) pComp = new H5::CompType( sizeof( Trade ) );
   DatedDatum::DefineDataType( pComp );
@@ -169,10 +146,6 @@ Bar::Bar( const ptime dt)
 : DatedDatum( dt ), m_dblOpen( 0 ), m_dblHigh( 0 ), m_dblLow( 0 ), m_dblClose( 0 ), m_nVolume( 0 )
 {}
 
-Bar::Bar(const Bar& bar): DatedDatum( bar.m_dt ),
-  m_dblOpen( bar.m_dblOpen ), m_dblHigh( bar.m_dblHigh ), m_dblLow( bar.m_dblLow ), m_dblClose( bar.m_dblClose ), m_nVolume( bar.m_nVolume ) {
-}
-
 Bar::Bar( const boost::posix_time::ptime dt, price_t dblOpen, price_t dblHigh, price_t dblLow, price_t dblClose, volume_t nVolume )
 : DatedDatum( dt )
 , m_dblOpen( dblOpen ), m_dblHigh( dblHigh ), m_dblLow( dblLow ), m_dblClose( dblClose ), m_nVolume( nVolume )
@@ -191,9 +164,6 @@ Bar::Bar( const std::string& dt, const std::string& open,
   m_nVolume = atoi( volume.c_str() );
 }
 
-Bar::~Bar() {
-}
-
 H5::CompType* Bar::DefineDataType( H5::CompType* pComp ) {
   if ( NULL == pComp ) pComp = new H5::CompType( sizeof( Bar ) );
   DatedDatum::DefineDataType( pComp );
@@ -217,12 +187,6 @@ Depth::Depth( const dt_t dt )
 : DatedDatum( dt ), m_dblPrice {}, m_nShares {}, m_chMsgType( '0' ), m_chSide( ' ' )
 {}
 
-Depth::Depth( const Depth& depth )
-: DatedDatum( depth.m_dt )
-, m_dblPrice( depth.m_dblPrice ), m_nShares( depth.m_nShares)
-, m_chMsgType( depth.m_chMsgType ), m_chSide( depth.m_chSide )
-{}
-
 Depth::Depth( const dt_t dt, price_t dblPrice, quotesize_t nShares )
 : DatedDatum( dt ), m_dblPrice( dblPrice ), m_nShares( nShares ), m_chMsgType( '0' ), m_chSide( '0' )
 {}
@@ -235,8 +199,6 @@ Depth::Depth( const dt_t dt, char chMsgType, char chSide, price_t dblPrice, quot
 : DatedDatum( dt ), m_dblPrice( dblPrice ), m_nShares( nShares ), m_chMsgType( chMsgType ), m_chSide( chSide )
 {}
 
-Depth::~Depth() {}
-
 H5::CompType* Depth::DefineDataType( H5::CompType* pComp ) {
   if ( NULL == pComp ) pComp = new H5::CompType( sizeof( Depth ) );
   DatedDatum::DefineDataType( pComp );
@@ -255,10 +217,6 @@ DepthByMM::DepthByMM(): Depth() {}
 
 DepthByMM::DepthByMM( const ptime dt ): Depth( dt ) {}
 
-DepthByMM::DepthByMM( const DepthByMM& depth )
-: Depth( depth ), m_uMMID( depth.m_uMMID )
-{}
-
 DepthByMM::DepthByMM( const boost::posix_time::ptime dt, char chMsgType, char chSide, volume_t nShares, price_t dblPrice, char* pch )
 : Depth( dt, dblPrice, nShares, chMsgType, chSide ), m_uMMID( pch )
 {}
@@ -267,8 +225,6 @@ DepthByMM::DepthByMM( const boost::posix_time::ptime dt, char chMsgType, char ch
 : Depth( dt, chMsgType, chSide, dblPrice, nShares ), m_uMMID( mmid )
 {}
 
-DepthByMM::~DepthByMM() {}
-
 H5::CompType* DepthByMM::DefineDataType( H5::CompType* pComp ) {
   if ( NULL == pComp ) pComp = new H5::CompType( sizeof( DepthByMM ) );
   Depth::DefineDataType( pComp );
@@ -295,20 +251,12 @@ DepthByOrder::DepthByOrder( const ptime dt )
 , m_nOrderID {}, m_nPriority {}
 {}
 
-DepthByOrder::DepthByOrder( const DepthByOrder& depth )
-: Depth( depth )
-, m_dtMarket( depth.m_dtMarket )
-, m_nOrderID( depth.m_nOrderID ), m_nPriority( depth.m_nPriority )
-{}
-
 DepthByOrder::DepthByOrder( const dt_t dt, const dt_t dtMarket, idorder_t nOrderID, uint64_t nPriority, char chMsgType, char chSide, price_t dblPrice, volume_t nShares)
 : Depth( dt, chMsgType, chSide, dblPrice, nShares )
 , m_dtMarket( dtMarket )
 , m_nOrderID( nOrderID ), m_nPriority( nPriority )
 {}
 
-DepthByOrder::~DepthByOrder() {}
-
 H5::CompType* DepthByOrder::DefineDataType( H5::CompType* pComp ) {
   if ( NULL == pComp ) pComp = new H5::CompType( sizeof( DepthByOrder ) );
   Depth::DefineDataType( pComp );
@@ -330,12 +278,6 @@ Greek::Greek( const ptime dt )
 : DatedDatum(dt), m_dblImpliedVolatility( 0 ), m_dblDelta( 0 ), m_dblGamma( 0 ), m_dblTheta( 0 ), m_dblVega( 0 ), m_dblRho( 0 )
 {}
 
-Greek::Greek( const Greek& greeks )
-: DatedDatum( greeks.m_dt )
-, m_dblImpliedVolatility( greeks.m_dblImpliedVolatility )
-, m_dblDelta( greeks.m_dblDelta ), m_dblGamma( greeks.m_dblGamma ), m_dblTheta( greeks.m_dblTheta ), m_dblVega( greeks.m_dblVega ), m_dblRho( greeks.m_dblRho )
-{}
-
 Greek::Greek( const ptime dt, double dblImpliedVolatility, const greeks_t& greeks )
 : DatedDatum( dt )
 , m_dblImpliedVolatility( dblImpliedVolatility )
@@ -348,9 +290,6 @@ Greek::Greek( const boost::posix_time::ptime dt, double dblImpliedVolatility, do
 , m_dblDelta( dblDelta ), m_dblGamma( dblGamma ), m_dblTheta( dblTheta ), m_dblVega( dblVega ), m_dblRho( dblRho )
 {}
 
-Greek::~Greek() {
-}
-
 H5::CompType* Greek::DefineDataType( H5::CompType* pComp ) {
   if ( NULL == pComp ) pComp = new H5::CompType( sizeof( Greek ) );
   DatedDatum::DefineDataType( pComp );
@@ -375,10 +314,6 @@ Price::Price( const ptime dt )
 : DatedDatum( dt ), m_dblPrice( 0 )
 {}
 
-Price::Price( const Price& price)
-: DatedDatum( price.m_dt ), m_dblPrice( price.m_dblPrice )
-{}
-
 Price::Price( const ptime dt, price_t dblPrice )
 : DatedDatum( dt ), m_dblPrice( dblPrice )
 {}
@@ -389,9 +324,6 @@ DatedDatum( dt ) {
   m_dblPrice = strtod( price.c_str(), &stopchar );
 }
 
-Price::~Price() {
-}
-
 H5::CompType* Price::DefineDataType( H5::CompType* pComp ) {
   if ( NULL == pComp ) pComp = new H5::CompType( sizeof( Price ) );
   DatedDatum::DefineDataType( pComp );
@@ -410,10 +342,6 @@ PriceIV::PriceIV( const ptime dt )
 : Price( dt ),  m_dblIVCall( 0.0 ), m_dblIVPut( 0.0 )
 {}
 
-PriceIV::PriceIV( const PriceIV& rhs )
-  : Price( rhs.m_dt, rhs.Value() ), m_dblIVCall( rhs.m_dblIVCall ), m_dblIVPut( rhs.m_dblIVPut )
-{}
-
 PriceIV::PriceIV( const ptime dtSampled, price_t dblPrice, double dblIVCall, double dblIVPut )
 : Price( dtSampled, dblPrice ), m_dblIVCall( dblIVCall ), m_dblIVPut( dblIVPut )
 {}
@@ -437,10 +365,6 @@ PriceIVExpiry::PriceIVExpiry( const ptime dt )
 : Price( dt ), m_dtExpiry( not_a_date_time), m_dblIVCall( 0.0 ), m_dblIVPut( 0.0 )
 {}
 
-PriceIVExpiry::PriceIVExpiry( const PriceIVExpiry& rhs )
-: Price( rhs.m_dt, rhs.Value() ), m_dtExpiry( rhs.m_dtExpiry ), m_dblIVCall( rhs.m_dblIVCall ), m_dblIVPut( rhs.m_dblIVPut )
-{}
-
 PriceIVExpiry::PriceIVExpiry( const ptime dtSampled, price_t dblPrice, const ptime& dtExpiry, double dblIVCall, double dblIVPut )
 : Price( dtSampled, dblPrice ), m_dtExpiry( dtExpiry ), m_dblIVCall( dblIVCall ), m_dblIVPut( dblIVPut )
 {}
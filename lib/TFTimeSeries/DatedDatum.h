@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include <hdf5/H5Cpp.h>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -26,7 +28,11 @@ using namespace boost::posix_time;
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 
-// TODO: convert to crtp, remove virtual destructor?
+// datums are plain values:  no virtual functions, no vptr, trivially copyable
+//   TimeSeries<T> storage is dense, containers may memcpy them,
+//   and a DatedDatum& handed out by MergeCarrier<T> can be static_cast back to T
+// HDF5 compound members are matched by name, so files written with the former
+//   (vptr offset) layout continue to read
 
 class DatedDatum {
 public:
@@ -40,9 +46,8 @@ public:
 
   DatedDatum();
   DatedDatum( const dt_t dt );
-  DatedDatum( const DatedDatum& datum );
+  DatedDatum( const DatedDatum& ) = default;
   DatedDatum( const std::string& dt ); // YYYY-MM-DD HH:MM:SS
-  virtual ~DatedDatum();
 
   inline bool IsNull() const { return m_dt.is_not_a_date_time(); }
 
@@ -78,12 +83,11 @@ public:
 
   Quote();
   Quote( const dt_t dt );
-  Quote( const Quote& quote );
+  Quote( const Quote& ) = default;
   Quote( const dt_t dt, double dblBid, bidsize_t nBidSize, double dblAsk, asksize_t nAskSize );
   Quote( const std::string& dt,
     const std::string& bid, const std::string& bidsize,
     const std::string& ask, const std::string& asksize );
-  virtual ~Quote();
 
   inline price_t Bid() const { return m_dblBid; }
   inline price_t Ask() const { return m_dblAsk; }
@@ -121,10 +125,9 @@ public:
 
   Trade();
   Trade( const dt_t dt );
-  Trade( const Trade &trade );
+  Trade( const Trade& ) = default;
   Trade( const dt_t dt, price_t dblTrade, volume_t nTradeSize );
   Trade( const std::string& dt, const std::string& trade, const std::string& size );
-  virtual ~Trade();
 
   inline price_t Price() const { return m_dblPrice; }  // 20120715 was Trace, may cause problems in other areas.
   inline volume_t Volume() const { return m_nTradeSize; }
@@ -147,11 +150,10 @@ public:
 
   Bar();
   Bar( const dt_t dt );
-  Bar( const Bar& bar );
+  Bar( const Bar& ) = default;
   Bar( const dt_t dt, price_t dblOpen, price_t dblHigh, price_t dblLow, price_t dblClose, volume_t nVolume );
   Bar( const std::string& dt, const std::string& open, const std::string& high,
     const std::string& low, const std::string& close, const std::string& volume );
-  virtual ~Bar();
 
   inline price_t Open() const { return m_dblOpen; }
   inline price_t High() const { return m_dblHigh; }
@@ -186,11 +188,10 @@ public:
 
   Depth();
   Depth( const dt_t );
-  Depth( const Depth& );
+  Depth( const Depth& ) = default;
   explicit Depth( const dt_t, price_t, volume_t ); // quicky temp build
   explicit Depth( const dt_t, char chSide, price_t, volume_t ); // quicky temp build
   explicit Depth( const dt_t, char chMsgType, char chSide, price_t, quotesize_t );
-  virtual ~Depth();
 
   inline char MsgType() const { return m_chMsgType; }
   inline char Side() const { return m_chSide; }
@@ -221,10 +222,9 @@ public:
 
   DepthByMM();
   DepthByMM( const dt_t );
-  DepthByMM( const DepthByMM& );
+  DepthByMM( const DepthByMM& ) = default;
   explicit DepthByMM( const dt_t, char chMsgType, char chSide, volume_t nShares, price_t dblPrice, char* pch );
   explicit DepthByMM( const dt_t, char chMsgType, char chSide, volume_t nShares, price_t dblPrice, MMID_t mmid );
-  virtual ~DepthByMM();
 
   static MMID_t Cast( const char* rchMMID ) {
     unionMMID ummid( rchMMID );
@@ -253,7 +253,7 @@ private:
     char rch[4];
     unionMMID() { mmid = 0; }
     unionMMID( MMID_t id ): mmid( id ) {}
-    unionMMID( const unionMMID &u ): mmid( u.mmid ) {}
+    unionMMID( const unionMMID& ) = default;
     unionMMID( const char* pch ) {
       char* p = rch;
       for ( int ix = 0; ix < 4; ix++ ) {
@@ -282,9 +282,8 @@ public:
 
   DepthByOrder();
   DepthByOrder( const dt_t );
-  DepthByOrder( const DepthByOrder& );
+  DepthByOrder( const DepthByOrder& ) = default;
   explicit DepthByOrder( const dt_t, const dt_t dtMarket, idorder_t, uint64_t nPriority, char chMsgType, char chSide, price_t dblPrice = 0.0, volume_t nShares = 0 );
-  virtual ~DepthByOrder();
 
   inline idorder_t OrderID() const { return m_nOrderID; }
   inline uint64_t Priority() const { return m_nPriority; }
@@ -321,10 +320,9 @@ public:
 
   Greek();
   Greek( const dt_t dt );
-  Greek( const Greek& greeks );
+  Greek( const Greek& ) = default;
   Greek( const dt_t dt, double dblImpliedVolatility, const greeks_t& greeks );
   Greek( const dt_t dt, double dblImpliedVolatility, double dblDelta, double dblGamma, double dblTheta, double dblVega, double dblRho );
-  virtual ~Greek();
 
   inline double ImpliedVolatility() const { return m_dblImpliedVolatility; }
   inline double Delta() const { return m_dblDelta; }
@@ -374,10 +372,9 @@ public:
 
   Price();
   Price( const dt_t dt );
-  Price( const Price& price );
+  Price( const Price& ) = default;
   Price( const dt_t dt, price_t dblPrice );
   Price( const std::string &dt, const std::string& price );
-  virtual ~Price();
 
   inline price_t Value() const { return m_dblPrice; };  // 20120715 was Price, is going to cause some problems in some code somewhere as is now class name
 
@@ -397,9 +394,8 @@ class PriceIV: public Price {
 public:
   PriceIV();
   PriceIV( const dt_t dt );
-  PriceIV( const PriceIV& rhs );
+  PriceIV( const PriceIV& ) = default;
   PriceIV( const dt_t dtSampled, price_t dblPrice, double dblIVCall, double dblIVPut );
-  virtual ~PriceIV() {};
 
   inline double IVCall() const { return m_dblIVCall; }
   inline double IVPut() const { return m_dblIVPut; }
@@ -422,9 +418,8 @@ class PriceIVExpiry: public Price {
 public:
   PriceIVExpiry();
   PriceIVExpiry( const dt_t dt );
-  PriceIVExpiry( const PriceIVExpiry& rhs );
+  PriceIVExpiry( const PriceIVExpiry& ) = default;
   PriceIVExpiry( const dt_t dtSampled, price_t dblPrice, const dt_t& dtExpiry, double dblIVCall, double dblIVPut );
-  virtual ~PriceIVExpiry() {};
 
   inline double IVCall() const { return m_dblIVCall; };
   inline double IVPut() const { return m_dblIVPut; };
@@ -440,6 +435,22 @@ private:
   double m_dblIVPut;
 };
 
+static_assert( std::is_trivially_copyable_v<DatedDatum> );
+static_assert( std::is_trivially_copyable_v<Quote> );
+static_assert( std::is_trivially_copyable_v<Trade> );
+static_assert( std::is_trivially_copyable_v<Bar> );
+static_assert( std::is_trivially_copyable_v<Depth> );
+static_assert( std::is_trivially_copyable_v<DepthByMM> );
+static_assert( std::is_trivially_copyable_v<DepthByOrder> );
+static_assert( std::is_trivially_copyable_v<Greek> );
+static_assert( std::is_trivially_copyable_v<Price> );
+static_assert( std::is_trivially_copyable_v<PriceIV> );
+static_assert( std::is_trivially_copyable_v<PriceIVExpiry> );
+
+static_assert( !std::is_polymorphic_v<DatedDatum> );
+static_assert( sizeof( Quote ) == sizeof( DatedDatum::dt_t ) + 2 * sizeof( DatedDatum::price_t ) + 2 * sizeof( DatedDatum::quotesize_t ) );
+static_assert( sizeof( Trade ) == sizeof( DatedDatum::dt_t ) + sizeof( DatedDatum::price_t ) + sizeof( DatedDatum::volume_t ) );
+
 } // namespace tf
 } // namespace ou
 
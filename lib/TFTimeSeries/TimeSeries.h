@@ -381,14 +381,8 @@ typename TimeSeries<T>::const_iterator TimeSeries<T>::AtOrAfter( const dt_t &dt
   // assumes valid access, else undefined
   // TODO: Check that this is correct
   T key( dt );
-  std::pair<const_iterator, const_iterator> p;
   //strict_lock<TimeSeries<T> > guard(*this);
-  p = equal_range( m_vSeries.begin(), m_vSeries.end(), key );
-//  if ( p.first != p.second ) {
-//    m_vIterator = p.first;
-//  }
-//  return &(*m_vIterator);
-  return p.first;
+  return std::lower_bound( m_vSeries.cbegin(), m_vSeries.cend(), key ); // first of equal_range, without the second search
 }
 
 template<typename T>
@@ -397,10 +391,8 @@ typename TimeSeries<T>::const_iterator TimeSeries<T>::After( const dt_t &dt ) co
   // assumes valid access, else undefined
   // TODO: Check that this is correct
   T key( dt );
-  std::pair<const_iterator, const_iterator> p;
   //strict_lock<TimeSeries<T> > guard(*this);
-  p = equal_range( m_vSeries.begin(), m_vSeries.end(), key );
-  return p.second;
+  return std::upper_bound( m_vSeries.cbegin(), m_vSeries.cend(), key );
 }
 
 template<typename T>
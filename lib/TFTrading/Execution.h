@@ -118,6 +118,7 @@ public:
   const std::string& GetExchangeExecutionId() const { return m_row.sExchangeExecutionId; };
   ptime GetTimeStamp() const { return m_row.dtExecutionTimeStamp; };
   void SetOrderId( idOrder_t idOrder ) { m_row.idOrder = idOrder; };
+  void SetExecutionId( idExecution_t idExecution ) { m_row.idExecution = idExecution; }; // when not keyed by the db
 
   const TableRowDef& GetRow() const { return m_row; };
 
@@ -13,6 +13,7 @@
 
 #include <OUCommon/TimeSource.h>
 
+#include "WriteBehind.h"
 #include "OrderManager.h"
 
 namespace ou { // One Unified
@@ -22,12 +23,36 @@ namespace tf { // TradeFrame
 // OrderManager
 //
 
-OrderManager::OrderManager() {
+OrderManager::OrderManager()
+: m_idExecution {}
+{
 }
 
 OrderManager::~OrderManager() {
 }
 
+void OrderManager::EnableWriteBehind( const std::string& sJournalFileName ) {
+  assert( nullptr == m_pSession );
+  m_sWriteBehindJournal = sJournalFileName;
+}
+
+void OrderManager::FlushWriteBehind() {
+  if ( m_pWriteBehind ) {
+    m_pWriteBehind->Flush();
+  }
+}
+
+template<class F>
+void OrderManager::Persist( EStatement eStatement, const std::string& sUpdate, F& f ) {
+  if ( m_pWriteBehind ) {
+    m_pWriteBehind->Append( eStatement, f );
+  }
+  else {
+    typename ou::db::QueryFields<F>::pQueryFields_t pQuery
+      = m_pSession->SQL<F>( sUpdate, f ).Where( "orderid=?" ); // todo:  cache this query
+  }
+}
+
 Order::idOrder_t OrderManager::CheckOrderId( idOrder_t id ) {
   idOrder_t oldId = m_orderIds.GetCurrentId();
   if ( id > oldId ) {
@@ -112,8 +137,13 @@ bool OrderManager::ConstructOrder( pOrder_t& pOrder ) {
 
       if ( nullptr != m_pSession ) { // add to database
         assert( 0 != pOrder->GetRow().idPosition );
-        ou::db::QueryFields<Order::TableRowDef>::pQueryFields_t pQuery
-          = m_pSession->Insert<Order::TableRowDef>( const_cast<Order::TableRowDef&>( pOrder->GetRow() ) );
+        if ( m_pWriteBehind ) {
+          m_pWriteBehind->Append( EInsertOrder, pOrder->GetRow() );
+        }
+        else {
+          ou::db::QueryFields<Order::TableRowDef>::pQueryFields_t pQuery
+            = m_pSession->Insert<Order::TableRowDef>( const_cast<Order::TableRowDef&>( pOrder->GetRow() ) );
+        }
       }
       bOk = true;
     }
@@ -156,6 +186,9 @@ namespace OrderManagerQueries {
     double dblSignalPrice;
     std::string sDescription;
 
+    UpdateAtPlaceOrder1()
+    : idOrder {}, eTimeInForce {}, idParent {}, bTransmit {}, bOutsideRTH {}
+    , eOrderStatus {}, dblSignalPrice {} {}
     UpdateAtPlaceOrder1(
       ETimeInForce eTimeInForce_, ptime dtGoodTillDate_, ptime dtGoodAfterTime_
     , Order::idOrder_t idParent_, bool bTransmit_, bool bOutsideRTH_
@@ -167,6 +200,13 @@ namespace OrderManagerQueries {
     , idOrder( id ), dtOrderSubmitted( dtOrderSubmitted_ ), eOrderStatus( status )
     , dblSignalPrice( dblSignalPrice_ ), sDescription( sDescription_) {};
   };
+
+  const std::string sUpdateAtPlaceOrder1(
+    "update orders set"
+    " timeinforce=?, goodtilldate=?, goodaftertime=?"
+    ", parentid=?, transmit=?, outsiderth=?"
+    ", orderstatus=?, datetimesubmitted=?"
+    ", signalprice=?, description=?" );
 }
 
 void OrderManager::PlaceOrder(ProviderInterfaceBase *pProvider, pOrder_t pOrder) {
@@ -186,14 +226,7 @@ void OrderManager::PlaceOrder(ProviderInterfaceBase *pProvider, pOrder_t pOrder)
             , pOrder->GetOrderId(), pOrder->GetRow().eOrderStatus, pOrder->GetRow().dtOrderSubmitted
             , pOrder->GetRow().dblSignalPrice, pOrder->GetRow().sDescription
           );
-        ou::db::QueryFields<OrderManagerQueries::UpdateAtPlaceOrder1>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateAtPlaceOrder1>( // todo:  cache this query
-            "update orders set"
-            " timeinforce=?, goodtilldate=?, goodaftertime=?"
-            ", parentid=?, transmit=?, outsiderth=?"
-            ", orderstatus=?, datetimesubmitted=?"
-            ", signalprice=?, description=?"
-            , update ).Where( "orderid=?" );
+        Persist( EUpdateAtPlaceOrder1, OrderManagerQueries::sUpdateAtPlaceOrder1, update );
       }
     }
     else {
@@ -216,9 +249,12 @@ namespace OrderManagerQueries {
     Order::idOrder_t idOrder;
     double dblPrice1;
     double dblPrice2;
+    UpdateAtPlaceOrder2(): idOrder {}, dblPrice1 {}, dblPrice2 {} {}
     UpdateAtPlaceOrder2( Order::idOrder_t id, double dblPrice1_, double dblPrice2_ )
       : idOrder( id ), dblPrice1( dblPrice1_ ), dblPrice2( dblPrice2_ ) {};
   };
+
+  const std::string sUpdateAtPlaceOrder2( "update orders set price1=?, price2=?" );
 }
 
 void OrderManager::UpdateOrder(ProviderInterfaceBase *pProvider, pOrder_t pOrder) {
@@ -233,9 +269,7 @@ void OrderManager::UpdateOrder(ProviderInterfaceBase *pProvider, pOrder_t pOrder
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateAtPlaceOrder2
           update( pOrder->GetOrderId(), pOrder->GetRow().dblPrice1, pOrder->GetRow().dblPrice2 );
-        ou::db::QueryFields<OrderManagerQueries::UpdateAtPlaceOrder2>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateAtPlaceOrder2>( // todo:  cache this query
-            "update orders set price1=?, price2=?", update ).Where( "orderid=?" );
+        Persist( EUpdateAtPlaceOrder2, OrderManagerQueries::sUpdateAtPlaceOrder2, update );
       }
     }
     else {
@@ -331,9 +365,12 @@ namespace OrderManagerQueries {
     Order::idOrder_t idOrder;
     ptime dtOrderClosed;
     OrderStatus::EOrderStatus eOrderStatus;
+    UpdateAtOrderClose(): idOrder {}, eOrderStatus {} {}
     UpdateAtOrderClose( Order::idOrder_t id, OrderStatus::EOrderStatus status, ptime dtOrderClosed_ )
       : idOrder( id ), dtOrderClosed( dtOrderClosed_ ), eOrderStatus( status ) {};
   };
+
+  const std::string sUpdateAtOrderClose( "update orders set orderstatus=?, datetimeclosed=?" );
 }
 
 void OrderManager::CancelOrder( idOrder_t nOrderId) {  // this needs to work in conjunction with ReportCancellation, database update maybe premature
@@ -361,9 +398,7 @@ void OrderManager::ReportCancellation( idOrder_t nOrderId ) {
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateAtOrderClose
           close( pOrder->GetOrderId(), pOrder->GetRow().eOrderStatus, pOrder->GetRow().dtOrderClosed );
-        ou::db::QueryFields<OrderManagerQueries::UpdateAtOrderClose>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateAtOrderClose>( // todo:  cache this query
-            "update orders set orderstatus=?, datetimeclosed=?", close ).Where( "orderid=?" );
+        Persist( EUpdateAtOrderClose, OrderManagerQueries::sUpdateAtOrderClose, close );
       }
     }
     else {
@@ -392,6 +427,8 @@ namespace OrderManagerQueries {
     ptime dtClosed;
     double dblAverageFillPrice;
     Order::idOrder_t idOrder;
+    UpdateOrder()
+      : eOrderStatus {}, nQuantityRemaining {}, nQuantityFilled {}, dblAverageFillPrice {}, idOrder {} {}
     UpdateOrder( Order::idOrder_t idOrder_, OrderStatus::EOrderStatus eOrderStatus_,
       boost::uint32_t nQuantityRemaining_, boost::uint32_t nQuantityFilled_, double dblAverageFillPrice_, ptime dtClosed_ = boost::date_time::not_a_date_time )
       : idOrder( idOrder_ ), eOrderStatus( eOrderStatus_ ),
@@ -416,28 +453,32 @@ void OrderManager::ReportExecution( idOrder_t nOrderId, const Execution& exec) {
           {
             OrderManagerQueries::UpdateOrder
               order( nOrderId, row.eOrderStatus, row.nQuantityRemaining, row.nQuantityFilled, row.dblAverageFillPrice, ou::TimeSource::LocalCommonInstance().Internal() );
-            ou::db::QueryFields<OrderManagerQueries::UpdateOrder>::pQueryFields_t pQuery
-              = m_pSession->SQL<OrderManagerQueries::UpdateOrder>( // todo:  cache this query
-              OrderManagerQueries::sUpdateOrderQuery, order ).Where( "orderid=?" );
+            Persist( EUpdateOrder, OrderManagerQueries::sUpdateOrderQuery, order );
           }
           break;
         default:
           {
             OrderManagerQueries::UpdateOrder
               order( nOrderId, row.eOrderStatus, row.nQuantityRemaining, row.nQuantityFilled, row.dblAverageFillPrice );
-            ou::db::QueryFields<OrderManagerQueries::UpdateOrder>::pQueryFields_t pQuery
-              = m_pSession->SQL<OrderManagerQueries::UpdateOrder>( // todo:  cache this query
-              OrderManagerQueries::sUpdateOrderQuery, order ).Where( "orderid=?" );
+            Persist( EUpdateOrder, OrderManagerQueries::sUpdateOrderQuery, order );
           }
           break;
         }
         // add execution record
         pExecution_t pExecution = std::make_shared<ou::tf::Execution>( exec );
         pExecution->SetOrderId( nOrderId );
-        ou::db::QueryFields<Execution::TableRowDefNoKey>::pQueryFields_t pQueryExecutionWrite
-          = m_pSession->Insert<Execution::TableRowDefNoKey>(
-            const_cast<Execution::TableRowDefNoKey&>( dynamic_cast<const Execution::TableRowDefNoKey&>( pExecution->GetRow() ) ) );
-        idExecution_t idExecution = m_pSession->GetLastRowId();
+        idExecution_t idExecution;
+        if ( m_pWriteBehind ) {
+          idExecution = ++m_idExecution;
+          pExecution->SetExecutionId( idExecution );
+          m_pWriteBehind->Append( EInsertExecution, pExecution->GetRow() );
+        }
+        else {
+          ou::db::QueryFields<Execution::TableRowDefNoKey>::pQueryFields_t pQueryExecutionWrite
+            = m_pSession->Insert<Execution::TableRowDefNoKey>(
+              const_cast<Execution::TableRowDefNoKey&>( dynamic_cast<const Execution::TableRowDefNoKey&>( pExecution->GetRow() ) ) );
+          idExecution = m_pSession->GetLastRowId();
+        }
         pairExecution_t pair( idExecution, pExecution );
         iter->second.pmapExecutions->insert( pair );
       }
@@ -465,9 +506,12 @@ namespace OrderManagerQueries {
     }
     Order::idOrder_t idOrder;
     double dblCommission;
+    UpdateCommission(): idOrder {}, dblCommission {} {}
     UpdateCommission( Order::idOrder_t id, double dblCommission_ )
       : idOrder( id ), dblCommission( dblCommission_ ) {};
   };
+
+  const std::string sUpdateCommission( "update orders set commission=?" );
 }
 
 void OrderManager::ReportCommission( idOrder_t nOrderId, double dblCommission ) {
@@ -478,9 +522,7 @@ void OrderManager::ReportCommission( idOrder_t nOrderId, double dblCommission )
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateCommission
           commission( pOrder->GetOrderId(), dblCommission );
-        ou::db::QueryFields<OrderManagerQueries::UpdateCommission>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateCommission>( // todo:  cache this query
-            "update orders set commission=?", commission ).Where( "orderid=?" );
+        Persist( EUpdateCommission, OrderManagerQueries::sUpdateCommission, commission );
       }
       pOrder->SetCommission( dblCommission );  // need to do afterwards as delegated objects may query the db (other stuff above may not obey this format)
       // as a result, may need to set delegates here so database is updated before order calls delegates.
@@ -505,9 +547,12 @@ namespace OrderManagerQueries {
     Order::idOrder_t idOrder;
     ptime dtOrderClosed;
     OrderStatus::EOrderStatus eOrderStatus;
+    UpdateOnOrderError(): idOrder {}, eOrderStatus {} {}
     UpdateOnOrderError( Order::idOrder_t id, OrderStatus::EOrderStatus status, ptime dtOrderClosed_ )
       : idOrder( id ), dtOrderClosed( dtOrderClosed_ ), eOrderStatus( status ) {};
   };
+
+  const std::string sUpdateOnOrderError( "update orders set orderstatus=?, datetimeclosed=?" );
 }
 
 void OrderManager::ReportErrors( idOrder_t nOrderId, OrderError::EOrderError eError) {
@@ -520,9 +565,7 @@ void OrderManager::ReportErrors( idOrder_t nOrderId, OrderError::EOrderError eEr
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateOnOrderError
           error( pOrder->GetOrderId(), pOrder->GetRow().eOrderStatus, pOrder->GetRow().dtOrderClosed );
-        ou::db::QueryFields<OrderManagerQueries::UpdateOnOrderError>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateOnOrderError>( // todo:  cache this query
-            "update orders set orderstatus=?, datetimeclosed=?", error ).Where( "orderid=?" );
+        Persist( EUpdateOnOrderError, OrderManagerQueries::sUpdateOnOrderError, error );
       }
     }
     else {
@@ -542,10 +585,13 @@ namespace OrderManagerQueries {
       ou::db::Field( a, "orderid", idOrder );
     }
     Order::idOrder_t idOrder;
-    const std::string& sReference;
+    std::string sReference;
+    UpdateReference(): idOrder {} {}
     UpdateReference( Order::idOrder_t idOrder_, const std::string& sReference_ )
     : idOrder( idOrder_ ), sReference( sReference_ ) {}
   };
+
+  const std::string sUpdateReference( "update orders set reference=?" );
 }
 
 void OrderManager::UpdateReference( idOrder_t idOrder, const std::string& sReference ) {
@@ -556,9 +602,7 @@ void OrderManager::UpdateReference( idOrder_t idOrder, const std::string& sRefer
       pOrder->SetReference( sReference );
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateReference reference( idOrder, sReference );
-        ou::db::QueryFields<OrderManagerQueries::UpdateReference>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateReference>( // todo:  cache this query
-            "update orders set reference=?", reference ).Where( "orderid=?" );
+        Persist( EUpdateReference, OrderManagerQueries::sUpdateReference, reference );
       }
     }
     else {
@@ -582,6 +626,9 @@ void OrderManager::HandleRegisterRows( ou::db::Session& session ) {
 }
 
 void OrderManager::HandlePopulateTables( ou::db::Session& session ) {
+  if ( !m_sWriteBehindJournal.empty() ) {
+    StartWriteBehind( session, false ); // a journal left over from another database does not apply to a new one
+  }
 }
 
 namespace OrderManagerQueries {
@@ -592,9 +639,50 @@ namespace OrderManagerQueries {
     }
     Order::idOrder_t idOrder;
   };
+
+  struct ColumnMaxExecutionId {
+    template<typename A>
+    void Fields( A& a ) {
+      ou::db::Field( a, "executionid", idExecution );
+    }
+    Execution::idExecution_t idExecution;
+  };
+
+  // replayed journal records may already have been committed
+  template<class F>
+  std::string InsertOrIgnore( const std::string& sTableName ) {
+    F f;
+    ou::db::Action_Compose_Insert action( sTableName );
+    f.Fields( action );
+    std::string sStatement;
+    action.ComposeStatement( sStatement ); // INSERT INTO ...
+    return "INSERT OR IGNORE" + sStatement.substr( 6 );
+  }
+
+  const std::string sWhereOrderId( " WHERE orderid=?" );
+}
+
+void OrderManager::StartWriteBehind( ou::db::Session& session, bool bReplay ) {
+  namespace q = OrderManagerQueries;
+  m_pWriteBehind = std::make_unique<WriteBehind>( session.FileName(), m_sWriteBehindJournal );
+  m_pWriteBehind->Register<Order::TableRowDef>( EInsertOrder, q::InsertOrIgnore<Order::TableRowDef>( tablenames::sOrder ) );
+  m_pWriteBehind->Register<Execution::TableRowDef>( EInsertExecution, q::InsertOrIgnore<Execution::TableRowDef>( tablenames::sExecution ) );
+  m_pWriteBehind->Register<q::UpdateAtPlaceOrder1>( EUpdateAtPlaceOrder1, q::sUpdateAtPlaceOrder1 + q::sWhereOrderId );
+  m_pWriteBehind->Register<q::UpdateAtPlaceOrder2>( EUpdateAtPlaceOrder2, q::sUpdateAtPlaceOrder2 + q::sWhereOrderId );
+  m_pWriteBehind->Register<q::UpdateAtOrderClose>( EUpdateAtOrderClose, q::sUpdateAtOrderClose + q::sWhereOrderId );
+  m_pWriteBehind->Register<q::UpdateOrder>( EUpdateOrder, q::sUpdateOrderQuery + q::sWhereOrderId );
+  m_pWriteBehind->Register<q::UpdateCommission>( EUpdateCommission, q::sUpdateCommission + q::sWhereOrderId );
+  m_pWriteBehind->Register<q::UpdateOnOrderError>( EUpdateOnOrderError, q::sUpdateOnOrderError + q::sWhereOrderId );
+  m_pWriteBehind->Register<q::UpdateReference>( EUpdateReference, q::sUpdateReference + q::sWhereOrderId );
+  m_pWriteBehind->Start( bReplay );
 }
 
 void OrderManager::HandleLoadTables( ou::db::Session& session ) {
+
+  if ( !m_sWriteBehindJournal.empty() ) {
+    StartWriteBehind( session, true ); // journal is replayed before the keys are obtained
+  }
+
   try {
     ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t pQuery
       = m_pSession->SQL<ou::db::NoBind>( "select max(orderid) as orderid from orders;" ); // immediately executed
@@ -610,6 +698,19 @@ void OrderManager::HandleLoadTables( ou::db::Session& session ) {
   catch ( const std::runtime_error& error ) {
     std::cout << "OrderManager::HandleLoadTables: no orders found, " << error.what() << std::endl;
   }
+
+  if ( m_pWriteBehind ) {
+    try {
+      ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t pQuery
+        = m_pSession->SQL<ou::db::NoBind>( "select max(executionid) as executionid from executions;" ); // immediately executed
+      OrderManagerQueries::ColumnMaxExecutionId result;
+      m_pSession->Columns<ou::db::NoBind,OrderManagerQueries::ColumnMaxExecutionId>( pQuery, result );
+      m_idExecution = result.idExecution; // produces 0 when no executions present
+    }
+    catch ( const std::runtime_error& error ) {
+      std::cout << "OrderManager::HandleLoadTables: no executions found, " << error.what() << std::endl;
+    }
+  }
 }
 
 // this stuff could probably be rolled into Session with a template
@@ -626,6 +727,7 @@ void OrderManager::DetachFromSession( ou::db::Session* pSession ) {
   pSession->OnRegisterRows.Remove( MakeDelegate( this, &OrderManager::HandleRegisterRows ) );
   pSession->OnPopulate.Remove( MakeDelegate( this, &OrderManager::HandlePopulateTables ) );
   pSession->OnLoad.Remove( MakeDelegate( this, &OrderManager::HandleLoadTables ) );
+  m_pWriteBehind.reset(); // outstanding records are committed
   ManagerBase::DetachFromSession( pSession );
 }
 
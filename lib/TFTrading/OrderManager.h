@@ -17,6 +17,7 @@
 // At some point, make order manager responsible for constructing Order
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <stdexcept>
 
@@ -38,6 +39,7 @@ namespace tf { // TradeFrame
 //
 
 class ProviderInterfaceBase;
+class WriteBehind;
 
 // this is a singleton so use the Instance() call from all users
 class OrderManager: public ou::db::ManagerBase<OrderManager> {
@@ -98,6 +100,13 @@ public:
   void AttachToSession( ou::db::Session* pSession );
   void DetachFromSession( ou::db::Session* pSession );
 
+  // call before the session is opened:  order and execution records are written to the journal,
+  //   and committed to the database by a background writer, rather than on the calling thread
+  //   records remaining in the journal from an interrupted run are committed when the session loads
+  //   queries through the session see the records once committed, use FlushWriteBehind to wait for them
+  void EnableWriteBehind( const std::string& sJournalFileName );
+  void FlushWriteBehind(); // blocks until records reported so far are in the database
+
 protected:
 
   using pairExecution_t = std::pair<idExecution_t, pExecution_t>;
@@ -139,6 +148,21 @@ private:
 
   mapOrders_t m_mapOrders; // all orders for when checking for consistency
 
+  enum EStatement { // write-behind statements
+    EInsertOrder, EInsertExecution,
+    EUpdateAtPlaceOrder1, EUpdateAtPlaceOrder2, EUpdateAtOrderClose, EUpdateOrder,
+    EUpdateCommission, EUpdateOnOrderError, EUpdateReference
+  };
+
+  std::string m_sWriteBehindJournal;
+  std::unique_ptr<WriteBehind> m_pWriteBehind;
+  idExecution_t m_idExecution; // last assigned, with write-behind the id is not obtained from the insert
+
+  void StartWriteBehind( ou::db::Session& session, bool bReplay );
+
+  template<class F>
+  void Persist( EStatement, const std::string& sUpdate, F& ); // sUpdate is completed with the orderid
+
 //  iterOrders_t LocateOrder( idOrder_t nOrderId );  // in memory or from disk
   bool LocateOrder( idOrder_t nOrderId, iterOrders_t& );  // in memory or from disk, return true if order found
 
@@ -30,6 +30,7 @@
 #include "KeyTypes.h"
 #include "Symbol.h"
 #include "Order.h"
+#include "SymbolIndex.hpp"
 
 // need to include a check that callbacks and virtuals are in the correct thread
 // in IB, processMsg may be best place to have in cross thread management, if it isn't already
@@ -226,7 +227,10 @@ public:
 protected:
 
   using mapSymbols_t = std::map<idSymbol_t, pSymbol_t>;
-  mapSymbols_t m_mapSymbols;
+  mapSymbols_t m_mapSymbols; // cold path:  add, remove handlers, connection changes
+
+  using indexSymbols_t = SymbolIndex<pSymbol_t>;
+  indexSymbols_t m_indexSymbols; // hot path:  routing of inbound messages by symbol
 
   //void Connecting( void );
   void ConnectionComplete();
@@ -266,6 +270,7 @@ ProviderInterface<P,S>::ProviderInterface(void)
 
 template <typename P, typename S>
 ProviderInterface<P,S>::~ProviderInterface(void) {
+  m_indexSymbols.Clear();
   m_mapSymbols.clear();
 }
 
@@ -328,6 +333,7 @@ typename ProviderInterface<P,S>::pSymbol_t ProviderInterface<P,S>::AddCSymbol( p
     m_mapSymbols.insert( typename mapSymbols_t::value_type( pSymbol->GetId(), pSymbol ) );
     iter = m_mapSymbols.find( pSymbol->GetId() );
     assert( m_mapSymbols.end() != iter );
+    m_indexSymbols.Insert( pSymbol->GetId(), pSymbol );
   }
   else {
     throw std::runtime_error( "AddCSymbol " + pSymbol->GetId() + " symbol already exists in provider" );
@@ -0,0 +1,176 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    SymbolIndex.hpp
+ * Author:  raymond@burkholder.net
+ * Project: TFTrading
+ * Created: 2026/10/16 09:12:41
+ */
+
+// hot path symbol routing for providers:  message symbol field -> pSymbol_t
+// open addressing, linear probing, hash is computed once on insert and stored with the entry
+// single writer (serialized internally), lock free readers:
+//   a slot is published with a release store once its entry is complete,
+//   growth builds a new table and publishes it, retired tables are kept until Clear,
+//   symbols are never removed individually (ProviderInterface doesn't remove them either)
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+template<typename pSymbol_t>
+class SymbolIndex {
+public:
+
+  struct Entry {
+    const std::string sId;
+    const uint64_t hash;
+    const pSymbol_t pSymbol;
+    Entry( const std::string& sId_, uint64_t hash_, pSymbol_t pSymbol_ )
+    : sId( sId_ ), hash( hash_ ), pSymbol( std::move( pSymbol_ ) ) {}
+  };
+
+  // optional per connection cache of the last hit, consecutive messages tend to be for the same symbol
+  struct Cache {
+    const Entry* pEntry;
+    Cache(): pEntry( nullptr ) {}
+  };
+
+  SymbolIndex()
+  : m_nEntries {}, m_pTable( nullptr )
+  {
+    Publish( 64 );
+  }
+
+  ~SymbolIndex() {}
+
+  static uint64_t Hash( std::string_view sv ) { // FNV-1a
+    uint64_t hash( 14695981039346656037ull );
+    for ( const char ch: sv ) {
+      hash ^= static_cast<uint8_t>( ch );
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  // returns false if the id is already present
+  bool Insert( const std::string& sId, pSymbol_t pSymbol ) {
+    std::scoped_lock<std::mutex> lock( m_mutexWriter );
+    const uint64_t hash( Hash( sId ) );
+    if ( nullptr != Find( sId, hash ) ) return false;
+    Table* pTable( m_pTable.load( std::memory_order_relaxed ) );
+    if ( ( 2 * ( m_nEntries + 1 ) ) > pTable->nSlots ) { // keep load factor at or below 0.5
+      pTable = Publish( 2 * pTable->nSlots );
+    }
+    m_vEntry.emplace_back( std::make_unique<Entry>( sId, hash, std::move( pSymbol ) ) );
+    Place( *pTable, m_vEntry.back().get() );
+    ++m_nEntries;
+    return true;
+  }
+
+  const pSymbol_t* Find( std::string_view sv ) const {
+    const Entry* pEntry( Find( sv, Hash( sv ) ) );
+    return ( nullptr == pEntry ) ? nullptr : &pEntry->pSymbol;
+  }
+
+  const pSymbol_t* Find( std::string_view sv, Cache& cache ) const {
+    const Entry* pEntry( cache.pEntry );
+    if ( ( nullptr != pEntry ) && ( pEntry->sId == sv ) ) {
+      return &pEntry->pSymbol;
+    }
+    pEntry = Find( sv, Hash( sv ) );
+    if ( nullptr == pEntry ) return nullptr;
+    cache.pEntry = pEntry;
+    return &pEntry->pSymbol;
+  }
+
+  std::size_t Size() const { return m_nEntries; }
+
+  // caller ensures there are no readers, invalidates Cache
+  void Clear() {
+    std::scoped_lock<std::mutex> lock( m_mutexWriter );
+    m_vTable.clear();
+    m_vEntry.clear();
+    m_nEntries = 0;
+    m_pTable.store( nullptr, std::memory_order_relaxed );
+    Publish( 64 );
+  }
+
+private:
+
+  struct Table {
+    const std::size_t nSlots; // power of two
+    const std::size_t mask;
+    std::unique_ptr<std::atomic<const Entry*>[]> rSlot;
+    Table( std::size_t nSlots_ )
+    : nSlots( nSlots_ ), mask( nSlots_ - 1 )
+    , rSlot( new std::atomic<const Entry*>[ nSlots_ ] )
+    {
+      for ( std::size_t ix = 0; ix < nSlots; ++ix ) {
+        rSlot[ ix ].store( nullptr, std::memory_order_relaxed );
+      }
+    }
+  };
+
+  std::mutex m_mutexWriter;
+
+  std::size_t m_nEntries;
+  std::vector<std::unique_ptr<Entry> > m_vEntry; // stable addresses
+  std::vector<std::unique_ptr<Table> > m_vTable; // current is last, prior ones may still be in use by a reader
+
+  std::atomic<Table*> m_pTable;
+
+  const Entry* Find( std::string_view sv, uint64_t hash ) const {
+    const Table* pTable( m_pTable.load( std::memory_order_acquire ) );
+    std::size_t ix( hash & pTable->mask );
+    while ( true ) {
+      const Entry* pEntry( pTable->rSlot[ ix ].load( std::memory_order_acquire ) );
+      if ( nullptr == pEntry ) return nullptr;
+      if ( ( hash == pEntry->hash ) && ( sv == pEntry->sId ) ) return pEntry;
+      ix = ( ix + 1 ) & pTable->mask;
+    }
+  }
+
+  static void Place( Table& table, const Entry* pEntry ) {
+    std::size_t ix( pEntry->hash & table.mask );
+    while ( nullptr != table.rSlot[ ix ].load( std::memory_order_relaxed ) ) {
+      ix = ( ix + 1 ) & table.mask;
+    }
+    table.rSlot[ ix ].store( pEntry, std::memory_order_release );
+  }
+
+  Table* Publish( std::size_t nSlots ) {
+    m_vTable.emplace_back( std::make_unique<Table>( nSlots ) );
+    Table* pTable( m_vTable.back().get() );
+    for ( const typename decltype( m_vEntry )::value_type& pEntry: m_vEntry ) {
+      Place( *pTable, pEntry.get() );
+    }
+    m_pTable.store( pTable, std::memory_order_release );
+    return pTable;
+  }
+
+};
+
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,266 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    WriteBehind.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFTrading
+ * Created: 2026/10/16 21:05:37
+ */
+
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+#include <boost/filesystem.hpp>
+
+#include "WriteBehind.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+WriteBehind::WriteBehind( const std::string& sDbFileName, const std::string& sJournalFileName )
+: m_sJournalFileName( sJournalFileName )
+, m_pJournal( nullptr )
+, m_bRetainJournal( false )
+, m_queue( nQueueCapacity )
+, m_bWriterWaiting( false )
+, m_bStop( false )
+, m_nAppended {}, m_nCommitted {}, m_nTransactions {}, m_nErrors {}
+{
+  m_session.Open( sDbFileName );
+}
+
+WriteBehind::~WriteBehind() {
+  if ( m_threadWriter.joinable() ) {
+    {
+      std::lock_guard<std::mutex> lock( m_mutexWriter );
+      m_bStop = true;
+    }
+    m_cvWriter.notify_one();
+    m_threadWriter.join(); // the writer drains the queue before finishing
+  }
+  if ( nullptr != m_pJournal ) {
+    std::fclose( m_pJournal );
+    m_pJournal = nullptr;
+    if ( m_bRetainJournal ) {
+      std::cout << "WriteBehind: journal retained for replay: " << m_sJournalFileName << std::endl;
+    }
+    else {
+      std::remove( m_sJournalFileName.c_str() );
+    }
+  }
+  // statements are finalized before the connection is closed
+  m_vStatement.clear();
+  m_session.Close();
+}
+
+void WriteBehind::Step( ou::db::Session& session, pQueryBase_t pQuery ) {
+  try {
+    session.Execute( pQuery );
+  }
+  catch ( ... ) {
+    try {
+      session.Reset( pQuery ); // reports the same error again
+    }
+    catch ( ... ) {}
+    throw;
+  }
+  session.Reset( pQuery );
+}
+
+void WriteBehind::Start( bool bReplay ) {
+  assert( !m_threadWriter.joinable() );
+  if ( bReplay ) {
+    Replay(); // throws when the journal could not be applied, the journal is left in place
+  }
+  // a journal with a record which failed to apply is kept, and appended to, so the record is offered to the next replay
+  m_pJournal = std::fopen( m_sJournalFileName.c_str(), m_bRetainJournal ? "ab" : "wb" );
+  if ( nullptr == m_pJournal ) {
+    throw std::runtime_error( "WriteBehind::Start: can not open journal " + m_sJournalFileName );
+  }
+  m_threadWriter = std::thread( [this](){ Writer(); } );
+}
+
+void WriteBehind::Frame( std::string& record ) {
+  if ( nMaxRecordSize < ( record.size() - sizeof( uint32_t ) ) ) {
+    throw std::runtime_error( "WriteBehind::Append: record too large" );
+  }
+  const uint32_t nSize( record.size() - sizeof( uint32_t ) );
+  std::memcpy( &record[ 0 ], &nSize, sizeof( uint32_t ) );
+}
+
+void WriteBehind::Push( pRecord_t pRecord ) {
+  {
+    std::lock_guard<std::mutex> lock( m_mutexJournal );
+    if ( ( nullptr == m_pJournal ) || ( 1 != std::fwrite( pRecord->data(), pRecord->size(), 1, m_pJournal ) ) || ( 0 != std::fflush( m_pJournal ) ) ) {
+      std::cout << "WriteBehind::Append: journal write failed" << std::endl;
+      m_bRetainJournal = true; // can't be emptied safely
+    }
+    ++m_nAppended;
+    while ( !m_queue.push( pRecord ) ) { // the writer is a full queue behind
+      std::this_thread::yield();
+    }
+  }
+  // pairs with the fence in Writer, either the writer sees the record, or this sees the writer waiting
+  std::atomic_thread_fence( std::memory_order_seq_cst );
+  if ( m_bWriterWaiting.load( std::memory_order_relaxed ) ) {
+    std::lock_guard<std::mutex> lock( m_mutexWriter );
+    m_cvWriter.notify_one();
+  }
+}
+
+void WriteBehind::Apply( const std::string& record ) {
+  writebehind::Action_Read read( record.data() + sizeof( uint32_t ), record.size() - sizeof( uint32_t ) );
+  ixStatement_t ixStatement;
+  read.Read( ixStatement );
+  if ( ( m_vStatement.size() <= ixStatement ) || !m_vStatement[ ixStatement ] ) {
+    throw std::runtime_error( "WriteBehind::Apply: unknown statement" );
+  }
+  m_vStatement[ ixStatement ]->Apply( m_session, read );
+}
+
+bool WriteBehind::Commit( const vRecord_t& vRecord ) {
+  for ( unsigned int cnt = 0; cnt < 5; cnt++ ) {
+    uint64_t nFailed {}; // records of this attempt, counted once the batch is committed
+    try {
+      m_session.BeginTransaction();
+      for ( const pRecord_t pRecord: vRecord ) {
+        try {
+          Apply( *pRecord );
+        }
+        catch ( const std::runtime_error& e ) { // the batch continues, the record stays in the journal
+          ++nFailed;
+          m_bRetainJournal = true;
+          std::cout << "WriteBehind::Commit record: " << e.what() << std::endl;
+        }
+      }
+      m_session.CommitTransaction(); // rolls back when the commit fails
+      m_nErrors += nFailed;
+      ++m_nTransactions;
+      return true;
+    }
+    catch ( const std::runtime_error& e ) { // begin or commit, try the batch again
+      std::cout << "WriteBehind::Commit attempt " << cnt << ": " << e.what() << std::endl;
+      std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+    }
+  }
+  return false;
+}
+
+void WriteBehind::Committed( size_t n ) {
+  m_nCommitted += n;
+  {
+    std::lock_guard<std::mutex> lock( m_mutexCommitted );
+  }
+  m_cvCommitted.notify_all();
+
+  if ( !m_bRetainJournal ) {
+    // skipped when an append is in progress, tried again after the next batch
+    std::unique_lock<std::mutex> lock( m_mutexJournal, std::try_to_lock );
+    if ( lock.owns_lock() && ( m_nAppended.load() == m_nCommitted.load() ) && ( nJournalResetSize <= std::ftell( m_pJournal ) ) ) {
+      m_pJournal = std::freopen( m_sJournalFileName.c_str(), "wb", m_pJournal );
+      if ( nullptr == m_pJournal ) {
+        std::cout << "WriteBehind: can not re-open journal " << m_sJournalFileName << std::endl;
+      }
+    }
+  }
+}
+
+void WriteBehind::Writer() {
+  vRecord_t vRecord;
+  vRecord.reserve( nMaxBatch );
+  while ( true ) {
+    {
+      std::unique_lock<std::mutex> lock( m_mutexWriter );
+      m_bWriterWaiting.store( true, std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_seq_cst );
+      m_cvWriter.wait( lock, [this](){ return m_bStop || ( 0 < m_queue.read_available() ); } );
+      m_bWriterWaiting.store( false, std::memory_order_relaxed );
+    }
+    // records arriving during a commit are picked up by the next batch
+    pRecord_t pRecord;
+    while ( ( vRecord.size() < nMaxBatch ) && m_queue.pop( pRecord ) ) {
+      vRecord.push_back( pRecord );
+    }
+    if ( vRecord.empty() ) break; // stopped, and drained
+    if ( !Commit( vRecord ) ) { // each record once, however many attempts
+      m_nErrors += vRecord.size();
+      m_bRetainJournal = true;
+      std::cout << "WriteBehind: " << vRecord.size() << " records not committed, retained in journal" << std::endl;
+    }
+    for ( pRecord_t p: vRecord ) delete p;
+    Committed( vRecord.size() );
+    vRecord.clear();
+  }
+}
+
+void WriteBehind::Replay() {
+  std::FILE* pFile = std::fopen( m_sJournalFileName.c_str(), "rb" );
+  if ( nullptr == pFile ) return; // clean shutdown last time
+
+  const uintmax_t nFile( boost::filesystem::file_size( m_sJournalFileName ) );
+
+  vRecord_t vRecord;
+  uint32_t nSize;
+  uintmax_t nComplete {}; // bytes of whole records
+  while ( 1 == std::fread( &nSize, sizeof( uint32_t ), 1, pFile ) ) {
+    if ( ( nMaxRecordSize < nSize ) || ( ( nFile - nComplete - sizeof( uint32_t ) ) < nSize ) ) {
+      break; // a size torn while being written, or past the end of the file, the tail is cut off as a partial record
+    }
+    pRecord_t pRecord = new std::string( sizeof( uint32_t ) + nSize, 0 );
+    std::memcpy( &(*pRecord)[ 0 ], &nSize, sizeof( uint32_t ) );
+    if ( ( 0 < nSize ) && ( 1 != std::fread( &(*pRecord)[ sizeof( uint32_t ) ], nSize, 1, pFile ) ) ) {
+      delete pRecord; // partial record, interrupted while being written
+      break;
+    }
+    nComplete += pRecord->size();
+    vRecord.push_back( pRecord );
+  }
+  std::fclose( pFile );
+
+  // a partial record is cut off, as a retained journal is appended to
+  if ( nFile != nComplete ) {
+    boost::filesystem::resize_file( m_sJournalFileName, nComplete );
+  }
+
+  bool bOk( true );
+  for ( vRecord_t::size_type ix = 0; bOk && ( ix < vRecord.size() ); ix += nMaxBatch ) {
+    const vRecord_t vBatch(
+      vRecord.begin() + ix,
+      vRecord.begin() + std::min( ix + nMaxBatch, vRecord.size() ) );
+    bOk = Commit( vBatch );
+  }
+  for ( pRecord_t p: vRecord ) delete p;
+
+  if ( !bOk ) {
+    throw std::runtime_error( "WriteBehind::Replay: journal could not be committed " + m_sJournalFileName );
+  }
+  std::cout << "WriteBehind::Replay: " << vRecord.size() << " records from " << m_sJournalFileName << std::endl;
+}
+
+void WriteBehind::Flush() {
+  const uint64_t nTarget( m_nAppended.load() );
+  std::unique_lock<std::mutex> lock( m_mutexCommitted );
+  m_cvCommitted.wait( lock, [this,nTarget](){ return nTarget <= m_nCommitted.load(); } );
+}
+
+WriteBehind::Stats WriteBehind::GetStats() const {
+  return Stats {
+    m_nAppended.load(), m_nCommitted.load(), m_nTransactions.load(), m_nErrors.load()
+  };
+}
+
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,250 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    WriteBehind.h
+ * Author:  raymond@burkholder.net
+ * Project: TFTrading
+ * Created: 2026/10/16 21:05:37
+ */
+
+// write-behind persistence for a set of registered statements
+//   Append serializes the Fields of a query structure into a journal record, writes the record to the
+//   journal file, then hands it to the writer thread through a lock-free queue, the caller never waits on sqlite
+//   the writer thread has its own connection to the database, drains the queue in batches,
+//   one transaction per batch, with each statement prepared once and re-bound per record
+//   the journal is emptied once everything appended has been committed,
+//   records left in the journal by a crash are replayed into the database by Start
+//   a batch or a record which fails to apply keeps the journal, Start then replays it and appends to it
+// the journal is flushed to the operating system on each append, so it survives a process crash,
+//   it is not synced to the disk
+// appending threads are serialized on the journal, the queue is single producer / single consumer
+
+#pragma once
+
+#include <mutex>
+#include <cassert>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <condition_variable>
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <OUSqlite/Session.h>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+namespace writebehind {
+
+// journal record: uint32_t size of the remainder, uint16_t statement index, fields
+
+class Action_Write {
+public:
+  Action_Write( std::string& s ): m_s( s ) {}
+
+  template<typename T>
+  void Field( const std::string& sFieldName, T& var, const std::string& sFieldType = "" ) {
+    Write( var );
+  }
+
+  template<typename T>
+  void Write( const T& var ) {
+    static_assert( std::is_trivially_copyable<T>::value, "writebehind::Action_Write: type needs a Write overload" );
+    m_s.append( reinterpret_cast<const char*>( &var ), sizeof( T ) );
+  }
+
+  void Write( const std::string& var ) {
+    Write( static_cast<uint32_t>( var.size() ) );
+    m_s.append( var );
+  }
+
+private:
+  std::string& m_s;
+};
+
+class Action_Read {
+public:
+  Action_Read( const char* p, size_t n ): m_p( p ), m_pEnd( p + n ) {}
+
+  template<typename T>
+  void Field( const std::string& sFieldName, T& var, const std::string& sFieldType = "" ) {
+    Read( var );
+  }
+
+  template<typename T>
+  void Read( T& var ) {
+    static_assert( std::is_trivially_copyable<T>::value, "writebehind::Action_Read: type needs a Read overload" );
+    Check( sizeof( T ) );
+    std::memcpy( &var, m_p, sizeof( T ) );
+    m_p += sizeof( T );
+  }
+
+  void Read( std::string& var ) {
+    uint32_t n;
+    Read( n );
+    Check( n );
+    var.assign( m_p, n );
+    m_p += n;
+  }
+
+private:
+  const char* m_p;
+  const char* m_pEnd;
+  void Check( size_t n ) const {
+    if ( n > (size_t)( m_pEnd - m_p ) ) throw std::runtime_error( "writebehind::Action_Read: record too short" );
+  }
+};
+
+} // namespace writebehind
+
+class WriteBehind {
+public:
+
+  using ixStatement_t = uint16_t;
+
+  WriteBehind( const std::string& sDbFileName, const std::string& sJournalFileName );
+  WriteBehind( const WriteBehind& ) = delete;
+  WriteBehind( WriteBehind&& ) = delete;
+  ~WriteBehind(); // commits everything appended, then empties the journal
+
+  // F: structure with Fields, default constructible, sStatement has a '?' for each field, in order
+  // all statements are registered before Start
+  template<class F>
+  void Register( ixStatement_t, const std::string& sStatement );
+
+  // bReplay: apply records remaining in the journal, otherwise they are discarded
+  void Start( bool bReplay );
+
+  template<class F>
+  void Append( ixStatement_t, const F& );
+
+  void Flush(); // blocks until everything appended so far has been committed
+
+  struct Stats {
+    uint64_t nAppended;
+    uint64_t nCommitted;    // written, or given up on
+    uint64_t nTransactions;
+    uint64_t nErrors;       // records which failed
+  };
+  Stats GetStats() const;
+
+protected:
+private:
+
+  using pQueryBase_t = ou::db::QueryBase::pQueryBase_t;
+
+  static void Step( ou::db::Session&, pQueryBase_t ); // execute, then reset for re-use
+
+  struct StatementBase {
+    virtual ~StatementBase() {}
+    virtual void Apply( ou::db::Session&, writebehind::Action_Read& ) = 0; // throws on a failed statement
+  };
+
+  template<class F>
+  struct Statement: public StatementBase {
+    F f; // the prepared statement binds from this instance
+    const std::string sStatement;
+    typename ou::db::QueryFields<F>::pQueryFields_t pQuery;
+    Statement( const std::string& sStatement_ ): sStatement( sStatement_ ) {}
+    virtual ~Statement() {}
+    virtual void Apply( ou::db::Session& session, writebehind::Action_Read& read ) {
+      f.Fields( read );
+      if ( !pQuery ) {
+        pQuery = session.SQL<F>( sStatement, f ).NoExecute();
+      }
+      session.Bind<F>( pQuery );
+      Step( session, pQuery );
+    }
+  };
+
+  using pStatement_t = std::unique_ptr<StatementBase>;
+  using vStatement_t = std::vector<pStatement_t>;
+  vStatement_t m_vStatement;
+
+  using pRecord_t = std::string*; // journal record, owned by the queue until applied
+  using vRecord_t = std::vector<pRecord_t>;
+
+  static const size_t nQueueCapacity = 64 * 1024;
+  static const size_t nMaxBatch = 4096;
+  static const long nJournalResetSize = 1024 * 1024; // bytes, emptied at this size once fully committed
+  static const uint32_t nMaxRecordSize = 1024 * 1024; // bytes after the size, a larger size in the journal is taken as a torn tail
+
+  const std::string m_sJournalFileName;
+
+  ou::db::Session m_session; // the writer's own connection
+
+  std::mutex m_mutexJournal; // serializes Append and the journal reset
+  std::FILE* m_pJournal;
+  std::atomic<bool> m_bRetainJournal; // set when a batch or a record could not be committed, the journal is kept for the next Start
+
+  boost::lockfree::spsc_queue<pRecord_t> m_queue;
+
+  std::mutex m_mutexWriter;
+  std::condition_variable m_cvWriter;
+  std::atomic<bool> m_bWriterWaiting;
+  bool m_bStop;
+
+  std::mutex m_mutexCommitted;
+  std::condition_variable m_cvCommitted;
+
+  std::atomic<uint64_t> m_nAppended;
+  std::atomic<uint64_t> m_nCommitted; // includes records given up on
+  std::atomic<uint64_t> m_nTransactions;
+  std::atomic<uint64_t> m_nErrors;
+
+  std::thread m_threadWriter;
+
+  static void Frame( std::string& record ); // fills in the size, throws when the record is larger than nMaxRecordSize
+  void Push( pRecord_t );
+
+  void Writer();
+  void Apply( const std::string& record );
+  bool Commit( const vRecord_t& ); // false when the batch could not be committed
+  void Committed( size_t n );
+  void Replay();
+};
+
+template<class F>
+void WriteBehind::Register( ixStatement_t ixStatement, const std::string& sStatement ) {
+  assert( !m_threadWriter.joinable() );
+  if ( m_vStatement.size() <= ixStatement ) m_vStatement.resize( ixStatement + 1 );
+  if ( m_vStatement[ ixStatement ] ) {
+    throw std::runtime_error( "WriteBehind::Register: statement already registered" );
+  }
+  m_vStatement[ ixStatement ] = std::make_unique<Statement<F> >( sStatement );
+}
+
+template<class F>
+void WriteBehind::Append( ixStatement_t ixStatement, const F& f ) {
+  assert( ixStatement < m_vStatement.size() );
+  std::unique_ptr<std::string> pRecord( new std::string );
+  pRecord->reserve( 256 );
+  pRecord->resize( sizeof( uint32_t ) );
+  writebehind::Action_Write write( *pRecord );
+  write.Write( ixStatement );
+  const_cast<F&>( f ).Fields( write );
+  Frame( *pRecord );
+  Push( pRecord.release() );
+}
+
+} // namespace tf
+} // namespace ou